@@ -0,0 +1,237 @@
+#if defined(_WIN32) || defined(_WIN64)
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <windows.h>
+#else
+#	include <time.h>
+#endif
+
+double bench_now(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+	LARGE_INTEGER freq, counter;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+void bench_buffer_append(Bench_Buffer* buffer, const char* data, size_t len)
+{
+	if (buffer->len + len + 1 > buffer->cap)
+	{
+		size_t cap = buffer->cap ? buffer->cap : 4096;
+		while (buffer->len + len + 1 > cap)
+		{
+			cap *= 2;
+		}
+
+		char* tmp = (char*)realloc(buffer->data, cap);
+		if (!tmp)
+			return;
+
+		buffer->data = tmp;
+		buffer->cap = cap;
+	}
+
+	memcpy(buffer->data + buffer->len, data, len);
+	buffer->len += len;
+	buffer->data[buffer->len] = '\0';
+}
+
+void bench_buffer_printf(Bench_Buffer* buffer, const char* fmt, ...)
+{
+	char tmp[512];
+	va_list args;
+	va_start(args, fmt);
+	int len = vsnprintf(tmp, sizeof(tmp), fmt, args);
+	va_end(args);
+
+	if (len > 0)
+		bench_buffer_append(buffer, tmp, (size_t)len < sizeof(tmp) ? (size_t)len : sizeof(tmp) - 1);
+}
+
+void bench_buffer_free(Bench_Buffer* buffer)
+{
+	free(buffer->data);
+	memset(buffer, 0, sizeof(*buffer));
+}
+
+uint32_t bench_rand(uint32_t* state)
+{
+	*state = *state * 1664525u + 1013904223u;
+	return *state >> 8;
+}
+
+void bench_run(Bench_Context* ctx, const char* suite, const char* name, const char* corpus, size_t bytes, Bench_Fn fn, void* user)
+{
+	bench_run_prepared(ctx, suite, name, corpus, bytes, NULL, fn, user);
+}
+
+void bench_run_prepared(Bench_Context* ctx, const char* suite, const char* name, const char* corpus, size_t bytes, Bench_Fn prepare, Bench_Fn fn, void* user)
+{
+	char full[128];
+	snprintf(full, sizeof(full), "%s/%s/%s", suite, name, corpus);
+	if (ctx->filter && !strstr(full, ctx->filter))
+		return;
+
+	Bench_Result result;
+	memset(&result, 0, sizeof(result));
+	snprintf(result.suite, sizeof(result.suite), "%s", suite);
+	snprintf(result.name, sizeof(result.name), "%s", name);
+	snprintf(result.corpus, sizeof(result.corpus), "%s", corpus);
+	result.bytes = bytes;
+	result.seconds = -1.0;
+
+	for (int32_t i = 0; i < ctx->iterations; ++i)
+	{
+		Bench_Result run = result;
+		if (prepare)
+			prepare(user, &run);
+
+		double start = bench_now();
+		fn(user, &run);
+		double elapsed = bench_now() - start;
+		if (result.seconds < 0.0 || elapsed < result.seconds)
+			result.seconds = elapsed;
+
+		if (run.allocations > result.allocations)
+			result.allocations = run.allocations;
+
+		if (run.peak_bytes > result.peak_bytes)
+			result.peak_bytes = run.peak_bytes;
+	}
+
+	result.mb_per_s = result.seconds > 0.0 ? (double)bytes / (1024.0 * 1024.0) / result.seconds : 0.0;
+	naui_list_push(ctx->results, result);
+
+	printf("%-40s %8.2f MB %10.3f ms %10.1f MB/s %8zu allocs %10.2f MB peak\n",
+		full, (double)bytes / (1024.0 * 1024.0), result.seconds * 1000.0, result.mb_per_s,
+		result.allocations, (double)result.peak_bytes / (1024.0 * 1024.0));
+}
+
+bool bench_write_results(const Bench_Context* ctx, const Naui_Path path)
+{
+	Naui_FileHandle handle = NAUI_FILE_HANDLE_INIT;
+	if (!naui_file_open(&handle, path, NAUI_FILE_WRITE))
+		return false;
+
+	char buf[NAUI_JSON_WRITER_STREAM_SIZE];
+	Naui_JsonWriter w;
+	naui_json_writer_init_file(&w, &handle, buf, sizeof(buf), true);
+
+	naui_json_writer_object_begin(&w);
+	naui_json_writer_key(&w, "iterations");
+	naui_json_writer_int(&w, ctx->iterations);
+	naui_json_writer_key(&w, "scale_mb");
+	naui_json_writer_number(&w, ctx->scale_mb);
+	naui_json_writer_key(&w, "results");
+	naui_json_writer_array_begin(&w);
+	for (int32_t i = 0; i < naui_list_len(ctx->results); ++i)
+	{
+		const Bench_Result* r = &ctx->results[i];
+		naui_json_writer_object_begin(&w);
+		naui_json_writer_key(&w, "suite");
+		naui_json_writer_string(&w, r->suite);
+		naui_json_writer_key(&w, "name");
+		naui_json_writer_string(&w, r->name);
+		naui_json_writer_key(&w, "corpus");
+		naui_json_writer_string(&w, r->corpus);
+		naui_json_writer_key(&w, "bytes");
+		naui_json_writer_uint64(&w, r->bytes);
+		naui_json_writer_key(&w, "seconds");
+		naui_json_writer_number(&w, r->seconds);
+		naui_json_writer_key(&w, "mb_per_s");
+		naui_json_writer_number(&w, r->mb_per_s);
+		naui_json_writer_key(&w, "allocations");
+		naui_json_writer_uint64(&w, r->allocations);
+		naui_json_writer_key(&w, "peak_bytes");
+		naui_json_writer_uint64(&w, r->peak_bytes);
+		naui_json_writer_object_end(&w);
+	}
+
+	naui_json_writer_array_end(&w);
+	naui_json_writer_object_end(&w);
+
+	bool ok = naui_json_writer_finish(&w) >= 0;
+	naui_file_close(&handle);
+	return ok;
+}
+
+static const Naui_JsonValue* bench_find(const Naui_JsonValue* results, const Naui_JsonValue* entry)
+{
+	const char* keys[] = { "suite", "name", "corpus" };
+	NAUI_JSON_FOREACH(results, unused, other)
+	{
+		(void)unused;
+		bool same = true;
+		for (int k = 0; k < 3 && same; ++k)
+		{
+			const Naui_JsonValue* a = naui_json_object_get(entry, keys[k]);
+			const Naui_JsonValue* b = naui_json_object_get(other, keys[k]);
+			same = a && b && a->string.len == b->string.len && memcmp(a->string.ptr, b->string.ptr, a->string.len) == 0;
+		}
+
+		if (same)
+			return other;
+	}
+
+	return NULL;
+}
+
+int bench_compare(const Naui_Path baseline, const Naui_Path current, double threshold)
+{
+	Naui_Json base = naui_json_parse_file(baseline);
+	Naui_Json cur = naui_json_parse_file(current);
+	if (base.error || cur.error)
+	{
+		fprintf(stderr, "[Naui] bench: failed to read results (%s)\n", base.error ? base.error : cur.error);
+		naui_json_free(&base);
+		naui_json_free(&cur);
+		return -1;
+	}
+
+	const Naui_JsonValue* base_results = naui_json_object_get(base.root, "results");
+	const Naui_JsonValue* cur_results = naui_json_object_get(cur.root, "results");
+
+	int regressions = 0;
+	printf("%-40s %12s %12s %9s %12s\n", "phase", "base MB/s", "MB/s", "delta", "peak delta");
+	NAUI_JSON_FOREACH(cur_results, unused, entry)
+	{
+		(void)unused;
+		char suite[32], name[64], corpus[32];
+		naui_json_copy_string(naui_json_object_get(entry, "suite"), suite, sizeof(suite));
+		naui_json_copy_string(naui_json_object_get(entry, "name"), name, sizeof(name));
+		naui_json_copy_string(naui_json_object_get(entry, "corpus"), corpus, sizeof(corpus));
+
+		char full[128];
+		snprintf(full, sizeof(full), "%s/%s/%s", suite, name, corpus);
+
+		const Naui_JsonValue* old = bench_find(base_results, entry);
+		double speed = naui_json_get_number(naui_json_object_get(entry, "mb_per_s"), 0.0);
+		if (!old)
+		{
+			printf("%-40s %12s %12.1f %9s %12s\n", full, "-", speed, "new", "-");
+			continue;
+		}
+
+		double old_speed = naui_json_get_number(naui_json_object_get(old, "mb_per_s"), 0.0);
+		double peak = naui_json_get_number(naui_json_object_get(entry, "peak_bytes"), 0.0);
+		double old_peak = naui_json_get_number(naui_json_object_get(old, "peak_bytes"), 0.0);
+		double delta = old_speed > 0.0 ? (speed - old_speed) / old_speed * 100.0 : 0.0;
+		double peak_delta = old_peak > 0.0 ? (peak - old_peak) / old_peak * 100.0 : 0.0;
+		bool slower = delta < -threshold;
+		regressions += slower;
+
+		printf("%-40s %12.1f %12.1f %+8.1f%% %+11.1f%%%s\n", full, old_speed, speed, delta, peak_delta, slower ? "  <- slower" : "");
+	}
+
+	naui_json_free(&base);
+	naui_json_free(&cur);
+	return regressions;
+}
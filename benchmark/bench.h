@@ -0,0 +1,55 @@
+#pragma once
+
+#define BENCH_DEFAULT_ITERATIONS 5
+#define BENCH_DEFAULT_SCALE_MB 8.0
+
+typedef struct Bench_Result
+{
+	char suite[32];
+	char name[64];
+	char corpus[32];
+	size_t bytes;
+	double seconds;
+	double mb_per_s;
+	size_t allocations;
+	size_t peak_bytes;
+} Bench_Result;
+
+typedef struct Bench_Context
+{
+	Naui_List(Bench_Result) results;
+	int32_t iterations;
+	double scale_mb;
+	const char* filter;
+	const char* assets;
+} Bench_Context;
+
+typedef struct Bench_Buffer
+{
+	char* data;
+	size_t len;
+	size_t cap;
+} Bench_Buffer;
+
+/* Phase body, run `iterations` times. Fills allocations/peak_bytes of the result it is given. */
+typedef void (*Bench_Fn)(void* user, Bench_Result* result);
+
+double bench_now(void);
+
+/* Times `fn` and keeps the fastest run. Skipped when the name does not contain ctx->filter. */
+void bench_run(Bench_Context* ctx, const char* suite, const char* name, const char* corpus, size_t bytes, Bench_Fn fn, void* user);
+
+/* Same, with `prepare` run untimed before every run, e.g. to drop caches. */
+void bench_run_prepared(Bench_Context* ctx, const char* suite, const char* name, const char* corpus, size_t bytes, Bench_Fn prepare, Bench_Fn fn, void* user);
+
+void bench_buffer_append(Bench_Buffer* buffer, const char* data, size_t len);
+void bench_buffer_printf(Bench_Buffer* buffer, const char* fmt, ...);
+void bench_buffer_free(Bench_Buffer* buffer);
+
+/* Deterministic generator so corpora are identical between runs. */
+uint32_t bench_rand(uint32_t* state);
+
+bool bench_write_results(const Bench_Context* ctx, const Naui_Path path);
+
+/* Prints per-phase deltas of `current` against `baseline`. Returns the number of phases that got slower than `threshold` percent. */
+int bench_compare(const Naui_Path baseline, const Naui_Path current, double threshold);
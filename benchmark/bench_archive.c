@@ -0,0 +1,100 @@
+typedef struct
+{
+	const char* name;
+	Naui_ArchivePolicy policy;
+} Archive_Policy;
+
+typedef struct
+{
+	Naui_Path folder;
+	Naui_Path output;
+	const Naui_ArchivePolicy* policy;
+} Archive_Phase;
+
+/* The asset tree copied until it reaches the corpus size, so timings are not dominated by a handful of files. */
+static size_t archive_build_corpus(const Naui_Path assets, const Naui_Path folder, size_t target)
+{
+	Naui_List(Naui_DirEntry) entries = naui_directory_filter_recursive(assets, NULL, NULL, 0);
+	size_t count = entries ? (size_t)naui_list_len(entries) : 0;
+	size_t root_len = strlen(assets.data);
+	size_t total = 0;
+
+	naui_directory_create(folder);
+	for (int copy = 0; count && total < target; ++copy)
+	{
+		char dir[NAUI_PATH_MAX];
+		snprintf(dir, sizeof(dir), "%s/copy_%d", folder.data, copy);
+		naui_directory_create(naui_path_from_cstr(dir));
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			char dest[NAUI_PATH_MAX];
+			snprintf(dest, sizeof(dest), "%s%s", dir, entries[i].path.data + root_len);
+			if (entries[i].is_directory)
+			{
+				naui_directory_create(naui_path_from_cstr(dest));
+				continue;
+			}
+
+			if (naui_file_copy(entries[i].path, naui_path_from_cstr(dest)))
+				total += entries[i].size;
+		}
+	}
+
+	naui_directory_filter_free(entries);
+	return total;
+}
+
+static void phase_archive_pack(void* user, Bench_Result* result)
+{
+	Archive_Phase* phase = (Archive_Phase*)user;
+	Naui_Archive archive = NAUI_ARCHIVE_INIT;
+	if (naui_archive_open(&archive, phase->output, NAUI_ARCHIVE_WRITE))
+	{
+		naui_archive_set_policy(&archive, phase->policy);
+		naui_archive_add_folder(&archive, phase->folder, naui_path_from_cstr(""));
+		naui_archive_close(&archive);
+	}
+
+	result->allocations = 0;
+	result->peak_bytes = 0;
+}
+
+void bench_archive(Bench_Context* ctx)
+{
+	Naui_Path assets = naui_path_from_cstr(ctx->assets);
+	if (!naui_path_is_directory(assets))
+	{
+		fprintf(stderr, "[Naui] bench: asset folder '%s' not found, skipping archive suite\n", ctx->assets);
+		return;
+	}
+
+	Archive_Phase phase;
+	phase.folder = naui_path_from_cstr("bench_archive_corpus");
+	phase.output = naui_path_from_cstr("bench_archive_corpus.zip");
+
+	size_t bytes = archive_build_corpus(assets, phase.folder, (size_t)(ctx->scale_mb * 1024.0 * 1024.0));
+
+	const Naui_ArchivePolicy* base = naui_archive_policy_default();
+	Archive_Policy policies[] = {
+		{ "deflate_all", { MZ_BEST_SPEED, 0, NULL, 0, false, NAUI_ARCHIVE_ADAPTIVE_RATIO } },
+		{ "default", *base },
+		{ "adaptive", *base },
+	};
+
+	policies[2].policy.is_adaptive = true;
+
+	for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); ++i)
+	{
+		phase.policy = &policies[i].policy;
+		naui_file_delete(phase.output);
+		bench_run(ctx, "archive", policies[i].name, "assets", bytes, phase_archive_pack, &phase);
+
+		size_t packed = naui_file_size(phase.output);
+		if (packed)
+			printf("%-40s %8.2f MB packed, %.1f%% of input\n", "", (double)packed / (1024.0 * 1024.0), 100.0 * (double)packed / (double)(bytes ? bytes : 1));
+	}
+
+	naui_file_delete(phase.output);
+	naui_directory_remove_all(phase.folder);
+}
@@ -0,0 +1,413 @@
+/* An index entry like the pak format's: a length, a name and four fixed fields, written field by field. */
+typedef struct
+{
+	uint16_t name_len;
+	char name[22];
+	uint64_t offset;
+	uint64_t size;
+	int64_t modified;
+	uint64_t hash;
+} File_Record;
+
+#define FILE_RECORD_BYTES (sizeof(uint16_t) + 22 + sizeof(uint64_t) * 4)
+
+typedef struct
+{
+	Naui_Path path;
+	File_Record record;
+	size_t count;
+} File_Phase;
+
+static void phase_file_write_stdio(void* user, Bench_Result* result)
+{
+	File_Phase* phase = (File_Phase*)user;
+	const File_Record* r = &phase->record;
+	FILE* fp = fopen(phase->path.data, "wb");
+	for (size_t i = 0; fp && i < phase->count; ++i)
+	{
+		fwrite(&r->name_len, sizeof(r->name_len), 1, fp);
+		fwrite(r->name, r->name_len, 1, fp);
+		fwrite(&r->offset, sizeof(r->offset), 1, fp);
+		fwrite(&r->size, sizeof(r->size), 1, fp);
+		fwrite(&r->modified, sizeof(r->modified), 1, fp);
+		fwrite(&r->hash, sizeof(r->hash), 1, fp);
+	}
+
+	if (fp)
+		fclose(fp);
+
+	result->allocations = 1;
+	result->peak_bytes = BUFSIZ;
+}
+
+static void phase_file_write_unbuffered(void* user, Bench_Result* result)
+{
+	File_Phase* phase = (File_Phase*)user;
+	const File_Record* r = &phase->record;
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	if (naui_file_open(&fh, phase->path, NAUI_FILE_WRITE))
+	{
+		for (size_t i = 0; i < phase->count; ++i)
+		{
+			naui_file_write(&fh, &r->name_len, sizeof(r->name_len));
+			naui_file_write(&fh, r->name, r->name_len);
+			naui_file_write(&fh, &r->offset, sizeof(r->offset));
+			naui_file_write(&fh, &r->size, sizeof(r->size));
+			naui_file_write(&fh, &r->modified, sizeof(r->modified));
+			naui_file_write(&fh, &r->hash, sizeof(r->hash));
+		}
+
+		naui_file_close(&fh);
+	}
+
+	result->allocations = 0;
+	result->peak_bytes = 0;
+}
+
+/* One gathered call per record instead of one per field. */
+static void phase_file_writev(void* user, Bench_Result* result)
+{
+	File_Phase* phase = (File_Phase*)user;
+	File_Record* r = &phase->record;
+	Naui_FileVec vecs[6] = {
+		{ &r->name_len, sizeof(r->name_len) }, { r->name, r->name_len }, { &r->offset, sizeof(r->offset) },
+		{ &r->size, sizeof(r->size) }, { &r->modified, sizeof(r->modified) }, { &r->hash, sizeof(r->hash) },
+	};
+
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	if (naui_file_open(&fh, phase->path, NAUI_FILE_WRITE))
+	{
+		for (size_t i = 0; i < phase->count; ++i)
+		{
+			naui_file_writev(&fh, vecs, 6);
+		}
+
+		naui_file_close(&fh);
+	}
+
+	result->allocations = 0;
+	result->peak_bytes = 0;
+}
+
+static void phase_file_write_buffered(void* user, Bench_Result* result)
+{
+	File_Phase* phase = (File_Phase*)user;
+	const File_Record* r = &phase->record;
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	Naui_FileWriter w;
+	if (naui_file_open(&fh, phase->path, NAUI_FILE_WRITE) && naui_file_writer_init(&w, &fh, NULL, 0))
+	{
+		for (size_t i = 0; i < phase->count; ++i)
+		{
+			naui_file_writer_write(&w, &r->name_len, sizeof(r->name_len));
+			naui_file_writer_write(&w, r->name, r->name_len);
+			naui_file_writer_write(&w, &r->offset, sizeof(r->offset));
+			naui_file_writer_write(&w, &r->size, sizeof(r->size));
+			naui_file_writer_write(&w, &r->modified, sizeof(r->modified));
+			naui_file_writer_write(&w, &r->hash, sizeof(r->hash));
+		}
+
+		naui_file_writer_finish(&w);
+	}
+
+	naui_file_close(&fh);
+	result->allocations = 1;
+	result->peak_bytes = NAUI_FILE_BUFFER_DEFAULT_SIZE;
+}
+
+static void phase_file_read_stdio(void* user, Bench_Result* result)
+{
+	File_Phase* phase = (File_Phase*)user;
+	uint8_t record[FILE_RECORD_BYTES];
+	FILE* fp = fopen(phase->path.data, "rb");
+	while (fp && fread(record, sizeof(record), 1, fp) == 1)
+	{
+	}
+
+	if (fp)
+		fclose(fp);
+
+	result->allocations = 1;
+	result->peak_bytes = BUFSIZ;
+}
+
+static void phase_file_read_unbuffered(void* user, Bench_Result* result)
+{
+	File_Phase* phase = (File_Phase*)user;
+	uint8_t record[FILE_RECORD_BYTES];
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	if (naui_file_open(&fh, phase->path, NAUI_FILE_READ))
+	{
+		while (naui_file_read(&fh, record, sizeof(record)) == sizeof(record))
+		{
+		}
+
+		naui_file_close(&fh);
+	}
+
+	result->allocations = 0;
+	result->peak_bytes = 0;
+}
+
+static void phase_file_read_buffered(void* user, Bench_Result* result)
+{
+	File_Phase* phase = (File_Phase*)user;
+	uint8_t record[FILE_RECORD_BYTES];
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	Naui_FileReader r;
+	if (naui_file_open(&fh, phase->path, NAUI_FILE_READ) && naui_file_reader_init(&r, &fh, NULL, 0))
+	{
+		while (naui_file_reader_read(&r, record, sizeof(record)) == sizeof(record))
+		{
+		}
+
+		naui_file_reader_free(&r);
+	}
+
+	naui_file_close(&fh);
+	result->allocations = 1;
+	result->peak_bytes = NAUI_FILE_BUFFER_DEFAULT_SIZE;
+}
+
+/* Records handed out in place, no copy per record. */
+static void phase_file_read_next(void* user, Bench_Result* result)
+{
+	File_Phase* phase = (File_Phase*)user;
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	Naui_FileReader r;
+	uint64_t sum = 0;
+	if (naui_file_open(&fh, phase->path, NAUI_FILE_READ) && naui_file_reader_init(&r, &fh, NULL, 0))
+	{
+		const uint8_t* record;
+		while ((record = (const uint8_t*)naui_file_reader_next(&r, FILE_RECORD_BYTES)) != NULL)
+		{
+			sum += record[0];
+		}
+
+		naui_file_reader_free(&r);
+	}
+
+	naui_file_close(&fh);
+	phase->record.hash = sum;
+	result->allocations = 1;
+	result->peak_bytes = NAUI_FILE_BUFFER_DEFAULT_SIZE;
+}
+
+typedef struct
+{
+	Naui_Path folder;
+	Naui_Path output;
+} Copy_Phase;
+
+/* A project folder: mostly sources and small assets, some files of a few MB. */
+static size_t copy_build_corpus(const Naui_Path folder, size_t target)
+{
+	enum { COPY_FILE_MAX = 4 * 1024 * 1024, COPY_FILES_PER_DIR = 16 };
+
+	char* data = (char*)malloc(COPY_FILE_MAX);
+	uint32_t seed = 11;
+	for (size_t b = 0; data && b < COPY_FILE_MAX; ++b)
+	{
+		data[b] = (char)bench_rand(&seed);
+	}
+
+	naui_directory_create(folder);
+	size_t total = 0;
+	for (int i = 0; data && total < target; ++i)
+	{
+		size_t size = bench_rand(&seed) % 8 == 0 ? 256 * 1024 + bench_rand(&seed) % (COPY_FILE_MAX - 256 * 1024) : 1024 + bench_rand(&seed) % (63 * 1024);
+		char path[NAUI_PATH_MAX];
+		snprintf(path, sizeof(path), "%s/dir_%02d", folder.data, i / COPY_FILES_PER_DIR);
+		naui_directory_create(naui_path_from_cstr(path));
+		snprintf(path, sizeof(path), "%s/dir_%02d/file_%03d.bin", folder.data, i / COPY_FILES_PER_DIR, i);
+		if (naui_file_write_all(naui_path_from_cstr(path), data, size))
+			total += size;
+	}
+
+	free(data);
+	return total;
+}
+
+static void copy_prepare(void* user, Bench_Result* result)
+{
+	(void)result;
+	Copy_Phase* phase = (Copy_Phase*)user;
+	naui_directory_remove_all(phase->output);
+}
+
+/* What callers did before naui_file_copy: each file through a heap buffer of its full size. */
+static void phase_copy_read_write(void* user, Bench_Result* result)
+{
+	Copy_Phase* phase = (Copy_Phase*)user;
+	Naui_List(Naui_DirEntry) files = naui_directory_filter_recursive(phase->folder, NULL, NULL, 0);
+	size_t root_len = strlen(phase->folder.data);
+	size_t peak = 0;
+	naui_directory_create(phase->output);
+	for (int32_t i = 0; i < naui_list_len(files); ++i)
+	{
+		Naui_Path dest;
+		snprintf(dest.data, NAUI_PATH_MAX, "%s%s", phase->output.data, files[i].path.data + root_len);
+		if (files[i].is_directory)
+		{
+			naui_directory_create(dest);
+			continue;
+		}
+
+		size_t size;
+		char* data = naui_file_read_all(files[i].path, &size);
+		if (data)
+			naui_file_write_all(dest, data, size);
+
+		peak = size > peak ? size : peak;
+		free(data);
+	}
+
+	result->allocations = (size_t)naui_list_len(files) + 1;
+	result->peak_bytes = peak;
+	naui_directory_filter_free(files);
+}
+
+static void phase_copy_file(void* user, Bench_Result* result)
+{
+	Copy_Phase* phase = (Copy_Phase*)user;
+	Naui_List(Naui_DirEntry) files = naui_directory_filter_recursive(phase->folder, NULL, NULL, 0);
+	size_t root_len = strlen(phase->folder.data);
+	naui_directory_create(phase->output);
+	for (int32_t i = 0; i < naui_list_len(files); ++i)
+	{
+		Naui_Path dest;
+		snprintf(dest.data, NAUI_PATH_MAX, "%s%s", phase->output.data, files[i].path.data + root_len);
+		if (files[i].is_directory)
+			naui_directory_create(dest);
+		else
+			naui_file_copy(files[i].path, dest);
+	}
+
+	result->allocations = 1;
+	result->peak_bytes = 0;
+	naui_directory_filter_free(files);
+}
+
+static void phase_copy_directory(void* user, Bench_Result* result)
+{
+	Copy_Phase* phase = (Copy_Phase*)user;
+	naui_directory_copy(phase->folder, phase->output);
+	result->allocations = 3;
+	result->peak_bytes = 0;
+}
+
+typedef struct
+{
+	Naui_List(Naui_Path) files;
+	uint64_t* hashes;
+	Naui_FileHashCache* cache;
+} Hash_Phase;
+
+/* What change detection did before naui_file_hash: the whole file on the heap, then hashed. */
+static void phase_hash_read_all(void* user, Bench_Result* result)
+{
+	Hash_Phase* phase = (Hash_Phase*)user;
+	size_t peak = 0;
+	for (int32_t i = 0; i < naui_list_len(phase->files); ++i)
+	{
+		size_t size = 0;
+		char* data = naui_file_read_all(phase->files[i], &size);
+		phase->hashes[i] = data ? naui_hash64(data, size, 0) : 0;
+		peak = size > peak ? size : peak;
+		free(data);
+	}
+
+	result->allocations = (size_t)naui_list_len(phase->files);
+	result->peak_bytes = peak;
+}
+
+static void phase_hash_stream(void* user, Bench_Result* result)
+{
+	Hash_Phase* phase = (Hash_Phase*)user;
+	for (int32_t i = 0; i < naui_list_len(phase->files); ++i)
+	{
+		naui_file_hash(phase->files[i], &phase->hashes[i]);
+	}
+
+	result->allocations = 0;
+	result->peak_bytes = 0;
+}
+
+static void phase_hash_many(void* user, Bench_Result* result)
+{
+	Hash_Phase* phase = (Hash_Phase*)user;
+	naui_file_hash_many(phase->files, (size_t)naui_list_len(phase->files), phase->hashes, phase->cache);
+	result->allocations = 1;
+	result->peak_bytes = 0;
+}
+
+void bench_file(Bench_Context* ctx)
+{
+	File_Phase phase;
+	memset(&phase, 0, sizeof(phase));
+	phase.path = naui_path_from_cstr("bench_file_records.bin");
+	phase.record.name_len = 22;
+	memcpy(phase.record.name, "Textures/icon_0042.png", 22);
+	phase.record.offset = 4096;
+	phase.record.size = 1234;
+	phase.record.modified = 1700000000;
+	phase.record.hash = 0x9e3779b97f4a7c15ull;
+
+	phase.count = (size_t)(ctx->scale_mb * 1024.0 * 1024.0) / FILE_RECORD_BYTES;
+	size_t bytes = phase.count * FILE_RECORD_BYTES;
+	char corpus[32];
+	snprintf(corpus, sizeof(corpus), "%zuk_records", phase.count / 1000);
+
+	bench_run(ctx, "file", "write_stdio", corpus, bytes, phase_file_write_stdio, &phase);
+	bench_run(ctx, "file", "write_unbuffered", corpus, bytes, phase_file_write_unbuffered, &phase);
+	bench_run(ctx, "file", "writev", corpus, bytes, phase_file_writev, &phase);
+	bench_run(ctx, "file", "write_buffered", corpus, bytes, phase_file_write_buffered, &phase);
+
+	bench_run(ctx, "file", "read_stdio", corpus, bytes, phase_file_read_stdio, &phase);
+	bench_run(ctx, "file", "read_unbuffered", corpus, bytes, phase_file_read_unbuffered, &phase);
+	bench_run(ctx, "file", "read_buffered", corpus, bytes, phase_file_read_buffered, &phase);
+	bench_run(ctx, "file", "read_next", corpus, bytes, phase_file_read_next, &phase);
+
+	naui_file_delete(phase.path);
+
+	Copy_Phase copy;
+	memset(&copy, 0, sizeof(copy));
+	copy.folder = naui_path_from_cstr("bench_copy_corpus");
+	copy.output = naui_path_from_cstr("bench_copy_output");
+	size_t copy_bytes = copy_build_corpus(copy.folder, (size_t)(ctx->scale_mb * 8.0 * 1024.0 * 1024.0));
+
+	bench_run_prepared(ctx, "file", "copy_read_write", "tree", copy_bytes, copy_prepare, phase_copy_read_write, &copy);
+	bench_run_prepared(ctx, "file", "copy_file", "tree", copy_bytes, copy_prepare, phase_copy_file, &copy);
+	bench_run_prepared(ctx, "file", "copy_directory", "tree", copy_bytes, copy_prepare, phase_copy_directory, &copy);
+
+	/* Hashing the same tree: streamed, spread over the workers, and answered from a warm cache. */
+	Hash_Phase hash;
+	memset(&hash, 0, sizeof(hash));
+	Naui_List(Naui_DirEntry) entries = naui_directory_filter_recursive(copy.folder, NULL, NULL, 0);
+	for (int32_t i = 0; i < naui_list_len(entries); ++i)
+	{
+		if (!entries[i].is_directory)
+			naui_list_push(hash.files, entries[i].path);
+	}
+
+	naui_directory_filter_free(entries);
+	hash.hashes = (uint64_t*)calloc((size_t)naui_list_len(hash.files) + 1, sizeof(uint64_t));
+
+	bench_run(ctx, "file", "hash_read_all", "tree", copy_bytes, phase_hash_read_all, &hash);
+	bench_run(ctx, "file", "hash_stream", "tree", copy_bytes, phase_hash_stream, &hash);
+	bench_run(ctx, "file", "hash_many", "tree", copy_bytes, phase_hash_many, &hash);
+
+	Naui_FileHashCache cache;
+	if (naui_file_hash_cache_open(&cache, naui_path_from_cstr("")))
+	{
+		hash.cache = &cache;
+		naui_file_hash_many(hash.files, (size_t)naui_list_len(hash.files), hash.hashes, &cache);
+		bench_run(ctx, "file", "hash_many_cached", "tree", copy_bytes, phase_hash_many, &hash);
+		naui_file_hash_cache_close(&cache);
+	}
+
+	free(hash.hashes);
+	naui_list_free(hash.files);
+	naui_directory_remove_all(copy.folder);
+	naui_directory_remove_all(copy.output);
+}
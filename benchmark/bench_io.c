@@ -0,0 +1,130 @@
+typedef struct
+{
+	Naui_Path folder;
+	Naui_List(Naui_Path) files;
+	Naui_IoRequest* requests;
+	bool is_cold;
+} Io_Phase;
+
+/* Asset-sized files: mostly a few KB, some up to 64KB, like icons, shaders and small textures. */
+static size_t io_build_corpus(Io_Phase* phase, size_t target)
+{
+	naui_directory_create(phase->folder);
+
+	char* data = (char*)malloc(64 * 1024);
+	uint32_t seed = 7;
+	size_t total = 0;
+	for (size_t i = 0; data && total < target; ++i)
+	{
+		size_t size = 1024 + (bench_rand(&seed) % 8 == 0 ? bench_rand(&seed) % (63 * 1024) : bench_rand(&seed) % (7 * 1024));
+		for (size_t b = 0; b < size; ++b)
+		{
+			data[b] = (char)bench_rand(&seed);
+		}
+
+		Naui_Path path;
+		snprintf(path.data, NAUI_PATH_MAX, "%s/asset_%04zu.bin", phase->folder.data, i);
+		if (naui_file_write_all(path, data, size))
+		{
+			naui_list_push(phase->files, path);
+			total += size;
+		}
+	}
+
+	free(data);
+
+#if defined(__linux__)
+	/* Dirty pages cannot be dropped, so everything is flushed once up front. */
+	sync();
+#endif
+	return total;
+}
+
+static void io_prepare(void* user, Bench_Result* result)
+{
+	(void)result;
+	Io_Phase* phase = (Io_Phase*)user;
+#if defined(__linux__)
+	for (size_t i = 0; i < (size_t)naui_list_len(phase->files); ++i)
+	{
+		int fd = open(phase->files[i].data, O_RDONLY);
+		if (fd >= 0)
+		{
+			posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+			close(fd);
+		}
+	}
+#else
+	(void)phase;
+#endif
+}
+
+static void phase_io_read_all(void* user, Bench_Result* result)
+{
+	Io_Phase* phase = (Io_Phase*)user;
+	size_t count = (size_t)naui_list_len(phase->files);
+	for (size_t i = 0; i < count; ++i)
+	{
+		size_t size;
+		free(naui_file_read_all(phase->files[i], &size));
+	}
+
+	result->allocations = count;
+	result->peak_bytes = 0;
+}
+
+static void phase_io_async(void* user, Bench_Result* result)
+{
+	Io_Phase* phase = (Io_Phase*)user;
+	size_t count = (size_t)naui_list_len(phase->files);
+	naui_io_submit(phase->requests, count);
+	naui_io_wait_all();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		naui_io_release(&phase->requests[i]);
+	}
+
+	result->allocations = count;
+	result->peak_bytes = 0;
+}
+
+void bench_io(Bench_Context* ctx)
+{
+	Io_Phase phase;
+	memset(&phase, 0, sizeof(phase));
+	phase.folder = naui_path_from_cstr("bench_io_corpus");
+
+	size_t bytes = io_build_corpus(&phase, (size_t)(ctx->scale_mb * 1024.0 * 1024.0));
+	size_t count = (size_t)naui_list_len(phase.files);
+	phase.requests = (Naui_IoRequest*)calloc(count ? count : 1, sizeof(Naui_IoRequest));
+	for (size_t i = 0; i < count; ++i)
+	{
+		phase.requests[i].op = NAUI_IO_READ;
+		phase.requests[i].path = phase.files[i];
+	}
+
+#if defined(__linux__)
+	const char* corpus = "cold";
+#else
+	const char* corpus = "warm";
+#endif
+
+	bench_run_prepared(ctx, "io", "read_all", corpus, bytes, io_prepare, phase_io_read_all, &phase);
+
+	if (naui_io_init(NAUI_IO_BACKEND_THREADS, 0))
+	{
+		bench_run_prepared(ctx, "io", "async_threads", corpus, bytes, io_prepare, phase_io_async, &phase);
+		naui_io_shutdown();
+	}
+
+	if (naui_io_init(NAUI_IO_BACKEND_URING, 0))
+	{
+		bench_run_prepared(ctx, "io", "async_uring", corpus, bytes, io_prepare, phase_io_async, &phase);
+		naui_io_shutdown();
+	}
+
+	free(phase.requests);
+	naui_list_free(phase.files);
+	naui_directory_remove_all(phase.folder);
+}
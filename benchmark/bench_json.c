@@ -0,0 +1,231 @@
+typedef struct
+{
+	const char* name;
+	Bench_Buffer src;
+	bool is_array;
+} Json_Corpus;
+
+typedef struct
+{
+	const Json_Corpus* corpus;
+	Naui_Json dom;
+	size_t written;
+} Json_Phase;
+
+#pragma region Corpora
+/* Panel layouts and settings: objects nested close to the reader's depth limit. */
+static void corpus_deep(Bench_Buffer* out, size_t target, uint32_t seed)
+{
+	bench_buffer_append(out, "[", 1);
+	for (size_t doc = 0; out->len < target; ++doc)
+	{
+		if (doc)
+			bench_buffer_append(out, ",", 1);
+
+		int depth = 16 + (int)(bench_rand(&seed) % 40);
+		for (int d = 0; d < depth; ++d)
+		{
+			bench_buffer_printf(out, "{\"kind\":\"split\",\"ratio\":0.%u,\"child%d\":", bench_rand(&seed) % 1000, d & 1);
+		}
+
+		bench_buffer_printf(out, "{\"kind\":\"tabs\",\"tabs\":[\"scene\",\"inspector\"],\"active_tab\":%u}", bench_rand(&seed) % 2);
+		for (int d = 0; d < depth; ++d)
+		{
+			bench_buffer_append(out, "}", 1);
+		}
+	}
+
+	bench_buffer_append(out, "]", 1);
+}
+
+/* One flat object with thousands of keys, like a big settings or theme file. */
+static void corpus_wide(Bench_Buffer* out, size_t target, uint32_t seed)
+{
+	bench_buffer_append(out, "{", 1);
+	for (size_t i = 0; out->len < target; ++i)
+	{
+		uint32_t r = bench_rand(&seed);
+		const char* sep = i ? "," : "";
+		switch (r % 3)
+		{
+			case 0:
+				bench_buffer_printf(out, "%s\"setting_%zu\":%u", sep, i, r % 100000);
+				break;
+
+			case 1:
+				bench_buffer_printf(out, "%s\"setting_%zu\":%s", sep, i, (r & 8) ? "true" : "false");
+				break;
+
+			default:
+				bench_buffer_printf(out, "%s\"setting_%zu\":\"value_%u\"", sep, i, r);
+				break;
+		}
+	}
+
+	bench_buffer_append(out, "}", 1);
+}
+
+/* Vertex-like float triples. */
+static void corpus_numbers(Bench_Buffer* out, size_t target, uint32_t seed)
+{
+	bench_buffer_append(out, "[", 1);
+	for (size_t i = 0; out->len < target; ++i)
+	{
+		bench_buffer_printf(out, "%s[%d.%06u,%d.%06u,-%u.%03ue-2]", i ? "," : "",
+			(int)(bench_rand(&seed) % 2000) - 1000, bench_rand(&seed) % 1000000,
+			(int)(bench_rand(&seed) % 2000) - 1000, bench_rand(&seed) % 1000000,
+			bench_rand(&seed) % 100, bench_rand(&seed) % 1000);
+	}
+
+	bench_buffer_append(out, "]", 1);
+}
+
+/* Localization tables: long strings with escapes and multi-byte text. */
+static void corpus_strings(Bench_Buffer* out, size_t target, uint32_t seed)
+{
+	static const char* words[] = {
+		"Ouvrir", "les", "fichiers", "r\xc3\xa9" "cents", "Gr\xc3\xb6\xc3\x9f" "e", "\\\"Projekt\\\"", "\xe8\xa8\xad\xe5\xae\x9a",
+		"\\u00e9tat", "panel", "\\n", "sauvegarder", "\xd0\xa4\xd0\xb0\xd0\xb9\xd0\xbb", "\\t", "naui", "%s", "{0}"
+	};
+
+	bench_buffer_append(out, "{\"language\":\"fr\",\"entries\":{", 28);
+	for (size_t i = 0; out->len < target; ++i)
+	{
+		bench_buffer_printf(out, "%s\"menu.section_%u.item_%zu\":\"", i ? "," : "", bench_rand(&seed) % 64, i);
+		int count = 4 + (int)(bench_rand(&seed) % 20);
+		for (int w = 0; w < count; ++w)
+		{
+			const char* word = words[bench_rand(&seed) % (sizeof(words) / sizeof(words[0]))];
+			if (w)
+				bench_buffer_append(out, " ", 1);
+
+			bench_buffer_append(out, word, strlen(word));
+		}
+
+		bench_buffer_append(out, "\"", 1);
+	}
+
+	bench_buffer_append(out, "}}", 2);
+}
+
+/* Asset manifest records, the shape naui_json_parse_parallel targets. */
+static void corpus_records(Bench_Buffer* out, size_t target, uint32_t seed)
+{
+	bench_buffer_append(out, "[", 1);
+	for (size_t i = 0; out->len < target; ++i)
+	{
+		bench_buffer_printf(out, "%s{\"id\":%zu,\"path\":\"Assets/Textures/tex_%u.png\",\"size\":%u,\"hash\":\"%08x%08x\",\"tags\":[\"ui\",\"icon\"],\"mip\":{\"levels\":%u,\"srgb\":%s}}",
+			i ? ",\n" : "", i, bench_rand(&seed) % 10000, bench_rand(&seed), bench_rand(&seed), bench_rand(&seed),
+			1 + bench_rand(&seed) % 12, (bench_rand(&seed) & 1) ? "true" : "false");
+	}
+
+	bench_buffer_append(out, "]", 1);
+}
+#pragma endregion
+
+#pragma region Phases
+static void phase_reader(void* user, Bench_Result* result)
+{
+	Json_Phase* phase = (Json_Phase*)user;
+	Naui_JsonReader reader;
+	naui_json_reader_init(&reader, phase->corpus->src.data, phase->corpus->src.len);
+
+	Naui_JsonToken t;
+	do
+	{
+		t = naui_json_reader_next(&reader);
+	} while (t != NAUI_JSON_TOKEN_EOF && t != NAUI_JSON_TOKEN_ERROR);
+
+	result->allocations = 0;
+	result->peak_bytes = 0;
+}
+
+static void phase_dom_result(Naui_Json* json, Bench_Result* result)
+{
+	Naui_ArenaStats stats = naui_arena_stats(&json->_arena);
+	result->allocations = stats.block_count;
+	result->peak_bytes = stats.reserved;
+	naui_json_free(json);
+}
+
+static void phase_dom_parse(void* user, Bench_Result* result)
+{
+	Json_Phase* phase = (Json_Phase*)user;
+	Naui_Json json = naui_json_parse(phase->corpus->src.data, phase->corpus->src.len);
+	phase_dom_result(&json, result);
+}
+
+static void phase_dom_parse_parallel(void* user, Bench_Result* result)
+{
+	Json_Phase* phase = (Json_Phase*)user;
+	Naui_Json json = naui_json_parse_parallel(phase->corpus->src.data, phase->corpus->src.len, 0);
+	phase_dom_result(&json, result);
+}
+
+static void phase_tape_parse(void* user, Bench_Result* result)
+{
+	Json_Phase* phase = (Json_Phase*)user;
+	Naui_JsonTape tape = naui_json_tape_parse(phase->corpus->src.data, phase->corpus->src.len);
+	result->allocations = 1;
+	result->peak_bytes = (size_t)arrcap((Naui_JsonTapeEntry*)tape.entries) * sizeof(Naui_JsonTapeEntry);
+	naui_json_tape_free(&tape);
+}
+
+static void phase_dom_write(void* user, Bench_Result* result)
+{
+	/* Measuring mode streams the whole DOM through the writer into a discarding sink. */
+	Json_Phase* phase = (Json_Phase*)user;
+	int written = naui_json_write(phase->dom.root, NULL, 0, false);
+	phase->written = written > 0 ? (size_t)written : 0;
+
+	result->allocations = 0;
+	result->peak_bytes = NAUI_JSON_WRITER_STREAM_SIZE;
+}
+#pragma endregion
+
+void bench_json(Bench_Context* ctx)
+{
+	size_t target = (size_t)(ctx->scale_mb * 1024.0 * 1024.0);
+	Json_Corpus corpora[] = {
+		{ "deep", { 0 }, true },
+		{ "wide", { 0 }, false },
+		{ "numbers", { 0 }, true },
+		{ "strings", { 0 }, false },
+		{ "records", { 0 }, true },
+	};
+
+	corpus_deep(&corpora[0].src, target, 1);
+	corpus_wide(&corpora[1].src, target, 2);
+	corpus_numbers(&corpora[2].src, target, 3);
+	corpus_strings(&corpora[3].src, target, 4);
+	corpus_records(&corpora[4].src, target, 5);
+
+	for (size_t c = 0; c < sizeof(corpora) / sizeof(corpora[0]); ++c)
+	{
+		Json_Corpus* corpus = &corpora[c];
+		Json_Phase phase;
+		memset(&phase, 0, sizeof(phase));
+		phase.corpus = corpus;
+
+		bench_run(ctx, "json", "reader", corpus->name, corpus->src.len, phase_reader, &phase);
+		bench_run(ctx, "json", "dom_parse", corpus->name, corpus->src.len, phase_dom_parse, &phase);
+		if (corpus->is_array)
+			bench_run(ctx, "json", "dom_parse_parallel", corpus->name, corpus->src.len, phase_dom_parse_parallel, &phase);
+
+		bench_run(ctx, "json", "tape_parse", corpus->name, corpus->src.len, phase_tape_parse, &phase);
+
+		phase.dom = naui_json_parse(corpus->src.data, corpus->src.len);
+		if (phase.dom.error)
+			fprintf(stderr, "[Naui] bench: corpus '%s' does not parse: %s (%d:%d)\n", corpus->name, phase.dom.error, phase.dom.error_line, phase.dom.error_col);
+
+		if (phase.dom.root)
+		{
+			Bench_Result probe;
+			phase_dom_write(&phase, &probe);
+			bench_run(ctx, "json", "dom_write", corpus->name, phase.written, phase_dom_write, &phase);
+		}
+
+		naui_json_free(&phase.dom);
+		bench_buffer_free(&corpus->src);
+	}
+}
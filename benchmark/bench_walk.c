@@ -0,0 +1,315 @@
+typedef struct
+{
+	Naui_Path folder;
+	Naui_WalkFlags flags;
+	size_t entries;
+	const char* filter;
+	const char** extensions;
+	int ext_count;
+} Walk_Phase;
+
+/* Every name of the corpus, matched a number of times over so the filters dominate the timing. */
+typedef struct
+{
+	Naui_DirListing listing;
+	const char* filter;
+	const char** extensions;
+	int ext_count;
+	int32_t rounds;
+	size_t matched;
+} Filter_Phase;
+
+#define FILTER_ROUNDS 50
+
+/* Folders of small files a few levels deep, roughly the shape of an unpacked asset library. */
+static size_t walk_build_corpus(const Naui_Path folder, size_t target_files)
+{
+	enum { WALK_FANOUT = 8, WALK_FILES_PER_DIR = 24 };
+
+	naui_directory_create(folder);
+	size_t files = 0;
+	for (int a = 0; files < target_files; ++a)
+	{
+		char top[NAUI_PATH_MAX];
+		snprintf(top, sizeof(top), "%s/pack_%03d", folder.data, a);
+		naui_directory_create(naui_path_from_cstr(top));
+
+		for (int b = 0; b < WALK_FANOUT && files < target_files; ++b)
+		{
+			char dir[NAUI_PATH_MAX];
+			snprintf(dir, sizeof(dir), "%s/group_%d", top, b);
+			naui_directory_create(naui_path_from_cstr(dir));
+
+			for (int c = 0; c < WALK_FILES_PER_DIR && files < target_files; ++c)
+			{
+				char path[NAUI_PATH_MAX];
+				snprintf(path, sizeof(path), "%s/asset_%02d.%s", dir, c, c % 3 ? "png" : "json");
+				if (naui_file_write_all(naui_path_from_cstr(path), "x", 1))
+					++files;
+			}
+		}
+	}
+
+	return files;
+}
+
+/* What naui_directory_filter_recursive did before the walker: one thread, a stat per entry on the full path. */
+static void walk_recursive_stat(const char* path, Naui_List(Naui_DirEntry)* list)
+{
+	DIR* dir = opendir(path);
+	if (!dir)
+		return;
+
+	struct dirent* entry;
+	while ((entry = readdir(dir)) != NULL)
+	{
+		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+			continue;
+
+		Naui_DirEntry de;
+		snprintf(de.path.data, NAUI_PATH_MAX, "%s/%s", path, entry->d_name);
+
+		struct stat st;
+		if (stat(de.path.data, &st) != 0)
+			continue;
+
+		de.is_directory = S_ISDIR(st.st_mode);
+		de.size = de.is_directory ? 0 : (size_t)st.st_size;
+		naui_list_push(*list, de);
+		if (de.is_directory)
+			walk_recursive_stat(de.path.data, list);
+	}
+
+	closedir(dir);
+}
+
+static void phase_walk_recursive(void* user, Bench_Result* result)
+{
+	Walk_Phase* phase = (Walk_Phase*)user;
+	Naui_List(Naui_DirEntry) list = NULL;
+	walk_recursive_stat(phase->folder.data, &list);
+
+	phase->entries = (size_t)naui_list_len(list);
+	result->allocations = 1;
+	result->peak_bytes = phase->entries * sizeof(Naui_DirEntry);
+	naui_directory_filter_free(list);
+}
+
+static void phase_walk(void* user, Bench_Result* result)
+{
+	Walk_Phase* phase = (Walk_Phase*)user;
+	Naui_List(Naui_DirEntry) list = naui_directory_walk(phase->folder, NULL, NULL, 0, phase->flags);
+
+	phase->entries = (size_t)naui_list_len(list);
+	result->allocations = 1;
+	result->peak_bytes = phase->entries * sizeof(Naui_DirEntry);
+	naui_directory_filter_free(list);
+}
+
+static void phase_walk_filtered(void* user, Bench_Result* result)
+{
+	Walk_Phase* phase = (Walk_Phase*)user;
+	Naui_List(Naui_DirEntry) list = naui_directory_walk(phase->folder, phase->filter, phase->extensions, phase->ext_count, phase->flags);
+
+	phase->entries = (size_t)naui_list_len(list);
+	result->allocations = 1;
+	result->peak_bytes = phase->entries * sizeof(Naui_DirEntry);
+	naui_directory_filter_free(list);
+}
+
+/* What the listings did before Naui_FileFilter: the filter parsed again and every extension compared, for each name. */
+static bool filter_linear_match(const char* name, const char* filter, const char** exts, int ext_count)
+{
+	const char* star = strchr(filter, '*');
+	if (!star)
+	{
+		if (strcmp(name, filter) != 0)
+			return false;
+	}
+	else
+	{
+		size_t prefix_len = (size_t)(star - filter);
+		size_t suffix_len = strlen(star + 1);
+		size_t name_len = strlen(name);
+		if (strncmp(name, filter, prefix_len) != 0 || suffix_len > name_len - prefix_len || strcmp(name + name_len - suffix_len, star + 1) != 0)
+			return false;
+	}
+
+	const char* dot = strrchr(name, '.');
+	if (!dot)
+		return false;
+
+	for (int i = 0; i < ext_count; ++i)
+	{
+		if (strcmp(dot, exts[i]) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+static void phase_filter_linear(void* user, Bench_Result* result)
+{
+	Filter_Phase* phase = (Filter_Phase*)user;
+	size_t count = naui_dir_listing_count(&phase->listing);
+	phase->matched = 0;
+	for (int32_t round = 0; round < phase->rounds; ++round)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			phase->matched += filter_linear_match(naui_dir_listing_name(&phase->listing, i), phase->filter, phase->extensions, phase->ext_count);
+		}
+	}
+
+	result->allocations = 0;
+	result->peak_bytes = 0;
+}
+
+static void phase_filter_compiled(void* user, Bench_Result* result)
+{
+	Filter_Phase* phase = (Filter_Phase*)user;
+	size_t count = naui_dir_listing_count(&phase->listing);
+	phase->matched = 0;
+
+	Naui_FileFilter filter;
+	naui_file_filter_init(&filter, phase->filter, phase->extensions, phase->ext_count, true);
+	for (int32_t round = 0; round < phase->rounds; ++round)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Naui_DirRecord* record = &phase->listing.records[i];
+			phase->matched += naui_file_filter_match(&filter, phase->listing.names + record->name, record->name_length);
+		}
+	}
+
+	naui_file_filter_free(&filter);
+	result->allocations = 3;
+	result->peak_bytes = 0;
+}
+
+/* The tree walked one Naui_DirIterator per folder, the way app code browses a folder at a time. */
+static size_t walk_iterate(const Naui_Path path, Naui_DirIteratorFlags flags, size_t* folders)
+{
+	size_t count = 0;
+	++*folders;
+	Naui_DirIterator it = naui_dir_iterator_open(path, NULL, NULL, true, flags);
+	for (; naui_dir_iterator_valid(&it); naui_dir_iterator_next(&it))
+	{
+		++count;
+		if (!it.is_directory)
+			continue;
+
+		Naui_Path child;
+		if (it.path)
+			snprintf(child.data, NAUI_PATH_MAX, "%s", it.path);
+		else
+			snprintf(child.data, NAUI_PATH_MAX, "%s/%s", path.data, it.name);
+
+		count += walk_iterate(child, flags, folders);
+	}
+
+	naui_dir_iterator_close(&it);
+	return count;
+}
+
+static void phase_walk_iterate(void* user, Bench_Result* result)
+{
+	Walk_Phase* phase = (Walk_Phase*)user;
+	size_t folders = 0;
+	phase->entries = walk_iterate(phase->folder, phase->flags & NAUI_WALK_SIZES ? NAUI_DIR_ITERATOR_DEFAULT : NAUI_DIR_ITERATOR_NAMES, &folders);
+	result->allocations = folders;
+	result->peak_bytes = 0;
+}
+
+/* Same tree as a compact listing, peak is the records plus the name pool. */
+static void phase_walk_list(void* user, Bench_Result* result)
+{
+	Walk_Phase* phase = (Walk_Phase*)user;
+	Naui_DirListing listing = NAUI_DIR_LISTING_INIT;
+	naui_directory_list(&listing, phase->folder, NULL, NULL, 0, phase->flags);
+
+	phase->entries = naui_dir_listing_count(&listing);
+	result->allocations = 2;
+	result->peak_bytes = phase->entries * sizeof(Naui_DirRecord) + listing._names_capacity;
+	naui_dir_listing_free(&listing);
+}
+
+void bench_walk(Bench_Context* ctx)
+{
+	Walk_Phase phase;
+	memset(&phase, 0, sizeof(phase));
+	phase.folder = naui_path_from_cstr("bench_walk_corpus");
+
+	/* 2500 files per scale MB, 20k at the default scale. */
+	size_t files = walk_build_corpus(phase.folder, (size_t)(ctx->scale_mb * 2500.0));
+	char corpus[32];
+	snprintf(corpus, sizeof(corpus), "%zuk_files", files / 1000);
+
+	/* Bytes are the listing handed back, the part that grows with the tree. */
+	size_t bytes = files * sizeof(Naui_DirEntry);
+
+	bench_run(ctx, "walk", "recursive_stat", corpus, bytes, phase_walk_recursive, &phase);
+
+	phase.flags = NAUI_WALK_SIZES;
+	bench_run(ctx, "walk", "walk_sizes", corpus, bytes, phase_walk, &phase);
+
+	phase.flags = NAUI_WALK_DEFAULT;
+	bench_run(ctx, "walk", "walk_names", corpus, bytes, phase_walk, &phase);
+
+	phase.flags = NAUI_WALK_SIZES;
+	bench_run(ctx, "walk", "list_sizes", corpus, bytes, phase_walk_list, &phase);
+
+	phase.flags = NAUI_WALK_DEFAULT;
+	bench_run(ctx, "walk", "list_names", corpus, bytes, phase_walk_list, &phase);
+
+	phase.flags = NAUI_WALK_SIZES;
+	bench_run(ctx, "walk", "iterate_paths", corpus, bytes, phase_walk_iterate, &phase);
+
+	phase.flags = NAUI_WALK_DEFAULT;
+	bench_run(ctx, "walk", "iterate_names", corpus, bytes, phase_walk_iterate, &phase);
+
+	/* An import filter: a name pattern and the extensions an asset pipeline knows, the common ones last. */
+	const char* extensions[] = {
+		".bmp", ".tga", ".gif", ".psd", ".hdr", ".ktx", ".dds", ".wav", ".ogg", ".mp3", ".flac",
+		".ttf", ".otf", ".glsl", ".hlsl", ".obj", ".gltf", ".glb", ".fbx", ".lua", ".json", ".png"
+	};
+
+	int ext_count = (int)(sizeof(extensions) / sizeof(extensions[0]));
+	phase.filter = "asset_1*";
+	phase.extensions = extensions;
+	phase.ext_count = ext_count;
+	bench_run(ctx, "walk", "walk_filtered", corpus, bytes, phase_walk_filtered, &phase);
+
+	phase.filter = "pack_00*/**/asset_?[05].png";
+	bench_run(ctx, "walk", "walk_filtered_glob", corpus, bytes, phase_walk_filtered, &phase);
+
+	Filter_Phase filter;
+	memset(&filter, 0, sizeof(filter));
+	filter.filter = "asset_1*";
+	filter.extensions = extensions;
+	filter.ext_count = ext_count;
+	filter.rounds = FILTER_ROUNDS;
+	if (naui_directory_list(&filter.listing, phase.folder, NULL, NULL, 0, NAUI_WALK_DEFAULT))
+	{
+		/* Bytes are the names matched over all rounds. */
+		size_t names = (size_t)FILTER_ROUNDS * naui_dir_listing_count(&filter.listing);
+		size_t name_bytes = 0;
+		for (size_t i = 0; i < naui_dir_listing_count(&filter.listing); ++i)
+		{
+			name_bytes += (size_t)FILTER_ROUNDS * filter.listing.records[i].name_length;
+		}
+
+		char names_corpus[32];
+		snprintf(names_corpus, sizeof(names_corpus), "%zuk_names", names / 1000);
+
+		bench_run(ctx, "walk", "filter_linear", names_corpus, name_bytes, phase_filter_linear, &filter);
+		size_t linear = filter.matched;
+		bench_run(ctx, "walk", "filter_compiled", names_corpus, name_bytes, phase_filter_compiled, &filter);
+		if (linear != filter.matched)
+			fprintf(stderr, "[Naui] bench: compiled filter matched %zu names, linear %zu\n", filter.matched, linear);
+
+		naui_dir_listing_free(&filter.listing);
+	}
+
+	naui_directory_remove_all(phase.folder);
+}
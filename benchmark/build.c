@@ -0,0 +1,11 @@
+#include <naui/build.c>
+
+#include "bench.h"
+
+#include "bench.c"
+#include "bench_json.c"
+#include "bench_archive.c"
+#include "bench_io.c"
+#include "bench_walk.c"
+#include "bench_file.c"
+#include "main.c"
@@ -0,0 +1,87 @@
+static void bench_usage(void)
+{
+	printf(
+		"Usage: NauiBench [options]\n"
+		"  --iterations N      Runs per phase, the fastest is kept (default %d)\n"
+		"  --scale MB          Size of each generated corpus (default %.0f)\n"
+		"  --filter TEXT       Only run phases whose suite/name/corpus contains TEXT\n"
+		"  --assets PATH       Asset tree packed by the archive suite (default Assets)\n"
+		"  --jobs N            Worker threads for parallel phases (default 4)\n"
+		"  --out PATH          Where to write JSON results (default bench_results.json)\n"
+		"  --compare BASE CUR  Compare two result files, exits non-zero on regressions\n"
+		"  --threshold PCT     Slowdown tolerated by --compare (default 5)\n",
+		BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_SCALE_MB);
+}
+
+int main(int argc, char** argv)
+{
+	Bench_Context ctx;
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.iterations = BENCH_DEFAULT_ITERATIONS;
+	ctx.scale_mb = BENCH_DEFAULT_SCALE_MB;
+	ctx.assets = "Assets";
+
+	const char* out = "bench_results.json";
+	const char* compare_base = NULL;
+	const char* compare_cur = NULL;
+	double threshold = 5.0;
+	int32_t jobs = 4;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+		bool has_value = i + 1 < argc;
+		if (!strcmp(arg, "--iterations") && has_value)
+			ctx.iterations = atoi(argv[++i]);
+		else if (!strcmp(arg, "--scale") && has_value)
+			ctx.scale_mb = atof(argv[++i]);
+		else if (!strcmp(arg, "--filter") && has_value)
+			ctx.filter = argv[++i];
+		else if (!strcmp(arg, "--assets") && has_value)
+			ctx.assets = argv[++i];
+		else if (!strcmp(arg, "--jobs") && has_value)
+			jobs = atoi(argv[++i]);
+		else if (!strcmp(arg, "--out") && has_value)
+			out = argv[++i];
+		else if (!strcmp(arg, "--threshold") && has_value)
+			threshold = atof(argv[++i]);
+		else if (!strcmp(arg, "--compare") && i + 2 < argc)
+		{
+			compare_base = argv[++i];
+			compare_cur = argv[++i];
+		}
+		else
+		{
+			bench_usage();
+			return 1;
+		}
+	}
+
+	if (compare_base)
+	{
+		int regressions = bench_compare(naui_path_from_cstr(compare_base), naui_path_from_cstr(compare_cur), threshold);
+		return regressions == 0 ? 0 : 1;
+	}
+
+	if (ctx.iterations < 1)
+		ctx.iterations = 1;
+
+	naui_jobs_init(jobs, 1024);
+
+	bench_json(&ctx);
+	bench_archive(&ctx);
+	bench_io(&ctx);
+	bench_walk(&ctx);
+	bench_file(&ctx);
+
+	naui_jobs_shutdown();
+
+	bool ok = bench_write_results(&ctx, naui_path_from_cstr(out));
+	if (ok)
+		printf("\nResults written to %s\n", out);
+	else
+		fprintf(stderr, "[Naui] bench: failed to write %s\n", out);
+
+	naui_list_free(ctx.results);
+	return ok ? 0 : 1;
+}
@@ -119,9 +119,13 @@ local function link_flags()
     return out
 end
 
-local function output_path(release)
+local APP = { name = config.app_name, src = config.src }
+local BENCH = { name = config.bench_name, src = config.bench_src }
+
+local function output_path(release, target)
+    target = target or APP
     local build_type = release and "Release" or "Debug"
-    local exe_name = IS_WINDOWS and (config.app_name .. ".exe") or config.app_name
+    local exe_name = IS_WINDOWS and (target.name .. ".exe") or target.name
 
     if IS_WINDOWS then
         return ("bin\\%s\\%s"):format(build_type, exe_name)
@@ -134,12 +138,13 @@ local function opt_flags(release)
     return release and { "-O2 -s" } or { "-O0 -g" }
 end
 
-local function compile(release)
+local function compile(release, target)
+    target = target or APP
     local build_dir = release and "bin/Release" or "bin/Debug"
     mkdir("bin")
     mkdir(build_dir)
 
-    local out = output_path(release)
+    local out = output_path(release, target)
 
     local parts = {}
     table.insert(parts, compiler())
@@ -148,12 +153,14 @@ local function compile(release)
     for _, part in ipairs(defines(release))       do table.insert(parts, part) end
     for _, part in ipairs(include_flags())        do table.insert(parts, part) end
 
-    table.insert(parts, config.src)
+    table.insert(parts, target.src)
     table.insert(parts, "-o")
     table.insert(parts, '"' .. out .. '"')
 
     for _, part in ipairs(link_flags())           do table.insert(parts, part) end
-    for _, part in ipairs(subsystem_flags(release)) do table.insert(parts, part) end
+    if target == APP then
+        for _, part in ipairs(subsystem_flags(release)) do table.insert(parts, part) end
+    end
 
     local cmd = table.concat(parts, " ")
     info("%s", cmd)
@@ -167,8 +174,8 @@ local function compile(release)
     end
 end
 
-local function run(release)
-    local out = output_path(release)
+local function run(release, target, args)
+    local out = output_path(release, target)
 
     if not exists(out) then
         fail("Target '%s' does not exist", out)
@@ -179,9 +186,9 @@ local function run(release)
 
     local ok
     if IS_WINDOWS then
-        ok = os.execute('"' .. out .. '"')
+        ok = os.execute('"' .. out .. '"' .. (args or ""))
     else
-        ok = os.execute("./" .. out)
+        ok = os.execute("./" .. out .. (args or ""))
     end
 
     io.stderr:write("\n")
@@ -214,6 +221,8 @@ Usage:
   lua build.lua release       Build Release
   lua build.lua run_debug     Run Debug build
   lua build.lua run_release   Run Release build
+  lua build.lua bench         Build the benchmark suite (Release)
+  lua build.lua run_bench     Run it, results go to bin/Release/bench_results.json
   lua build.lua clean         Delete bin/
   lua build.lua help          Show this help
 ]]):format(COLOR.bold, COLOR.reset))
@@ -224,6 +233,8 @@ local COMMANDS = {
     release     = function(release) compile(release) end,
     run_debug   = function(_)       run(false) end,
     run_release = function(_)       run(true) end,
+    bench       = function(_)       compile(true, BENCH) end,
+    run_bench   = function(_)       run(true, BENCH, " --out bin/Release/bench_results.json") end,
     clean       = function(_)       clean() end,
     help        = function(_)       help() end,
 }
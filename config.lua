@@ -2,6 +2,9 @@ return {
     app_name = "NauiApp",
     src = "app/build.c",
 
+    bench_name = "NauiBench",
+    bench_src = "benchmark/build.c",
+
     include_dirs = {
         ".",
         "naui/vendor",
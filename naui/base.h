@@ -8,6 +8,15 @@
 
 #define NAUI_API
 
+// debug builds watch the loose asset and language folders and reload what changed
+#if !defined(NAUI_HOT_RELOAD)
+#	if defined(NDEBUG)
+#		define NAUI_HOT_RELOAD 0
+#	else
+#		define NAUI_HOT_RELOAD 1
+#	endif
+#endif
+
 #if defined(_MSC_VER)
 #	define NAUI_THREAD_LOCAL __declspec(thread)
 #elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
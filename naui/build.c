@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <limits.h>
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdarg.h>
@@ -37,6 +38,9 @@
 	#include <dirent.h>
 	#include <fcntl.h>
 	#include <sys/file.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <sys/uio.h>
 #endif
 
 #include "vendor/stb/stb.c"
@@ -63,22 +67,31 @@
 #include "core/log.h"
 #include "core/shortcut.h"
 
+#include "threading/jobs.h"
+#include "threading/threads.h"
+
 #include "filesystem/filesystem.h"
+#include "filesystem/file_filter.h"
+#include "filesystem/listing.h"
+#include "filesystem/buffered.h"
+#include "filesystem/file_hash.h"
 #include "filesystem/iterator.h"
 #include "filesystem/archive.h"
+#include "filesystem/vfs.h"
+#include "filesystem/async_io.h"
+#include "filesystem/watch.h"
 
 #include "serialization/json_writer.h"
 #include "serialization/json_reader.h"
 #include "serialization/json.h"
+#include "serialization/json_tape.h"
+#include "serialization/json_path.h"
 
 #include "renderer/renderer.h"
 #include "renderer/shaders/base.glsl.h"
 #include "renderer/asset_manager.h"
 #include "core/theme.h" // need Naui_Color
 
-#include "threading/jobs.h"
-#include "threading/threads.h"
-
 #include "localization/localization.h"
 
 // source files
@@ -99,6 +112,8 @@
 #include "serialization/json.c"
 #include "serialization/json_writer.c"
 #include "serialization/json_reader.c"
+#include "serialization/json_tape.c"
+#include "serialization/json_path.c"
 
 #include "renderer/renderer.c"
 #include "renderer/asset_manager.c"
@@ -107,10 +122,21 @@
 #include "threading/thread_win32.c"
 #include "threading/thread_unix.c"
 
+#include "filesystem/file_filter.c"
+#include "filesystem/listing.c"
 #include "filesystem/iterator_unix.c"
 #include "filesystem/filesystem_win32.c"
 #include "filesystem/iterator_win32.c"
 #include "filesystem/filesystem_unix.c"
+#include "filesystem/buffered.c"
+#include "filesystem/copy.c"
+#include "filesystem/file_hash.c"
 #include "filesystem/archive.c"
+#include "filesystem/vfs.c"
+#include "filesystem/async_io_uring.c"
+#include "filesystem/async_io.c"
+#include "filesystem/watch_unix.c"
+#include "filesystem/watch_win32.c"
+#include "filesystem/watch.c"
 
 #include "localization/localization.c"
@@ -18,6 +18,11 @@ typedef struct
     events;
     Naui_List(Naui_DeferredEntry) deferred_entries;
     Naui_Arena deferred_arg_arena;
+
+    // jobs defer from worker threads, the pending entries are swapped into these under the lock and run outside it
+    Naui_List(Naui_DeferredEntry) running_entries;
+    Naui_Arena running_arg_arena;
+    Naui_Mutex deferred_lock;
 }
 Naui_AppState;
 static Naui_AppState state;
@@ -132,11 +137,21 @@ static void __naui_app_start(void)
 {
     naui_arena_init(naui_arena_frame(), 2 * 1024 * 1024); // 2mb should be enough for most string operations
     naui_renderer_initialize();
+
+    // a packed Assets.naui next to the loose Assets folder shadows it, except in hot reload builds,
+    // whose watches are on the loose files and have to read back what was edited.
+    if (naui_path_is_directory(NAUI_PATH("Assets")))
+        naui_vfs_mount(NAUI_PATH("Assets"), "Assets", NAUI_HOT_RELOAD ? 2 : 0);
+    if (naui_path_exists(NAUI_PATH("Assets.naui")))
+        naui_vfs_mount(NAUI_PATH("Assets.naui"), "Assets", 1);
+
     naui_asset_manager_load_images("Assets/Images");
     naui_themes_initialize();
     leaf_init();
     leaf_set_measure_text(measure_text_bridge);
     naui_arena_init(&state.deferred_arg_arena, NAUI_BASE_DEFERRED_ARG_ARENA_SIZE);
+    naui_arena_init(&state.running_arg_arena, NAUI_BASE_DEFERRED_ARG_ARENA_SIZE);
+    state.deferred_lock = naui_mutex_create();
     state.events.start();
     render();
     mg_app_show(true);
@@ -148,19 +163,56 @@ static void __naui_app_end(void)
     leaf_shutdown();
     naui_renderer_shutdown();
     naui_themes_shutdown();
+    naui_localization_shutdown();
+    naui_io_shutdown();
+    naui_watch_shutdown();
+    naui_vfs_shutdown();
     naui_list_free(state.deferred_entries);
+    naui_list_free(state.running_entries);
     naui_arena_free(&state.deferred_arg_arena);
+    naui_arena_free(&state.running_arg_arena);
     naui_arena_free(naui_arena_frame());
+    if (state.deferred_lock)
+        naui_mutex_destroy(state.deferred_lock);
+    state.deferred_lock = NULL;
+}
+
+static inline void naui_deferred_lock(void)
+{
+    if (state.deferred_lock)
+        naui_mutex_lock(state.deferred_lock);
+}
+
+static inline void naui_deferred_unlock(void)
+{
+    if (state.deferred_lock)
+        naui_mutex_unlock(state.deferred_lock);
 }
 
 static inline void naui_process_deferred(void)
 {
-    if (naui_list_len(state.deferred_entries) > 0)
+    // events deferred while running land in the pending list and still run this frame
+    for (;;)
     {
-        for (uint32_t i = 0; i < (uint32_t)naui_list_len(state.deferred_entries); i++)
-            state.deferred_entries[i].event(state.deferred_entries[i].data);
-        naui_list_clear(state.deferred_entries);
-        naui_arena_reset(&state.deferred_arg_arena);
+        naui_deferred_lock();
+        if (naui_list_len(state.deferred_entries) == 0)
+        {
+            naui_deferred_unlock();
+            break;
+        }
+
+        Naui_List(Naui_DeferredEntry) entries = state.deferred_entries;
+        Naui_Arena arena = state.deferred_arg_arena;
+        state.deferred_entries = state.running_entries;
+        state.deferred_arg_arena = state.running_arg_arena;
+        state.running_entries = entries;
+        state.running_arg_arena = arena;
+        naui_deferred_unlock();
+
+        for (uint32_t i = 0; i < (uint32_t)naui_list_len(state.running_entries); i++)
+            state.running_entries[i].event(state.running_entries[i].data);
+        naui_list_clear(state.running_entries);
+        naui_arena_reset(&state.running_arg_arena);
     }
 }
 
@@ -168,6 +220,8 @@ static void __naui_app_update(void)
 {
     naui_arena_reset(naui_arena_frame());
     naui_process_deferred();
+    naui_io_poll();
+    naui_watch_poll();
     naui_input_update();
 	naui_shortcut_update();
     render();
@@ -177,7 +231,8 @@ void naui_defer(Naui_DeferredEvent event, void *data, size_t data_size)
 {
     Naui_DeferredEntry entry;
     entry.event = event;
-    
+
+    naui_deferred_lock();
     if (data_size)
     {
         entry.data = naui_arena_alloc(&state.deferred_arg_arena, data_size);
@@ -189,6 +244,7 @@ void naui_defer(Naui_DeferredEvent event, void *data, size_t data_size)
     }
     
     naui_list_push(state.deferred_entries, entry);
+    naui_deferred_unlock();
 }
 
 int32_t naui_app_width(void)
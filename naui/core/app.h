@@ -10,6 +10,7 @@ NAUI_API void naui_app_run(
     Naui_AppEvent update
 );
 
+// safe to call from any thread, events run on the main thread at the start of the next frame
 NAUI_API void       naui_defer          (Naui_DeferredEvent event, void *data, size_t data_size);
 
 NAUI_API int32_t    naui_app_width      (void);
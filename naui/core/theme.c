@@ -10,6 +10,10 @@ typedef struct
     Naui_Map(Naui_ThemeFloatEntry) float_map;
     Naui_Map(Naui_ThemeVec2Entry) vec2_map;
     Naui_Arena key_arena;
+    char current[64];
+#if NAUI_HOT_RELOAD
+    Naui_WatchHandle watch;
+#endif
 }
 Naui_ThemeData;
 static Naui_ThemeData tm;
@@ -39,19 +43,60 @@ static Naui_Color naui_color_from_hex(const char *hex)
     return color;
 }
 
+#if NAUI_HOT_RELOAD
+static void naui_theme_changed(const Naui_WatchChange *change, void *user)
+{
+    (void)user;
+    char file_name[sizeof(tm.current) + 8];
+    snprintf(file_name, sizeof(file_name), "%s.json", tm.current);
+
+    // only the theme in use is loaded again, other files in the folder do not matter
+    if ((change->events & NAUI_WATCH_OVERFLOW) || strcmp(change->relative, file_name) == 0)
+    {
+        char name[sizeof(tm.current)];
+        memcpy(name, tm.current, sizeof(name));
+        naui_load_theme(name);
+    }
+}
+#endif
+
 void naui_themes_initialize(void) { naui_arena_init(&tm.key_arena, NAUI_THEME_KEY_SCRATCH_SIZE); }
-void naui_themes_shutdown(void) { naui_arena_free(&tm.key_arena); }
+
+void naui_themes_shutdown(void)
+{
+#if NAUI_HOT_RELOAD
+    naui_watch_remove(tm.watch);
+    tm.watch = NAUI_WATCH_INVALID;
+#endif
+    naui_arena_free(&tm.key_arena);
+}
 
 // TODO(doomguy): move this into asset_manager
 void naui_load_theme(const char *file_name)
 {
-    naui_arena_reset(&tm.key_arena);
+    snprintf(tm.current, sizeof(tm.current), "%s", file_name);
 
     char final_file_name[64];
     strncpy(final_file_name, file_name, strlen(file_name) + 1);
     strncat(final_file_name, ".json", sizeof(final_file_name) - 1);
 	Naui_Path json_path = NAUI_PATH("Assets/Themes", final_file_name);
-    Naui_Json json = naui_json_parse_file(json_path);
+    Naui_VfsFile file;
+    if (!naui_vfs_read(json_path.data, &file)) return;
+
+    // a file caught halfway through a save keeps the old values
+    Naui_Json json = naui_json_parse((const char*)file.data, file.size);
+    if (!json.root || json.error)
+    {
+        naui_json_free(&json);
+        naui_vfs_release(&file);
+        return;
+    }
+
+    // the maps point at keys in the arena, they go with it
+    naui_arena_reset(&tm.key_arena);
+    naui_strmap_free(tm.color_map);
+    naui_strmap_free(tm.float_map);
+    naui_strmap_free(tm.vec2_map);
 
     NAUI_JSON_FOREACH(json.root, key, val)
     {
@@ -77,6 +122,12 @@ void naui_load_theme(const char *file_name)
     }
 	
     naui_json_free(&json);
+    naui_vfs_release(&file);
+
+#if NAUI_HOT_RELOAD
+    if (!naui_watch_is_valid(tm.watch) && naui_path_is_directory(NAUI_PATH("Assets/Themes")))
+        tm.watch = naui_watch_add(NAUI_PATH("Assets/Themes"), 0, naui_theme_changed, NULL);
+#endif
 }
 
 Naui_Color naui_theme_color(const char *name)
@@ -2,6 +2,7 @@ typedef struct
 {
 	char name[NAUI_PATH_MAX];
 	uint64_t size;
+	uint64_t compressed_size;
 	bool is_directory;
 } Zip_EntryStat;
 
@@ -26,9 +27,9 @@ static void zip_close_write(mz_zip_archive* zip)
 	mz_zip_writer_end(zip);
 }
 
-static bool zip_add_file(mz_zip_archive* zip, const char* dest, const char* source)
+static bool zip_add_file(mz_zip_archive* zip, const char* dest, const char* source, int level)
 {
-	return mz_zip_writer_add_file(zip, dest, source, NULL, 0, MZ_BEST_SPEED) != 0;
+	return mz_zip_writer_add_file(zip, dest, source, NULL, 0, (mz_uint)level) != 0;
 }
 
 static int zip_entry_count(mz_zip_archive* zip)
@@ -44,18 +45,1357 @@ static bool zip_entry_stat(mz_zip_archive* zip, int index, Zip_EntryStat* out)
 
 	snprintf(out->name, NAUI_PATH_MAX, "%s", st.m_filename);
 	out->size = (uint64_t)st.m_uncomp_size;
+	out->compressed_size = (uint64_t)st.m_comp_size;
 	out->is_directory = mz_zip_reader_is_file_a_directory(zip, index) != 0;
 	return true;
 }
 
-static bool zip_extract_to_file(mz_zip_archive* zip, int index, const char* dest)
+static bool zip_extract_entry_to_file(mz_zip_archive* zip, const char* entry, const char* dest)
+{
+	return mz_zip_reader_extract_file_to_file(zip, entry, dest, 0) != 0;
+}
+
+#define NAUI_ARCHIVE_PARALLEL_MAX_WINDOW 64
+#define NAUI_ARCHIVE_PARALLEL_MAX_FILE (64ull * 1024 * 1024)
+#define NAUI_ARCHIVE_PARALLEL_MAX_BYTES (512ull * 1024 * 1024)
+#define NAUI_ARCHIVE_SAMPLE_SIZE (16 * 1024)
+
+/* One file read and deflated off the writer thread. */
+typedef struct
+{
+	Naui_Path source;
+	Naui_Path dest;
+	const Naui_ArchivePolicy* policy;
+	int level;
+	uint64_t size;
+	uint64_t read_size;
+	void* data;
+	size_t data_len;
+	mz_uint32 crc;
+	MZ_TIME_T modified;
+	bool is_compressed;
+	bool is_direct;
+	bool is_submitted;
+	bool is_unchanged;
+	bool failed;
+} Zip_CompressJob;
+
+typedef struct
+{
+	char* key;
+	size_t value;
+} Zip_JobName;
+
+/* Progress of a pack or pak operation, advanced on the thread running it. */
+typedef struct
+{
+	Naui_ArchiveProgressFn fn;
+	void* user;
+	Naui_ArchiveProgress progress;
+} Archive_Progress;
+
+/* Publishes the totals before the first entry, returns false when the operation was already cancelled. */
+static bool archive_progress_begin(Archive_Progress* progress)
+{
+	return !progress || !progress->fn || progress->fn(&progress->progress, progress->user);
+}
+
+/* Counts one finished entry, returns false when the operation was cancelled. `progress` may be NULL. */
+static bool archive_progress_step(Archive_Progress* progress, uint64_t bytes)
+{
+	if (!progress)
+		return true;
+
+	progress->progress.done_bytes += bytes;
+	++progress->progress.done_entries;
+	return !progress->fn || progress->fn(&progress->progress, progress->user);
+}
+
+static Naui_Path archive_dest_path(const Naui_Path folder, const Naui_Path root_in_archive, const Naui_Path full)
+{
+	const char* rel = full.data + strlen(folder.data);
+	if (*rel == '/' || *rel == '\\')
+		++rel;
+
+	Naui_Path dest;
+	if (root_in_archive.data[0] != '\0')
+		snprintf(dest.data, NAUI_PATH_MAX, "%s/%s", root_in_archive.data, rel);
+	else
+		snprintf(dest.data, NAUI_PATH_MAX, "%s", rel);
+
+	return dest;
+}
+
+static bool archive_extension_is(const char* filename, const char* extension)
+{
+	const char* dot = strrchr(filename, '.');
+	if (!dot)
+		return false;
+
+	for (; *dot && *extension; ++dot, ++extension)
+	{
+		if (tolower((unsigned char)*dot) != tolower((unsigned char)*extension))
+			return false;
+	}
+
+	return *dot == *extension;
+}
+
+/* The level the policy gives a file before looking at its contents. */
+static int archive_policy_level(const Naui_ArchivePolicy* policy, const Naui_Path source, uint64_t size)
+{
+	if (size < policy->store_below)
+		return MZ_NO_COMPRESSION;
+
+	const char* filename = source.data;
+	for (const char* c = source.data; *c; ++c)
+	{
+		if (*c == '/' || *c == '\\')
+			filename = c + 1;
+	}
+
+	for (size_t i = 0; i < policy->rule_count; ++i)
+	{
+		const Naui_ArchiveRule* rule = &policy->rules[i];
+		if (size >= rule->min_size && (!rule->extension || archive_extension_is(filename, rule->extension)))
+			return rule->level;
+	}
+
+	return policy->level;
+}
+
+/*
+ * Deflates the head of the data at the fastest level, poor means it did not shrink below adaptive_ratio.
+ * When the sample covered all of the data and `out_comp` is given, the deflated sample is handed back.
+ */
+static bool zip_sample_is_poor(const Naui_ArchivePolicy* policy, const void* data, size_t len, void** out_comp, size_t* out_comp_len)
+{
+	size_t sample = len < NAUI_ARCHIVE_SAMPLE_SIZE ? len : NAUI_ARCHIVE_SAMPLE_SIZE;
+	if (sample == 0)
+		return false;
+
+	size_t comp_len = 0;
+	void* comp = tdefl_compress_mem_to_heap(data, sample, &comp_len, tdefl_create_comp_flags_from_zip_params(MZ_BEST_SPEED, -15, MZ_DEFAULT_STRATEGY));
+	bool is_poor = !comp || (double)comp_len >= (double)sample * policy->adaptive_ratio;
+	if (out_comp && !is_poor && sample == len)
+	{
+		*out_comp = comp;
+		*out_comp_len = comp_len;
+		return false;
+	}
+
+	free(comp);
+	return is_poor;
+}
+
+/* Level for a job whose file is not in memory, sampling its head from disk when the policy is adaptive. */
+static int zip_job_level(const Zip_CompressJob* job)
+{
+	if (job->level == MZ_NO_COMPRESSION || !job->policy->is_adaptive)
+		return job->level;
+
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	void* head = malloc(NAUI_ARCHIVE_SAMPLE_SIZE);
+	if (!head || !naui_file_open(&fh, job->source, NAUI_FILE_READ))
+	{
+		free(head);
+		return job->level;
+	}
+
+	size_t n = naui_file_read(&fh, head, NAUI_ARCHIVE_SAMPLE_SIZE);
+	naui_file_close(&fh);
+
+	bool is_poor = zip_sample_is_poor(job->policy, head, n, NULL, NULL);
+	free(head);
+	return is_poor ? MZ_NO_COMPRESSION : job->level;
+}
+
+static bool zip_add_job_file(mz_zip_archive* zip, const Zip_CompressJob* job)
+{
+	return zip_add_file(zip, job->dest.data, job->source.data, zip_job_level(job));
+}
+
+static void zip_compress(Zip_CompressJob* job)
+{
+	size_t len;
+	char* raw = naui_file_read_all(job->source, &len);
+	if (!raw)
+	{
+		job->failed = true;
+		return;
+	}
+
+	if (!mz_zip_get_file_modified_time(job->source.data, &job->modified))
+		job->modified = 0;
+
+	job->read_size = (uint64_t)len;
+	job->crc = (mz_uint32)mz_crc32(MZ_CRC32_INIT, (const mz_uint8*)raw, len);
+	job->data = raw;
+	job->data_len = len;
+	job->is_compressed = false;
+
+	/* A small file at the fastest level is fully deflated by its sample already. */
+	void* comp = NULL;
+	size_t comp_len = 0;
+	if (job->level != MZ_NO_COMPRESSION && job->policy->is_adaptive)
+	{
+		if (zip_sample_is_poor(job->policy, raw, len, job->level == MZ_BEST_SPEED && len > 3 ? &comp : NULL, &comp_len))
+			job->level = MZ_NO_COMPRESSION;
+	}
+
+	/* Raw deflate, exactly what miniz would have produced at the same level. Incompressible data is stored. */
+	if (len > 3 && job->level != MZ_NO_COMPRESSION)
+	{
+		if (!comp)
+			comp = tdefl_compress_mem_to_heap(raw, len, &comp_len, tdefl_create_comp_flags_from_zip_params(job->level, -15, MZ_DEFAULT_STRATEGY));
+
+		if (comp && comp_len < len)
+		{
+			free(raw);
+			job->data = comp;
+			job->data_len = comp_len;
+			job->is_compressed = true;
+		}
+		else
+			free(comp);
+	}
+}
+
+static void zip_compress_job(void* data, char* err_buf, size_t err_size)
+{
+	Zip_CompressJob* job = (Zip_CompressJob*)data;
+	zip_compress(job);
+	if (job->failed)
+		snprintf(err_buf, err_size, "failed to read %s", job->source.data);
+}
+
+static bool zip_write_compressed(mz_zip_archive* zip, const Zip_CompressJob* job)
+{
+	MZ_TIME_T* modified = job->modified ? (MZ_TIME_T*)&job->modified : NULL;
+	if (!job->is_compressed)
+		return mz_zip_writer_add_mem_ex_v2(zip, job->dest.data, job->data, job->data_len, NULL, 0, 0, 0, 0, modified, NULL, 0, NULL, 0) != 0;
+
+	return mz_zip_writer_add_mem_ex_v2(zip, job->dest.data, job->data, job->data_len, NULL, 0, (mz_uint)job->level | MZ_ZIP_FLAG_COMPRESSED_DATA,
+		job->read_size, job->crc, modified, NULL, 0, NULL, 0) != 0;
+}
+
+/*
+ * Workers read and deflate a sliding window of files while this thread appends finished ones in list order,
+ * so the archive is byte-for-byte independent of scheduling. The window is bounded by file count and by bytes held.
+ */
+static bool zip_add_parallel(mz_zip_archive* zip, Zip_CompressJob* jobs, size_t count, Archive_Progress* progress)
+{
+	size_t window = (size_t)naui_jobs_worker_count() * 2 + 2;
+	if (window > NAUI_ARCHIVE_PARALLEL_MAX_WINDOW)
+		window = NAUI_ARCHIVE_PARALLEL_MAX_WINDOW;
+
+	Naui_JobHandle* handles = (Naui_JobHandle*)calloc(count, sizeof(Naui_JobHandle));
+	if (!handles)
+		return false;
+
+	bool ok = true;
+	size_t next_submit = 0;
+	uint64_t held = 0;
+	for (size_t next_write = 0; next_write < count; ++next_write)
+	{
+		while (ok && next_submit < count && next_submit - next_write < window)
+		{
+			Zip_CompressJob* job = &jobs[next_submit];
+			if (job->size > NAUI_ARCHIVE_PARALLEL_MAX_FILE)
+				job->is_direct = true;
+			else
+			{
+				if (next_submit > next_write && held + job->size > NAUI_ARCHIVE_PARALLEL_MAX_BYTES)
+					break;
+
+				held += job->size;
+				job->is_submitted = naui_job_submit(&handles[next_submit], zip_compress_job, job) == NAUI_JOB_SUBMIT_OK;
+				if (!job->is_submitted)
+					zip_compress(job);
+			}
+
+			++next_submit;
+		}
+
+		Zip_CompressJob* job = &jobs[next_write];
+		if (job->is_submitted)
+			naui_job_wait(handles[next_write]);
+
+		if (ok)
+		{
+			if (job->is_direct)
+				ok = zip_add_job_file(zip, job);
+			else
+				ok = !job->failed && zip_write_compressed(zip, job);
+
+			ok = ok && archive_progress_step(progress, job->size);
+		}
+
+		if (!job->is_direct)
+			held -= job->size;
+
+		free(job->data);
+		job->data = NULL;
+	}
+
+	free(handles);
+	return ok;
+}
+
+#define NAUI_ARCHIVE_STREAM_CHUNK (256 * 1024)
+
+/* Every file under folder as a compress job, in listing order. */
+static bool zip_collect_jobs(const Naui_Path folder, const Naui_Path root_in_archive, const Naui_ArchivePolicy* policy, Zip_CompressJob** out_jobs, size_t* out_count)
+{
+	*out_jobs = NULL;
+	*out_count = 0;
+
+	Naui_List(Naui_DirEntry) entries = naui_directory_filter_recursive(folder, NULL, NULL, 0);
+	if (!entries)
+		return true;
+
+	Zip_CompressJob* jobs = (Zip_CompressJob*)calloc((size_t)naui_list_len(entries), sizeof(Zip_CompressJob));
+	if (!jobs)
+	{
+		naui_directory_filter_free(entries);
+		return false;
+	}
+
+	size_t count = 0;
+	for (ptrdiff_t i = 0; i < naui_list_len(entries); ++i)
+	{
+		if (entries[i].is_directory)
+			continue;
+
+		Zip_CompressJob* job = &jobs[count++];
+		job->source = entries[i].path;
+		job->dest = archive_dest_path(folder, root_in_archive, entries[i].path);
+		job->size = (uint64_t)entries[i].size;
+		job->policy = policy;
+		job->level = archive_policy_level(policy, job->source, job->size);
+	}
+
+	naui_directory_filter_free(entries);
+	*out_jobs = jobs;
+	*out_count = count;
+	return true;
+}
+
+/* Code already running as a job passes use_workers = false, waiting on nested jobs could starve the pool. */
+static bool zip_add_jobs(mz_zip_archive* zip, Zip_CompressJob* jobs, size_t count, bool use_workers, Archive_Progress* progress)
+{
+	if (progress)
+	{
+		progress->progress.total_entries = (uint32_t)count;
+		for (size_t i = 0; i < count; ++i)
+		{
+			progress->progress.total_bytes += jobs[i].size;
+		}
+	}
+
+	if (!archive_progress_begin(progress))
+		return false;
+
+	/* Without workers there is nothing to overlap with, let miniz stream each file. */
+	if (!use_workers || naui_jobs_worker_count() == 0)
+	{
+		bool ok = true;
+		for (size_t i = 0; i < count && ok; ++i)
+		{
+			ok = zip_add_job_file(zip, &jobs[i]) && archive_progress_step(progress, jobs[i].size);
+		}
+
+		return ok;
+	}
+
+	return zip_add_parallel(zip, jobs, count, progress);
+}
+
+static bool zip_file_crc32(const Naui_Path path, mz_uint32* out_crc)
+{
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	void* chunk = malloc(NAUI_ARCHIVE_STREAM_CHUNK);
+	if (!chunk || !naui_file_open(&fh, path, NAUI_FILE_READ))
+	{
+		free(chunk);
+		return false;
+	}
+
+	mz_ulong crc = MZ_CRC32_INIT;
+	size_t n;
+	while ((n = naui_file_read(&fh, chunk, NAUI_ARCHIVE_STREAM_CHUNK)) > 0)
+	{
+		crc = mz_crc32(crc, (const mz_uint8*)chunk, n);
+	}
+
+	naui_file_close(&fh);
+	free(chunk);
+	*out_crc = (mz_uint32)crc;
+	return true;
+}
+
+/*
+ * Same size, and either the exact stored modification time on a file strictly older than the previous archive, or the
+ * same crc32. A time inside the 2 second DOS window can hide an edit made right after packing, so it is always hashed.
+ */
+static bool zip_entry_unchanged(const Zip_CompressJob* job, const mz_zip_archive_file_stat* st, MZ_TIME_T archive_modified)
+{
+	if (st->m_uncomp_size != job->size)
+		return false;
+
+	MZ_TIME_T modified;
+	if (mz_zip_get_file_modified_time(job->source.data, &modified) && modified == st->m_time && modified < archive_modified)
+		return true;
+
+	mz_uint32 crc;
+	return zip_file_crc32(job->source, &crc) && crc == st->m_crc32;
+}
+
+/* Pak index entry, names live in one shared pool instead of a path buffer each. */
+typedef struct
+{
+	uint32_t name_offset;
+	uint16_t name_len;
+	uint64_t offset;
+	uint64_t size;
+	int64_t modified;
+	uint64_t hash;
+} Pak_IndexEntry;
+
+/* Fixed-width fields, so the placeholder written before the data and the final index have the same length. */
+static bool pak_write_header(Naui_FileHandle* fh, const Pak_IndexEntry* index, size_t count, const char* names)
+{
+	Naui_FileWriter w;
+	if (!naui_file_writer_init(&w, fh, NULL, 0))
+		return false;
+
+	uint32_t version = NAUI_ARCHIVE_VERSION;
+	uint64_t count64 = (uint64_t)count;
+	naui_file_writer_write(&w, NAUI_ARCHIVE_MAGIC, NAUI_ARCHIVE_MAGIC_SIZE);
+	naui_file_writer_write(&w, &version, sizeof(version));
+	naui_file_writer_write(&w, &count64, sizeof(count64));
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Pak_IndexEntry* e = &index[i];
+		naui_file_writer_write(&w, &e->name_len, sizeof(e->name_len));
+		naui_file_writer_write(&w, names + e->name_offset, e->name_len);
+		naui_file_writer_write(&w, &e->offset, sizeof(e->offset));
+		naui_file_writer_write(&w, &e->size, sizeof(e->size));
+		naui_file_writer_write(&w, &e->modified, sizeof(e->modified));
+		naui_file_writer_write(&w, &e->hash, sizeof(e->hash));
+	}
+
+	return naui_file_writer_finish(&w);
+}
+
+/*
+ * Copies through `chunk` until EOF, recording what was actually read in case the file changed since listing.
+ * With no `out` the file is only hashed.
+ */
+static bool pak_copy_file(Naui_FileHandle* out, const Naui_Path source, void* chunk, uint64_t* out_size, uint64_t* out_hash)
+{
+	Naui_FileHandle in = NAUI_FILE_HANDLE_INIT;
+	if (!naui_file_open(&in, source, NAUI_FILE_READ))
+		return false;
+
+	bool ok = true;
+	uint64_t total = 0;
+	size_t n;
+	Naui_Hash64State hash;
+	naui_hash64_init(&hash, 0);
+	while ((n = naui_file_read(&in, chunk, NAUI_ARCHIVE_STREAM_CHUNK)) > 0)
+	{
+		if (out && naui_file_write(out, chunk, n) != n)
+		{
+			ok = false;
+			break;
+		}
+
+		naui_hash64_update(&hash, chunk, n);
+		total += n;
+	}
+
+	naui_file_close(&in);
+	*out_size = total;
+	*out_hash = naui_hash64_digest(&hash);
+	return ok;
+}
+
+/* Pak index entry resolved against the mapping, the name points into the mapped index. */
+typedef struct
+{
+	uint64_t hash;
+	const char* name;
+	uint16_t name_len;
+	uint64_t offset;
+	uint64_t size;
+	int64_t modified;
+	uint64_t content_hash;
+} Pak_Entry;
+
+static char pak_fold(char c)
+{
+	return c == '\\' ? '/' : c;
+}
+
+/* FNV-1a over the name with separators folded, so lookups do not depend on the platform that built the pak. */
+static uint64_t pak_hash_name(const char* name, size_t len)
+{
+	uint64_t hash = NAUI_FNV_OFFSET;
+	for (size_t i = 0; i < len; ++i)
+	{
+		hash ^= (uint8_t)pak_fold(name[i]);
+		hash *= NAUI_FNV_PRIME;
+	}
+
+	return hash;
+}
+
+static bool pak_name_equals(const char* a, const char* b, size_t len)
+{
+	for (size_t i = 0; i < len; ++i)
+	{
+		if (pak_fold(a[i]) != pak_fold(b[i]))
+			return false;
+	}
+
+	return true;
+}
+
+static const Pak_Entry* pak_find_entry(const Naui_Pak* pak, const char* name, size_t len)
+{
+	if (!pak->_slots)
+		return NULL;
+
+	uint64_t hash = pak_hash_name(name, len);
+	const Pak_Entry* entries = (const Pak_Entry*)pak->_entries;
+	for (uint32_t slot = (uint32_t)hash & pak->_slot_mask; pak->_slots[slot]; slot = (slot + 1) & pak->_slot_mask)
+	{
+		const Pak_Entry* e = &entries[pak->_slots[slot] - 1];
+		if (e->hash == hash && e->name_len == len && pak_name_equals(e->name, name, len))
+			return e;
+	}
+
+	return NULL;
+}
+
+/* Walks the index in place, every field is bounds-checked against the mapping. */
+static bool pak_read_index(Naui_Pak* pak)
+{
+	const uint8_t* cursor = pak->data;
+	const uint8_t* end = pak->data + pak->size;
+	size_t header = NAUI_ARCHIVE_MAGIC_SIZE + sizeof(uint32_t) + sizeof(uint64_t);
+	if (pak->size < header || memcmp(cursor, NAUI_ARCHIVE_MAGIC, NAUI_ARCHIVE_MAGIC_SIZE) != 0)
+		return false;
+
+	uint32_t version;
+	uint64_t count;
+	memcpy(&version, cursor + NAUI_ARCHIVE_MAGIC_SIZE, sizeof(version));
+	memcpy(&count, cursor + NAUI_ARCHIVE_MAGIC_SIZE + sizeof(version), sizeof(count));
+	cursor += header;
+
+	/* Version 1 entries end after the size, version 2 adds the modification time and content hash. */
+	if (version < 1 || version > NAUI_ARCHIVE_VERSION)
+		return false;
+
+	size_t fields = sizeof(uint64_t) * (version >= 2 ? 4 : 2);
+
+	/* The smallest entry bounds `count` before allocating. Slot indices are 32-bit. */
+	if (count > (uint64_t)(end - cursor) / (sizeof(uint16_t) + fields) || count > ((uint64_t)1 << 30))
+		return false;
+
+	Pak_Entry* entries = (Pak_Entry*)malloc((size_t)(count ? count : 1) * sizeof(Pak_Entry));
+	if (!entries)
+		return false;
+
+	for (uint64_t i = 0; i < count; ++i)
+	{
+		Pak_Entry* e = &entries[i];
+		if ((size_t)(end - cursor) < sizeof(uint16_t))
+			break;
+
+		memcpy(&e->name_len, cursor, sizeof(e->name_len));
+		cursor += sizeof(e->name_len);
+		if ((size_t)(end - cursor) < (size_t)e->name_len + fields)
+			break;
+
+		e->name = (const char*)cursor;
+		e->hash = pak_hash_name(e->name, e->name_len);
+		cursor += e->name_len;
+
+		memcpy(&e->offset, cursor, sizeof(e->offset));
+		cursor += sizeof(e->offset);
+		memcpy(&e->size, cursor, sizeof(e->size));
+		cursor += sizeof(e->size);
+
+		e->modified = 0;
+		e->content_hash = 0;
+		if (version >= 2)
+		{
+			memcpy(&e->modified, cursor, sizeof(e->modified));
+			cursor += sizeof(e->modified);
+			memcpy(&e->content_hash, cursor, sizeof(e->content_hash));
+			cursor += sizeof(e->content_hash);
+		}
+
+		pak->count = (size_t)i + 1;
+	}
+
+	pak->_entries = entries;
+	pak->_payload = cursor;
+	pak->version = version;
+	if (pak->count != (size_t)count)
+		return false;
+
+	uint64_t payload_size = (uint64_t)(end - cursor);
+	for (size_t i = 0; i < pak->count; ++i)
+	{
+		if (entries[i].offset > payload_size || entries[i].size > payload_size - entries[i].offset)
+			return false;
+	}
+
+	/* Open addressing at no more than half load, slots hold entry index + 1. */
+	uint32_t slots = 16;
+	while (slots < pak->count * 2)
+	{
+		slots <<= 1;
+	}
+
+	pak->_slots = (uint32_t*)calloc(slots, sizeof(uint32_t));
+	if (!pak->_slots)
+		return false;
+
+	pak->_slot_mask = slots - 1;
+	for (size_t i = 0; i < pak->count; ++i)
+	{
+		uint32_t slot = (uint32_t)entries[i].hash & pak->_slot_mask;
+		while (pak->_slots[slot])
+		{
+			slot = (slot + 1) & pak->_slot_mask;
+		}
+
+		pak->_slots[slot] = (uint32_t)i + 1;
+	}
+
+	return true;
+}
+
+/* One payload written to a pak being built, chained with the other payloads of the same size. */
+typedef struct
+{
+	uint64_t offset;
+	uint64_t size;
+	uint64_t hash;
+	int64_t next;
+} Pak_Blob;
+
+typedef struct
+{
+	uint64_t key;
+	int64_t value;
+} Pak_BlobBySize;
+
+typedef struct
+{
+	uint64_t key;
+	uint64_t value;
+} Pak_PayloadSize;
+
+/*
+ * Compares a payload already written to the pak at `position`, read back through the handle writing it, with the
+ * contents about to be stored: either `mapped` bytes or the file at `source`. `chunk` holds two stream chunks.
+ * Positional reads leave the write position alone and take 64-bit offsets.
+ */
+static bool pak_blob_equals(const Naui_FileHandle* pak, uint64_t position, uint64_t size, const uint8_t* mapped, const Naui_Path source, uint8_t* chunk)
+{
+	Naui_FileHandle in = NAUI_FILE_HANDLE_INIT;
+	if (!mapped && !naui_file_open(&in, source, NAUI_FILE_READ))
+		return false;
+
+	bool same = true;
+	uint8_t* other = chunk + NAUI_ARCHIVE_STREAM_CHUNK;
+	for (uint64_t done = 0; done < size && same; )
+	{
+		size_t want = size - done < NAUI_ARCHIVE_STREAM_CHUNK ? (size_t)(size - done) : NAUI_ARCHIVE_STREAM_CHUNK;
+		const uint8_t* current = mapped ? mapped + done : other;
+		same = naui_file_read_at(pak, chunk, want, position + done) == want;
+		same = same && (mapped || naui_file_read(&in, other, want) == want);
+		same = same && memcmp(chunk, current, want) == 0;
+		done += want;
+	}
+
+	/* A source that grew since it was hashed is no longer the same file. */
+	if (!mapped)
+	{
+		same = same && naui_file_read(&in, other, 1) == 0;
+		naui_file_close(&in);
+	}
+
+	return same;
+}
+
+/* Swaps a finished temporary file in for the original, which is replaced in one rename and kept if that fails. */
+static bool archive_replace(const Naui_Path path, const Naui_Path temp)
+{
+	if (naui_file_rename(temp, path))
+		return true;
+
+	naui_file_delete(temp);
+	return false;
+}
+
+typedef struct
+{
+	char* key;
+	bool value;
+} Archive_Dir;
+
+/* Directories already created during one extraction, so each costs a single mkdir. Keys live in `names`. */
+typedef struct
+{
+	Archive_Dir* dirs;
+	Naui_Arena names;
+} Archive_DirCache;
+
+static void archive_create_dir(const Naui_Path dir, Archive_DirCache* cache)
+{
+	if (!cache)
+	{
+		naui_directory_create(dir);
+		return;
+	}
+
+	if (naui_strmap_get_index(cache->dirs, dir.data) >= 0)
+		return;
+
+	naui_directory_create(dir);
+	size_t len = strlen(dir.data);
+	char* key = (char*)naui_arena_alloc(&cache->names, len + 1);
+	if (key)
+	{
+		memcpy(key, dir.data, len + 1);
+		naui_strmap_put(cache->dirs, key, true);
+	}
+}
+
+/* Creates every missing directory above `file`, entries can arrive before their parent folders. `cache` may be NULL. */
+static void archive_create_parents(const Naui_Path file, Archive_DirCache* cache)
+{
+	Naui_Path dir = naui_path_parent(file);
+	if (!dir.data[0] || (cache && naui_strmap_get_index(cache->dirs, dir.data) >= 0))
+		return;
+
+	for (char* c = dir.data + 1; *c; ++c)
+	{
+		if (*c != '/' && *c != '\\')
+			continue;
+
+		char sep = *c;
+		*c = '\0';
+		archive_create_dir(dir, cache);
+		*c = sep;
+	}
+
+	archive_create_dir(dir, cache);
+}
+
+static void archive_dir_cache_free(Archive_DirCache* cache)
+{
+	naui_strmap_free(cache->dirs);
+	naui_arena_free(&cache->names);
+}
+
+#define NAUI_ARCHIVE_EXTRACT_BUFFER_MAX (8 * 1024 * 1024)
+
+/* Shared by every thread extracting one archive. Entries are claimed one at a time under `lock`. */
+typedef struct
+{
+	Naui_Path archive_path;
+	Naui_Path output;
+	Naui_Mutex lock;
+	int count;
+	int next;
+	Naui_ArchiveProgress progress;
+	bool failed;
+	bool cancelled;
+} Zip_Extract;
+
+/* One thread's reader over the archive and the buffer it inflates whole entries into. */
+typedef struct
+{
+	Zip_Extract* shared;
+	mz_zip_archive* zip;
+	mz_zip_archive reader;
+	void* buffer;
+	size_t buffer_cap;
+} Zip_ExtractWorker;
+
+/* miniz hands over whatever part of its window was filled, the writer turns that into full-buffer writes. */
+typedef struct
+{
+	Zip_Extract* shared;
+	Naui_FileHandle fh;
+	Naui_FileWriter writer;
+} Zip_ExtractStream;
+
+static void zip_extract_lock(Zip_Extract* ex)
+{
+	if (ex->lock)
+		naui_mutex_lock(ex->lock);
+}
+
+static void zip_extract_unlock(Zip_Extract* ex)
+{
+	if (ex->lock)
+		naui_mutex_unlock(ex->lock);
+}
+
+/* Adds to the progress, returns false once the extraction should stop. */
+static bool zip_extract_advance(Zip_Extract* ex, uint64_t bytes)
+{
+	zip_extract_lock(ex);
+	ex->progress.done_bytes += bytes;
+	bool keep_going = !ex->failed && !ex->cancelled;
+	zip_extract_unlock(ex);
+	return keep_going;
+}
+
+static size_t zip_extract_write(void* opaque, mz_uint64 offset, const void* data, size_t n)
+{
+	(void)offset;
+	Zip_ExtractStream* stream = (Zip_ExtractStream*)opaque;
+	if (!naui_file_writer_write(&stream->writer, data, n) || !zip_extract_advance(stream->shared, n))
+		return 0;
+
+	return n;
+}
+
+/* Entries that fit the buffer are inflated whole and written in one go, larger ones stream through miniz's window. */
+static bool zip_extract_entry(Zip_ExtractWorker* worker, int index)
+{
+	mz_zip_archive_file_stat st;
+	if (!mz_zip_reader_file_stat(worker->zip, (mz_uint)index, &st))
+		return false;
+
+	if (mz_zip_reader_is_file_a_directory(worker->zip, (mz_uint)index))
+		return true;
+
+	Naui_Path out;
+	snprintf(out.data, NAUI_PATH_MAX, "%s/%s", worker->shared->output.data, st.m_filename);
+
+	bool ok;
+	size_t size = (size_t)st.m_uncomp_size;
+	if (size == 0)
+		ok = naui_file_write_all(out, "", 0);
+	else if (st.m_uncomp_size <= NAUI_ARCHIVE_EXTRACT_BUFFER_MAX)
+	{
+		if (size > worker->buffer_cap)
+		{
+			void* grown = realloc(worker->buffer, size);
+			if (!grown)
+				return false;
+
+			worker->buffer = grown;
+			worker->buffer_cap = size;
+		}
+
+		ok = mz_zip_reader_extract_to_mem(worker->zip, (mz_uint)index, worker->buffer, size, 0) != 0;
+		ok = ok && naui_file_write_all(out, worker->buffer, size);
+		ok = ok && zip_extract_advance(worker->shared, size);
+	}
+	else
+	{
+		Zip_ExtractStream stream;
+		stream.shared = worker->shared;
+		memset(&stream.fh, 0, sizeof(stream.fh));
+		ok = naui_file_open(&stream.fh, out, NAUI_FILE_WRITE);
+		if (ok && naui_file_writer_init(&stream.writer, &stream.fh, NULL, 0))
+		{
+			ok = mz_zip_reader_extract_to_callback(worker->zip, (mz_uint)index, zip_extract_write, &stream, 0) != 0;
+			ok = naui_file_writer_finish(&stream.writer) && ok;
+		}
+		else
+			ok = false;
+
+		if (naui_file_is_valid(&stream.fh))
+			naui_file_close(&stream.fh);
+	}
+
+	if (ok)
+		mz_zip_set_file_times(out.data, st.m_time, st.m_time);
+
+	return ok;
+}
+
+/* Only the calling thread passes `progress`, and only it ever sets `cancelled`. */
+static void zip_extract_report(Zip_Extract* ex, Naui_ArchiveProgressFn progress, void* user)
+{
+	if (!progress || ex->cancelled)
+		return;
+
+	zip_extract_lock(ex);
+	Naui_ArchiveProgress snapshot = ex->progress;
+	zip_extract_unlock(ex);
+
+	if (!progress(&snapshot, user))
+	{
+		zip_extract_lock(ex);
+		ex->cancelled = true;
+		zip_extract_unlock(ex);
+	}
+}
+
+static void zip_extract_run(Zip_ExtractWorker* worker, Naui_ArchiveProgressFn progress, void* user)
+{
+	Zip_Extract* ex = worker->shared;
+	for (;;)
+	{
+		zip_extract_lock(ex);
+		int index = ex->failed || ex->cancelled ? ex->count : ex->next++;
+		zip_extract_unlock(ex);
+		if (index >= ex->count)
+			break;
+
+		bool ok = zip_extract_entry(worker, index);
+		zip_extract_lock(ex);
+		if (ok)
+			++ex->progress.done_entries;
+		else
+			ex->failed = !ex->cancelled;
+		zip_extract_unlock(ex);
+
+		zip_extract_report(ex, progress, user);
+	}
+}
+
+static void zip_extract_job(void* data, char* err_buf, size_t err_size)
+{
+	Zip_ExtractWorker* worker = (Zip_ExtractWorker*)data;
+
+	/* A worker that cannot open its own reader leaves its share to the others. */
+	worker->zip = &worker->reader;
+	if (!zip_open_read(worker->zip, worker->shared->archive_path.data))
+	{
+		snprintf(err_buf, err_size, "failed to open %s", worker->shared->archive_path.data);
+		return;
+	}
+
+	zip_extract_run(worker, NULL, NULL);
+	zip_close_read(worker->zip);
+}
+
+/* Code already running as a job passes use_workers = false and extracts everything itself. */
+static bool zip_extract_all(Naui_Archive* archive, const Naui_Path output_folder, Naui_ArchiveProgressFn progress, void* user, bool use_workers)
+{
+	if (!archive->is_valid || archive->mode != NAUI_ARCHIVE_READ)
+		return false;
+
+	Zip_Extract ex;
+	memset(&ex, 0, sizeof(ex));
+	ex.archive_path = archive->_path;
+	ex.output = output_folder;
+	ex.count = zip_entry_count(&archive->zip);
+	ex.progress.total_entries = (uint32_t)ex.count;
+
+	/* The whole directory tree exists before any file is written. */
+	Archive_DirCache cache;
+	memset(&cache, 0, sizeof(cache));
+	for (int i = 0; i < ex.count; ++i)
+	{
+		Zip_EntryStat st;
+		if (!zip_entry_stat(&archive->zip, i, &st))
+			continue;
+
+		Naui_Path out;
+		snprintf(out.data, NAUI_PATH_MAX, "%s/%s", output_folder.data, st.name);
+		archive_create_parents(out, &cache);
+		if (st.is_directory)
+			archive_create_dir(out, &cache);
+		else
+			ex.progress.total_bytes += st.size;
+	}
+
+	archive_dir_cache_free(&cache);
+
+	/* The first report comes before any work starts, so a caller can still back out with nothing written. */
+	zip_extract_report(&ex, progress, user);
+
+	/* The calling thread extracts too, through the archive's own reader, and is the one reporting progress. */
+	int32_t worker_count = ex.cancelled || !use_workers ? 0 : naui_jobs_worker_count();
+	if (worker_count > ex.count - 1)
+		worker_count = ex.count > 1 ? ex.count - 1 : 0;
+
+	Zip_ExtractWorker* workers = NULL;
+	Naui_JobHandle* handles = NULL;
+	if (worker_count > 0)
+	{
+		workers = (Zip_ExtractWorker*)calloc((size_t)worker_count, sizeof(Zip_ExtractWorker));
+		handles = (Naui_JobHandle*)calloc((size_t)worker_count, sizeof(Naui_JobHandle));
+		ex.lock = naui_mutex_create();
+		if (!workers || !handles || !ex.lock)
+			worker_count = 0;
+	}
+
+	int32_t submitted = 0;
+	for (int32_t w = 0; w < worker_count; ++w)
+	{
+		workers[submitted].shared = &ex;
+		if (naui_job_submit(&handles[submitted], zip_extract_job, &workers[submitted]) == NAUI_JOB_SUBMIT_OK)
+			++submitted;
+	}
+
+	Zip_ExtractWorker self;
+	memset(&self, 0, sizeof(self));
+	self.shared = &ex;
+	self.zip = &archive->zip;
+	zip_extract_run(&self, progress, user);
+
+	for (int32_t w = 0; w < submitted; ++w)
+	{
+		while (!naui_job_is_done(handles[w]))
+		{
+			zip_extract_report(&ex, progress, user);
+			naui_thread_sleep_ms(5);
+		}
+
+		naui_job_wait(handles[w]);
+	}
+
+	if (progress && !ex.cancelled && !ex.failed)
+		progress(&ex.progress, user);
+
+	for (int32_t w = 0; w < submitted; ++w)
+	{
+		free(workers[w].buffer);
+	}
+
+	free(self.buffer);
+	free(workers);
+	free(handles);
+	if (ex.lock)
+		naui_mutex_destroy(ex.lock);
+
+	return !ex.failed && !ex.cancelled;
+}
+
+/*
+ * Streams `folder` into a pak. With a `previous` pak, files whose size and modification time match
+ * their old entry are copied from its mapping, so their sources are never opened.
+ * Files with the same contents share one payload: equal size, then equal XXH64, then equal bytes.
+ */
+static bool pak_build(const Naui_Path folder, const Naui_Path archive_path, const Naui_Pak* previous, Naui_ArchiveUpdateStats* stats, Archive_Progress* progress)
+{
+	Naui_DirListing listing = NAUI_DIR_LISTING_INIT;
+	naui_directory_list(&listing, folder, NULL, NULL, 0, NAUI_WALK_SIZES);
+
+	/* Only relative names are kept, the listing is dropped before any data is copied. */
+	Naui_List(Pak_IndexEntry) index = NULL;
+	Naui_List(char) names = NULL;
+	char rel[NAUI_PATH_MAX];
+	for (size_t i = 0; i < naui_dir_listing_count(&listing); ++i)
+	{
+		if (listing.records[i].is_directory)
+			continue;
+
+		size_t rel_len = naui_dir_listing_relative(&listing, i, rel, sizeof(rel));
+		if (!rel_len)
+			continue;
+
+		Pak_IndexEntry e;
+		e.name_offset = (uint32_t)naui_list_len(names);
+		e.name_len = (uint16_t)rel_len;
+		e.offset = 0;
+		e.size = listing.records[i].size;
+		e.modified = naui_file_modified_time(naui_dir_listing_path(&listing, i));
+		e.hash = 0;
+		naui_list_push(index, e);
+
+		for (uint16_t c = 0; c < e.name_len; ++c)
+		{
+			naui_list_push(names, rel[c]);
+		}
+	}
+
+	naui_dir_listing_free(&listing);
+
+	size_t count = index ? naui_list_len(index) : 0;
+	if (progress)
+	{
+		progress->progress.total_entries = (uint32_t)count;
+		for (size_t i = 0; i < count; ++i)
+		{
+			progress->progress.total_bytes += index[i].size;
+		}
+	}
+
+	uint8_t* chunk = (uint8_t*)malloc(NAUI_ARCHIVE_STREAM_CHUNK * 2);
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	bool ok = archive_progress_begin(progress) && chunk && naui_file_open(&fh, archive_path, NAUI_FILE_READ_WRITE);
+
+	/* Placeholder index first, then the data streamed straight from each file, then the real index over the placeholder. */
+	ok = ok && pak_write_header(&fh, index, count, names);
+
+	uint64_t payload_start = NAUI_ARCHIVE_MAGIC_SIZE + sizeof(uint32_t) + sizeof(uint64_t);
+	for (size_t i = 0; i < count; ++i)
+	{
+		payload_start += sizeof(uint16_t) + index[i].name_len + sizeof(uint64_t) * 4;
+	}
+
+	/*
+	 * Payloads are compared by reading back what was already written through the same read-write handle.
+	 * A second read handle would not do: Windows refuses to open a file for reading while a writer without
+	 * FILE_SHARE_WRITE holds it.
+	 */
+	Naui_List(Pak_Blob) blobs = NULL;
+	Pak_BlobBySize* by_size = NULL;
+	naui_intmap_default(by_size, -1);
+
+	size_t reused = 0;
+	uint64_t offset = 0;
+	for (size_t i = 0; i < count && ok; ++i)
+	{
+		Pak_IndexEntry* e = &index[i];
+		const Pak_Entry* old = previous ? pak_find_entry(previous, names + e->name_offset, e->name_len) : NULL;
+		if (old)
+			++reused;
+
+		const uint8_t* mapped = NULL;
+		if (old && e->modified != 0 && old->modified == e->modified && old->size == e->size)
+		{
+			mapped = previous->_payload + old->offset;
+			e->hash = old->content_hash;
+		}
+
+		Naui_Path source;
+		snprintf(source.data, NAUI_PATH_MAX, "%s/%.*s", folder.data, (int)e->name_len, names + e->name_offset);
+
+		/* Only a file whose size was seen before is hashed up front, the rest are hashed while copied. */
+		int64_t match = -1;
+		if (e->size > 0 && naui_intmap_get(by_size, e->size) >= 0)
+		{
+			if (!mapped)
+				ok = pak_copy_file(NULL, source, chunk, &e->size, &e->hash);
+
+			for (int64_t b = naui_intmap_get(by_size, e->size); ok && b >= 0 && match < 0; b = blobs[b].next)
+			{
+				if (blobs[b].hash == e->hash && pak_blob_equals(&fh, payload_start + blobs[b].offset, blobs[b].size, mapped, source, chunk))
+					match = b;
+			}
+		}
+
+		if (match >= 0)
+		{
+			e->offset = blobs[match].offset;
+			if (stats)
+			{
+				++stats->duplicates;
+				stats->bytes_saved += e->size;
+			}
+		}
+		else if (ok)
+		{
+			e->offset = offset;
+			if (mapped)
+				ok = naui_file_write(&fh, mapped, (size_t)e->size) == (size_t)e->size;
+			else
+				ok = pak_copy_file(&fh, source, chunk, &e->size, &e->hash);
+
+			if (e->size > 0)
+			{
+				Pak_Blob blob = { offset, e->size, e->hash, naui_intmap_get(by_size, e->size) };
+				naui_intmap_put(by_size, e->size, (int64_t)naui_list_len(blobs));
+				naui_list_push(blobs, blob);
+			}
+
+			offset += e->size;
+		}
+
+		if (stats && mapped)
+			++stats->unchanged;
+		else if (stats)
+			++stats->updated;
+
+		ok = ok && archive_progress_step(progress, e->size);
+	}
+
+	naui_list_free(blobs);
+	naui_intmap_free(by_size);
+
+	if (stats && previous)
+		stats->removed = (uint32_t)(previous->count - reused);
+
+	ok = ok && naui_file_seek(&fh, 0, SEEK_SET) && pak_write_header(&fh, index, count, names);
+
+	if (naui_file_is_valid(&fh))
+	{
+		naui_file_close(&fh);
+		if (!ok)
+			naui_file_delete(archive_path);
+	}
+
+	free(chunk);
+	naui_list_free(index);
+	naui_list_free(names);
+	return ok;
+}
+
+static bool pak_extract_all(const Naui_Path archive_path, const Naui_Path output_folder, Archive_Progress* progress)
+{
+	Naui_Pak pak = NAUI_PAK_INIT;
+	if (!naui_pak_open(&pak, archive_path))
+		return false;
+
+	if (progress)
+	{
+		progress->progress.total_entries = (uint32_t)pak.count;
+		for (size_t i = 0; i < pak.count; ++i)
+		{
+			progress->progress.total_bytes += naui_pak_entry(&pak, i, NULL, NULL).size;
+		}
+	}
+
+	Archive_DirCache cache;
+	memset(&cache, 0, sizeof(cache));
+
+	bool ok = archive_progress_begin(progress);
+	for (size_t i = 0; i < pak.count && ok; ++i)
+	{
+		const char* name;
+		size_t name_len;
+		Naui_PakView view = naui_pak_entry(&pak, i, &name, &name_len);
+
+		Naui_Path out;
+		snprintf(out.data, NAUI_PATH_MAX, "%s/%.*s", output_folder.data, (int)name_len, name);
+
+		archive_create_parents(out, &cache);
+		ok = naui_file_write_all(out, view.data, view.size) && archive_progress_step(progress, view.size);
+	}
+
+	archive_dir_cache_free(&cache);
+	naui_pak_close(&pak);
+	return ok;
+}
+
+/* Completion handed to the main thread, a copy so the event never has to read the task. */
+typedef struct
+{
+	Naui_ArchiveTask* task;
+	Naui_ArchiveDoneFn on_done;
+	void* user;
+	bool ok;
+} Archive_TaskDone;
+
+static void archive_task_done_event(void* data)
 {
-	return mz_zip_reader_extract_to_file(zip, index, dest, 0) != 0;
+	Archive_TaskDone* done = (Archive_TaskDone*)data;
+	done->on_done(done->task, done->ok, done->user);
 }
 
-static bool zip_extract_entry_to_file(mz_zip_archive* zip, const char* entry, const char* dest)
+/* Publishes the job's progress to the task and picks up a cancel request. */
+static bool archive_task_report(const Naui_ArchiveProgress* progress, void* user)
 {
-	return mz_zip_reader_extract_file_to_file(zip, entry, dest, 0) != 0;
+	Naui_ArchiveTask* task = (Naui_ArchiveTask*)user;
+	naui_mutex_lock(task->_lock);
+	task->_progress = *progress;
+	bool keep_going = !task->_cancel;
+	naui_mutex_unlock(task->_lock);
+	return keep_going;
+}
+
+static bool archive_task_pack(Naui_ArchiveTask* task, Archive_Progress* progress)
+{
+	Zip_CompressJob* jobs;
+	size_t count;
+	if (!zip_collect_jobs(task->_source, task->_root, naui_archive_policy_default(), &jobs, &count))
+		return false;
+
+	mz_zip_archive zip;
+	memset(&zip, 0, sizeof(zip));
+	bool ok = zip_open_write(&zip, task->_dest.data);
+	if (ok)
+	{
+		ok = zip_add_jobs(&zip, jobs, count, false, progress);
+		zip_close_write(&zip);
+		if (!ok)
+			naui_file_delete(task->_dest);
+	}
+
+	free(jobs);
+	return ok;
+}
+
+static void archive_task_job(void* data, char* err_buf, size_t err_size)
+{
+	Naui_ArchiveTask* task = (Naui_ArchiveTask*)data;
+	Archive_Progress progress;
+	memset(&progress, 0, sizeof(progress));
+	progress.fn = archive_task_report;
+	progress.user = task;
+
+	/* Everything runs on this job's thread, waiting on nested jobs from inside a job could starve the pool. */
+	bool ok = false;
+	switch (task->_kind)
+	{
+		case NAUI_ARCHIVE_TASK_PACK:
+			ok = archive_task_pack(task, &progress);
+			break;
+
+		case NAUI_ARCHIVE_TASK_EXTRACT:
+		{
+			Naui_Archive archive = NAUI_ARCHIVE_INIT;
+			if (naui_archive_open(&archive, task->_source, NAUI_ARCHIVE_READ))
+			{
+				ok = zip_extract_all(&archive, task->_dest, archive_task_report, task, false);
+				naui_archive_close(&archive);
+			}
+			break;
+		}
+
+		case NAUI_ARCHIVE_TASK_CREATE_CUSTOM:
+			ok = pak_build(task->_source, task->_dest, NULL, NULL, &progress);
+			break;
+
+		case NAUI_ARCHIVE_TASK_EXTRACT_CUSTOM:
+			ok = pak_extract_all(task->_source, task->_dest, &progress);
+			break;
+	}
+
+	naui_mutex_lock(task->_lock);
+	bool cancelled = task->_cancel;
+	naui_mutex_unlock(task->_lock);
+
+	if (!ok)
+		snprintf(err_buf, err_size, "%s", cancelled ? "cancelled" : "failed");
+
+	/* Last thing the job does, on_done may free the task as soon as it runs. */
+	if (task->on_done)
+	{
+		Archive_TaskDone done = { task, task->on_done, task->user, ok };
+		naui_defer(archive_task_done_event, &done, sizeof(done));
+	}
+}
+
+static Naui_JobHandle archive_task_submit(Naui_ArchiveTask* task, Naui_ArchiveTaskKind kind, const Naui_Path source, const Naui_Path dest, const Naui_Path root, Naui_ArchiveDoneFn on_done, void* user)
+{
+	memset(task, 0, sizeof(*task));
+	task->on_done = on_done;
+	task->user = user;
+	task->_source = source;
+	task->_dest = dest;
+	task->_root = root;
+	task->_kind = kind;
+	task->_lock = naui_mutex_create();
+
+	Naui_JobHandle handle = NAUI_JOB_INVALID;
+	if (!task->_lock || naui_job_submit(&handle, archive_task_job, task) != NAUI_JOB_SUBMIT_OK)
+	{
+		fprintf(stderr, "[Naui] Failed to start archive task: %s\n", source.data);
+		naui_archive_task_free(task);
+		return NAUI_JOB_INVALID;
+	}
+
+	return handle;
 }
 
 bool naui_archive_open(Naui_Archive* archive, const Naui_Path path, Naui_ArchiveMode mode)
@@ -63,6 +1403,8 @@ bool naui_archive_open(Naui_Archive* archive, const Naui_Path path, Naui_Archive
 	memset(&archive->zip, 0, sizeof(archive->zip));
 	archive->mode = mode;
 	archive->is_valid = false;
+	archive->policy = NULL;
+	archive->_path = path;
 
 	if (mode == NAUI_ARCHIVE_READ)
 		archive->is_valid = zip_open_read(&archive->zip, path.data);
@@ -79,6 +1421,11 @@ void naui_archive_move(Naui_Archive* dst, Naui_Archive* src)
 {
 	naui_archive_close(dst);
 	memcpy(dst, src, sizeof(Naui_Archive));
+
+	/* miniz's file IO keeps a pointer back to the archive itself. */
+	if (dst->zip.m_pIO_opaque == &src->zip)
+		dst->zip.m_pIO_opaque = &dst->zip;
+
 	memset(&src->zip, 0, sizeof(src->zip));
 	src->is_valid = false;
 }
@@ -101,12 +1448,46 @@ bool naui_archive_is_valid(const Naui_Archive* archive)
 	return archive->is_valid;
 }
 
+const Naui_ArchivePolicy* naui_archive_policy_default(void)
+{
+	/* Formats that carry their own compression. Fonts are left out, TTFs still deflate by a third or more. */
+	static const Naui_ArchiveRule rules[] = {
+		{ ".png", 0, MZ_NO_COMPRESSION },
+		{ ".jpg", 0, MZ_NO_COMPRESSION },
+		{ ".jpeg", 0, MZ_NO_COMPRESSION },
+		{ ".webp", 0, MZ_NO_COMPRESSION },
+		{ ".gif", 0, MZ_NO_COMPRESSION },
+		{ ".ogg", 0, MZ_NO_COMPRESSION },
+		{ ".mp3", 0, MZ_NO_COMPRESSION },
+		{ ".zip", 0, MZ_NO_COMPRESSION },
+		{ ".gz", 0, MZ_NO_COMPRESSION },
+		{ ".naui", 0, MZ_NO_COMPRESSION },
+	};
+
+	static const Naui_ArchivePolicy policy = {
+		MZ_DEFAULT_LEVEL, 0, rules, sizeof(rules) / sizeof(rules[0]), false, NAUI_ARCHIVE_ADAPTIVE_RATIO
+	};
+
+	return &policy;
+}
+
+void naui_archive_set_policy(Naui_Archive* archive, const Naui_ArchivePolicy* policy)
+{
+	archive->policy = policy;
+}
+
 bool naui_archive_add_file(Naui_Archive* archive, const Naui_Path source, const Naui_Path dest_in_archive)
 {
 	if (!archive->is_valid || archive->mode != NAUI_ARCHIVE_WRITE)
 		return false;
 
-	return zip_add_file(&archive->zip, dest_in_archive.data, source.data);
+	Zip_CompressJob job;
+	memset(&job, 0, sizeof(job));
+	job.source = source;
+	job.dest = dest_in_archive;
+	job.policy = archive->policy ? archive->policy : naui_archive_policy_default();
+	job.level = archive_policy_level(job.policy, source, (uint64_t)naui_file_size(source));
+	return zip_add_job_file(&archive->zip, &job);
 }
 
 bool naui_archive_add_folder(Naui_Archive* archive, const Naui_Path folder, const Naui_Path root_in_archive)
@@ -114,65 +1495,125 @@ bool naui_archive_add_folder(Naui_Archive* archive, const Naui_Path folder, cons
 	if (!archive->is_valid || archive->mode != NAUI_ARCHIVE_WRITE)
 		return false;
 
-	Naui_List(Naui_DirEntry) entries = naui_directory_filter_recursive(folder, NULL, NULL, 0);
-	if (!entries)
-		return true;
-
-	bool ok = true;
-	for (ptrdiff_t i = 0; i < naui_list_len(entries); ++i)
-	{
-		if (entries[i].is_directory)
-			continue;
-
-		const char* full = entries[i].path.data;
-		const char* rel = full + strlen(folder.data);
-		if (*rel == '/' || *rel == '\\')
-			++rel;
-
-		Naui_Path dest;
-		if (root_in_archive.data[0] != '\0')
-			snprintf(dest.data, NAUI_PATH_MAX, "%s/%s", root_in_archive.data, rel);
-		else
-			snprintf(dest.data, NAUI_PATH_MAX, "%s", rel);
-
-		if (!naui_archive_add_file(archive, entries[i].path, dest))
-		{
-			ok = false;
-			break;
-		}
-	}
+	Zip_CompressJob* jobs;
+	size_t count;
+	const Naui_ArchivePolicy* policy = archive->policy ? archive->policy : naui_archive_policy_default();
+	if (!zip_collect_jobs(folder, root_in_archive, policy, &jobs, &count))
+		return false;
 
-	naui_directory_filter_free(entries);
+	bool ok = zip_add_jobs(&archive->zip, jobs, count, true, NULL);
+	free(jobs);
 	return ok;
 }
 
-bool naui_archive_extract_to(Naui_Archive* archive, const Naui_Path output_folder)
+bool naui_archive_update_folder(const Naui_Path archive_path, const Naui_Path folder, const Naui_Path root_in_archive, const Naui_ArchivePolicy* policy, Naui_ArchiveUpdateStats* out_stats)
 {
-	if (!archive->is_valid || archive->mode != NAUI_ARCHIVE_READ)
+	Naui_ArchiveUpdateStats stats;
+	memset(&stats, 0, sizeof(stats));
+
+	Zip_CompressJob* jobs;
+	size_t count;
+	if (!zip_collect_jobs(folder, root_in_archive, policy ? policy : naui_archive_policy_default(), &jobs, &count))
 		return false;
 
-	int count = zip_entry_count(&archive->zip);
-	for (int i = 0; i < count; ++i)
+	mz_zip_archive previous;
+	memset(&previous, 0, sizeof(previous));
+	bool has_previous = naui_path_exists(archive_path) && zip_open_read(&previous, archive_path.data);
+
+	/* The old zip is read while the new one is written next to it. */
+	Naui_Path out_path = archive_path;
+	if (has_previous)
+		snprintf(out_path.data, NAUI_PATH_MAX, "%s.tmp", archive_path.data);
+
+	mz_zip_archive zip;
+	memset(&zip, 0, sizeof(zip));
+	bool ok = zip_open_write(&zip, out_path.data);
+
+	if (ok && has_previous)
 	{
-		Zip_EntryStat st;
-		if (!zip_entry_stat(&archive->zip, i, &st))
-			continue;
+		MZ_TIME_T archive_modified;
+		if (!mz_zip_get_file_modified_time(archive_path.data, &archive_modified))
+			archive_modified = 0;
 
-		Naui_Path out;
-		snprintf(out.data, NAUI_PATH_MAX, "%s/%s", output_folder.data, st.name);
-		if (st.is_directory)
+		Naui_Map(Zip_JobName) by_name = NULL;
+		for (size_t i = 0; i < count; ++i)
 		{
-			naui_directory_create(out);
-			continue;
+			naui_strmap_put(by_name, jobs[i].dest.data, i);
 		}
 
-		Naui_Path parent = naui_path_parent(out);
-		naui_directory_create(parent);
-		if (!zip_extract_to_file(&archive->zip, i, out.data))
-			return false;
+		size_t root_len = strlen(root_in_archive.data);
+		mz_uint previous_count = mz_zip_reader_get_num_files(&previous);
+		for (mz_uint i = 0; i < previous_count && ok; ++i)
+		{
+			mz_zip_archive_file_stat st;
+			if (!mz_zip_reader_file_stat(&previous, i, &st))
+				continue;
+
+			bool is_managed = !st.m_is_directory && (root_len == 0 || (strncmp(st.m_filename, root_in_archive.data, root_len) == 0 && st.m_filename[root_len] == '/'));
+			if (!is_managed)
+			{
+				ok = mz_zip_writer_add_from_zip_reader(&zip, &previous, i) != 0;
+				continue;
+			}
+
+			ptrdiff_t j = by_name ? naui_strmap_get_index(by_name, st.m_filename) : -1;
+			if (j < 0)
+			{
+				++stats.removed;
+				continue;
+			}
+
+			/* Unchanged entries keep their compressed bytes, changed ones are skipped here and deflated below. */
+			Zip_CompressJob* job = &jobs[by_name[j].value];
+			if (!job->is_unchanged && zip_entry_unchanged(job, &st, archive_modified))
+			{
+				ok = mz_zip_writer_add_from_zip_reader(&zip, &previous, i) != 0;
+				job->is_unchanged = true;
+				++stats.unchanged;
+			}
+		}
+
+		naui_strmap_free(by_name);
 	}
 
-	return true;
+	size_t pending = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (!jobs[i].is_unchanged)
+			jobs[pending++] = jobs[i];
+	}
+
+	stats.updated = (uint32_t)pending;
+	ok = ok && zip_add_jobs(&zip, jobs, pending, true, NULL);
+	ok = ok && mz_zip_writer_finalize_archive(&zip);
+	mz_zip_writer_end(&zip);
+	free(jobs);
+
+	if (has_previous)
+	{
+		zip_close_read(&previous);
+		if (ok)
+			ok = archive_replace(archive_path, out_path);
+		else
+			naui_file_delete(out_path);
+	}
+	else if (!ok)
+		naui_file_delete(archive_path);
+
+	if (out_stats)
+		*out_stats = stats;
+
+	return ok;
+}
+
+bool naui_archive_extract_to(Naui_Archive* archive, const Naui_Path output_folder)
+{
+	return naui_archive_extract_to_progress(archive, output_folder, NULL, NULL);
+}
+
+bool naui_archive_extract_to_progress(Naui_Archive* archive, const Naui_Path output_folder, Naui_ArchiveProgressFn progress, void* user)
+{
+	return zip_extract_all(archive, output_folder, progress, user, true);
 }
 
 bool naui_archive_extract_file(Naui_Archive* archive, const Naui_Path entry, const Naui_Path dest)
@@ -200,6 +1641,7 @@ Naui_List(Naui_ArchiveEntry) naui_archive_list_entries(Naui_Archive* archive)
 		Naui_ArchiveEntry entry;
 		snprintf(entry.path.data, NAUI_PATH_MAX, "%s", st.name);
 		entry.size = st.size;
+		entry.compressed_size = st.compressed_size;
 		entry.is_directory = st.is_directory;
 		naui_list_push(list, entry);
 	}
@@ -215,205 +1657,171 @@ void naui_archive_list_free(Naui_List(Naui_ArchiveEntry) list)
 
 bool naui_archive_create_custom(const Naui_Path folder, const Naui_Path archive_path)
 {
-	Naui_List(Naui_DirEntry) entries = naui_directory_filter_recursive(folder, NULL, NULL, 0);
+	return pak_build(folder, archive_path, NULL, NULL, NULL);
+}
 
-	size_t blob_cap = 1024 * 1024;
-	size_t blob_len = 0;
-	uint8_t* blob = (uint8_t*)malloc(blob_cap);
-	if (!blob)
-	{
-		naui_directory_filter_free(entries);
-		return false;
-	}
+bool naui_archive_update_custom(const Naui_Path folder, const Naui_Path archive_path, Naui_ArchiveUpdateStats* out_stats)
+{
+	if (out_stats)
+		memset(out_stats, 0, sizeof(*out_stats));
 
-	typedef struct
-	{
-		char name[NAUI_PATH_MAX];
-		uint64_t offset;
-		uint64_t size;
-	} IndexEntry;
+	Naui_Pak previous = NAUI_PAK_INIT;
+	if (!naui_path_exists(archive_path) || !naui_pak_open(&previous, archive_path))
+		return pak_build(folder, archive_path, NULL, out_stats, NULL);
 
-	size_t idx_cap = 64;
-	size_t idx_len = 0;
-	IndexEntry* index = (IndexEntry*)malloc(idx_cap * sizeof(IndexEntry));
-	if (!index)
-	{
-		free(blob);
-		naui_directory_filter_free(entries);
-		return false;
-	}
+	/* The old pak stays mapped while the new one is written next to it. */
+	Naui_Path temp;
+	snprintf(temp.data, NAUI_PATH_MAX, "%s.tmp", archive_path.data);
+	bool ok = pak_build(folder, temp, &previous, out_stats, NULL);
+	naui_pak_close(&previous);
 
-	bool ok = true;
-	size_t n = entries ? naui_list_len(entries) : 0;
-	for (size_t i = 0; i < n && ok; ++i)
-	{
-		if (entries[i].is_directory)
-			continue;
+	return ok && archive_replace(archive_path, temp);
+}
 
-		size_t file_size;
-		char* file_data = naui_file_read_all(entries[i].path, &file_size);
-		if (!file_data)
-		{
-			ok = false;
-			break;
-		}
+bool naui_archive_extract_custom(const Naui_Path archive_path, const Naui_Path output_folder)
+{
+	return pak_extract_all(archive_path, output_folder, NULL);
+}
 
-		while (blob_len + file_size > blob_cap)
-		{
-			blob_cap *= 2;
-			uint8_t* tmp = (uint8_t*)realloc(blob, blob_cap);
-			if (!tmp)
-			{
-				ok = false;
-				free(file_data);
-				break;
-			}
+Naui_JobHandle naui_archive_pack_async(Naui_ArchiveTask* task, const Naui_Path folder, const Naui_Path archive_path, const Naui_Path root_in_archive, Naui_ArchiveDoneFn on_done, void* user)
+{
+	return archive_task_submit(task, NAUI_ARCHIVE_TASK_PACK, folder, archive_path, root_in_archive, on_done, user);
+}
 
-			blob = tmp;
-		}
-		if (!ok)
-		{
-			free(file_data);
-			break;
-		}
+Naui_JobHandle naui_archive_extract_async(Naui_ArchiveTask* task, const Naui_Path archive_path, const Naui_Path output_folder, Naui_ArchiveDoneFn on_done, void* user)
+{
+	return archive_task_submit(task, NAUI_ARCHIVE_TASK_EXTRACT, archive_path, output_folder, naui_path_from_cstr(""), on_done, user);
+}
 
-		memcpy(blob + blob_len, file_data, file_size);
-		free(file_data);
+Naui_JobHandle naui_archive_create_custom_async(Naui_ArchiveTask* task, const Naui_Path folder, const Naui_Path archive_path, Naui_ArchiveDoneFn on_done, void* user)
+{
+	return archive_task_submit(task, NAUI_ARCHIVE_TASK_CREATE_CUSTOM, folder, archive_path, naui_path_from_cstr(""), on_done, user);
+}
 
-		const char* full = entries[i].path.data;
-		const char* rel = full + strlen(folder.data);
-		if (*rel == '/' || *rel == '\\')
-			++rel;
+Naui_JobHandle naui_archive_extract_custom_async(Naui_ArchiveTask* task, const Naui_Path archive_path, const Naui_Path output_folder, Naui_ArchiveDoneFn on_done, void* user)
+{
+	return archive_task_submit(task, NAUI_ARCHIVE_TASK_EXTRACT_CUSTOM, archive_path, output_folder, naui_path_from_cstr(""), on_done, user);
+}
 
-		if (idx_len >= idx_cap)
-		{
-			idx_cap *= 2;
-			IndexEntry* tmp = (IndexEntry*)realloc(index, idx_cap * sizeof(IndexEntry));
-			if (!tmp)
-			{
-				ok = false;
-				break;
-			}
+Naui_ArchiveProgress naui_archive_task_progress(Naui_ArchiveTask* task)
+{
+	Naui_ArchiveProgress progress;
+	memset(&progress, 0, sizeof(progress));
+	if (!task->_lock)
+		return progress;
+
+	naui_mutex_lock(task->_lock);
+	progress = task->_progress;
+	naui_mutex_unlock(task->_lock);
+	return progress;
+}
 
-			index = tmp;
-		}
+void naui_archive_task_cancel(Naui_ArchiveTask* task)
+{
+	if (!task->_lock)
+		return;
 
-		snprintf(index[idx_len].name, NAUI_PATH_MAX, "%s", rel);
-		index[idx_len].offset = (uint64_t)blob_len;
-		index[idx_len].size = (uint64_t)file_size;
-		++idx_len;
-		blob_len += file_size;
-	}
+	naui_mutex_lock(task->_lock);
+	task->_cancel = true;
+	naui_mutex_unlock(task->_lock);
+}
 
-	naui_directory_filter_free(entries);
+void naui_archive_task_free(Naui_ArchiveTask* task)
+{
+	if (task->_lock)
+		naui_mutex_destroy(task->_lock);
 
-	if (!ok)
-	{
-		free(blob);
-		free(index);
-		return false;
-	}
+	task->_lock = NULL;
+}
 
-	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
-	if (!naui_file_open(&fh, archive_path, NAUI_FILE_WRITE))
-	{
-		free(blob);
-		free(index);
+bool naui_pak_open(Naui_Pak* pak, const Naui_Path path)
+{
+	memset(pak, 0, sizeof(*pak));
+	if (!naui_file_map(&pak->_file, path, NAUI_FILE_MAP_NONE))
 		return false;
-	}
-
-	uint32_t version = NAUI_ARCHIVE_VERSION;
-	uint64_t count = (uint64_t)idx_len;
 
-	naui_file_write(&fh, NAUI_ARCHIVE_MAGIC, NAUI_ARCHIVE_MAGIC_SIZE);
-	naui_file_write(&fh, &version, sizeof(version));
-	naui_file_write(&fh, &count, sizeof(count));
+	pak->data = pak->_file.data;
+	pak->size = pak->_file.size;
 
-	for (size_t i = 0; i < idx_len; ++i)
+	if (!pak_read_index(pak))
 	{
-		uint16_t len = (uint16_t)strlen(index[i].name);
-		naui_file_write(&fh, &len, sizeof(len));
-		naui_file_write(&fh, index[i].name, len);
-		naui_file_write(&fh, &index[i].offset, sizeof(index[i].offset));
-		naui_file_write(&fh, &index[i].size, sizeof(index[i].size));
+		fprintf(stderr, "[Naui] Invalid NauiPak: %s\n", path.data);
+		naui_pak_close(pak);
+		return false;
 	}
 
-	naui_file_write(&fh, blob, blob_len);
-	naui_file_close(&fh);
-	free(blob);
-	free(index);
 	return true;
 }
 
-bool naui_archive_extract_custom(const Naui_Path archive_path, const Naui_Path output_folder)
+void naui_pak_close(Naui_Pak* pak)
 {
-	size_t total_size;
-	char* blob = naui_file_read_all(archive_path, &total_size);
-	if (!blob)
-		return false;
-
-	if (total_size < NAUI_ARCHIVE_MAGIC_SIZE || memcmp(blob, NAUI_ARCHIVE_MAGIC, NAUI_ARCHIVE_MAGIC_SIZE) != 0)
-	{
-		free(blob);
-		return false;
-	}
+	naui_file_unmap(&pak->_file);
 
-	const char* cursor = blob + NAUI_ARCHIVE_MAGIC_SIZE;
-
-	uint32_t version;
-	uint64_t count;
-	memcpy(&version, cursor, sizeof(version));
-	cursor += sizeof(version);
-
-	memcpy(&count, cursor, sizeof(count));
-	cursor += sizeof(count);
-
-	typedef struct
-	{
-		char name[NAUI_PATH_MAX];
-		uint64_t offset;
-		uint64_t size;
-	} IndexEntry;
+	free(pak->_entries);
+	free(pak->_slots);
+	memset(pak, 0, sizeof(*pak));
+}
 
-	IndexEntry* index = (IndexEntry*)malloc((size_t)count * sizeof(IndexEntry));
-	if (!index)
+Naui_PakView naui_pak_find(const Naui_Pak* pak, const char* name)
+{
+	Naui_PakView view = { NULL, 0 };
+	const Pak_Entry* e = name ? pak_find_entry(pak, name, strlen(name)) : NULL;
+	if (e)
 	{
-		free(blob);
-		return false;
+		view.data = pak->_payload + e->offset;
+		view.size = (size_t)e->size;
 	}
 
-	for (uint64_t i = 0; i < count; ++i)
-	{
-		uint16_t len;
-		memcpy(&len, cursor, sizeof(len));
-		cursor += sizeof(len);
+	return view;
+}
 
-		memcpy(index[i].name, cursor, len);
-		cursor += len;
+Naui_PakView naui_pak_entry(const Naui_Pak* pak, size_t index, const char** out_name, size_t* out_name_len)
+{
+	Naui_PakView view = { NULL, 0 };
+	if (index >= pak->count)
+		return view;
 
-		index[i].name[len] = '\0';
+	const Pak_Entry* e = &((const Pak_Entry*)pak->_entries)[index];
+	if (out_name)
+		*out_name = e->name;
 
-		memcpy(&index[i].offset, cursor, sizeof(index[i].offset));
-		cursor += sizeof(index[i].offset);
+	if (out_name_len)
+		*out_name_len = e->name_len;
 
-		memcpy(&index[i].size, cursor, sizeof(index[i].size));
-		cursor += sizeof(index[i].size);
-	}
+	view.data = pak->_payload + e->offset;
+	view.size = (size_t)e->size;
+	return view;
+}
 
-	const char* data_start = cursor;
-	bool ok = true;
+Naui_PakStats naui_pak_stats(const Naui_Pak* pak)
+{
+	Naui_PakStats stats;
+	memset(&stats, 0, sizeof(stats));
 
-	for (uint64_t i = 0; i < count && ok; ++i)
+	/* Entries sharing a payload share its offset, the longest one at an offset is what is stored there. */
+	Pak_PayloadSize* payloads = NULL;
+	const Pak_Entry* entries = (const Pak_Entry*)pak->_entries;
+	for (size_t i = 0; i < pak->count; ++i)
 	{
-		Naui_Path out;
-		snprintf(out.data, NAUI_PATH_MAX, "%s/%s", output_folder.data, index[i].name);
+		const Pak_Entry* e = &entries[i];
+		stats.logical_size += e->size;
+		if (e->size == 0)
+			continue;
 
-		Naui_Path parent = naui_path_parent(out);
-		naui_directory_create(parent);
-		ok = naui_file_write_all(out, data_start + index[i].offset, (size_t)index[i].size);
+		ptrdiff_t at = naui_intmap_get_index(payloads, e->offset);
+		if (at < 0)
+		{
+			naui_intmap_put(payloads, e->offset, e->size);
+			stats.stored_size += e->size;
+		}
+		else if (payloads[at].value < e->size)
+		{
+			stats.stored_size += e->size - payloads[at].value;
+			payloads[at].value = e->size;
+		}
 	}
 
-	free(index);
-	free(blob);
-	return ok;
+	stats.payloads = payloads ? (size_t)naui_intmap_len(payloads) : 0;
+	naui_intmap_free(payloads);
+	return stats;
 }
\ No newline at end of file
@@ -2,9 +2,11 @@
 
 #define NAUI_ARCHIVE_MAGIC "NauiPak"
 #define NAUI_ARCHIVE_MAGIC_SIZE (sizeof(NAUI_ARCHIVE_MAGIC) - 1)
-#define NAUI_ARCHIVE_VERSION 1
+#define NAUI_ARCHIVE_VERSION 2
 
-#define NAUI_ARCHIVE_INIT { {0}, 0, false }
+#define NAUI_ARCHIVE_ADAPTIVE_RATIO 0.9f
+
+#define NAUI_ARCHIVE_INIT { {0}, 0, false, NULL, { {0} } }
 
 typedef uint8_t Naui_ArchiveMode;
 enum
@@ -17,30 +19,166 @@ typedef struct Naui_ArchiveEntry
 {
 	Naui_Path path;
 	uint64_t size;
+	uint64_t compressed_size;
 	bool is_directory;
 } Naui_ArchiveEntry;
 
+/* Zero-copy view of one NauiPak entry, valid until the pak is closed. */
+typedef struct Naui_PakView
+{
+	const uint8_t* data;
+	size_t size;
+} Naui_PakView;
+
+/* A NauiPak mapped read-only (small ones are read into memory), with its index hashed for lookups by relative path. */
+typedef struct Naui_Pak
+{
+	const uint8_t* data;
+	size_t size;
+	size_t count;
+	uint32_t version;
+
+	const uint8_t* _payload;
+	void* _entries;
+	uint32_t* _slots;
+	uint32_t _slot_mask;
+	Naui_FileMap _file;
+} Naui_Pak;
+
+#define NAUI_PAK_INIT { NULL, 0, 0, 0, NULL, NULL, NULL, 0, NAUI_FILE_MAP_INIT }
+
+/* What an incremental update did with each file. Duplicates are files stored as a reference to an identical one. */
+typedef struct Naui_ArchiveUpdateStats
+{
+	uint32_t unchanged;
+	uint32_t updated;
+	uint32_t removed;
+	uint32_t duplicates;
+	uint64_t bytes_saved;
+} Naui_ArchiveUpdateStats;
+
+/* How much a pak saves by storing identical files once. */
+typedef struct Naui_PakStats
+{
+	size_t payloads;
+	uint64_t logical_size;
+	uint64_t stored_size;
+} Naui_PakStats;
+
+/* Level for files with a matching extension (NULL matches any) of at least min_size bytes. */
+typedef struct Naui_ArchiveRule
+{
+	const char* extension;
+	uint64_t min_size;
+	int level;
+} Naui_ArchiveRule;
+
+/*
+ * How each zip entry is compressed. Levels are miniz levels, MZ_NO_COMPRESSION stores the entry.
+ * Files below store_below bytes are stored, otherwise the first matching rule wins (extensions compare
+ * case-insensitively, e.g. ".png") and `level` applies when none match. With is_adaptive the head of every
+ * file that would be deflated is sampled first, and the file is stored when the sample does not shrink
+ * below adaptive_ratio of its size.
+ */
+typedef struct Naui_ArchivePolicy
+{
+	int level;
+	uint64_t store_below;
+	const Naui_ArchiveRule* rules;
+	size_t rule_count;
+	bool is_adaptive;
+	float adaptive_ratio;
+} Naui_ArchivePolicy;
+
 typedef struct Naui_Archive
 {
 	mz_zip_archive zip;
 	Naui_ArchiveMode mode;
 	bool is_valid;
+	const Naui_ArchivePolicy* policy;
+	Naui_Path _path;
 } Naui_Archive;
 
+/* Bytes and entries written so far out of the totals. */
+typedef struct Naui_ArchiveProgress
+{
+	uint64_t done_bytes;
+	uint64_t total_bytes;
+	uint32_t done_entries;
+	uint32_t total_entries;
+} Naui_ArchiveProgress;
+
+/* Return false to cancel. */
+typedef bool (*Naui_ArchiveProgressFn)(const Naui_ArchiveProgress* progress, void* user);
+
+typedef uint8_t Naui_ArchiveTaskKind;
+enum
+{
+	NAUI_ARCHIVE_TASK_PACK,
+	NAUI_ARCHIVE_TASK_EXTRACT,
+	NAUI_ARCHIVE_TASK_CREATE_CUSTOM,
+	NAUI_ARCHIVE_TASK_EXTRACT_CUSTOM
+};
+
+struct Naui_ArchiveTask;
+
+/* Runs on the main thread through naui_defer once the task has finished, it may free the task. */
+typedef void (*Naui_ArchiveDoneFn)(struct Naui_ArchiveTask* task, bool ok, void* user);
+
+/*
+ * One archive operation running as a job. The caller owns the task and keeps it alive until the job is done,
+ * either by waiting on the handle or by freeing it from on_done.
+ */
+typedef struct Naui_ArchiveTask
+{
+	Naui_ArchiveDoneFn on_done;
+	void* user;
+	Naui_Path _source;
+	Naui_Path _dest;
+	Naui_Path _root;
+	Naui_ArchiveTaskKind _kind;
+	Naui_Mutex _lock;
+	Naui_ArchiveProgress _progress;
+	bool _cancel;
+} Naui_ArchiveTask;
+
 bool naui_archive_open(Naui_Archive* archive, const Naui_Path path, Naui_ArchiveMode mode);
 void naui_archive_move(Naui_Archive* dst, Naui_Archive* src);
 void naui_archive_close(Naui_Archive* archive);
 bool naui_archive_is_valid(const Naui_Archive* archive);
 
+/* Stores images, audio and archives, MZ_DEFAULT_LEVEL for everything else. Used whenever no policy is set. */
+const Naui_ArchivePolicy* naui_archive_policy_default(void);
+
+/* Policy for the files added from now on, NULL for the default. Opening resets it, the policy must outlive the archive. */
+void naui_archive_set_policy(Naui_Archive* archive, const Naui_ArchivePolicy* policy);
+
 /* Add all files under folder recursively, prefixed with root_in_archive. */
 bool naui_archive_add_folder(Naui_Archive* archive, const Naui_Path folder, const Naui_Path root_in_archive);
 
+/*
+ * Bring the zip at archive_path in line with folder, stored under root_in_archive. Entries whose size and
+ * modification time (or crc32) still match are copied without recompressing, only changed files are deflated again.
+ * Entries under root_in_archive with no file left are dropped, everything else in the zip is kept.
+ * policy and out_stats may be NULL.
+ */
+bool naui_archive_update_folder(const Naui_Path archive_path, const Naui_Path folder, const Naui_Path root_in_archive, const Naui_ArchivePolicy* policy, Naui_ArchiveUpdateStats* out_stats);
+
 /* Add a single file into the archive at dest_in_archive. */
 bool naui_archive_add_file(Naui_Archive* archive, const Naui_Path source, const Naui_Path dest_in_archive);
 
-/* Extract all entries to output_folder. */
+/*
+ * Extract all entries to output_folder. Job workers each open their own reader on the archive file and
+ * take entries alongside the calling thread, with the directory tree created up front.
+ */
 bool naui_archive_extract_to(Naui_Archive* archive, const Naui_Path output_folder);
 
+/*
+ * Same, calling `progress` on the calling thread between entries and while waiting on the workers.
+ * Cancelling stops after the entries in flight and returns false; files already written are left in place.
+ */
+bool naui_archive_extract_to_progress(Naui_Archive* archive, const Naui_Path output_folder, Naui_ArchiveProgressFn progress, void* user);
+
 /* Extract a single named entry to dest. */
 bool naui_archive_extract_file(Naui_Archive* archive, const Naui_Path entry, const Naui_Path dest);
 
@@ -49,5 +187,44 @@ bool naui_archive_extract_file(Naui_Archive* archive, const Naui_Path entry, con
 Naui_List(Naui_ArchiveEntry) naui_archive_list_entries(Naui_Archive* archive);
 void naui_archive_list_free(Naui_List(Naui_ArchiveEntry) list);
 
+/*
+ * Version 2 paks record each file's modification time and XXH64 content hash, version 1 paks are still read.
+ * Identical files are stored once and their index entries point at the same payload.
+ */
 bool naui_archive_create_custom(const Naui_Path folder, const Naui_Path archive_path);
-bool naui_archive_extract_custom(const Naui_Path archive_path, const Naui_Path output_folder);
\ No newline at end of file
+
+/* Rebuilds the pak, copying files whose size and modification time are unchanged from the old pak instead of their sources. */
+bool naui_archive_update_custom(const Naui_Path folder, const Naui_Path archive_path, Naui_ArchiveUpdateStats* out_stats);
+bool naui_archive_extract_custom(const Naui_Path archive_path, const Naui_Path output_folder);
+
+/*
+ * Async variants of add_folder on a fresh zip, extract_to, create_custom and extract_custom. Each runs as a
+ * single job that does the work itself, without fanning out to further jobs, and returns NAUI_JOB_INVALID
+ * when it could not be submitted. The job fails with "cancelled" or "failed" as its error. on_done may be NULL.
+ */
+Naui_JobHandle naui_archive_pack_async(Naui_ArchiveTask* task, const Naui_Path folder, const Naui_Path archive_path, const Naui_Path root_in_archive, Naui_ArchiveDoneFn on_done, void* user);
+Naui_JobHandle naui_archive_extract_async(Naui_ArchiveTask* task, const Naui_Path archive_path, const Naui_Path output_folder, Naui_ArchiveDoneFn on_done, void* user);
+Naui_JobHandle naui_archive_create_custom_async(Naui_ArchiveTask* task, const Naui_Path folder, const Naui_Path archive_path, Naui_ArchiveDoneFn on_done, void* user);
+Naui_JobHandle naui_archive_extract_custom_async(Naui_ArchiveTask* task, const Naui_Path archive_path, const Naui_Path output_folder, Naui_ArchiveDoneFn on_done, void* user);
+
+/* Snapshot of the progress so far, safe to poll from any thread while the job runs. */
+Naui_ArchiveProgress naui_archive_task_progress(Naui_ArchiveTask* task);
+
+/* Ask the task to stop after the entry it is on. Files already written are left in place, a partial archive is deleted. */
+void naui_archive_task_cancel(Naui_ArchiveTask* task);
+
+/* Release the task's lock. Only once its job is done. */
+void naui_archive_task_free(Naui_ArchiveTask* task);
+
+/* Map a pak and index its entries. Names use '/' or '\\' interchangeably, matching is case-sensitive. */
+bool naui_pak_open(Naui_Pak* pak, const Naui_Path path);
+void naui_pak_close(Naui_Pak* pak);
+
+/* Returns a view with data == NULL when the entry does not exist. */
+Naui_PakView naui_pak_find(const Naui_Pak* pak, const char* name);
+
+/* Entry by position in the index, for enumerating. `out_name` is not null-terminated. */
+Naui_PakView naui_pak_entry(const Naui_Pak* pak, size_t index, const char** out_name, size_t* out_name_len);
+
+/* Payload count and the bytes the entries would take without sharing, against what is actually stored. */
+Naui_PakStats naui_pak_stats(const Naui_Pak* pak);
\ No newline at end of file
@@ -0,0 +1,527 @@
+/* Requests per job is roughly count / (workers * NAUI_IO_SLICES_PER_WORKER), so a slow file does not hold up the rest. */
+#define NAUI_IO_SLICES_PER_WORKER 4
+
+/* io_uring caps one read or write at what fits its 32-bit length, larger ones go round again. */
+#define NAUI_IO_MAX_TRANSFER (1u << 30)
+
+enum
+{
+	IO_STAGE_OPEN,
+	IO_STAGE_DATA
+};
+
+/* Backends push finished requests under `lock`, only the polling thread takes them off and touches `in_flight`. */
+typedef struct
+{
+	bool initialized;
+	Naui_IoBackend backend;
+	Naui_Mutex lock;
+	Naui_Cond finished_cv;
+	Naui_IoRequest* finished;
+	Naui_IoRequest* finished_tail;
+	size_t in_flight;
+
+#ifdef NAUI_IO_URING
+	Io_Uring ring;
+	uint32_t ring_in_flight;
+	Naui_IoRequest* waiting;
+	Naui_IoRequest* waiting_tail;
+#endif
+} Io_Engine;
+
+static Io_Engine g_io;
+
+typedef struct
+{
+	Naui_IoRequest* requests;
+	size_t count;
+} Io_Slice;
+
+static void io_finish(Naui_IoRequest* request, bool ok)
+{
+	request->_failed = !ok;
+	request->_next = NULL;
+
+	naui_mutex_lock(g_io.lock);
+	if (g_io.finished_tail)
+		g_io.finished_tail->_next = request;
+	else
+		g_io.finished = request;
+
+	g_io.finished_tail = request;
+	naui_mutex_unlock(g_io.lock);
+	naui_cond_signal(g_io.finished_cv);
+}
+
+/* Reads into the caller's buffer, or one allocated with room for a '\0'. */
+static bool io_prepare_buffer(Naui_IoRequest* request, size_t length)
+{
+	request->_length = length;
+	if (request->buffer)
+		return true;
+
+	request->buffer = malloc(length + 1);
+	if (!request->buffer)
+		return false;
+
+	request->_owns_buffer = true;
+	((char*)request->buffer)[0] = '\0';
+	return true;
+}
+
+static void io_terminate_buffer(Naui_IoRequest* request)
+{
+	if (request->_owns_buffer)
+		((char*)request->buffer)[request->transferred] = '\0';
+}
+
+#pragma region Threads
+static bool io_read_blocking(Naui_IoRequest* request)
+{
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	if (!naui_file_open(&fh, request->path, NAUI_FILE_READ))
+		return false;
+
+	size_t length = request->size;
+	if (length == 0)
+	{
+		size_t file_size = naui_file_size(request->path);
+		length = file_size > request->offset ? file_size - (size_t)request->offset : 0;
+	}
+
+	/* Positional, so offsets past 2 GiB work where a long seek would not. */
+	bool ok = io_prepare_buffer(request, length);
+	if (ok && length)
+		request->transferred = naui_file_read_at(&fh, request->buffer, length, request->offset);
+
+	if (ok)
+		io_terminate_buffer(request);
+
+	naui_file_close(&fh);
+	return ok;
+}
+
+static bool io_write_blocking(Naui_IoRequest* request)
+{
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	if ((!request->buffer && request->size) || !naui_file_open(&fh, request->path, NAUI_FILE_WRITE))
+		return false;
+
+	request->transferred = request->size ? naui_file_write(&fh, request->buffer, request->size) : 0;
+	naui_file_close(&fh);
+	return request->transferred == request->size;
+}
+
+static void io_run_blocking(Naui_IoRequest* request)
+{
+	bool ok = request->op == NAUI_IO_READ ? io_read_blocking(request) : io_write_blocking(request);
+	io_finish(request, ok);
+}
+
+static void io_slice_job(void* data, char* err_buf, size_t err_size)
+{
+	(void)err_buf;
+	(void)err_size;
+
+	Io_Slice* slice = (Io_Slice*)data;
+	for (size_t i = 0; i < slice->count; ++i)
+	{
+		io_run_blocking(&slice->requests[i]);
+	}
+
+	free(slice);
+}
+
+static void io_submit_threads(Naui_IoRequest* requests, size_t count)
+{
+	size_t workers = (size_t)naui_jobs_worker_count();
+	size_t slices = workers * NAUI_IO_SLICES_PER_WORKER;
+	if (slices > count)
+		slices = count;
+
+	/* A slice that cannot become a job, or a pool with no workers, runs right here. */
+	size_t start = 0;
+	for (size_t s = 0; s < slices; ++s)
+	{
+		size_t end = count * (s + 1) / slices;
+		Io_Slice* slice = (Io_Slice*)malloc(sizeof(Io_Slice));
+		Naui_JobHandle handle;
+		if (slice)
+		{
+			slice->requests = requests + start;
+			slice->count = end - start;
+		}
+
+		if (slice && naui_job_submit(&handle, io_slice_job, slice) == NAUI_JOB_SUBMIT_OK)
+			naui_job_release(handle);
+		else
+		{
+			free(slice);
+			for (size_t i = start; i < end; ++i)
+			{
+				io_run_blocking(&requests[i]);
+			}
+		}
+
+		start = end;
+	}
+
+	for (size_t i = start; i < count; ++i)
+	{
+		io_run_blocking(&requests[i]);
+	}
+}
+#pragma endregion
+
+#pragma region Uring
+#ifdef NAUI_IO_URING
+/* A free submission slot, flushing the queued ones to the kernel when full. NULL once the completion queue could overflow. */
+static struct io_uring_sqe* io_uring_slot(void)
+{
+	if (g_io.ring_in_flight >= g_io.ring.cq_entries)
+		return NULL;
+
+	struct io_uring_sqe* sqe = uring_get_sqe(&g_io.ring);
+	if (!sqe && g_io.ring.to_submit && uring_enter(&g_io.ring, 0))
+		sqe = uring_get_sqe(&g_io.ring);
+
+	return sqe;
+}
+
+static void io_uring_prep(Naui_IoRequest* request, struct io_uring_sqe* sqe)
+{
+	++g_io.ring_in_flight;
+	if (request->_stage == IO_STAGE_OPEN)
+	{
+		int flags = request->op == NAUI_IO_READ ? O_RDONLY | O_CLOEXEC : O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+		uring_prep(sqe, IORING_OP_OPENAT, AT_FDCWD, request->path.data, 0644, 0, (uint64_t)(uintptr_t)request);
+		sqe->open_flags = (uint32_t)flags;
+		return;
+	}
+
+	size_t remaining = request->_length - request->transferred;
+	uint32_t len = remaining > NAUI_IO_MAX_TRANSFER ? NAUI_IO_MAX_TRANSFER : (uint32_t)remaining;
+	uint8_t* data = (uint8_t*)request->buffer + request->transferred;
+	uint64_t offset = (request->op == NAUI_IO_READ ? request->offset : 0) + request->transferred;
+	uring_prep(sqe, request->op == NAUI_IO_READ ? IORING_OP_READ : IORING_OP_WRITE, request->_fd, data, len, offset, (uint64_t)(uintptr_t)request);
+}
+
+/* Hands the request's next step to the ring, or parks it until a slot frees up. */
+static void io_uring_queue(Naui_IoRequest* request)
+{
+	struct io_uring_sqe* sqe = g_io.waiting ? NULL : io_uring_slot();
+	if (sqe)
+	{
+		io_uring_prep(request, sqe);
+		return;
+	}
+
+	request->_next = NULL;
+	if (g_io.waiting_tail)
+		g_io.waiting_tail->_next = request;
+	else
+		g_io.waiting = request;
+
+	g_io.waiting_tail = request;
+}
+
+static void io_uring_done(Naui_IoRequest* request, bool ok)
+{
+	if (request->_fd >= 0)
+		close(request->_fd);
+
+	request->_fd = -1;
+	if (ok && request->op == NAUI_IO_READ)
+		io_terminate_buffer(request);
+
+	io_finish(request, ok);
+}
+
+static void io_uring_opened(Naui_IoRequest* request, int32_t fd)
+{
+	request->_fd = fd;
+	request->_stage = IO_STAGE_DATA;
+
+	size_t length = request->size;
+	if (request->op == NAUI_IO_READ)
+	{
+		struct stat st;
+		if (length == 0 && fstat(fd, &st) == 0)
+			length = (uint64_t)st.st_size > request->offset ? (size_t)((uint64_t)st.st_size - request->offset) : 0;
+
+		if (!io_prepare_buffer(request, length))
+		{
+			io_uring_done(request, false);
+			return;
+		}
+	}
+	else if (!request->buffer && length)
+	{
+		io_uring_done(request, false);
+		return;
+	}
+	else
+		request->_length = length;
+
+	if (request->_length == 0)
+		io_uring_done(request, true);
+	else
+		io_uring_queue(request);
+}
+
+static void io_uring_complete(Naui_IoRequest* request, int32_t res)
+{
+	--g_io.ring_in_flight;
+	if (res == -EINTR || res == -EAGAIN)
+	{
+		io_uring_queue(request);
+		return;
+	}
+
+	if (res < 0)
+	{
+		io_uring_done(request, false);
+		return;
+	}
+
+	if (request->_stage == IO_STAGE_OPEN)
+	{
+		io_uring_opened(request, res);
+		return;
+	}
+
+	/* A read that hits the end of the file early is done, a write that makes no progress failed. */
+	if (res == 0)
+	{
+		io_uring_done(request, request->op == NAUI_IO_READ);
+		return;
+	}
+
+	request->transferred += (size_t)res;
+	if (request->transferred < request->_length)
+		io_uring_queue(request);
+	else
+		io_uring_done(request, true);
+}
+
+static void io_uring_reap(void)
+{
+	uint64_t user_data;
+	int32_t res;
+	while (uring_next_cqe(&g_io.ring, &user_data, &res))
+	{
+		io_uring_complete((Naui_IoRequest*)(uintptr_t)user_data, res);
+	}
+
+	while (g_io.waiting)
+	{
+		struct io_uring_sqe* sqe = io_uring_slot();
+		if (!sqe)
+			break;
+
+		Naui_IoRequest* request = g_io.waiting;
+		g_io.waiting = request->_next;
+		if (!g_io.waiting)
+			g_io.waiting_tail = NULL;
+
+		io_uring_prep(request, sqe);
+	}
+
+	if (g_io.ring.to_submit)
+		uring_enter(&g_io.ring, 0);
+}
+#endif
+#pragma endregion
+
+/* Sleeps until a backend has something finished. */
+static void io_block(void)
+{
+#ifdef NAUI_IO_URING
+	if (g_io.backend == NAUI_IO_BACKEND_URING)
+	{
+		if (g_io.ring_in_flight)
+			uring_enter(&g_io.ring, 1);
+
+		return;
+	}
+#endif
+
+	naui_mutex_lock(g_io.lock);
+	while (!g_io.finished)
+	{
+		naui_cond_wait(g_io.finished_cv, g_io.lock);
+	}
+
+	naui_mutex_unlock(g_io.lock);
+}
+
+bool naui_io_init(Naui_IoBackend backend, uint32_t queue_depth)
+{
+	if (g_io.initialized)
+		return true;
+
+	memset(&g_io, 0, sizeof(g_io));
+	g_io.lock = naui_mutex_create();
+	g_io.finished_cv = naui_cond_create();
+	if (!g_io.lock || !g_io.finished_cv)
+	{
+		naui_mutex_destroy(g_io.lock);
+		naui_cond_destroy(g_io.finished_cv);
+		memset(&g_io, 0, sizeof(g_io));
+		return false;
+	}
+
+	g_io.backend = NAUI_IO_BACKEND_THREADS;
+	if (backend != NAUI_IO_BACKEND_THREADS)
+	{
+#ifdef NAUI_IO_URING
+		if (uring_open(&g_io.ring, queue_depth ? queue_depth : NAUI_IO_DEFAULT_QUEUE_DEPTH))
+			g_io.backend = NAUI_IO_BACKEND_URING;
+#else
+		(void)queue_depth;
+#endif
+	}
+
+	if (backend == NAUI_IO_BACKEND_URING && g_io.backend != NAUI_IO_BACKEND_URING)
+	{
+		fprintf(stderr, "[Naui] io_uring is not available\n");
+		naui_mutex_destroy(g_io.lock);
+		naui_cond_destroy(g_io.finished_cv);
+		memset(&g_io, 0, sizeof(g_io));
+		return false;
+	}
+
+	g_io.initialized = true;
+	return true;
+}
+
+void naui_io_shutdown(void)
+{
+	if (!g_io.initialized)
+		return;
+
+	naui_io_wait_all();
+
+#ifdef NAUI_IO_URING
+	if (g_io.backend == NAUI_IO_BACKEND_URING)
+		uring_close(&g_io.ring);
+#endif
+
+	naui_mutex_destroy(g_io.lock);
+	naui_cond_destroy(g_io.finished_cv);
+	memset(&g_io, 0, sizeof(g_io));
+}
+
+Naui_IoBackend naui_io_backend(void)
+{
+	return g_io.initialized ? g_io.backend : NAUI_IO_BACKEND_AUTO;
+}
+
+bool naui_io_submit(Naui_IoRequest* requests, size_t count)
+{
+	if (!g_io.initialized)
+		return false;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (requests[i].status == NAUI_IO_PENDING)
+			return false;
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		Naui_IoRequest* request = &requests[i];
+		request->status = NAUI_IO_PENDING;
+		request->transferred = 0;
+		request->_length = 0;
+		request->_failed = false;
+		request->_stage = IO_STAGE_OPEN;
+		request->_fd = -1;
+		request->_next = NULL;
+	}
+
+	g_io.in_flight += count;
+
+#ifdef NAUI_IO_URING
+	if (g_io.backend == NAUI_IO_BACKEND_URING)
+	{
+		/* Whatever does not fit the ring now is queued by the next poll. */
+		for (size_t i = 0; i < count; ++i)
+		{
+			io_uring_queue(&requests[i]);
+		}
+
+		uring_enter(&g_io.ring, 0);
+		return true;
+	}
+#endif
+
+	io_submit_threads(requests, count);
+	return true;
+}
+
+size_t naui_io_poll(void)
+{
+	if (!g_io.initialized)
+		return 0;
+
+#ifdef NAUI_IO_URING
+	if (g_io.backend == NAUI_IO_BACKEND_URING)
+		io_uring_reap();
+#endif
+
+	naui_mutex_lock(g_io.lock);
+	Naui_IoRequest* request = g_io.finished;
+	g_io.finished = NULL;
+	g_io.finished_tail = NULL;
+	naui_mutex_unlock(g_io.lock);
+
+	/* The callback may reuse or free the request, so the link is read first. */
+	size_t count = 0;
+	while (request)
+	{
+		Naui_IoRequest* next = request->_next;
+		request->_next = NULL;
+		request->status = request->_failed ? NAUI_IO_FAILED : NAUI_IO_DONE;
+		--g_io.in_flight;
+		++count;
+
+		if (request->on_done)
+			request->on_done(request, request->user);
+
+		request = next;
+	}
+
+	return count;
+}
+
+void naui_io_wait(Naui_IoRequest* request)
+{
+	while (g_io.initialized && request->status == NAUI_IO_PENDING)
+	{
+		if (naui_io_poll() == 0 && request->status == NAUI_IO_PENDING)
+			io_block();
+	}
+}
+
+void naui_io_wait_all(void)
+{
+	while (g_io.initialized && g_io.in_flight)
+	{
+		if (naui_io_poll() == 0 && g_io.in_flight)
+			io_block();
+	}
+}
+
+void naui_io_release(Naui_IoRequest* request)
+{
+	if (request->_owns_buffer)
+	{
+		free(request->buffer);
+		request->buffer = NULL;
+	}
+
+	request->_owns_buffer = false;
+	request->status = NAUI_IO_IDLE;
+	request->transferred = 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#define NAUI_IO_DEFAULT_QUEUE_DEPTH 64
+
+typedef uint8_t Naui_IoBackend;
+enum
+{
+	NAUI_IO_BACKEND_AUTO,
+	NAUI_IO_BACKEND_THREADS,
+	NAUI_IO_BACKEND_URING
+};
+
+typedef uint8_t Naui_IoOp;
+enum
+{
+	NAUI_IO_READ,
+	NAUI_IO_WRITE
+};
+
+typedef uint8_t Naui_IoStatus;
+enum
+{
+	NAUI_IO_IDLE,
+	NAUI_IO_PENDING,
+	NAUI_IO_DONE,
+	NAUI_IO_FAILED
+};
+
+struct Naui_IoRequest;
+
+typedef void (*Naui_IoCallback)(struct Naui_IoRequest* request, void* user);
+
+/*
+ * One read or write. Reads take `size` bytes from `offset`, or the rest of the file when size is 0, into
+ * `buffer`, which is allocated (and '\0'-terminated) when NULL. Writes create or truncate the file and
+ * write `size` bytes from `buffer`, offset is ignored. The request, its path and buffer must stay put
+ * until it completes. status and transferred are only valid once on_done has run or naui_io_wait returned.
+ */
+typedef struct Naui_IoRequest
+{
+	Naui_IoOp op;
+	Naui_Path path;
+	void* buffer;
+	size_t size;
+	uint64_t offset;
+	Naui_IoCallback on_done;
+	void* user;
+
+	Naui_IoStatus status;
+	size_t transferred;
+
+	size_t _length;
+	bool _owns_buffer;
+	bool _failed;
+	uint8_t _stage;
+	int32_t _fd;
+	struct Naui_IoRequest* _next;
+} Naui_IoRequest;
+
+/*
+ * Start the engine. AUTO picks io_uring when the kernel offers it and falls back to the job pool,
+ * URING fails when it is not available. queue_depth caps the requests io_uring has in flight, 0 for the default.
+ * Requests are submitted, polled and waited on from one thread, usually the main thread.
+ */
+bool naui_io_init(Naui_IoBackend backend, uint32_t queue_depth);
+
+/* Waits for every request in flight, runs their callbacks, then tears the engine down. */
+void naui_io_shutdown(void);
+
+/* The backend in use, NAUI_IO_BACKEND_AUTO when not initialized. */
+Naui_IoBackend naui_io_backend(void);
+
+/*
+ * Submit `count` requests as one batch: a single io_uring submission, or a handful of jobs that each
+ * work through a slice. Without job workers the requests run before this returns, callbacks still wait for a poll.
+ */
+bool naui_io_submit(Naui_IoRequest* requests, size_t count);
+
+/* Run the callbacks of finished requests without blocking. Returns how many finished. The app calls this every frame. */
+size_t naui_io_poll(void);
+
+/* Block until the request has finished, running callbacks of whatever finishes meanwhile. */
+void naui_io_wait(Naui_IoRequest* request);
+void naui_io_wait_all(void);
+
+/* Free a buffer the engine allocated for a read and reset the request so it can be submitted again. */
+void naui_io_release(Naui_IoRequest* request);
@@ -0,0 +1,189 @@
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <errno.h>
+
+/* OPENAT, READ and WRITE arrived in 5.6, FAST_POLL in 5.7, so its flag stands in for all three. */
+#ifdef IORING_FEAT_FAST_POLL
+#define NAUI_IO_URING 1
+
+/* A bare ring over the raw syscalls, only what the engine needs. */
+typedef struct
+{
+	int fd;
+	uint32_t sq_entries;
+	uint32_t cq_entries;
+
+	uint32_t* sq_head;
+	uint32_t* sq_tail;
+	uint32_t* sq_mask;
+	uint32_t* sq_array;
+	struct io_uring_sqe* sqes;
+	uint32_t sq_local_tail;
+	uint32_t to_submit;
+
+	uint32_t* cq_head;
+	uint32_t* cq_tail;
+	uint32_t* cq_mask;
+	struct io_uring_cqe* cqes;
+
+	void* sq_ring;
+	size_t sq_ring_size;
+	void* cq_ring;
+	size_t cq_ring_size;
+	size_t sqes_size;
+} Io_Uring;
+
+static void uring_close(Io_Uring* ring)
+{
+	if (ring->sqes)
+		munmap(ring->sqes, ring->sqes_size);
+
+	if (ring->cq_ring && ring->cq_ring != ring->sq_ring)
+		munmap(ring->cq_ring, ring->cq_ring_size);
+
+	if (ring->sq_ring)
+		munmap(ring->sq_ring, ring->sq_ring_size);
+
+	if (ring->fd >= 0)
+		close(ring->fd);
+
+	memset(ring, 0, sizeof(*ring));
+	ring->fd = -1;
+}
+
+static bool uring_open(Io_Uring* ring, uint32_t entries)
+{
+	memset(ring, 0, sizeof(*ring));
+	ring->fd = -1;
+
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	int fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+	if (fd < 0)
+		return false;
+
+	ring->fd = fd;
+	if (!(params.features & IORING_FEAT_FAST_POLL))
+	{
+		uring_close(ring);
+		return false;
+	}
+
+	ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+	{
+		if (ring->cq_ring_size > ring->sq_ring_size)
+			ring->sq_ring_size = ring->cq_ring_size;
+
+		ring->cq_ring_size = ring->sq_ring_size;
+	}
+
+	ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (ring->sq_ring == MAP_FAILED)
+	{
+		ring->sq_ring = NULL;
+		uring_close(ring);
+		return false;
+	}
+
+	ring->cq_ring = ring->sq_ring;
+	if (!(params.features & IORING_FEAT_SINGLE_MMAP))
+	{
+		ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+		if (ring->cq_ring == MAP_FAILED)
+		{
+			ring->cq_ring = NULL;
+			uring_close(ring);
+			return false;
+		}
+	}
+
+	ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	if (ring->sqes == MAP_FAILED)
+	{
+		ring->sqes = NULL;
+		uring_close(ring);
+		return false;
+	}
+
+	uint8_t* sq = (uint8_t*)ring->sq_ring;
+	uint8_t* cq = (uint8_t*)ring->cq_ring;
+	ring->sq_entries = params.sq_entries;
+	ring->cq_entries = params.cq_entries;
+	ring->sq_head = (uint32_t*)(sq + params.sq_off.head);
+	ring->sq_tail = (uint32_t*)(sq + params.sq_off.tail);
+	ring->sq_mask = (uint32_t*)(sq + params.sq_off.ring_mask);
+	ring->sq_array = (uint32_t*)(sq + params.sq_off.array);
+	ring->cq_head = (uint32_t*)(cq + params.cq_off.head);
+	ring->cq_tail = (uint32_t*)(cq + params.cq_off.tail);
+	ring->cq_mask = (uint32_t*)(cq + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+	ring->sq_local_tail = *ring->sq_tail;
+	return true;
+}
+
+/* Next free submission slot, NULL when the queue is full. It is handed to the kernel by uring_enter. */
+static struct io_uring_sqe* uring_get_sqe(Io_Uring* ring)
+{
+	uint32_t head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+	if (ring->sq_local_tail - head >= ring->sq_entries)
+		return NULL;
+
+	uint32_t index = ring->sq_local_tail & *ring->sq_mask;
+	struct io_uring_sqe* sqe = &ring->sqes[index];
+	memset(sqe, 0, sizeof(*sqe));
+	ring->sq_array[index] = index;
+	++ring->sq_local_tail;
+	++ring->to_submit;
+	return sqe;
+}
+
+/* Submit everything queued and optionally block until `wait` completions are posted. */
+static bool uring_enter(Io_Uring* ring, uint32_t wait)
+{
+	__atomic_store_n(ring->sq_tail, ring->sq_local_tail, __ATOMIC_RELEASE);
+	for (;;)
+	{
+		long ret = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, wait, wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+		if (ret >= 0)
+		{
+			ring->to_submit -= (uint32_t)ret < ring->to_submit ? (uint32_t)ret : ring->to_submit;
+			return true;
+		}
+
+		if (errno != EINTR)
+			return false;
+	}
+}
+
+static bool uring_next_cqe(Io_Uring* ring, uint64_t* out_user_data, int32_t* out_res)
+{
+	uint32_t head = *ring->cq_head;
+	if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE))
+		return false;
+
+	const struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+	*out_user_data = cqe->user_data;
+	*out_res = cqe->res;
+	__atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+static void uring_prep(struct io_uring_sqe* sqe, uint8_t opcode, int fd, const void* addr, uint32_t len, uint64_t offset, uint64_t user_data)
+{
+	sqe->opcode = opcode;
+	sqe->fd = fd;
+	sqe->addr = (uint64_t)(uintptr_t)addr;
+	sqe->len = len;
+	sqe->off = offset;
+	sqe->user_data = user_data;
+}
+
+#endif
+#endif
+#endif
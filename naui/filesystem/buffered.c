@@ -0,0 +1,182 @@
+static bool file_buffer_setup(Naui_FileHandle* file, void* buffer, size_t* capacity, uint8_t** out_buffer, bool* out_owns)
+{
+	if (!naui_file_is_valid(file) || (buffer && *capacity == 0))
+		return false;
+
+	*out_owns = buffer == NULL;
+	if (!buffer)
+	{
+		if (*capacity == 0)
+			*capacity = NAUI_FILE_BUFFER_DEFAULT_SIZE;
+
+		buffer = malloc(*capacity);
+		if (!buffer)
+			return false;
+	}
+
+	*out_buffer = (uint8_t*)buffer;
+	return true;
+}
+
+#pragma region Reader
+
+bool naui_file_reader_init(Naui_FileReader* reader, Naui_FileHandle* file, void* buffer, size_t capacity)
+{
+	memset(reader, 0, sizeof(*reader));
+	if (!file_buffer_setup(file, buffer, &capacity, &reader->_buffer, &reader->_owns_buffer))
+		return false;
+
+	reader->file = file;
+	reader->_capacity = capacity;
+	naui_file_readahead(file, capacity);
+	return true;
+}
+
+/* Keeps the unread tail, tops the buffer up behind it and hints the window after that. */
+static void reader_fill(Naui_FileReader* reader)
+{
+	size_t left = reader->_end - reader->_start;
+	memmove(reader->_buffer, reader->_buffer + reader->_start, left);
+	reader->_start = 0;
+	reader->_end = left;
+
+	size_t want = reader->_capacity - left;
+	size_t got = naui_file_read(reader->file, reader->_buffer + left, want);
+	reader->_end += got;
+	if (got < want)
+		reader->_is_eof = true;
+	else
+		naui_file_readahead(reader->file, reader->_capacity);
+}
+
+size_t naui_file_reader_read(Naui_FileReader* reader, void* restrict out, size_t size)
+{
+	if (!reader->_buffer || !out)
+		return 0;
+
+	uint8_t* dst = (uint8_t*)out;
+	size_t done = 0;
+	for (;;)
+	{
+		size_t take = reader->_end - reader->_start;
+		if (take > size - done)
+			take = size - done;
+
+		memcpy(dst + done, reader->_buffer + reader->_start, take);
+		reader->_start += take;
+		done += take;
+		if (done == size || reader->_is_eof)
+			return done;
+
+		/* The buffer is empty here, a request it could not hold skips it. */
+		if (size - done >= reader->_capacity)
+		{
+			size_t got = naui_file_read(reader->file, dst + done, size - done);
+			if (got < size - done)
+				reader->_is_eof = true;
+
+			return done + got;
+		}
+
+		reader_fill(reader);
+		if (reader->_end == reader->_start)
+			return done;
+	}
+}
+
+const void* naui_file_reader_next(Naui_FileReader* reader, size_t size)
+{
+	if (!reader->_buffer || size > reader->_capacity)
+		return NULL;
+
+	if (reader->_end - reader->_start < size && !reader->_is_eof)
+		reader_fill(reader);
+
+	if (reader->_end - reader->_start < size)
+		return NULL;
+
+	const uint8_t* record = reader->_buffer + reader->_start;
+	reader->_start += size;
+	return record;
+}
+
+void naui_file_reader_free(Naui_FileReader* reader)
+{
+	if (reader->_owns_buffer)
+		free(reader->_buffer);
+
+	memset(reader, 0, sizeof(*reader));
+}
+
+#pragma endregion
+
+#pragma region Writer
+
+bool naui_file_writer_init(Naui_FileWriter* writer, Naui_FileHandle* file, void* buffer, size_t capacity)
+{
+	memset(writer, 0, sizeof(*writer));
+	if (!file_buffer_setup(file, buffer, &capacity, &writer->_buffer, &writer->_owns_buffer))
+		return false;
+
+	writer->file = file;
+	writer->_capacity = capacity;
+	return true;
+}
+
+bool naui_file_writer_write(Naui_FileWriter* writer, const void* restrict data, size_t size)
+{
+	if (!writer->_buffer || writer->_failed || (!data && size))
+		return false;
+
+	if (size == 0)
+		return true;
+
+	if (size <= writer->_capacity - writer->_size)
+	{
+		memcpy(writer->_buffer + writer->_size, data, size);
+		writer->_size += size;
+		return true;
+	}
+
+	if (size < writer->_capacity)
+	{
+		if (!naui_file_writer_flush(writer))
+			return false;
+
+		memcpy(writer->_buffer, data, size);
+		writer->_size = size;
+		return true;
+	}
+
+	Naui_FileVec vecs[2] = { { writer->_buffer, writer->_size }, { (void*)data, size } };
+	size_t total = writer->_size + size;
+	writer->_failed = naui_file_writev(writer->file, vecs, 2) != total;
+	writer->_size = 0;
+	return !writer->_failed;
+}
+
+bool naui_file_writer_flush(Naui_FileWriter* writer)
+{
+	if (!writer->_buffer || writer->_failed)
+		return false;
+
+	if (writer->_size > 0)
+	{
+		writer->_failed = naui_file_write(writer->file, writer->_buffer, writer->_size) != writer->_size;
+		writer->_size = 0;
+	}
+
+	return !writer->_failed;
+}
+
+bool naui_file_writer_finish(Naui_FileWriter* writer)
+{
+	bool ok = naui_file_writer_flush(writer);
+	if (writer->_owns_buffer)
+		free(writer->_buffer);
+
+	memset(writer, 0, sizeof(*writer));
+	return ok;
+}
+
+#pragma endregion
@@ -0,0 +1,58 @@
+#pragma once
+
+#define NAUI_FILE_BUFFER_DEFAULT_SIZE (64 * 1024)
+
+/*
+ * Buffered reads from the current position of an open handle. Small reads are served from the buffer,
+ * reads at least as large as the buffer go straight to the file, and every refill asks the OS to read ahead
+ * the window after it. The handle is not read or seeked directly while the reader is in use.
+ */
+typedef struct Naui_FileReader
+{
+	Naui_FileHandle* file;
+	uint8_t* _buffer;
+	size_t _capacity;
+	size_t _start;
+	size_t _end;
+	bool _owns_buffer;
+	bool _is_eof;
+} Naui_FileReader;
+
+/*
+ * Buffered writes at the current position of an open handle. Writes at least as large as the free space
+ * leave together with what is buffered in one vectored call. The first failed write makes every later call fail.
+ */
+typedef struct Naui_FileWriter
+{
+	Naui_FileHandle* file;
+	uint8_t* _buffer;
+	size_t _capacity;
+	size_t _size;
+	bool _owns_buffer;
+	bool _failed;
+} Naui_FileWriter;
+
+/*
+ * Wrap `file` with `buffer` of `capacity` bytes. A NULL buffer is allocated, with NAUI_FILE_BUFFER_DEFAULT_SIZE
+ * when capacity is 0. Returns false when the file is not open or the allocation fails. The file stays open.
+ */
+bool naui_file_reader_init(Naui_FileReader* reader, Naui_FileHandle* file, void* buffer, size_t capacity);
+bool naui_file_writer_init(Naui_FileWriter* writer, Naui_FileHandle* file, void* buffer, size_t capacity);
+
+/* Copy up to `size` bytes out. Returns bytes read, short only at the end of the file or on error. */
+size_t naui_file_reader_read(Naui_FileReader* reader, void* restrict out, size_t size);
+
+/*
+ * The next `size` bytes in place, valid until the next call on the reader. NULL when fewer remain
+ * or size is larger than the buffer. Fixed-size records are read this way without a copy.
+ */
+const void* naui_file_reader_next(Naui_FileReader* reader, size_t size);
+
+/* Frees an allocated buffer. The file position is past whatever was buffered but not read. */
+void naui_file_reader_free(Naui_FileReader* reader);
+
+bool naui_file_writer_write(Naui_FileWriter* writer, const void* restrict data, size_t size);
+bool naui_file_writer_flush(Naui_FileWriter* writer);
+
+/* Flushes and frees an allocated buffer. Returns false if any write failed. */
+bool naui_file_writer_finish(Naui_FileWriter* writer);
@@ -0,0 +1,162 @@
+/* Most job workers a tree copy recruits, past this the copies queue on the disk rather than overlap. */
+#define NAUI_COPY_HELPERS_MAX 8
+
+/* Shared by the caller and its helper jobs, freed by whoever drops the last reference. */
+typedef struct
+{
+	Naui_Mutex lock;
+	Naui_Cond idle;
+	Naui_DirListing listing;
+	Naui_Path dest;
+	size_t dest_length;
+	size_t next;
+	int32_t busy;
+	int32_t refs;
+	bool failed;
+} Copy_State;
+
+/* `dest` followed by the record's path relative to the listed folder. */
+static bool copy_target(const Copy_State* state, size_t index, Naui_Path* out)
+{
+	memcpy(out->data, state->dest.data, state->dest_length);
+	out->data[state->dest_length] = NAUI_LISTING_SEPARATOR;
+	return naui_dir_listing_relative(&state->listing, index, out->data + state->dest_length + 1, NAUI_PATH_MAX - state->dest_length - 1) > 0;
+}
+
+/* Claims files one at a time until none are left. */
+static void copy_run(Copy_State* state)
+{
+	size_t count = naui_dir_listing_count(&state->listing);
+	naui_mutex_lock(state->lock);
+	for (;;)
+	{
+		while (state->next < count && state->listing.records[state->next].is_directory)
+			++state->next;
+
+		if (state->next >= count)
+			break;
+
+		size_t index = state->next++;
+		++state->busy;
+		naui_mutex_unlock(state->lock);
+
+		Naui_Path target;
+		Naui_Path source = naui_dir_listing_path(&state->listing, index);
+		bool ok = source.data[0] != '\0' && copy_target(state, index, &target) && naui_file_copy(source, target);
+
+		naui_mutex_lock(state->lock);
+		state->failed = state->failed || !ok;
+		if (--state->busy == 0)
+			naui_cond_broadcast(state->idle);
+	}
+
+	naui_mutex_unlock(state->lock);
+}
+
+static void copy_release(Copy_State* state)
+{
+	naui_mutex_lock(state->lock);
+	bool last = --state->refs == 0;
+	naui_mutex_unlock(state->lock);
+	if (!last)
+		return;
+
+	naui_dir_listing_free(&state->listing);
+	naui_cond_destroy(state->idle);
+	naui_mutex_destroy(state->lock);
+	free(state);
+}
+
+/* Like the walker's helpers, a late one finds nothing left to claim and only drops its reference. */
+static void copy_job(void* data, char* err_buf, size_t err_size)
+{
+	(void)err_buf;
+	(void)err_size;
+	Copy_State* state = (Copy_State*)data;
+	copy_run(state);
+	copy_release(state);
+}
+
+bool naui_directory_copy(const Naui_Path source, const Naui_Path dest)
+{
+	Naui_Path from = naui_path_weakly_canonical(source);
+	Naui_Path to = naui_path_weakly_canonical(dest);
+	size_t from_length = strlen(from.data);
+	if (from_length == 0 || to.data[0] == '\0')
+		return false;
+
+	if (strncmp(to.data, from.data, from_length) == 0 && (to.data[from_length] == '\0' || is_separator(to.data[from_length])))
+	{
+		fprintf(stderr, "[Naui] Cannot copy '%s' into itself\n", source.data);
+		return false;
+	}
+
+	Copy_State* state = (Copy_State*)calloc(1, sizeof(Copy_State));
+	if (!state)
+		return false;
+
+	state->lock = naui_mutex_create();
+	state->idle = naui_cond_create();
+	state->refs = 1;
+	state->dest = dest;
+	state->dest_length = strlen(dest.data);
+
+	/* Listed before anything is created, and parents come before their contents, so directories go first in order. */
+	bool ok = state->dest_length + 2 < NAUI_PATH_MAX && naui_directory_list(&state->listing, source, NULL, NULL, 0, NAUI_WALK_DEFAULT);
+	ok = ok && naui_directory_create(dest);
+
+	size_t count = naui_dir_listing_count(&state->listing);
+	size_t files = 0;
+	for (size_t i = 0; i < count && ok; ++i)
+	{
+		Naui_Path target;
+		if (!state->listing.records[i].is_directory)
+			++files;
+		else
+			ok = copy_target(state, i, &target) && naui_directory_create(target);
+	}
+
+	if (!ok)
+	{
+		copy_release(state);
+		return false;
+	}
+
+	int32_t helpers = naui_jobs_worker_count();
+	if (helpers > NAUI_COPY_HELPERS_MAX)
+		helpers = NAUI_COPY_HELPERS_MAX;
+
+	if ((size_t)helpers + 1 > files)
+		helpers = files > 1 ? (int32_t)files - 1 : 0;
+
+	for (int32_t i = 0; i < helpers; ++i)
+	{
+		naui_mutex_lock(state->lock);
+		++state->refs;
+		naui_mutex_unlock(state->lock);
+
+		Naui_JobHandle job;
+		if (naui_job_submit(&job, copy_job, state) != NAUI_JOB_SUBMIT_OK)
+		{
+			copy_release(state);
+			break;
+		}
+
+		naui_job_release(job);
+	}
+
+	/* The caller copies too, then waits only for copies already underway, never for a helper to start. */
+	copy_run(state);
+
+	naui_mutex_lock(state->lock);
+	while (state->busy > 0)
+	{
+		naui_cond_wait(state->idle, state->lock);
+	}
+
+	ok = !state->failed;
+	naui_mutex_unlock(state->lock);
+
+	copy_release(state);
+	return ok;
+}
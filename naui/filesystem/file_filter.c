@@ -0,0 +1,494 @@
+typedef uint8_t File_FilterKind;
+enum
+{
+	FILTER_ANY,
+	FILTER_NONE,
+	FILTER_EXACT,
+	FILTER_SPLIT,
+	FILTER_GLOB
+};
+
+typedef uint8_t File_FilterOpType;
+enum
+{
+	FILTER_OP_CHAR,
+	FILTER_OP_ONE,
+	FILTER_OP_CLASS,
+	FILTER_OP_SEPARATOR,
+	FILTER_OP_STAR,
+	FILTER_OP_DEEP,
+	FILTER_OP_DEEP_DIR
+};
+
+/* One step of a compiled pattern, every op but the stars consumes exactly one character. */
+struct Naui_FileFilterOp
+{
+	File_FilterOpType type;
+	unsigned char c;
+	uint16_t cls;
+};
+
+/* A slot of the extension set, `name` is an offset into _ext_names. */
+struct Naui_FileFilterExt
+{
+	uint32_t hash;
+	uint32_t name;
+	uint16_t length;
+	bool is_used;
+};
+
+static bool filter_is_separator(unsigned char c)
+{
+#if defined(_WIN32) || defined(_WIN64)
+	return c == '/' || c == '\\';
+#else
+	return c == '/';
+#endif
+}
+
+static unsigned char filter_fold(unsigned char c, bool case_sensitive)
+{
+	return (!case_sensitive && c >= 'A' && c <= 'Z') ? (unsigned char)(c | 0x20) : c;
+}
+
+static uint32_t filter_hash(const char* text, size_t length, bool case_sensitive)
+{
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < length; ++i)
+	{
+		hash ^= filter_fold((unsigned char)text[i], case_sensitive);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/* `folded` was folded at compile time, separators compare equal to each other. */
+static bool filter_equal(const Naui_FileFilter* filter, const char* text, const char* folded, size_t length)
+{
+	if (filter->case_sensitive && !filter->is_path)
+		return memcmp(text, folded, length) == 0;
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		unsigned char a = filter_fold((unsigned char)text[i], filter->case_sensitive);
+		unsigned char b = (unsigned char)folded[i];
+		if (a != b && !(filter_is_separator(a) && filter_is_separator(b)))
+			return false;
+	}
+
+	return true;
+}
+
+/* Index of the ']' closing the class opened at `open`, 0 when there is none and the '[' is a plain character. */
+static size_t filter_class_end(const char* pattern, size_t open, size_t length)
+{
+	size_t i = open + 1;
+	if (i < length && (pattern[i] == '!' || pattern[i] == '^'))
+		++i;
+
+	if (i < length && pattern[i] == ']')
+		++i;
+
+	while (i < length && pattern[i] != ']')
+		++i;
+
+	return i < length ? i : 0;
+}
+
+static void filter_class_compile(uint32_t bits[8], const char* pattern, size_t open, size_t close, bool case_sensitive)
+{
+	memset(bits, 0, 8 * sizeof(uint32_t));
+	size_t i = open + 1;
+	bool negate = pattern[i] == '!' || pattern[i] == '^';
+	if (negate)
+		++i;
+
+	for (; i < close; ++i)
+	{
+		unsigned char lo = (unsigned char)pattern[i];
+		unsigned char hi = lo;
+		if (i + 2 < close && pattern[i + 1] == '-')
+		{
+			hi = (unsigned char)pattern[i + 2];
+			i += 2;
+		}
+
+		for (unsigned int c = lo; c <= hi; ++c)
+		{
+			unsigned char folded = filter_fold((unsigned char)c, case_sensitive);
+			bits[folded >> 5] |= 1u << (folded & 31);
+		}
+	}
+
+	if (negate)
+	{
+		for (int w = 0; w < 8; ++w)
+		{
+			bits[w] = ~bits[w];
+		}
+	}
+}
+
+static bool filter_compile_glob(Naui_FileFilter* filter, const char* pattern, size_t length)
+{
+	size_t classes = 0;
+	for (size_t i = 0; i < length; ++i)
+	{
+		if (pattern[i] == '[')
+			++classes;
+	}
+
+	filter->_ops = (struct Naui_FileFilterOp*)malloc(length * sizeof(struct Naui_FileFilterOp));
+	if (classes)
+		filter->_classes = (uint32_t(*)[8])malloc(classes * sizeof(uint32_t[8]));
+
+	if (!filter->_ops || (classes && !filter->_classes) || classes > UINT16_MAX)
+		return false;
+
+	uint32_t count = 0;
+	uint16_t class_count = 0;
+	for (size_t i = 0; i < length;)
+	{
+		struct Naui_FileFilterOp op;
+		op.type = FILTER_OP_CHAR;
+		op.c = 0;
+		op.cls = 0;
+
+		unsigned char c = (unsigned char)pattern[i];
+		if (c == '*')
+		{
+			size_t run = i;
+			while (run < length && pattern[run] == '*')
+				++run;
+
+			bool is_deep = run - i >= 2;
+			bool is_dir = is_deep && (i == 0 || filter_is_separator((unsigned char)pattern[i - 1])) && run < length && filter_is_separator((unsigned char)pattern[run]);
+			op.type = is_dir ? FILTER_OP_DEEP_DIR : is_deep ? FILTER_OP_DEEP : FILTER_OP_STAR;
+			i = is_dir ? run + 1 : run;
+		}
+		else if (c == '?')
+		{
+			op.type = FILTER_OP_ONE;
+			++i;
+		}
+		else if (c == '[' && filter_class_end(pattern, i, length))
+		{
+			size_t close = filter_class_end(pattern, i, length);
+			filter_class_compile(filter->_classes[class_count], pattern, i, close, filter->case_sensitive);
+			op.type = FILTER_OP_CLASS;
+			op.cls = class_count++;
+			i = close + 1;
+		}
+		else
+		{
+			op.type = filter_is_separator(c) ? FILTER_OP_SEPARATOR : FILTER_OP_CHAR;
+			op.c = filter_fold(c, filter->case_sensitive);
+			++i;
+		}
+
+		filter->_ops[count++] = op;
+	}
+
+	filter->_op_count = count;
+	filter->_kind = FILTER_GLOB;
+	return true;
+}
+
+static bool filter_compile_pattern(Naui_FileFilter* filter, const char* pattern)
+{
+	if (!pattern || pattern[0] == '\0')
+		return true;
+
+	size_t length = strlen(pattern);
+	bool has_star = false;
+	bool has_other = false;
+	for (size_t i = 0; i < length; ++i)
+	{
+		unsigned char c = (unsigned char)pattern[i];
+		filter->is_path |= filter_is_separator(c);
+		has_star |= c == '*';
+		has_other |= c == '?' || c == '[';
+	}
+
+	if (has_other || (has_star && filter->is_path))
+		return filter_compile_glob(filter, pattern, length);
+
+	/* Without '?' or classes a name pattern is a literal, or a prefix and suffix around one run of stars. */
+	size_t first = has_star ? (size_t)(strchr(pattern, '*') - pattern) : length;
+	size_t last = has_star ? (size_t)(strrchr(pattern, '*') - pattern) + 1 : length;
+	for (size_t i = first; i < last; ++i)
+	{
+		if (pattern[i] != '*')
+			return filter_compile_glob(filter, pattern, length);
+	}
+
+	size_t literal_length = first + (length - last);
+	if (has_star && literal_length == 0)
+		return true;
+
+	filter->_literal = (char*)malloc(literal_length + 1);
+	if (!filter->_literal)
+		return false;
+
+	for (size_t i = 0, out = 0; i < length; ++i)
+	{
+		if (i < first || i >= last)
+			filter->_literal[out++] = (char)filter_fold((unsigned char)pattern[i], filter->case_sensitive);
+	}
+
+	filter->_literal[literal_length] = '\0';
+	filter->_prefix_length = (uint32_t)first;
+	filter->_suffix_length = (uint32_t)(length - last);
+	filter->_kind = has_star ? FILTER_SPLIT : FILTER_EXACT;
+	return true;
+}
+
+static bool filter_compile_extensions(Naui_FileFilter* filter, const char** extensions, int ext_count)
+{
+	if (!extensions || ext_count <= 0)
+		return true;
+
+	size_t names_size = 0;
+	for (int i = 0; i < ext_count; ++i)
+	{
+		names_size += extensions[i] ? strlen(extensions[i]) : 0;
+	}
+
+	uint32_t slots = 8;
+	while (slots < (uint32_t)ext_count * 2)
+		slots <<= 1;
+
+	filter->_exts = (struct Naui_FileFilterExt*)calloc(slots, sizeof(struct Naui_FileFilterExt));
+	filter->_ext_names = (char*)malloc(names_size + 1);
+	if (!filter->_exts || !filter->_ext_names)
+		return false;
+
+	filter->_ext_mask = slots - 1;
+	uint32_t names = 0;
+	for (int i = 0; i < ext_count; ++i)
+	{
+		const char* ext = extensions[i];
+		if (!ext)
+			continue;
+
+		if (ext[0] == '.')
+			++ext;
+
+		size_t length = strlen(ext);
+		if (length > UINT16_MAX)
+			continue;
+
+		for (size_t c = 0; c < length; ++c)
+		{
+			filter->_ext_names[names + c] = (char)filter_fold((unsigned char)ext[c], filter->case_sensitive);
+		}
+
+		uint32_t hash = filter_hash(ext, length, filter->case_sensitive);
+		uint32_t slot = hash & filter->_ext_mask;
+		bool is_duplicate = false;
+		while (filter->_exts[slot].is_used && !is_duplicate)
+		{
+			const struct Naui_FileFilterExt* other = &filter->_exts[slot];
+			is_duplicate = other->hash == hash && other->length == length && memcmp(filter->_ext_names + other->name, filter->_ext_names + names, length) == 0;
+			slot = (slot + 1) & filter->_ext_mask;
+		}
+
+		if (is_duplicate)
+			continue;
+
+		filter->_exts[slot].hash = hash;
+		filter->_exts[slot].name = names;
+		filter->_exts[slot].length = (uint16_t)length;
+		filter->_exts[slot].is_used = true;
+		filter->_ext_max_length = length > filter->_ext_max_length ? (uint32_t)length : filter->_ext_max_length;
+		++filter->_ext_count;
+		names += (uint32_t)length;
+	}
+
+	return true;
+}
+
+bool naui_file_filter_init(Naui_FileFilter* filter, const char* pattern, const char** extensions, int ext_count, bool case_sensitive)
+{
+	memset(filter, 0, sizeof(*filter));
+	filter->case_sensitive = case_sensitive;
+	filter->_kind = FILTER_ANY;
+	if (filter_compile_pattern(filter, pattern) && filter_compile_extensions(filter, extensions, ext_count))
+		return true;
+
+	fprintf(stderr, "[Naui] Failed to compile filter '%s'\n", pattern ? pattern : "");
+	naui_file_filter_free(filter);
+	filter->case_sensitive = case_sensitive;
+	filter->_kind = FILTER_NONE;
+	return false;
+}
+
+bool naui_file_filter_is_open(const Naui_FileFilter* filter)
+{
+	return filter->_kind == FILTER_ANY && !filter->_exts;
+}
+
+static bool filter_match_extension(const Naui_FileFilter* filter, const char* path, size_t length)
+{
+	size_t start = length;
+	while (start > 0 && path[start - 1] != '.' && !filter_is_separator((unsigned char)path[start - 1]))
+		--start;
+
+	if (start == 0 || path[start - 1] != '.' || length - start > filter->_ext_max_length)
+		return false;
+
+	size_t ext_length = length - start;
+	uint32_t hash = filter_hash(path + start, ext_length, filter->case_sensitive);
+	for (uint32_t slot = hash & filter->_ext_mask; filter->_exts[slot].is_used; slot = (slot + 1) & filter->_ext_mask)
+	{
+		const struct Naui_FileFilterExt* ext = &filter->_exts[slot];
+		if (ext->hash != hash || ext->length != ext_length)
+			continue;
+
+		bool is_equal = true;
+		for (size_t i = 0; i < ext_length && is_equal; ++i)
+		{
+			is_equal = filter_fold((unsigned char)path[start + i], filter->case_sensitive) == (unsigned char)filter->_ext_names[ext->name + i];
+		}
+
+		if (is_equal)
+			return true;
+	}
+
+	return false;
+}
+
+static bool filter_op_match(const Naui_FileFilter* filter, const struct Naui_FileFilterOp* op, unsigned char c)
+{
+	switch (op->type)
+	{
+		case FILTER_OP_CHAR:
+			return filter_fold(c, filter->case_sensitive) == op->c;
+
+		case FILTER_OP_SEPARATOR:
+			return filter_is_separator(c);
+
+		case FILTER_OP_ONE:
+			return !(filter->is_path && filter_is_separator(c));
+
+		case FILTER_OP_CLASS:
+		{
+			if (filter->is_path && filter_is_separator(c))
+				return false;
+
+			unsigned char folded = filter_fold(c, filter->case_sensitive);
+			return (filter->_classes[op->cls][folded >> 5] >> (folded & 31)) & 1u;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Backtracking with two restart points, so it stays linear in practice: the last '*', which may not swallow
+ * a separator in a path pattern, and the last '**' to fall back to once the '*' cannot grow any further.
+ */
+static bool filter_run(const Naui_FileFilter* filter, const char* text, size_t length)
+{
+	const struct Naui_FileFilterOp* ops = filter->_ops;
+	size_t count = filter->_op_count;
+	size_t p = 0;
+	size_t t = 0;
+	size_t star_p = SIZE_MAX;
+	size_t star_t = 0;
+	size_t deep_p = SIZE_MAX;
+	size_t deep_t = 0;
+
+	while (p < count || t < length)
+	{
+		if (p < count)
+		{
+			File_FilterOpType type = ops[p].type;
+			if (type == FILTER_OP_STAR)
+			{
+				star_p = p++;
+				star_t = t;
+				continue;
+			}
+
+			if (type == FILTER_OP_DEEP || type == FILTER_OP_DEEP_DIR)
+			{
+				deep_p = p++;
+				deep_t = t;
+				star_p = SIZE_MAX;
+				continue;
+			}
+
+			if (t < length && filter_op_match(filter, &ops[p], (unsigned char)text[t]))
+			{
+				++p;
+				++t;
+				continue;
+			}
+		}
+
+		if (star_p != SIZE_MAX && star_t < length && !(filter->is_path && filter_is_separator((unsigned char)text[star_t])))
+		{
+			p = star_p + 1;
+			t = ++star_t;
+			continue;
+		}
+
+		if (deep_p == SIZE_MAX || deep_t >= length)
+			return false;
+
+		/* "**" takes one more character, "**" + separator one more folder. */
+		if (ops[deep_p].type == FILTER_OP_DEEP_DIR)
+		{
+			while (deep_t < length && !filter_is_separator((unsigned char)text[deep_t]))
+				++deep_t;
+
+			if (deep_t >= length)
+				return false;
+		}
+
+		star_p = SIZE_MAX;
+		p = deep_p + 1;
+		t = ++deep_t;
+	}
+
+	return true;
+}
+
+bool naui_file_filter_match(const Naui_FileFilter* filter, const char* path, size_t length)
+{
+	if (filter->_exts && !filter_match_extension(filter, path, length))
+		return false;
+
+	switch (filter->_kind)
+	{
+		case FILTER_ANY:
+			return true;
+
+		case FILTER_EXACT:
+			return length == filter->_prefix_length && filter_equal(filter, path, filter->_literal, length);
+
+		case FILTER_SPLIT:
+		{
+			size_t prefix = filter->_prefix_length;
+			size_t suffix = filter->_suffix_length;
+			return length >= prefix + suffix && filter_equal(filter, path, filter->_literal, prefix) && filter_equal(filter, path + length - suffix, filter->_literal + prefix, suffix);
+		}
+
+		case FILTER_GLOB:
+			return filter_run(filter, path, length);
+	}
+
+	return false;
+}
+
+void naui_file_filter_free(Naui_FileFilter* filter)
+{
+	free(filter->_literal);
+	free(filter->_ops);
+	free(filter->_classes);
+	free(filter->_exts);
+	free(filter->_ext_names);
+	memset(filter, 0, sizeof(*filter));
+}
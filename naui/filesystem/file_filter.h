@@ -0,0 +1,41 @@
+#pragma once
+
+/*
+ * A name filter compiled once and matched against every entry of a listing: a glob pattern and a set of extensions,
+ * both must pass. Patterns take '*' (anything but a separator), '?' (one character), '**' (anything, separators
+ * included, "**" followed by a separator also matches no folder at all) and classes like "[a-z]" or "[!._]".
+ * A pattern without a separator is matched against the name, with one against the path below the listed folder.
+ * Extensions are compared with the name's last '.', the dot is optional in the list. There are no escapes,
+ * "[*]" matches a literal star.
+ */
+typedef struct Naui_FileFilter
+{
+	bool case_sensitive;
+	bool is_path;
+	uint8_t _kind;
+	char* _literal;
+	uint32_t _prefix_length;
+	uint32_t _suffix_length;
+	struct Naui_FileFilterOp* _ops;
+	uint32_t _op_count;
+	uint32_t (*_classes)[8];
+	struct Naui_FileFilterExt* _exts;
+	uint32_t _ext_mask;
+	uint32_t _ext_count;
+	uint32_t _ext_max_length;
+	char* _ext_names;
+} Naui_FileFilter;
+
+/*
+ * Compile `pattern` (NULL or "" for any name) and `ext_count` extensions (0 for any). Neither is referenced afterwards.
+ * Returns false when out of memory, the filter is then left matching nothing.
+ */
+bool naui_file_filter_init(Naui_FileFilter* filter, const char* pattern, const char** extensions, int ext_count, bool case_sensitive);
+
+/* True when the filter lets everything through, so callers can skip it. */
+bool naui_file_filter_is_open(const Naui_FileFilter* filter);
+
+/* Match a name, or a path below the listed folder for a path pattern, of `length` bytes. */
+bool naui_file_filter_match(const Naui_FileFilter* filter, const char* path, size_t length);
+
+void naui_file_filter_free(Naui_FileFilter* filter);
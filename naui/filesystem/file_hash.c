@@ -0,0 +1,355 @@
+#define NAUI_FILE_HASH_CHUNK (64 * 1024)
+#define NAUI_FILE_HASH_MAGIC "NHC1"
+#define NAUI_FILE_HASH_MAGIC_SIZE 4
+#define NAUI_FILE_HASH_VERSION 1
+
+/* Most job workers a batch recruits, past this the reads queue on the disk rather than overlap. */
+#define NAUI_FILE_HASH_HELPERS_MAX 8
+
+static bool file_hash_stream(const Naui_Path path, uint64_t* out_hash)
+{
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	if (!naui_file_open(&fh, path, NAUI_FILE_READ))
+		return false;
+
+	uint8_t chunk[NAUI_FILE_HASH_CHUNK];
+	Naui_Hash64State state;
+	naui_hash64_init(&state, 0);
+
+	size_t n;
+	while ((n = naui_file_read(&fh, chunk, sizeof(chunk))) > 0)
+	{
+		naui_hash64_update(&state, chunk, n);
+		if (n < sizeof(chunk))
+			break;
+	}
+
+	naui_file_close(&fh);
+	*out_hash = naui_hash64_digest(&state);
+	return true;
+}
+
+bool naui_file_hash(const Naui_Path path, uint64_t* out_hash)
+{
+	*out_hash = 0;
+	Naui_FileStat st;
+	return naui_file_stat(path, &st) && !st.is_directory && file_hash_stream(path, out_hash);
+}
+
+#pragma region Cache
+
+/* Called with the lock held. */
+static void file_hash_cache_put(Naui_FileHashCache* cache, const char* path, const Naui_FileHashRecord* record)
+{
+	ptrdiff_t index = naui_strmap_get_index(cache->_entries, path);
+	if (index >= 0)
+	{
+		cache->_entries[index].value = *record;
+		return;
+	}
+
+	size_t length = strlen(path);
+	char* key = (char*)naui_arena_alloc(&cache->_names, length + 1);
+	memcpy(key, path, length + 1);
+	naui_strmap_put(cache->_entries, key, *record);
+}
+
+/* magic, u32 version, u64 count, then per entry: u16 path length, the path, u64 size, i64 modified, u64 inode, u64 hash. */
+static bool file_hash_cache_parse(Naui_FileHashCache* cache, const uint8_t* data, size_t size)
+{
+	uint32_t version;
+	uint64_t count;
+	const size_t header = NAUI_FILE_HASH_MAGIC_SIZE + sizeof(version) + sizeof(count);
+	if (size < header || memcmp(data, NAUI_FILE_HASH_MAGIC, NAUI_FILE_HASH_MAGIC_SIZE) != 0)
+		return false;
+
+	memcpy(&version, data + NAUI_FILE_HASH_MAGIC_SIZE, sizeof(version));
+	memcpy(&count, data + NAUI_FILE_HASH_MAGIC_SIZE + sizeof(version), sizeof(count));
+	if (version != NAUI_FILE_HASH_VERSION)
+		return false;
+
+	const uint8_t* cursor = data + header;
+	const uint8_t* end = data + size;
+	char path[NAUI_PATH_MAX];
+	for (uint64_t i = 0; i < count; ++i)
+	{
+		uint16_t length;
+		if ((size_t)(end - cursor) < sizeof(length))
+			return false;
+
+		memcpy(&length, cursor, sizeof(length));
+		cursor += sizeof(length);
+		if (length >= NAUI_PATH_MAX || (size_t)(end - cursor) < (size_t)length + sizeof(uint64_t) * 4)
+			return false;
+
+		memcpy(path, cursor, length);
+		path[length] = '\0';
+		cursor += length;
+
+		Naui_FileHashRecord record;
+		memcpy(&record.size, cursor, sizeof(record.size));
+		memcpy(&record.modified_ns, cursor + 8, sizeof(record.modified_ns));
+		memcpy(&record.inode, cursor + 16, sizeof(record.inode));
+		memcpy(&record.hash, cursor + 24, sizeof(record.hash));
+		record.is_used = false;
+		cursor += sizeof(uint64_t) * 4;
+		file_hash_cache_put(cache, path, &record);
+	}
+
+	return true;
+}
+
+bool naui_file_hash_cache_open(Naui_FileHashCache* cache, const Naui_Path path)
+{
+	memset(cache, 0, sizeof(*cache));
+	cache->_path = path;
+	cache->_lock = naui_mutex_create();
+	if (!cache->_lock)
+		return false;
+
+	Naui_FileMap map = NAUI_FILE_MAP_INIT;
+	if (path.data[0] == '\0' || !naui_file_map(&map, path, NAUI_FILE_MAP_SEQUENTIAL))
+		return true;
+
+	/* A damaged file keeps whatever parsed before the damage and is rewritten on the next save. */
+	if (!file_hash_cache_parse(cache, map.data, map.size))
+	{
+		fprintf(stderr, "[Naui] Hash cache '%s' is damaged or from another version, rebuilding it\n", path.data);
+		cache->_is_dirty = true;
+	}
+
+	naui_file_unmap(&map);
+	return true;
+}
+
+bool naui_file_hash_cached(Naui_FileHashCache* cache, const Naui_Path path, uint64_t* out_hash)
+{
+	*out_hash = 0;
+	Naui_FileStat st;
+	if (!naui_file_stat(path, &st) || st.is_directory)
+		return false;
+
+	naui_mutex_lock(cache->_lock);
+	ptrdiff_t index = naui_strmap_get_index(cache->_entries, path.data);
+	if (index >= 0)
+	{
+		Naui_FileHashRecord* record = &cache->_entries[index].value;
+		if (record->size == st.size && record->modified_ns == st.modified_ns && record->inode == st.inode)
+		{
+			record->is_used = true;
+			*out_hash = record->hash;
+			naui_mutex_unlock(cache->_lock);
+			return true;
+		}
+	}
+
+	naui_mutex_unlock(cache->_lock);
+
+	/* Keyed by the stat taken before reading, so a file written to meanwhile is hashed again next time. */
+	Naui_FileHashRecord record = { st.size, st.modified_ns, st.inode, 0, true };
+	if (!file_hash_stream(path, &record.hash))
+		return false;
+
+	naui_mutex_lock(cache->_lock);
+	file_hash_cache_put(cache, path.data, &record);
+	cache->_is_dirty = true;
+	naui_mutex_unlock(cache->_lock);
+
+	*out_hash = record.hash;
+	return true;
+}
+
+bool naui_file_hash_cache_save(Naui_FileHashCache* cache)
+{
+	if (!cache->_lock || cache->_path.data[0] == '\0')
+		return true;
+
+	naui_mutex_lock(cache->_lock);
+
+	/* From the back, deleting swaps the last entry in and that one was already looked at. */
+	for (ptrdiff_t i = naui_strmap_len(cache->_entries) - 1; i >= 0; --i)
+	{
+		if (!cache->_entries[i].value.is_used)
+		{
+			naui_strmap_del(cache->_entries, cache->_entries[i].key);
+			cache->_is_dirty = true;
+		}
+	}
+
+	if (!cache->_is_dirty)
+	{
+		naui_mutex_unlock(cache->_lock);
+		return true;
+	}
+
+	Naui_Path temp;
+	snprintf(temp.data, NAUI_PATH_MAX, "%s.tmp", cache->_path.data);
+
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	Naui_FileWriter w;
+	bool ok = naui_file_open(&fh, temp, NAUI_FILE_WRITE) && naui_file_writer_init(&w, &fh, NULL, 0);
+	if (ok)
+	{
+		uint32_t version = NAUI_FILE_HASH_VERSION;
+		uint64_t count = (uint64_t)naui_strmap_len(cache->_entries);
+		naui_file_writer_write(&w, NAUI_FILE_HASH_MAGIC, NAUI_FILE_HASH_MAGIC_SIZE);
+		naui_file_writer_write(&w, &version, sizeof(version));
+		naui_file_writer_write(&w, &count, sizeof(count));
+
+		for (uint64_t i = 0; i < count; ++i)
+		{
+			const Naui_FileHashEntry* e = &cache->_entries[i];
+			uint16_t length = (uint16_t)strlen(e->key);
+			naui_file_writer_write(&w, &length, sizeof(length));
+			naui_file_writer_write(&w, e->key, length);
+			naui_file_writer_write(&w, &e->value.size, sizeof(e->value.size));
+			naui_file_writer_write(&w, &e->value.modified_ns, sizeof(e->value.modified_ns));
+			naui_file_writer_write(&w, &e->value.inode, sizeof(e->value.inode));
+			naui_file_writer_write(&w, &e->value.hash, sizeof(e->value.hash));
+		}
+
+		ok = naui_file_writer_finish(&w);
+	}
+
+	naui_file_close(&fh);
+	ok = ok && naui_file_rename(temp, cache->_path);
+	if (ok)
+		cache->_is_dirty = false;
+	else
+		naui_file_delete(temp);
+
+	naui_mutex_unlock(cache->_lock);
+	return ok;
+}
+
+bool naui_file_hash_cache_close(Naui_FileHashCache* cache)
+{
+	bool ok = naui_file_hash_cache_save(cache);
+	naui_strmap_free(cache->_entries);
+	naui_arena_free(&cache->_names);
+	if (cache->_lock)
+		naui_mutex_destroy(cache->_lock);
+
+	memset(cache, 0, sizeof(*cache));
+	return ok;
+}
+
+#pragma endregion
+
+#pragma region Batch
+
+/* Shared by the caller and its helper jobs, freed by whoever drops the last reference. Late helpers never touch the caller's arrays. */
+typedef struct
+{
+	Naui_Mutex lock;
+	Naui_Cond idle;
+	const Naui_Path* paths;
+	uint64_t* hashes;
+	Naui_FileHashCache* cache;
+	size_t count;
+	size_t next;
+	size_t hashed;
+	int32_t busy;
+	int32_t refs;
+} File_HashBatch;
+
+static void file_hash_batch_run(File_HashBatch* batch)
+{
+	naui_mutex_lock(batch->lock);
+	while (batch->next < batch->count)
+	{
+		size_t index = batch->next++;
+		++batch->busy;
+		naui_mutex_unlock(batch->lock);
+
+		uint64_t hash;
+		bool ok = batch->cache ? naui_file_hash_cached(batch->cache, batch->paths[index], &hash) : naui_file_hash(batch->paths[index], &hash);
+		batch->hashes[index] = hash;
+
+		naui_mutex_lock(batch->lock);
+		batch->hashed += ok ? 1 : 0;
+		if (--batch->busy == 0)
+			naui_cond_broadcast(batch->idle);
+	}
+
+	naui_mutex_unlock(batch->lock);
+}
+
+static void file_hash_batch_release(File_HashBatch* batch)
+{
+	naui_mutex_lock(batch->lock);
+	bool last = --batch->refs == 0;
+	naui_mutex_unlock(batch->lock);
+	if (!last)
+		return;
+
+	naui_cond_destroy(batch->idle);
+	naui_mutex_destroy(batch->lock);
+	free(batch);
+}
+
+static void file_hash_batch_job(void* data, char* err_buf, size_t err_size)
+{
+	(void)err_buf;
+	(void)err_size;
+	File_HashBatch* batch = (File_HashBatch*)data;
+	file_hash_batch_run(batch);
+	file_hash_batch_release(batch);
+}
+
+size_t naui_file_hash_many(const Naui_Path* paths, size_t count, uint64_t* out_hashes, Naui_FileHashCache* cache)
+{
+	if (count == 0 || !paths || !out_hashes)
+		return 0;
+
+	File_HashBatch* batch = (File_HashBatch*)calloc(1, sizeof(File_HashBatch));
+	if (!batch)
+		return 0;
+
+	batch->lock = naui_mutex_create();
+	batch->idle = naui_cond_create();
+	batch->paths = paths;
+	batch->hashes = out_hashes;
+	batch->cache = cache;
+	batch->count = count;
+	batch->refs = 1;
+
+	int32_t helpers = naui_jobs_worker_count();
+	if (helpers > NAUI_FILE_HASH_HELPERS_MAX)
+		helpers = NAUI_FILE_HASH_HELPERS_MAX;
+
+	if ((size_t)helpers + 1 > count)
+		helpers = (int32_t)count - 1;
+
+	for (int32_t i = 0; i < helpers; ++i)
+	{
+		naui_mutex_lock(batch->lock);
+		++batch->refs;
+		naui_mutex_unlock(batch->lock);
+
+		Naui_JobHandle job;
+		if (naui_job_submit(&job, file_hash_batch_job, batch) != NAUI_JOB_SUBMIT_OK)
+		{
+			file_hash_batch_release(batch);
+			break;
+		}
+
+		naui_job_release(job);
+	}
+
+	file_hash_batch_run(batch);
+
+	naui_mutex_lock(batch->lock);
+	while (batch->busy > 0)
+	{
+		naui_cond_wait(batch->idle, batch->lock);
+	}
+
+	size_t hashed = batch->hashed;
+	naui_mutex_unlock(batch->lock);
+
+	file_hash_batch_release(batch);
+	return hashed;
+}
+
+#pragma endregion
@@ -0,0 +1,55 @@
+#pragma once
+
+/* A remembered hash, trusted while the file's size, modification time and inode are unchanged. */
+typedef struct Naui_FileHashRecord
+{
+	uint64_t size;
+	int64_t modified_ns;
+	uint64_t inode;
+	uint64_t hash;
+	bool is_used;
+} Naui_FileHashRecord;
+
+typedef struct
+{
+	char* key;
+	Naui_FileHashRecord value;
+} Naui_FileHashEntry;
+
+/*
+ * File hashes keyed by path, kept on disk between runs. Safe to use from several threads at once.
+ * Entries not looked up since the cache was opened are dropped when it is saved, so the file follows
+ * the working set of the last run instead of growing forever.
+ */
+typedef struct Naui_FileHashCache
+{
+	Naui_Path _path;
+	Naui_FileHashEntry* _entries;
+	Naui_Arena _names;
+	Naui_Mutex _lock;
+	bool _is_dirty;
+} Naui_FileHashCache;
+
+/* XXH64 (seed 0) of a file's contents, streamed through a fixed buffer, the same value naui_hash64 gives for the whole file. */
+bool naui_file_hash(const Naui_Path path, uint64_t* out_hash);
+
+/*
+ * Open the cache stored at `path`. A missing or unreadable file gives an empty cache, an empty path one that is
+ * never saved. Returns false only when the cache could not be set up.
+ */
+bool naui_file_hash_cache_open(Naui_FileHashCache* cache, const Naui_Path path);
+
+/* Like naui_file_hash, but a file that looks unchanged since it was last hashed is not read. */
+bool naui_file_hash_cached(Naui_FileHashCache* cache, const Naui_Path path, uint64_t* out_hash);
+
+/*
+ * Hash `count` files, spread over the job workers, through `cache` when it is not NULL.
+ * out_hashes[i] is 0 for files that could not be read. Returns how many were hashed.
+ */
+size_t naui_file_hash_many(const Naui_Path* paths, size_t count, uint64_t* out_hashes, Naui_FileHashCache* cache);
+
+/* Write the cache back if anything changed, replacing the file in one rename. */
+bool naui_file_hash_cache_save(Naui_FileHashCache* cache);
+
+/* Save, then free the cache. Returns whether the save succeeded. */
+bool naui_file_hash_cache_close(Naui_FileHashCache* cache);
@@ -37,7 +37,9 @@ enum
 {
 	NAUI_FILE_READ,
 	NAUI_FILE_WRITE,
-	NAUI_FILE_APPEND
+	NAUI_FILE_APPEND,
+	/* Created or truncated like NAUI_FILE_WRITE, and readable through the same handle. */
+	NAUI_FILE_READ_WRITE
 };
 
 #define NAUI_FILE_HANDLE_SIZE 64
@@ -48,6 +50,44 @@ typedef struct Naui_FileHandle
 
 #define NAUI_FILE_HANDLE_INIT { {0} }
 
+/* Files below this are read into a heap buffer instead, mapping them costs more than the copy. */
+#define NAUI_FILE_MAP_MIN_SIZE (64 * 1024)
+
+typedef uint8_t Naui_FileMapHint;
+enum
+{
+	NAUI_FILE_MAP_NONE = 0,
+	NAUI_FILE_MAP_SEQUENTIAL = 1 << 0,
+	NAUI_FILE_MAP_WILLNEED = 1 << 1
+};
+
+/* Read-only view of a whole file, either mapped or a heap copy. */
+typedef struct Naui_FileMap
+{
+	const uint8_t* data;
+	size_t size;
+	bool is_mapped;
+	void* _handle;
+} Naui_FileMap;
+
+#define NAUI_FILE_MAP_INIT { NULL, 0, false, NULL }
+
+/* Enough of a file's metadata to tell it changed without reading it. */
+typedef struct Naui_FileStat
+{
+	uint64_t size;
+	int64_t modified_ns;
+	uint64_t inode;
+	bool is_directory;
+} Naui_FileStat;
+
+/* One buffer of a scatter/gather transfer. */
+typedef struct Naui_FileVec
+{
+	void* data;
+	size_t size;
+} Naui_FileVec;
+
 typedef struct Naui_DirEntry
 {
 	Naui_Path path;
@@ -55,11 +95,18 @@ typedef struct Naui_DirEntry
 	size_t size;
 } Naui_DirEntry;
 
+typedef uint8_t Naui_WalkFlags;
+enum
+{
+	NAUI_WALK_DEFAULT = 0,
+	NAUI_WALK_SIZES = 1 << 0
+};
+
 /* Open a file. Returns true on success. */
 bool naui_file_open(Naui_FileHandle* handle, const Naui_Path path, Naui_FileMode mode);
 
-/* Read/write up to `size` bytes.
- * Returns bytes actually transferred. */
+/* Read/write up to `size` bytes at the current position. Unbuffered, every call reaches the OS,
+ * Naui_FileReader / Naui_FileWriter batch small transfers. Returns bytes actually transferred. */
 size_t naui_file_read(const Naui_FileHandle* handle, void* restrict buffer, size_t size);
 size_t naui_file_write(const Naui_FileHandle* handle, const void* restrict buffer, size_t size);
 
@@ -67,6 +114,19 @@ size_t naui_file_write(const Naui_FileHandle* handle, const void* restrict buffe
  * Returns false on invalid handle or seek failure. */
 bool naui_file_seek(Naui_FileHandle* handle, long offset, int origin);
 
+/* Read/write `size` bytes at `offset` without moving the file position, so one handle can serve several threads.
+ * Returns bytes actually transferred, short only at the end of the file or on error. */
+size_t naui_file_read_at(const Naui_FileHandle* handle, void* restrict buffer, size_t size, uint64_t offset);
+size_t naui_file_write_at(const Naui_FileHandle* handle, const void* restrict buffer, size_t size, uint64_t offset);
+
+/* Read/write `count` buffers in order from the current position, in one call where the platform has one.
+ * Returns bytes actually transferred across all buffers. */
+size_t naui_file_readv(const Naui_FileHandle* handle, const Naui_FileVec* vecs, size_t count);
+size_t naui_file_writev(const Naui_FileHandle* handle, const Naui_FileVec* vecs, size_t count);
+
+/* Hint that the `size` bytes after the current position are read next, so the OS starts fetching them. Advisory. */
+void naui_file_readahead(const Naui_FileHandle* handle, size_t size);
+
 /* Returns false if the handle was never opened or has been closed. */
 bool naui_file_is_valid(const Naui_FileHandle* handle);
 
@@ -75,10 +135,23 @@ void naui_file_close(Naui_FileHandle* handle);
 /* Returns file size in bytes, or 0 on error. */
 size_t naui_file_size(const Naui_Path path);
 
+/* Returns the last modification time in seconds since the Unix epoch, or 0 on error. */
+int64_t naui_file_modified_time(const Naui_Path path);
+
+/* Size, modification time in nanoseconds since the Unix epoch and inode (the file index on Windows) in one call.
+ * Returns false if the path does not exist. */
+bool naui_file_stat(const Naui_Path path, Naui_FileStat* out);
+
 /* Read entire file into a heap buffer.
  * Sets *out_size to bytes read (excludes null terminator). NULL on failure. */
 char* naui_file_read_all(const Naui_Path path, size_t* out_size);
 
+/* Map a file read-only. `hints` are advisory and ignored for heap copies.
+ * data[size] is always readable and '\0', a file whose size is a whole number of pages is read instead.
+ * Call naui_file_unmap() when done, the view is invalid afterwards. */
+bool naui_file_map(Naui_FileMap* out, const Naui_Path path, Naui_FileMapHint hints);
+void naui_file_unmap(Naui_FileMap* map);
+
 /* Write `size` bytes from `data` to path, creating or truncating the file. */
 bool naui_file_write_all(const Naui_Path path, const void* data, size_t size);
 
@@ -86,12 +159,17 @@ bool naui_file_write_all(const Naui_Path path, const void* data, size_t size);
 bool naui_file_delete(const Naui_Path path);
 bool naui_file_rename(const Naui_Path old_path, const Naui_Path new_path);
 
+/* Copy a regular file's contents, creating or truncating `dest`, and keep its modification time.
+ * The data never passes through user space where the OS can avoid it: a reflink on filesystems that
+ * share blocks (Btrfs, XFS, ReFS), otherwise an in-kernel copy. Copying a file onto itself fails. */
+bool naui_file_copy(const Naui_Path source, const Naui_Path dest);
+
 /* Hide or unhide a file. */
 Naui_Path naui_file_hide(const Naui_Path path, bool hidden);
 bool naui_file_is_hidden(const Naui_Path path);
 
-/* Returns a pointer INTO path.data at the final component. */
-const char* naui_file_filename(const Naui_Path path);
+/* Returns a pointer INTO path->data at the final component, valid as long as `path` is. */
+const char* naui_file_filename(const Naui_Path* path);
 
 /* Returns the filename without its extension, as a Naui_Path.
  * Returns an empty Naui_Path if there is no stem. */
@@ -106,11 +184,17 @@ bool naui_directory_remove(const Naui_Path path);
 bool naui_directory_remove_all(const Naui_Path path);
 bool naui_directory_rename(const Naui_Path old_path, const Naui_Path new_path);
 
+/* Copy the tree under `source` into `dest`, which is created if missing, its parent must exist.
+ * Existing files are overwritten, others in `dest` are left alone. Files are copied with naui_file_copy,
+ * spread over the job workers. Returns false if `dest` is inside `source` or any entry failed. */
+bool naui_directory_copy(const Naui_Path source, const Naui_Path dest);
+
 /* Returns a Naui_Path for a well-known directory.
  * Returns an empty Naui_Path on failure. */
 Naui_Path naui_directory_get(const Naui_Dir directory);
 
-/* List directory entries.
+/* List directory entries. `filter` is a glob pattern and `extensions` a set, compiled once into a Naui_FileFilter,
+ * case-sensitive except on Windows. Recursive listings apply them to files only.
  * Returns a Naui_List(Naui_DirEntry). Call naui_directory_filter_free() when done. */
 Naui_List(Naui_DirEntry) naui_directory_filter(const Naui_Path path, const char* filter, const char** extensions, int ext_count);
 
@@ -118,6 +202,11 @@ Naui_List(Naui_DirEntry) naui_directory_filter(const Naui_Path path, const char*
  * Returns a Naui_List(Naui_DirEntry). Call naui_directory_filter_free() when done. */
 Naui_List(Naui_DirEntry) naui_directory_filter_recursive(const Naui_Path path, const char* filter, const char** extensions, int ext_count);
 
+/* Same listing and order as naui_directory_filter_recursive, with subdirectories spread over the job workers.
+ * File sizes are left at 0 unless NAUI_WALK_SIZES is set, which saves a stat per file.
+ * Returns a Naui_List(Naui_DirEntry). Call naui_directory_filter_free() when done. */
+Naui_List(Naui_DirEntry) naui_directory_walk(const Naui_Path path, const char* filter, const char** extensions, int ext_count, Naui_WalkFlags flags);
+
 /* Frees the list returned by naui_directory_filter. */
 void naui_directory_filter_free(Naui_List(Naui_DirEntry) list);
 
@@ -126,6 +215,9 @@ bool naui_path_set_current(const Naui_Path current_directory);
 /* Returns true if the path exists on the filesystem. */
 bool naui_path_exists(const Naui_Path path);
 
+/* Returns true if the path exists and is a directory. */
+bool naui_path_is_directory(const Naui_Path path);
+
 /* Returns true is the path is empty. */
 bool naui_path_is_empty(const Naui_Path path);
 
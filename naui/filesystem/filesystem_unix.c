@@ -1,5 +1,15 @@
 #if !defined(_WIN32) && !defined(_WIN64)
 
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+#endif
+
 #define NAUI_LOCK_MAX 32
 typedef struct
 {
@@ -33,100 +43,364 @@ static bool is_separator(char c)
 	return c == '/';
 }
 
-typedef struct { FILE* fp; } Naui_FileInternal;
+/* A raw descriptor, buffering is left to Naui_FileReader / Naui_FileWriter. Zeroed means closed, so the fd is kept + 1. */
+typedef struct { int fd_plus_one; } Naui_FileInternal;
 
 static Naui_FileInternal* file_internal(const Naui_FileHandle* handle)
 {
 	return (Naui_FileInternal*)(void*)handle->_opaque;
 }
 
-static bool match_filter(const char* name, const char* filter)
-{
-	if (!filter || filter[0] == '\0')
-		return true;
+#pragma region Walk
 
-	const char* star = strchr(filter, '*');
-	if (!star)
-		return strcmp(name, filter) == 0;
+/* Most job workers the walker recruits, past this the directory reads contend more than they overlap. */
+#define NAUI_WALK_HELPERS_MAX 8
 
-	size_t prefix_len = (size_t)(star - filter);
-	if (strncmp(name, filter, prefix_len) != 0)
-		return false;
+typedef struct
+{
+	uint32_t name;
+	uint32_t length;
+	bool is_directory;
+	size_t size;
+	int32_t child;
+} Walk_Item;
+
+/* One directory, filled in by whichever thread reads it. Items point into `names`. */
+typedef struct
+{
+	char* path;
+	Naui_List(Walk_Item) items;
+	char* names;
+	size_t names_size;
+	size_t names_capacity;
+} Walk_Dir;
+
+/* Shared by the caller and its helper jobs, freed by whoever drops the last reference. */
+typedef struct
+{
+	Naui_Mutex lock;
+	Naui_Cond wake;
+	Naui_List(Walk_Dir*) dirs;
+	Naui_List(int32_t) pending;
+	int32_t busy;
+	int32_t refs;
+	bool done;
+
+	Naui_FileFilter filter;
+	size_t root_length;
+	Naui_WalkFlags flags;
+} Walk_State;
+
+static Walk_Dir* walk_dir_create(const char* parent, const char* name, size_t length)
+{
+	Walk_Dir* dir = (Walk_Dir*)calloc(1, sizeof(Walk_Dir));
+	size_t parent_len = strlen(parent);
+	dir->path = (char*)malloc(parent_len + length + 2);
+	memcpy(dir->path, parent, parent_len);
+	if (name)
+	{
+		dir->path[parent_len++] = '/';
+		memcpy(dir->path + parent_len, name, length);
+		parent_len += length;
+	}
 
-	const char* suffix = star + 1;
-	size_t suffix_len = strlen(suffix);
-	size_t name_len = strlen(name);
-	if (suffix_len > name_len - prefix_len)
-		return false;
+	dir->path[parent_len] = '\0';
+	return dir;
+}
 
-	return strcmp(name + name_len - suffix_len, suffix) == 0;
+static void walk_dir_free(Walk_Dir* dir)
+{
+	naui_list_free(dir->items);
+	free(dir->names);
+	free(dir->path);
+	free(dir);
 }
 
-static bool match_extensions(const char* name, const char** exts, int ext_count)
+static bool walk_add(Walk_Dir* dir, const char* name, bool is_directory, size_t size)
 {
-	if (ext_count <= 0 || !exts)
-		return true;
+	size_t length = strlen(name);
+	if (dir->names_size + length + 1 > dir->names_capacity)
+	{
+		size_t capacity = dir->names_capacity ? dir->names_capacity * 2 : 1024;
+		while (capacity < dir->names_size + length + 1)
+			capacity *= 2;
 
-	const char* dot = strrchr(name, '.');
-	if (!dot)
-		return false;
+		char* names = (char*)realloc(dir->names, capacity);
+		if (!names)
+			return false;
 
-	for (int i = 0; i < ext_count; ++i)
-	{
-		if (exts[i] && strcmp(dot, exts[i]) == 0)
-			return true;
+		dir->names = names;
+		dir->names_capacity = capacity;
 	}
 
-	return false;
+	Walk_Item item;
+	item.name = (uint32_t)dir->names_size;
+	item.length = (uint32_t)length;
+	item.is_directory = is_directory;
+	item.size = size;
+	item.child = -1;
+	memcpy(dir->names + dir->names_size, name, length + 1);
+	dir->names_size += length + 1;
+	naui_list_push(dir->items, item);
+	return true;
 }
 
-static void filter_recursive_impl(const char* path, const char* filter, const char** extensions, int ext_count, Naui_List(Naui_DirEntry)* list)
+/* A path pattern is matched against the path below the walked folder, anything else against the name. */
+static bool walk_match(const Walk_State* state, const Walk_Dir* dir, const char* name, size_t length)
 {
-	DIR* dir = opendir(path);
-	if (!dir)
-		return;
+	if (!state->filter.is_path)
+		return naui_file_filter_match(&state->filter, name, length);
+
+	char relative[NAUI_PATH_MAX];
+	const char* parent = dir->path + state->root_length;
+	parent += parent[0] == '/';
+	int written = snprintf(relative, sizeof(relative), parent[0] ? "%s/%s" : "%s%s", parent, name);
+	return written > 0 && (size_t)written < sizeof(relative) && naui_file_filter_match(&state->filter, relative, (size_t)written);
+}
 
+/* Read one directory. d_type settles most entries, fstatat on the open directory covers the rest and the sizes. */
+static bool walk_read(Walk_State* state, Walk_Dir* dir)
+{
+	int fd = open(dir->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	DIR* handle = fdopendir(fd);
+	if (!handle)
+	{
+		close(fd);
+		return false;
+	}
+
+	bool sizes = (state->flags & NAUI_WALK_SIZES) != 0;
+	bool is_open = naui_file_filter_is_open(&state->filter);
+	int32_t subdirs = 0;
 	struct dirent* entry;
-	while ((entry = readdir(dir)) != NULL)
+	while ((entry = readdir(handle)) != NULL)
 	{
-		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+		const char* name = entry->d_name;
+		if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
 			continue;
 
-		char child[NAUI_PATH_MAX];
-		snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+		bool is_directory = false;
+		bool known = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+		if (entry->d_type == DT_DIR || entry->d_type == DT_REG)
+		{
+			is_directory = entry->d_type == DT_DIR;
+			known = true;
+		}
+#endif
 
-		struct stat st;
-		if (stat(child, &st) != 0)
+		if (known && !is_directory && !is_open && !walk_match(state, dir, name, strlen(name)))
 			continue;
 
-		if (S_ISDIR(st.st_mode))
+		size_t size = 0;
+		if (!known || (!is_directory && sizes))
 		{
-			Naui_DirEntry de;
-			de.path = path_from(child);
-			de.is_directory = true;
-			de.size = 0;
-			naui_list_push(*list, de);
-			filter_recursive_impl(child, filter, extensions, ext_count, list);
-		}
-		else
-		{
-			if (!match_filter(entry->d_name, filter))
+			/* Follows symlinks, like stat on the full path did. */
+			struct stat st;
+			if (fstatat(fd, name, &st, 0) != 0)
 				continue;
 
-			if (!match_extensions(entry->d_name, extensions, ext_count))
+			is_directory = S_ISDIR(st.st_mode);
+			size = is_directory ? 0 : (size_t)st.st_size;
+			if (!known && !is_directory && !is_open && !walk_match(state, dir, name, strlen(name)))
 				continue;
+		}
+
+		if (walk_add(dir, name, is_directory, size) && is_directory)
+			++subdirs;
+	}
+
+	closedir(handle);
+	if (subdirs == 0)
+		return true;
+
+	/* Children are created outside the lock, then queued in one go. */
+	Walk_Dir** children = (Walk_Dir**)malloc((size_t)subdirs * sizeof(Walk_Dir*));
+	int32_t count = 0;
+	for (size_t i = 0; children && i < (size_t)naui_list_len(dir->items); ++i)
+	{
+		Walk_Item* item = &dir->items[i];
+		if (item->is_directory)
+			children[count++] = walk_dir_create(dir->path, dir->names + item->name, item->length);
+	}
+
+	naui_mutex_lock(state->lock);
+	count = 0;
+	for (size_t i = 0; children && i < (size_t)naui_list_len(dir->items); ++i)
+	{
+		Walk_Item* item = &dir->items[i];
+		if (!item->is_directory)
+			continue;
+
+		item->child = (int32_t)naui_list_len(state->dirs);
+		naui_list_push(state->dirs, children[count++]);
+		naui_list_push(state->pending, item->child);
+	}
+
+	naui_cond_broadcast(state->wake);
+	naui_mutex_unlock(state->lock);
+	free(children);
+	return true;
+}
+
+/* Take directories off the shared stack until it is empty and nobody is still reading one. */
+static void walk_run(Walk_State* state)
+{
+	naui_mutex_lock(state->lock);
+	for (;;)
+	{
+		while (!state->done && naui_list_len(state->pending) == 0)
+		{
+			if (state->busy == 0)
+			{
+				state->done = true;
+				naui_cond_broadcast(state->wake);
+				break;
+			}
 
-			Naui_DirEntry de;
-			de.path = path_from(child);
-			de.is_directory = false;
-			de.size = (size_t)st.st_size;
-			naui_list_push(*list, de);
+			naui_cond_wait(state->wake, state->lock);
 		}
+
+		if (state->done)
+			break;
+
+		Walk_Dir* dir = state->dirs[naui_list_pop(state->pending)];
+		++state->busy;
+		naui_mutex_unlock(state->lock);
+
+		walk_read(state, dir);
+
+		naui_mutex_lock(state->lock);
+		--state->busy;
 	}
 
-	closedir(dir);
+	naui_mutex_unlock(state->lock);
+}
+
+static void walk_release(Walk_State* state)
+{
+	naui_mutex_lock(state->lock);
+	bool last = --state->refs == 0;
+	naui_mutex_unlock(state->lock);
+	if (!last)
+		return;
+
+	for (size_t i = 0; i < (size_t)naui_list_len(state->dirs); ++i)
+	{
+		walk_dir_free(state->dirs[i]);
+	}
+
+	naui_list_free(state->dirs);
+	naui_list_free(state->pending);
+	naui_file_filter_free(&state->filter);
+	naui_cond_destroy(state->wake);
+	naui_mutex_destroy(state->lock);
+	free(state);
+}
+
+/* Helpers never hold the caller up: once the walk is done a late one just drops its reference. */
+static void walk_job(void* data, char* err_buf, size_t err_size)
+{
+	(void)err_buf;
+	(void)err_size;
+	Walk_State* state = (Walk_State*)data;
+	walk_run(state);
+	walk_release(state);
+}
+
+/* Depth-first, each directory followed by its contents, the order the recursive listing always had. */
+static void walk_flatten(const Walk_State* state, const Walk_Dir* dir, Naui_List(Naui_DirEntry)* list)
+{
+	size_t path_len = strlen(dir->path);
+	for (size_t i = 0; i < (size_t)naui_list_len(dir->items); ++i)
+	{
+		const Walk_Item* item = &dir->items[i];
+		if (path_len + item->length + 2 > NAUI_PATH_MAX)
+			continue;
+
+		Naui_DirEntry de;
+		memcpy(de.path.data, dir->path, path_len);
+		de.path.data[path_len] = '/';
+		memcpy(de.path.data + path_len + 1, dir->names + item->name, item->length + 1);
+		de.is_directory = item->is_directory;
+		de.size = item->size;
+		naui_list_push(*list, de);
+
+		if (item->child >= 0)
+			walk_flatten(state, state->dirs[item->child], list);
+	}
+}
+
+static void walk_flatten_listing(const Walk_State* state, const Walk_Dir* dir, uint32_t parent, Naui_DirListing* listing)
+{
+	for (size_t i = 0; i < (size_t)naui_list_len(dir->items); ++i)
+	{
+		const Walk_Item* item = &dir->items[i];
+		uint32_t index = listing_add(listing, parent, dir->names + item->name, item->length, item->is_directory, item->size);
+		if (index != UINT32_MAX && item->child >= 0)
+			walk_flatten_listing(state, state->dirs[item->child], index, listing);
+	}
+}
+
+/* Walk the whole tree. Returns the state with the caller's reference, or NULL when the folder cannot be read. */
+static Walk_State* walk_collect(const Naui_Path path, const char* filter, const char** extensions, int ext_count, Naui_WalkFlags flags)
+{
+	if (path.data[0] == '\0')
+		return NULL;
+
+	Walk_State* state = (Walk_State*)calloc(1, sizeof(Walk_State));
+	if (!state)
+		return NULL;
+
+	state->lock = naui_mutex_create();
+	state->wake = naui_cond_create();
+	state->refs = 1;
+	state->root_length = strlen(path.data);
+	state->flags = flags;
+	naui_file_filter_init(&state->filter, filter, extensions, ext_count, true);
+
+	Walk_Dir* root = walk_dir_create(path.data, NULL, 0);
+	naui_list_push(state->dirs, root);
+
+	/* The root tells whether there is anything worth fanning out. */
+	if (!walk_read(state, root))
+	{
+		walk_release(state);
+		return NULL;
+	}
+
+	int32_t helpers = naui_jobs_worker_count();
+	if (helpers > NAUI_WALK_HELPERS_MAX)
+		helpers = NAUI_WALK_HELPERS_MAX;
+
+	if (helpers > (int32_t)naui_list_len(state->pending))
+		helpers = (int32_t)naui_list_len(state->pending);
+
+	for (int32_t i = 0; i < helpers; ++i)
+	{
+		naui_mutex_lock(state->lock);
+		++state->refs;
+		naui_mutex_unlock(state->lock);
+
+		Naui_JobHandle job;
+		if (naui_job_submit(&job, walk_job, state) != NAUI_JOB_SUBMIT_OK)
+		{
+			walk_release(state);
+			break;
+		}
+
+		naui_job_release(job);
+	}
+
+	walk_run(state);
+	return state;
 }
 
+#pragma endregion
+
 static void resolve_lock_target(const char* path, char* out)
 {
 	struct stat st;
@@ -136,90 +410,209 @@ static void resolve_lock_target(const char* path, char* out)
 		snprintf(out, NAUI_PATH_MAX, "%s", path);
 }
 
+static int file_fd(const Naui_FileHandle* handle)
+{
+	return handle ? file_internal(handle)->fd_plus_one - 1 : -1;
+}
+
 bool naui_file_open(Naui_FileHandle* handle, const Naui_Path path, Naui_FileMode mode)
 {
 	if (!handle)
 		return false;
 
-	const char* m;
+	int flags;
 	switch (mode)
 	{
 		case NAUI_FILE_READ:
-			m = "rb";
+			flags = O_RDONLY;
 			break;
 
 		case NAUI_FILE_WRITE:
-			m = "wb";
+			flags = O_WRONLY | O_CREAT | O_TRUNC;
 			break;
 
 		case NAUI_FILE_APPEND:
-			m = "ab";
+			flags = O_WRONLY | O_CREAT | O_APPEND;
+			break;
+
+		case NAUI_FILE_READ_WRITE:
+			flags = O_RDWR | O_CREAT | O_TRUNC;
 			break;
 
 		default:
 			return false;
 	}
 
-	Naui_FileInternal* fi = file_internal(handle);
-	fi->fp = fopen(path.data, m);
-	return fi->fp != NULL;
+	int fd = open(path.data, flags | O_CLOEXEC, 0666);
+	file_internal(handle)->fd_plus_one = fd + 1;
+	return fd >= 0;
+}
+
+/* read/write/pread/pwrite until `size` bytes moved, the end of the file or an error. */
+static size_t file_transfer(int fd, void* buffer, size_t size, bool is_write, bool is_positional, uint64_t offset)
+{
+	size_t total = 0;
+	while (total < size)
+	{
+		uint8_t* at = (uint8_t*)buffer + total;
+		size_t want = size - total > (size_t)SSIZE_MAX ? (size_t)SSIZE_MAX : size - total;
+		off_t position = (off_t)(offset + total);
+		ssize_t n;
+		if (is_write)
+			n = is_positional ? pwrite(fd, at, want, position) : write(fd, at, want);
+		else
+			n = is_positional ? pread(fd, at, want, position) : read(fd, at, want);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+
+		if (n <= 0)
+			break;
+
+		total += (size_t)n;
+	}
+
+	return total;
 }
 
 size_t naui_file_read(const Naui_FileHandle* handle, void* restrict buffer, size_t size)
 {
-	if (!handle || !buffer)
+	int fd = file_fd(handle);
+	if (fd < 0 || !buffer)
 		return 0;
 
-	Naui_FileInternal* fi = file_internal(handle);
-	if (!fi->fp)
+	return file_transfer(fd, buffer, size, false, false, 0);
+}
+
+size_t naui_file_write(const Naui_FileHandle* handle, const void* restrict buffer, size_t size)
+{
+	int fd = file_fd(handle);
+	if (fd < 0 || !buffer)
 		return 0;
 
-	return fread(buffer, 1, size, fi->fp);
+	return file_transfer(fd, (void*)buffer, size, true, false, 0);
 }
 
-size_t naui_file_write(const Naui_FileHandle* handle, const void* restrict buffer, size_t size)
+size_t naui_file_read_at(const Naui_FileHandle* handle, void* restrict buffer, size_t size, uint64_t offset)
 {
-	if (!handle || !buffer)
+	int fd = file_fd(handle);
+	if (fd < 0 || !buffer)
 		return 0;
 
-	Naui_FileInternal* fi = file_internal(handle);
-	if (!fi->fp)
+	return file_transfer(fd, buffer, size, false, true, offset);
+}
+
+size_t naui_file_write_at(const Naui_FileHandle* handle, const void* restrict buffer, size_t size, uint64_t offset)
+{
+	int fd = file_fd(handle);
+	if (fd < 0 || !buffer)
 		return 0;
 
-	return fwrite(buffer, 1, size, fi->fp);
+	return file_transfer(fd, (void*)buffer, size, true, true, offset);
 }
 
-bool naui_file_seek(Naui_FileHandle* handle, long offset, int origin)
+#ifndef IOV_MAX
+#define IOV_MAX 16
+#endif
+
+/* readv/writev in slices of IOV_MAX, picking up after a short transfer until everything moved or the file ends. */
+static size_t file_transfer_vec(int fd, const Naui_FileVec* vecs, size_t count, bool is_write)
 {
-	if (!handle)
-		return false;
+	struct iovec iov[64];
+	size_t total = 0;
+	size_t first = 0;
+	size_t skip = 0;
+	while (first < count)
+	{
+		int n = 0;
+		for (size_t i = first; i < count && n < (int)(sizeof(iov) / sizeof(iov[0])) && n < IOV_MAX; ++i)
+		{
+			size_t from = i == first ? skip : 0;
+			iov[n].iov_base = (uint8_t*)vecs[i].data + from;
+			iov[n].iov_len = vecs[i].size - from;
+			++n;
+		}
 
-	Naui_FileInternal* fi = file_internal(handle);
-	if (!fi->fp)
-		return false;
+		ssize_t got = is_write ? writev(fd, iov, n) : readv(fd, iov, n);
+		if (got < 0 && errno == EINTR)
+			continue;
+
+		if (got < 0)
+			break;
+
+		total += (size_t)got;
+		size_t left = (size_t)got;
+		bool is_empty = left == 0;
+		while (first < count && left >= vecs[first].size - skip)
+		{
+			left -= vecs[first].size - skip;
+			skip = 0;
+			++first;
+		}
+
+		skip += left;
+
+		/* Nothing moved while buffers with room remain: the end of the file. */
+		if (is_empty && first < count)
+			break;
+	}
 
-	return fseek(fi->fp, offset, origin) == 0;
+	return total;
 }
 
-bool naui_file_is_valid(const Naui_FileHandle* handle)
+size_t naui_file_readv(const Naui_FileHandle* handle, const Naui_FileVec* vecs, size_t count)
 {
-	if (!handle)
+	int fd = file_fd(handle);
+	if (fd < 0 || (!vecs && count))
+		return 0;
+
+	return file_transfer_vec(fd, vecs, count, false);
+}
+
+size_t naui_file_writev(const Naui_FileHandle* handle, const Naui_FileVec* vecs, size_t count)
+{
+	int fd = file_fd(handle);
+	if (fd < 0 || (!vecs && count))
+		return 0;
+
+	return file_transfer_vec(fd, vecs, count, true);
+}
+
+void naui_file_readahead(const Naui_FileHandle* handle, size_t size)
+{
+	int fd = file_fd(handle);
+	if (fd < 0 || size == 0)
+		return;
+
+#if defined(POSIX_FADV_WILLNEED)
+	off_t position = lseek(fd, 0, SEEK_CUR);
+	if (position >= 0)
+		posix_fadvise(fd, position, (off_t)size, POSIX_FADV_WILLNEED);
+#endif
+}
+
+bool naui_file_seek(Naui_FileHandle* handle, long offset, int origin)
+{
+	int fd = file_fd(handle);
+	if (fd < 0)
 		return false;
 
-	return file_internal(handle)->fp != NULL;
+	return lseek(fd, (off_t)offset, origin) >= 0;
+}
+
+bool naui_file_is_valid(const Naui_FileHandle* handle)
+{
+	return file_fd(handle) >= 0;
 }
 
 void naui_file_close(Naui_FileHandle* handle)
 {
-	if (!handle)
+	int fd = file_fd(handle);
+	if (fd < 0)
 		return;
 
-	Naui_FileInternal* fi = file_internal(handle);
-	if (fi->fp)
-	{
-		fclose(fi->fp);
-		fi->fp = NULL;
-	}
+	close(fd);
+	file_internal(handle)->fd_plus_one = 0;
 }
 
 size_t naui_file_size(const Naui_Path path)
@@ -231,6 +624,34 @@ size_t naui_file_size(const Naui_Path path)
 	return (size_t)st.st_size;
 }
 
+int64_t naui_file_modified_time(const Naui_Path path)
+{
+	struct stat st;
+	if (stat(path.data, &st) != 0)
+		return 0;
+
+	return (int64_t)st.st_mtime;
+}
+
+bool naui_file_stat(const Naui_Path path, Naui_FileStat* out)
+{
+	struct stat st;
+	memset(out, 0, sizeof(*out));
+	if (stat(path.data, &st) != 0)
+		return false;
+
+#if defined(__APPLE__)
+	struct timespec modified = st.st_mtimespec;
+#else
+	struct timespec modified = st.st_mtim;
+#endif
+	out->size = (uint64_t)st.st_size;
+	out->modified_ns = (int64_t)modified.tv_sec * 1000000000ll + modified.tv_nsec;
+	out->inode = (uint64_t)st.st_ino;
+	out->is_directory = S_ISDIR(st.st_mode);
+	return true;
+}
+
 char* naui_file_read_all(const Naui_Path path, size_t* out_size)
 {
 	FILE* fp = fopen(path.data, "rb");
@@ -264,6 +685,92 @@ char* naui_file_read_all(const Naui_Path path, size_t* out_size)
 	return buf;
 }
 
+/* Small files and page multiples are copied, so the view always ends in a readable '\0'. */
+static bool file_map_read(Naui_FileMap* out, int fd, size_t size)
+{
+	char* buf = (char*)malloc(size + 1);
+	if (!buf)
+		return false;
+
+	size_t total = 0;
+	while (total < size)
+	{
+		ssize_t got = read(fd, buf + total, size - total);
+		if (got < 0 && errno == EINTR)
+			continue;
+
+		if (got <= 0)
+			break;
+
+		total += (size_t)got;
+	}
+
+	buf[total] = '\0';
+	out->data = (const uint8_t*)buf;
+	out->size = total;
+	return true;
+}
+
+bool naui_file_map(Naui_FileMap* out, const Naui_Path path, Naui_FileMapHint hints)
+{
+	memset(out, 0, sizeof(*out));
+
+	int fd = open(path.data, O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < 0 || (uint64_t)st.st_size >= (uint64_t)SIZE_MAX)
+	{
+		close(fd);
+		return false;
+	}
+
+	size_t size = (size_t)st.st_size;
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	if (size < NAUI_FILE_MAP_MIN_SIZE || (page && size % page == 0))
+	{
+		bool ok = file_map_read(out, fd, size);
+		close(fd);
+		return ok;
+	}
+
+	void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED)
+	{
+		bool ok = file_map_read(out, fd, size);
+		close(fd);
+		return ok;
+	}
+
+	close(fd);
+
+#if defined(MADV_SEQUENTIAL) && defined(MADV_WILLNEED)
+	if (hints & NAUI_FILE_MAP_SEQUENTIAL)
+		madvise(data, size, MADV_SEQUENTIAL);
+
+	if (hints & NAUI_FILE_MAP_WILLNEED)
+		madvise(data, size, MADV_WILLNEED);
+#else
+	(void)hints;
+#endif
+
+	out->data = (const uint8_t*)data;
+	out->size = size;
+	out->is_mapped = true;
+	return true;
+}
+
+void naui_file_unmap(Naui_FileMap* map)
+{
+	if (map->is_mapped)
+		munmap((void*)map->data, map->size);
+	else
+		free((void*)map->data);
+
+	memset(map, 0, sizeof(*map));
+}
+
 bool naui_file_write_all(const Naui_Path path, const void* data, size_t size)
 {
 	if (!data)
@@ -288,9 +795,117 @@ bool naui_file_rename(const Naui_Path old_path, const Naui_Path new_path)
 	return rename(old_path.data, new_path.data) == 0;
 }
 
+/*
+ * Moves up to `size` bytes without them passing through user space: a reflink shares the blocks outright,
+ * copy_file_range and sendfile copy inside the kernel. Each step falls through to the next when the
+ * filesystem cannot do it. Returns bytes copied, both file positions are past them.
+ */
+static uint64_t file_copy_kernel(int in, int out, uint64_t size)
+{
+	uint64_t done = 0;
+#if defined(__linux__)
+	if (size > 0 && ioctl(out, FICLONE, in) == 0)
+	{
+		lseek(in, (off_t)size, SEEK_SET);
+		lseek(out, (off_t)size, SEEK_SET);
+		return size;
+	}
+
+#ifdef __NR_copy_file_range
+	while (done < size)
+	{
+		size_t want = size - done > (1u << 30) ? (1u << 30) : (size_t)(size - done);
+		long n = syscall(__NR_copy_file_range, in, NULL, out, NULL, want, 0);
+		if (n < 0 && errno == EINTR)
+			continue;
+
+		if (n <= 0)
+			break;
+
+		done += (uint64_t)n;
+	}
+#endif
+
+	while (done < size)
+	{
+		size_t want = size - done > (1u << 30) ? (1u << 30) : (size_t)(size - done);
+		ssize_t n = sendfile(out, in, NULL, want);
+		if (n < 0 && errno == EINTR)
+			continue;
+
+		if (n <= 0)
+			break;
+
+		done += (uint64_t)n;
+	}
+#else
+	(void)in;
+	(void)out;
+	(void)size;
+#endif
+	return done;
+}
+
+bool naui_file_copy(const Naui_Path source, const Naui_Path dest)
+{
+	int in = open(source.data, O_RDONLY | O_CLOEXEC);
+	if (in < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(in, &st) != 0 || !S_ISREG(st.st_mode))
+	{
+		close(in);
+		return false;
+	}
+
+	/* Truncated only once it is known not to be the source itself. */
+	int out = open(dest.data, O_WRONLY | O_CREAT | O_CLOEXEC, st.st_mode & 0777);
+	struct stat dst;
+	bool is_other = out >= 0 && fstat(out, &dst) == 0 && !(dst.st_dev == st.st_dev && dst.st_ino == st.st_ino);
+	bool is_truncated = is_other && (dst.st_size == 0 || ftruncate(out, 0) == 0);
+	bool ok = is_truncated;
+
+	if (ok)
+	{
+		file_copy_kernel(in, out, (uint64_t)st.st_size);
+
+		/* Whatever the kernel could not copy, or what the file grew by meanwhile. */
+		uint8_t chunk[64 * 1024];
+		size_t n;
+		while (ok && (n = file_transfer(in, chunk, sizeof(chunk), false, false, 0)) > 0)
+		{
+			ok = file_transfer(out, chunk, n, true, false, 0) == n;
+		}
+	}
+
+	if (ok)
+	{
+		struct timespec times[2];
+		times[0].tv_sec = 0;
+		times[0].tv_nsec = UTIME_OMIT;
+#if defined(__APPLE__)
+		times[1] = st.st_mtimespec;
+#else
+		times[1] = st.st_mtim;
+#endif
+		futimens(out, times);
+	}
+
+	close(in);
+	if (out >= 0)
+	{
+		close(out);
+		if (!ok && is_truncated)
+			unlink(dest.data);
+	}
+
+	return ok;
+}
+
 Naui_Path naui_file_hide(const Naui_Path path, bool hidden)
 {
-	const char* filename = naui_file_filename(path);
+	const char* filename = naui_file_filename(&path);
 	bool currently_hidden = (filename[0] == '.');
 	if (currently_hidden == hidden)
 		return path;
@@ -310,13 +925,13 @@ Naui_Path naui_file_hide(const Naui_Path path, bool hidden)
 
 bool naui_file_is_hidden(const Naui_Path path)
 {
-	const char* filename = naui_file_filename(path);
+	const char* filename = naui_file_filename(&path);
 	return filename[0] == '.';
 }
 
-const char* naui_file_filename(const Naui_Path path)
+const char* naui_file_filename(const Naui_Path* path)
 {
-	const char* data = path.data;
+	const char* data = path->data;
 	const char* last = NULL;
 	for (const char* p = data; *p; ++p)
 	{
@@ -329,7 +944,7 @@ const char* naui_file_filename(const Naui_Path path)
 
 Naui_Path naui_file_stem(const Naui_Path path)
 {
-	const char* filename = naui_file_filename(path);
+	const char* filename = naui_file_filename(&path);
 	const char* dot = strrchr(filename, '.');
 	if (!dot || dot == filename)
 		return path_from(filename);
@@ -346,7 +961,7 @@ Naui_Path naui_file_stem(const Naui_Path path)
 
 Naui_Path naui_file_extension(const Naui_Path path)
 {
-	const char* filename = naui_file_filename(path);
+	const char* filename = naui_file_filename(&path);
 	const char* dot = strrchr(filename, '.');
 	if (!dot || dot == filename)
 		return path_empty();
@@ -396,17 +1011,40 @@ bool naui_directory_remove_all(const Naui_Path path)
 	return remove_all_recursive(path.data);
 }
 
-Naui_List(Naui_DirEntry) naui_directory_filter_recursive(const Naui_Path path, const char* filter, const char** extensions, int ext_count)
+Naui_List(Naui_DirEntry) naui_directory_walk(const Naui_Path path, const char* filter, const char** extensions, int ext_count, Naui_WalkFlags flags)
 {
 	Naui_List(Naui_DirEntry) list = NULL;
-
-	if (path.data[0] == '\0')
+	Walk_State* state = walk_collect(path, filter, extensions, ext_count, flags);
+	if (!state)
 		return list;
 
-	filter_recursive_impl(path.data, filter, extensions, ext_count, &list);
+	walk_flatten(state, state->dirs[0], &list);
+	walk_release(state);
 	return list;
 }
 
+bool naui_directory_list(Naui_DirListing* out, const Naui_Path path, const char* filter, const char** extensions, int ext_count, Naui_WalkFlags flags)
+{
+	if (!listing_begin(out, path.data))
+		return false;
+
+	Walk_State* state = walk_collect(path, filter, extensions, ext_count, flags);
+	if (!state)
+	{
+		naui_dir_listing_free(out);
+		return false;
+	}
+
+	walk_flatten_listing(state, state->dirs[0], NAUI_DIR_LISTING_ROOT, out);
+	walk_release(state);
+	return true;
+}
+
+Naui_List(Naui_DirEntry) naui_directory_filter_recursive(const Naui_Path path, const char* filter, const char** extensions, int ext_count)
+{
+	return naui_directory_walk(path, filter, extensions, ext_count, NAUI_WALK_SIZES);
+}
+
 bool naui_directory_rename(const Naui_Path old_path, const Naui_Path new_path)
 {
 	return naui_file_rename(old_path, new_path);
@@ -528,16 +1166,16 @@ Naui_List(Naui_DirEntry) naui_directory_filter(const Naui_Path path, const char*
 	if (!dir)
 		return list;
 
+	Naui_FileFilter match;
+	naui_file_filter_init(&match, filter, extensions, ext_count, true);
+
 	struct dirent* entry;
 	while ((entry = readdir(dir)) != NULL)
 	{
 		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
 			continue;
 
-		if (!match_filter(entry->d_name, filter))
-			continue;
-
-		if (!match_extensions(entry->d_name, extensions, ext_count))
+		if (!naui_file_filter_match(&match, entry->d_name, strlen(entry->d_name)))
 			continue;
 
 		char child[NAUI_PATH_MAX];
@@ -553,6 +1191,7 @@ Naui_List(Naui_DirEntry) naui_directory_filter(const Naui_Path path, const char*
 		naui_list_push(list, de);
 	}
 
+	naui_file_filter_free(&match);
 	closedir(dir);
 	return list;
 }
@@ -581,6 +1220,12 @@ bool naui_path_exists(const Naui_Path path)
 	return stat(path.data, &st) == 0;
 }
 
+bool naui_path_is_directory(const Naui_Path path)
+{
+	struct stat st;
+	return stat(path.data, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
 bool naui_path_is_empty(const Naui_Path path)
 {
 	return path.data[0] == '\0';
@@ -760,7 +1405,7 @@ Naui_Path naui_path_weakly_canonical(const Naui_Path path)
 	while (existing.data[0] != '\0' && !naui_path_exists(existing))
 	{
 		Naui_Path parent = naui_path_parent(existing);
-		Naui_Path segment = path_from(naui_file_filename(existing));
+		Naui_Path segment = path_from(naui_file_filename(&existing));
 
 		if (tail.data[0] != '\0')
 		{
@@ -54,47 +54,14 @@ static Naui_FileInternal* file_internal(const Naui_FileHandle* handle)
 	return (Naui_FileInternal*)(void*)handle->_opaque;
 }
 
-static bool match_filter(const char* name, const char* filter)
+/* A path pattern sees `child` below the listed folder, anything else just the name. */
+static bool match_entry(const Naui_FileFilter* match, const char* child, size_t root_length, const char* name)
 {
-	if (!filter || filter[0] == '\0')
-		return true;
-
-	const char* star = strchr(filter, '*');
-	if (!star)
-		return _stricmp(name, filter) == 0;
-
-	size_t prefix_len = (size_t)(star - filter);
-	if (_strnicmp(name, filter, prefix_len) != 0)
-		return false;
-
-	const char* suffix = star + 1;
-	size_t suffix_len = strlen(suffix);
-	size_t name_len = strlen(name);
-	if (suffix_len > name_len - prefix_len)
-		return false;
-
-	return _stricmp(name + name_len - suffix_len, suffix) == 0;
+	const char* subject = match->is_path ? child + root_length + 1 : name;
+	return naui_file_filter_match(match, subject, strlen(subject));
 }
 
-static bool match_extensions(const char* name, const char** exts, int ext_count)
-{
-	if (ext_count <= 0 || !exts)
-		return true;
-
-	const char* dot = strrchr(name, '.');
-	if (!dot)
-		return false;
-
-	for (int i = 0; i < ext_count; ++i)
-	{
-		if (exts[i] && _stricmp(dot, exts[i]) == 0)
-			return true;
-	}
-
-	return false;
-}
-
-static void filter_recursive_impl_w(const char* path, const char* filter, const char** extensions, int ext_count, Naui_List(Naui_DirEntry)* list)
+static void filter_recursive_impl_w(const char* path, const Naui_FileFilter* match, size_t root_length, Naui_List(Naui_DirEntry)* list)
 {
 	wchar_t wsearch[NAUI_PATH_MAX];
 	{
@@ -130,14 +97,11 @@ static void filter_recursive_impl_w(const char* path, const char* filter, const
 			de.is_directory = true;
 			de.size = 0;
 			naui_list_push(*list, de);
-			filter_recursive_impl_w(child, filter, extensions, ext_count, list);
+			filter_recursive_impl_w(child, match, root_length, list);
 		}
 		else
 		{
-			if (!match_filter(name_u8, filter))
-				continue;
-
-			if (!match_extensions(name_u8, extensions, ext_count))
+			if (!match_entry(match, child, root_length, name_u8))
 				continue;
 
 			ULARGE_INTEGER size;
@@ -156,6 +120,54 @@ static void filter_recursive_impl_w(const char* path, const char* filter, const
 	FindClose(h);
 }
 
+static bool list_recursive_impl_w(const char* path, uint32_t parent, const Naui_FileFilter* match, size_t root_length, Naui_DirListing* listing)
+{
+	wchar_t wsearch[NAUI_PATH_MAX];
+	{
+		wchar_t wpath[NAUI_PATH_MAX];
+		if (!to_wide(path, wpath))
+			return false;
+
+		_snwprintf(wsearch, NAUI_PATH_MAX, L"%s\\*", wpath);
+	}
+
+	WIN32_FIND_DATAW fd;
+	HANDLE h = FindFirstFileW(wsearch, &fd);
+	if (h == INVALID_HANDLE_VALUE)
+		return false;
+
+	do
+	{
+		if (wcscmp(fd.cFileName, L".") == 0 || wcscmp(fd.cFileName, L"..") == 0)
+			continue;
+
+		char name_u8[NAUI_PATH_MAX];
+		if (!to_utf8(fd.cFileName, name_u8))
+			continue;
+
+		char child[NAUI_PATH_MAX];
+		snprintf(child, sizeof(child), "%s\\%s", path, name_u8);
+
+		bool is_dir = (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+		if (!is_dir && !match_entry(match, child, root_length, name_u8))
+			continue;
+
+		ULARGE_INTEGER size;
+		size.HighPart = is_dir ? 0 : fd.nFileSizeHigh;
+		size.LowPart = is_dir ? 0 : fd.nFileSizeLow;
+
+		uint32_t index = listing_add(listing, parent, name_u8, strlen(name_u8), is_dir, (uint64_t)size.QuadPart);
+		if (index == UINT32_MAX || !is_dir)
+			continue;
+
+		list_recursive_impl_w(child, index, match, root_length, listing);
+
+	} while (FindNextFileW(h, &fd));
+
+	FindClose(h);
+	return true;
+}
+
 static void resolve_lock_target(const char* path, char* out)
 {
 	wchar_t wpath[NAUI_PATH_MAX];
@@ -199,6 +211,11 @@ bool naui_file_open(Naui_FileHandle* handle, const Naui_Path path, Naui_FileMode
 			creation = OPEN_ALWAYS;
 			break;
 
+		case NAUI_FILE_READ_WRITE:
+			access = GENERIC_READ | GENERIC_WRITE;
+			creation = CREATE_ALWAYS;
+			break;
+
 		default:
 			return false;
 	}
@@ -242,6 +259,102 @@ size_t naui_file_write(const Naui_FileHandle* handle, const void* buffer, size_t
 	return (size_t)written;
 }
 
+/* ReadFile/WriteFile at `offset` in DWORD-sized pieces. A synchronous handle moves its pointer even with an offset, so it is put back. */
+static size_t file_transfer_at(HANDLE h, void* buffer, size_t size, bool is_write, uint64_t offset)
+{
+	LARGE_INTEGER zero, position;
+	zero.QuadPart = 0;
+	if (!SetFilePointerEx(h, zero, &position, FILE_CURRENT))
+		return 0;
+
+	size_t total = 0;
+	while (total < size)
+	{
+		uint64_t at = offset + total;
+		OVERLAPPED ov;
+		memset(&ov, 0, sizeof(ov));
+		ov.Offset = (DWORD)at;
+		ov.OffsetHigh = (DWORD)(at >> 32);
+
+		DWORD want = (DWORD)((size - total) > 0xFFFFFFFFu ? 0xFFFFFFFFu : size - total);
+		DWORD done = 0;
+		BOOL ok = is_write ? WriteFile(h, (uint8_t*)buffer + total, want, &done, &ov) : ReadFile(h, (uint8_t*)buffer + total, want, &done, &ov);
+		if (!ok || done == 0)
+			break;
+
+		total += done;
+	}
+
+	SetFilePointerEx(h, position, NULL, FILE_BEGIN);
+	return total;
+}
+
+size_t naui_file_read_at(const Naui_FileHandle* handle, void* buffer, size_t size, uint64_t offset)
+{
+	if (!handle || !buffer)
+		return 0;
+
+	HANDLE h = file_internal(handle)->h;
+	if (!h || h == INVALID_HANDLE_VALUE)
+		return 0;
+
+	return file_transfer_at(h, buffer, size, false, offset);
+}
+
+size_t naui_file_write_at(const Naui_FileHandle* handle, const void* buffer, size_t size, uint64_t offset)
+{
+	if (!handle || !buffer)
+		return 0;
+
+	HANDLE h = file_internal(handle)->h;
+	if (!h || h == INVALID_HANDLE_VALUE)
+		return 0;
+
+	return file_transfer_at(h, (void*)buffer, size, true, offset);
+}
+
+/* ReadFileScatter/WriteFileGather need unbuffered, page-aligned I/O, so buffers go one call each. */
+size_t naui_file_readv(const Naui_FileHandle* handle, const Naui_FileVec* vecs, size_t count)
+{
+	if (!vecs && count)
+		return 0;
+
+	size_t total = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		size_t got = naui_file_read(handle, vecs[i].data, vecs[i].size);
+		total += got;
+		if (got < vecs[i].size)
+			break;
+	}
+
+	return total;
+}
+
+size_t naui_file_writev(const Naui_FileHandle* handle, const Naui_FileVec* vecs, size_t count)
+{
+	if (!vecs && count)
+		return 0;
+
+	size_t total = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		size_t written = naui_file_write(handle, vecs[i].data, vecs[i].size);
+		total += written;
+		if (written < vecs[i].size)
+			break;
+	}
+
+	return total;
+}
+
+/* No per-range hint for file handles, the cache manager already reads ahead of sequential ReadFile calls. */
+void naui_file_readahead(const Naui_FileHandle* handle, size_t size)
+{
+	(void)handle;
+	(void)size;
+}
+
 bool naui_file_seek(Naui_FileHandle* handle, long offset, int origin)
 {
 	if (!handle)
@@ -311,6 +424,51 @@ size_t naui_file_size(const Naui_Path path)
 	return (size_t)size.QuadPart;
 }
 
+int64_t naui_file_modified_time(const Naui_Path path)
+{
+	wchar_t wpath[NAUI_PATH_MAX];
+	if (!to_wide(path.data, wpath))
+		return 0;
+
+	WIN32_FILE_ATTRIBUTE_DATA info;
+	if (!GetFileAttributesExW(wpath, GetFileExInfoStandard, &info))
+		return 0;
+
+	/* FILETIME counts 100ns ticks since 1601. */
+	ULARGE_INTEGER ticks;
+	ticks.HighPart = info.ftLastWriteTime.dwHighDateTime;
+	ticks.LowPart = info.ftLastWriteTime.dwLowDateTime;
+	return (int64_t)(ticks.QuadPart / 10000000ull) - 11644473600ll;
+}
+
+/* The file index only comes from an open handle, one that asks for no access at all. */
+bool naui_file_stat(const Naui_Path path, Naui_FileStat* out)
+{
+	memset(out, 0, sizeof(*out));
+	wchar_t wpath[NAUI_PATH_MAX];
+	if (!to_wide(path.data, wpath))
+		return false;
+
+	HANDLE h = CreateFileW(wpath, 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+	if (h == INVALID_HANDLE_VALUE)
+		return false;
+
+	BY_HANDLE_FILE_INFORMATION info;
+	bool ok = GetFileInformationByHandle(h, &info) != 0;
+	CloseHandle(h);
+	if (!ok)
+		return false;
+
+	ULARGE_INTEGER ticks;
+	ticks.HighPart = info.ftLastWriteTime.dwHighDateTime;
+	ticks.LowPart = info.ftLastWriteTime.dwLowDateTime;
+	out->size = ((uint64_t)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+	out->modified_ns = ((int64_t)ticks.QuadPart - 116444736000000000ll) * 100;
+	out->inode = ((uint64_t)info.nFileIndexHigh << 32) | info.nFileIndexLow;
+	out->is_directory = (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+	return true;
+}
+
 char* naui_file_read_all(const Naui_Path path, size_t* out_size)
 {
 	Naui_FileHandle handle = NAUI_FILE_HANDLE_INIT;
@@ -352,6 +510,96 @@ char* naui_file_read_all(const Naui_Path path, size_t* out_size)
 	return buf;
 }
 
+/* Small files and page multiples are copied, so the view always ends in a readable '\0'. */
+static bool file_map_read(Naui_FileMap* out, HANDLE file, size_t size)
+{
+	char* buf = (char*)malloc(size + 1);
+	if (!buf)
+		return false;
+
+	size_t total = 0;
+	DWORD chunk;
+	while (total < size)
+	{
+		DWORD to_read = (DWORD)((size - total) > 0xFFFFFFFFu ? 0xFFFFFFFFu : size - total);
+		if (!ReadFile(file, buf + total, to_read, &chunk, NULL) || chunk == 0)
+			break;
+
+		total += chunk;
+	}
+
+	buf[total] = '\0';
+	out->data = (const uint8_t*)buf;
+	out->size = total;
+	return true;
+}
+
+bool naui_file_map(Naui_FileMap* out, const Naui_Path path, Naui_FileMapHint hints)
+{
+	memset(out, 0, sizeof(*out));
+
+	wchar_t wpath[NAUI_PATH_MAX];
+	if (!to_wide(path.data, wpath))
+		return false;
+
+	/* Windows has no madvise for views, a sequential hint goes to the cache manager instead and willneed is ignored. */
+	DWORD flags = FILE_ATTRIBUTE_NORMAL | ((hints & NAUI_FILE_MAP_SEQUENTIAL) ? FILE_FLAG_SEQUENTIAL_SCAN : 0);
+	HANDLE file = CreateFileW(wpath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || (uint64_t)file_size.QuadPart >= (uint64_t)SIZE_MAX)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+
+	size_t size = (size_t)file_size.QuadPart;
+	bool ok;
+	if (size < NAUI_FILE_MAP_MIN_SIZE || size % info.dwPageSize == 0)
+		ok = file_map_read(out, file, size);
+	else
+	{
+		HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		const uint8_t* data = mapping ? (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+		if (data)
+		{
+			out->data = data;
+			out->size = size;
+			out->is_mapped = true;
+			out->_handle = mapping;
+			ok = true;
+		}
+		else
+		{
+			if (mapping)
+				CloseHandle(mapping);
+
+			ok = file_map_read(out, file, size);
+		}
+	}
+
+	CloseHandle(file);
+	return ok;
+}
+
+void naui_file_unmap(Naui_FileMap* map)
+{
+	if (map->is_mapped)
+	{
+		UnmapViewOfFile(map->data);
+		CloseHandle((HANDLE)map->_handle);
+	}
+	else
+		free((void*)map->data);
+
+	memset(map, 0, sizeof(*map));
+}
+
 bool naui_file_write_all(const Naui_Path path, const void* data, size_t size)
 {
 	if (!data)
@@ -388,6 +636,17 @@ bool naui_file_rename(const Naui_Path old_path, const Naui_Path new_path)
 	return MoveFileExW(wold, wnew, MOVEFILE_REPLACE_EXISTING) != 0;
 }
 
+/* CopyFileW copies inside the kernel, and clones blocks where the volume supports it (ReFS). */
+bool naui_file_copy(const Naui_Path source, const Naui_Path dest)
+{
+	wchar_t wsource[NAUI_PATH_MAX];
+	wchar_t wdest[NAUI_PATH_MAX];
+	if (!to_wide(source.data, wsource) || !to_wide(dest.data, wdest))
+		return false;
+
+	return CopyFileW(wsource, wdest, FALSE) != 0;
+}
+
 Naui_Path naui_file_hide(const Naui_Path path, bool hidden)
 {
 	Naui_Path result = path;
@@ -417,9 +676,9 @@ bool naui_file_is_hidden(const Naui_Path path)
 	return (attrs & FILE_ATTRIBUTE_HIDDEN) != 0;
 }
 
-const char* naui_file_filename(const Naui_Path path)
+const char* naui_file_filename(const Naui_Path* path)
 {
-	const char* data = path.data;
+	const char* data = path->data;
 	const char* last = NULL;
 	for (const char* p = data; *p; ++p)
 	{
@@ -432,7 +691,7 @@ const char* naui_file_filename(const Naui_Path path)
 
 Naui_Path naui_file_stem(const Naui_Path path)
 {
-	const char* filename = naui_file_filename(path);
+	const char* filename = naui_file_filename(&path);
 	const char* dot = strrchr(filename, '.');
 	if (!dot || dot == filename)
 		return path_from(filename);
@@ -449,7 +708,7 @@ Naui_Path naui_file_stem(const Naui_Path path)
 
 Naui_Path naui_file_extension(const Naui_Path path)
 {
-	const char* filename = naui_file_filename(path);
+	const char* filename = naui_file_filename(&path);
 	const char* dot = strrchr(filename, '.');
 	if (!dot || dot == filename)
 		return path_empty();
@@ -632,6 +891,9 @@ Naui_List(Naui_DirEntry) naui_directory_filter(const Naui_Path path, const char*
 	if (h == INVALID_HANDLE_VALUE)
 		return list;
 
+	Naui_FileFilter match;
+	naui_file_filter_init(&match, filter, extensions, ext_count, false);
+
 	do
 	{
 		if (wcscmp(fd.cFileName, L".") == 0 || wcscmp(fd.cFileName, L"..") == 0)
@@ -641,10 +903,7 @@ Naui_List(Naui_DirEntry) naui_directory_filter(const Naui_Path path, const char*
 		if (!to_utf8(fd.cFileName, name_u8))
 			continue;
 
-		if (!match_filter(name_u8, filter))
-			continue;
-
-		if (!match_extensions(name_u8, extensions, ext_count))
+		if (!naui_file_filter_match(&match, name_u8, strlen(name_u8)))
 			continue;
 
 		char full[NAUI_PATH_MAX];
@@ -661,17 +920,50 @@ Naui_List(Naui_DirEntry) naui_directory_filter(const Naui_Path path, const char*
 		naui_list_push(list, de);
 	} while (FindNextFileW(h, &fd));
 
+	naui_file_filter_free(&match);
 	FindClose(h);
 	return list;
 }
 
+/* FindFirstFile hands out the sizes with the names, so there is nothing to skip and the walk stays on this thread. */
+Naui_List(Naui_DirEntry) naui_directory_walk(const Naui_Path path, const char* filter, const char** extensions, int ext_count, Naui_WalkFlags flags)
+{
+	(void)flags;
+	return naui_directory_filter_recursive(path, filter, extensions, ext_count);
+}
+
+bool naui_directory_list(Naui_DirListing* out, const Naui_Path path, const char* filter, const char** extensions, int ext_count, Naui_WalkFlags flags)
+{
+	(void)flags;
+	if (path.data[0] == '\0')
+	{
+		memset(out, 0, sizeof(*out));
+		return false;
+	}
+
+	if (!listing_begin(out, path.data))
+		return false;
+
+	Naui_FileFilter match;
+	naui_file_filter_init(&match, filter, extensions, ext_count, false);
+	bool listed = list_recursive_impl_w(path.data, NAUI_DIR_LISTING_ROOT, &match, strlen(path.data), out);
+	naui_file_filter_free(&match);
+	if (!listed)
+		naui_dir_listing_free(out);
+
+	return listed;
+}
+
 Naui_List(Naui_DirEntry) naui_directory_filter_recursive(const Naui_Path path, const char* filter, const char** extensions, int ext_count)
 {
 	Naui_List(Naui_DirEntry) list = NULL;
 	if (path.data[0] == '\0')
 		return list;
 
-	filter_recursive_impl_w(path.data, filter, extensions, ext_count, &list);
+	Naui_FileFilter match;
+	naui_file_filter_init(&match, filter, extensions, ext_count, false);
+	filter_recursive_impl_w(path.data, &match, strlen(path.data), &list);
+	naui_file_filter_free(&match);
 	return list;
 }
 
@@ -706,6 +998,16 @@ bool naui_path_exists(const Naui_Path path)
 	return GetFileAttributesW(wpath) != INVALID_FILE_ATTRIBUTES;
 }
 
+bool naui_path_is_directory(const Naui_Path path)
+{
+	wchar_t wpath[NAUI_PATH_MAX];
+	if (!to_wide(path.data, wpath))
+		return false;
+
+	DWORD attrs = GetFileAttributesW(wpath);
+	return attrs != INVALID_FILE_ATTRIBUTES && (attrs & FILE_ATTRIBUTE_DIRECTORY);
+}
+
 bool naui_path_is_empty(const Naui_Path path)
 {
 	return path.data[0] == '\0';
@@ -917,7 +1219,7 @@ Naui_Path naui_path_weakly_canonical(const Naui_Path path)
 	while (existing.data[0] != '\0' && !naui_path_exists(existing))
 	{
 		Naui_Path parent = naui_path_parent(existing);
-		Naui_Path segment = path_from(naui_file_filename(existing));
+		Naui_Path segment = path_from(naui_file_filename(&existing));
 
 		if (tail.data[0] != '\0')
 		{
@@ -1,19 +1,37 @@
 #pragma once
 
-#define NAUI_DIR_ITERATOR_HANDLE_SIZE (NAUI_PATH_MAX << 1)
 #define NAUI_EXTENSIONS(...) (const char*[]){ __VA_ARGS__, NULL }
 
+typedef uint8_t Naui_DirIteratorFlags;
+enum
+{
+	NAUI_DIR_ITERATOR_DEFAULT = 0,
+	NAUI_DIR_ITERATOR_NAMES = 1 << 0
+};
+
+struct Naui_DirIteratorState;
+
+/*
+ * The current entry of an open directory. `name` and `path` point into the iterator and change with every step.
+ * With NAUI_DIR_ITERATOR_NAMES the full path is never joined, `path` is NULL and sizes are left at 0,
+ * which saves a stat per file wherever the directory read already tells files from folders.
+ * The state lives on the heap, so the iterator is small enough to pass around by value.
+ */
 typedef struct Naui_DirIterator
 {
-	Naui_DirEntry entry;
+	const char* name;
+	const char* path;
+	size_t size;
+	bool is_directory;
 	bool is_valid;
-	bool case_sensitive;
-	unsigned char _handle[NAUI_DIR_ITERATOR_HANDLE_SIZE];
-	char _filter[NAUI_PATH_MAX >> 2];
-	const char** _extensions;
+	struct Naui_DirIteratorState* _state;
 } Naui_DirIterator;
 
-Naui_DirIterator naui_dir_iterator_open(const Naui_Path path, const char* filter, const char** extensions, bool case_sensitive);
+/*
+ * Iterate the entries of `path` that pass `filter`, a Naui_FileFilter pattern, and the NULL-terminated `extensions`.
+ * A filter without wildcards matches names starting with it. Close the iterator even when it is not valid.
+ */
+Naui_DirIterator naui_dir_iterator_open(const Naui_Path path, const char* filter, const char** extensions, bool case_sensitive, Naui_DirIteratorFlags flags);
 
 void naui_dir_iterator_next(Naui_DirIterator* it);
 void naui_dir_iterator_close(Naui_DirIterator* it);
@@ -1,95 +1,119 @@
 #if !defined(_WIN32) && !defined(_WIN64)
 
-typedef struct
+/* One allocation per iterator: the open directory, the filter and `root/name`, rewritten in place for every entry. */
+struct Naui_DirIteratorState
 {
 	DIR* dir;
-	char root[NAUI_PATH_MAX];
-} Naui_DirIterInternal;
-
-static Naui_DirIterInternal* iterator_internal(Naui_DirIterator* it)
-{
-	return (Naui_DirIterInternal*)(void*)it->_handle;
-}
-
-static bool iterator_match_filter(const char* name, const char* filter, bool case_sensitive)
+	Naui_FileFilter filter;
+	Naui_DirIteratorFlags flags;
+	size_t root_length;
+	char path[];
+};
+
+/* Compiled once per iterator. A filter without wildcards keeps matching names that start with it. */
+static void iterator_filter_init(Naui_FileFilter* match, const char* filter, const char** extensions, bool case_sensitive)
 {
-	if (!filter || filter[0] == '\0')
-		return true;
-
-	size_t filter_len = strlen(filter);
-	return naui_cstr_strncmp(name, filter, filter_len, case_sensitive) == 0;
-}
+	int ext_count = 0;
+	while (extensions && extensions[ext_count])
+		++ext_count;
 
-static bool iterator_match_extensions(const char* name, const char** exts, bool case_sensitive)
-{
-	if (!exts)
-		return true;
-
-	const char* dot = strrchr(name, '.');
-	if (!dot)
-		return false;
-
-	size_t index = 0;
-	while (exts[index] != NULL)
+	char prefix[NAUI_PATH_MAX];
+	if (filter && filter[0] && !strpbrk(filter, "*?["))
 	{
-		if (exts[index] && naui_cstr_strcmp(dot, exts[index], case_sensitive) == 0)
-			return true;
-
-		index++;
+		snprintf(prefix, sizeof(prefix), "%s*", filter);
+		filter = prefix;
 	}
 
-	return false;	
+	naui_file_filter_init(match, filter, extensions, ext_count, case_sensitive);
 }
 
 static void iterator_advance(Naui_DirIterator* it)
 {
-	Naui_DirIterInternal* internal = iterator_internal(it);
+	struct Naui_DirIteratorState* state = it->_state;
 	it->is_valid = false;
+	if (!state)
+		return;
 
+	bool names_only = (state->flags & NAUI_DIR_ITERATOR_NAMES) != 0;
 	struct dirent* entry;
-	while ((entry = readdir(internal->dir)) != NULL)
+	while ((entry = readdir(state->dir)) != NULL)
 	{
-		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+		const char* name = entry->d_name;
+		if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
 			continue;
 
-		const char* filter = it->_filter[0] ? it->_filter : NULL;
-		if (!iterator_match_filter(entry->d_name, filter, it->case_sensitive))
+		size_t length = strlen(name);
+		if (!naui_file_filter_match(&state->filter, name, length))
 			continue;
 
-		if (!iterator_match_extensions(entry->d_name, it->_extensions, it->case_sensitive))
-			continue;
-
-		char child[NAUI_PATH_MAX];
-		snprintf(child, sizeof(child), "%s/%s", internal->root, entry->d_name);
-
-		struct stat st;
-		if (stat(child, &st) != 0)
-			continue;
-
-		snprintf(it->entry.path.data, NAUI_PATH_MAX, "%s", child);
-		it->entry.is_directory = S_ISDIR(st.st_mode);
-		it->entry.size = (size_t)st.st_size;
+		bool is_directory = false;
+		bool known = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+		if (entry->d_type == DT_DIR || entry->d_type == DT_REG)
+		{
+			is_directory = entry->d_type == DT_DIR;
+			known = true;
+		}
+#endif
+
+		size_t size = 0;
+		if (!known || !names_only)
+		{
+			/* Relative to the open directory, following symlinks like stat on the full path would. */
+			struct stat st;
+			if (fstatat(dirfd(state->dir), name, &st, 0) != 0)
+				continue;
+
+			is_directory = S_ISDIR(st.st_mode);
+			size = is_directory ? 0 : (size_t)st.st_size;
+		}
+
+		if (names_only)
+		{
+			it->name = name;
+			it->path = NULL;
+		}
+		else
+		{
+			memcpy(state->path + state->root_length + 1, name, length + 1);
+			it->name = state->path + state->root_length + 1;
+			it->path = state->path;
+		}
+
+		it->is_directory = is_directory;
+		it->size = size;
 		it->is_valid = true;
 		return;
 	}
 }
 
-Naui_DirIterator naui_dir_iterator_open(const Naui_Path path, const char* filter, const char** extensions, bool case_sensitive)
+Naui_DirIterator naui_dir_iterator_open(const Naui_Path path, const char* filter, const char** extensions, bool case_sensitive, Naui_DirIteratorFlags flags)
 {
 	Naui_DirIterator it;
 	memset(&it, 0, sizeof(it));
 
-	Naui_DirIterInternal* internal = iterator_internal(&it);
-	internal->dir = opendir(path.data);
-	if (!internal->dir)
+	DIR* dir = opendir(path.data);
+	if (!dir)
 		return it;
 
-	snprintf(internal->root, NAUI_PATH_MAX, "%s", path.data);
-	if (filter)
-		snprintf(it._filter, sizeof(it._filter), "%s", filter);
+	/* Room for the root, a separator and the longest name readdir can return. */
+	size_t root_length = strlen(path.data);
+	struct Naui_DirIteratorState* state = (struct Naui_DirIteratorState*)malloc(sizeof(*state) + root_length + 1 + sizeof(((struct dirent*)0)->d_name) + 1);
+	if (!state)
+	{
+		closedir(dir);
+		return it;
+	}
 
-	it._extensions = extensions;
-	it.case_sensitive = case_sensitive;
+	state->dir = dir;
+	state->flags = flags;
+	state->root_length = root_length;
+	memcpy(state->path, path.data, root_length);
+	state->path[root_length] = '/';
+	state->path[root_length + 1] = '\0';
+	iterator_filter_init(&state->filter, filter, extensions, case_sensitive);
+
+	it._state = state;
 	iterator_advance(&it);
 	return it;
 }
@@ -106,14 +130,15 @@ bool naui_dir_iterator_valid(const Naui_DirIterator* it)
 
 void naui_dir_iterator_close(Naui_DirIterator* it)
 {
-	Naui_DirIterInternal* internal = iterator_internal(it);
-	if (internal->dir)
+	struct Naui_DirIteratorState* state = it->_state;
+	if (state)
 	{
-		closedir(internal->dir);
-		internal->dir = NULL;
+		closedir(state->dir);
+		naui_file_filter_free(&state->filter);
+		free(state);
 	}
 
-	it->is_valid = false;
+	memset(it, 0, sizeof(*it));
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,86 +1,69 @@
 #if defined(_WIN32) || defined(_WIN64)
 
-typedef struct
+/* One allocation per iterator: the find handle, the filter and `root\name`, rewritten in place for every entry. */
+struct Naui_DirIteratorState
 {
 	HANDLE find_handle;
 	WIN32_FIND_DATAW find_data;
-	char root[NAUI_PATH_MAX];
+	Naui_FileFilter filter;
+	Naui_DirIteratorFlags flags;
 	bool first;
-} Naui_DirIteratorInternal;
+	size_t root_length;
+	char path[];
+};
 
-static Naui_DirIteratorInternal* iterator_internal(Naui_DirIterator* it)
+/* Compiled once per iterator. A filter without wildcards keeps matching names that start with it. */
+static void iterator_filter_init(Naui_FileFilter* match, const char* filter, const char** extensions, bool case_sensitive)
 {
-	return (Naui_DirIteratorInternal*)(void*)it->_handle;
-}
-
-static bool iterator_match_filter(const char* name, const char* filter, bool case_sensitive)
-{
-	if (!filter || filter[0] == '\0')
-		return true;
-
-	size_t filter_len = strlen(filter);
-	return naui_cstr_strncmp(name, filter, filter_len, case_sensitive) == 0;
-}
-
-static bool iterator_match_extensions(const char* name, const char** exts, bool case_sensitive)
-{
-	if (!exts)
-		return true;
-
-	const char* dot = strrchr(name, '.');
-	if (!dot)
-		return false;
+	int ext_count = 0;
+	while (extensions && extensions[ext_count])
+		++ext_count;
 
-	size_t index = 0;
-	while (exts[index] != NULL)
+	char prefix[NAUI_PATH_MAX];
+	if (filter && filter[0] && !strpbrk(filter, "*?["))
 	{
-		if (exts[index] && naui_cstr_strcmp(dot, exts[index], case_sensitive) == 0)
-			return true;
-
-		index++;
+		snprintf(prefix, sizeof(prefix), "%s*", filter);
+		filter = prefix;
 	}
 
-	return false;	
+	naui_file_filter_init(match, filter, extensions, ext_count, case_sensitive);
 }
 
+/* The name is converted straight into the path buffer, FindFirstFile already gave the size and attributes. */
 static bool iterator_fill_entry(Naui_DirIterator* it)
 {
-	Naui_DirIteratorInternal* internal = iterator_internal(it);
-	char name_u8[NAUI_PATH_MAX];
-	if (!to_utf8(internal->find_data.cFileName, name_u8))
-		return false;
-
-	if (strcmp(name_u8, ".") == 0 || strcmp(name_u8, "..") == 0)
+	struct Naui_DirIteratorState* state = it->_state;
+	char* name = state->path + state->root_length + 1;
+	if (!to_utf8(state->find_data.cFileName, name))
 		return false;
 
-	const char* filter = it->_filter[0] ? it->_filter : NULL;
-	if (!iterator_match_filter(name_u8, filter, it->case_sensitive))
+	if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
 		return false;
 
-	if (!iterator_match_extensions(name_u8, it->_extensions, it->case_sensitive))
+	if (!naui_file_filter_match(&state->filter, name, strlen(name)))
 		return false;
 
-	snprintf(it->entry.path.data, NAUI_PATH_MAX, "%s\\%s", internal->root, name_u8);
-	it->entry.is_directory = (internal->find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+	it->name = name;
+	it->path = (state->flags & NAUI_DIR_ITERATOR_NAMES) ? NULL : state->path;
+	it->is_directory = (state->find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
 
 	ULARGE_INTEGER sz;
-	sz.HighPart = internal->find_data.nFileSizeHigh;
-	sz.LowPart = internal->find_data.nFileSizeLow;
-	it->entry.size = (size_t)sz.QuadPart;
+	sz.HighPart = state->find_data.nFileSizeHigh;
+	sz.LowPart = state->find_data.nFileSizeLow;
+	it->size = (it->is_directory || (state->flags & NAUI_DIR_ITERATOR_NAMES)) ? 0 : (size_t)sz.QuadPart;
 	return true;
 }
 
 static void iterator_advance(Naui_DirIterator* it)
 {
-	Naui_DirIteratorInternal* internal = iterator_internal(it);
+	struct Naui_DirIteratorState* state = it->_state;
 	it->is_valid = false;
-
-	if (internal->find_handle == INVALID_HANDLE_VALUE)
+	if (!state)
 		return;
 
-	if (internal->first)
+	if (state->first)
 	{
-		internal->first = false;
+		state->first = false;
 		if (iterator_fill_entry(it))
 		{
 			it->is_valid = true;
@@ -88,7 +71,7 @@ static void iterator_advance(Naui_DirIterator* it)
 		}
 	}
 
-	while (FindNextFileW(internal->find_handle, &internal->find_data))
+	while (FindNextFileW(state->find_handle, &state->find_data))
 	{
 		if (iterator_fill_entry(it))
 		{
@@ -98,14 +81,11 @@ static void iterator_advance(Naui_DirIterator* it)
 	}
 }
 
-Naui_DirIterator naui_dir_iterator_open(const Naui_Path path, const char* filter, const char** extensions, bool case_sensitive)
+Naui_DirIterator naui_dir_iterator_open(const Naui_Path path, const char* filter, const char** extensions, bool case_sensitive, Naui_DirIteratorFlags flags)
 {
 	Naui_DirIterator it;
 	memset(&it, 0, sizeof(it));
 
-	Naui_DirIteratorInternal* internal = iterator_internal(&it);
-	internal->find_handle = INVALID_HANDLE_VALUE;
-	internal->first = true;
 	wchar_t wsearch[NAUI_PATH_MAX];
 	{
 		wchar_t wpath[NAUI_PATH_MAX];
@@ -115,16 +95,28 @@ Naui_DirIterator naui_dir_iterator_open(const Naui_Path path, const char* filter
 		_snwprintf(wsearch, NAUI_PATH_MAX, L"%s\\*", wpath);
 	}
 
-	internal->find_handle = FindFirstFileW(wsearch, &internal->find_data);
-	if (internal->find_handle == INVALID_HANDLE_VALUE)
+	/* to_utf8 may write up to NAUI_PATH_MAX bytes after the separator. */
+	size_t root_length = strlen(path.data);
+	struct Naui_DirIteratorState* state = (struct Naui_DirIteratorState*)malloc(sizeof(*state) + root_length + 1 + NAUI_PATH_MAX);
+	if (!state)
 		return it;
 
-	snprintf(internal->root, NAUI_PATH_MAX, "%s", path.data);
-	if (filter)
-		snprintf(it._filter, sizeof(it._filter), "%s", filter);
+	state->find_handle = FindFirstFileW(wsearch, &state->find_data);
+	if (state->find_handle == INVALID_HANDLE_VALUE)
+	{
+		free(state);
+		return it;
+	}
 
-	it._extensions = extensions;
-	it.case_sensitive = case_sensitive;
+	state->flags = flags;
+	state->first = true;
+	state->root_length = root_length;
+	memcpy(state->path, path.data, root_length);
+	state->path[root_length] = '\\';
+	state->path[root_length + 1] = '\0';
+	iterator_filter_init(&state->filter, filter, extensions, case_sensitive);
+
+	it._state = state;
 	iterator_advance(&it);
 	return it;
 }
@@ -141,14 +133,15 @@ bool naui_dir_iterator_valid(const Naui_DirIterator* it)
 
 void naui_dir_iterator_close(Naui_DirIterator* it)
 {
-	Naui_DirIteratorInternal* internal = iterator_internal(it);
-	if (internal->find_handle != INVALID_HANDLE_VALUE)
+	struct Naui_DirIteratorState* state = it->_state;
+	if (state)
 	{
-		FindClose(internal->find_handle);
-		internal->find_handle = INVALID_HANDLE_VALUE;
+		FindClose(state->find_handle);
+		naui_file_filter_free(&state->filter);
+		free(state);
 	}
 
-	it->is_valid = false;
+	memset(it, 0, sizeof(*it));
 }
 
-#endif
\ No newline at end of file
+#endif
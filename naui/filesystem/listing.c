@@ -0,0 +1,135 @@
+#if defined(_WIN32) || defined(_WIN64)
+#	define NAUI_LISTING_SEPARATOR '\\'
+#else
+#	define NAUI_LISTING_SEPARATOR '/'
+#endif
+
+/* Append a '\0'-terminated name to the pool, returns its offset or UINT32_MAX when out of memory. */
+static uint32_t listing_intern(Naui_DirListing* listing, const char* name, size_t length)
+{
+	if (listing->_names_size + length + 1 > listing->_names_capacity)
+	{
+		size_t capacity = listing->_names_capacity ? listing->_names_capacity * 2 : 4096;
+		while (capacity < listing->_names_size + length + 1)
+			capacity *= 2;
+
+		char* names = (char*)realloc(listing->names, capacity);
+		if (!names)
+			return UINT32_MAX;
+
+		listing->names = names;
+		listing->_names_capacity = capacity;
+	}
+
+	uint32_t offset = (uint32_t)listing->_names_size;
+	memcpy(listing->names + offset, name, length);
+	listing->names[offset + length] = '\0';
+	listing->_names_size += length + 1;
+	return offset;
+}
+
+/* Start an empty listing of `root`, the platform walkers then add records with listing_add. */
+static bool listing_begin(Naui_DirListing* listing, const char* root)
+{
+	memset(listing, 0, sizeof(*listing));
+	size_t length = strlen(root);
+	listing->_root_length = (uint32_t)length;
+	return listing_intern(listing, root, length) != UINT32_MAX;
+}
+
+static uint32_t listing_add(Naui_DirListing* listing, uint32_t parent, const char* name, size_t length, bool is_directory, uint64_t size)
+{
+	if (length > UINT16_MAX)
+		return UINT32_MAX;
+
+	Naui_DirRecord record;
+	record.parent = parent;
+	record.name = listing_intern(listing, name, length);
+	record.size = size;
+	record.name_length = (uint16_t)length;
+	record.is_directory = is_directory;
+	if (record.name == UINT32_MAX)
+		return UINT32_MAX;
+
+	naui_list_push(listing->records, record);
+	return (uint32_t)(naui_list_len(listing->records) - 1);
+}
+
+size_t naui_dir_listing_count(const Naui_DirListing* listing)
+{
+	return listing->records ? (size_t)naui_list_len(listing->records) : 0;
+}
+
+const char* naui_dir_listing_name(const Naui_DirListing* listing, size_t index)
+{
+	return listing->names + listing->records[index].name;
+}
+
+size_t naui_dir_listing_relative(const Naui_DirListing* listing, size_t index, char* out, size_t out_size)
+{
+	/* Measure the chain first, then fill the buffer back to front. */
+	size_t length = 0;
+	for (uint32_t i = (uint32_t)index; i != NAUI_DIR_LISTING_ROOT; i = listing->records[i].parent)
+	{
+		length += listing->records[i].name_length + (length ? 1 : 0);
+	}
+
+	if (length + 1 > out_size)
+		return 0;
+
+	size_t end = length;
+	out[end] = '\0';
+	for (uint32_t i = (uint32_t)index; i != NAUI_DIR_LISTING_ROOT; i = listing->records[i].parent)
+	{
+		const Naui_DirRecord* record = &listing->records[i];
+		end -= record->name_length;
+		memcpy(out + end, listing->names + record->name, record->name_length);
+		if (end)
+			out[--end] = NAUI_LISTING_SEPARATOR;
+	}
+
+	return length;
+}
+
+Naui_Path naui_dir_listing_path(const Naui_DirListing* listing, size_t index)
+{
+	Naui_Path path;
+	size_t root = listing->_root_length;
+	path.data[0] = '\0';
+	if (root + 2 > NAUI_PATH_MAX)
+		return path;
+
+	memcpy(path.data, listing->names, root);
+	path.data[root] = NAUI_LISTING_SEPARATOR;
+	if (!naui_dir_listing_relative(listing, index, path.data + root + 1, NAUI_PATH_MAX - root - 1))
+		path.data[0] = '\0';
+
+	return path;
+}
+
+Naui_List(Naui_DirEntry) naui_dir_listing_entries(const Naui_DirListing* listing)
+{
+	Naui_List(Naui_DirEntry) list = NULL;
+	size_t count = naui_dir_listing_count(listing);
+	if (count)
+		naui_list_reserve(list, count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		Naui_DirEntry de;
+		de.path = naui_dir_listing_path(listing, i);
+		de.is_directory = listing->records[i].is_directory;
+		de.size = (size_t)listing->records[i].size;
+		if (de.path.data[0] != '\0')
+			naui_list_push(list, de);
+	}
+
+	return list;
+}
+
+void naui_dir_listing_free(Naui_DirListing* listing)
+{
+	naui_list_free(listing->records);
+	free(listing->names);
+	memset(listing, 0, sizeof(*listing));
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+/* Parent of the records directly inside the listed folder. */
+#define NAUI_DIR_LISTING_ROOT UINT32_MAX
+
+/* One entry of a listing. The name lives in the listing's pool, the full path is rebuilt from the parents on demand. */
+typedef struct Naui_DirRecord
+{
+	uint32_t parent;
+	uint32_t name;
+	uint64_t size;
+	uint16_t name_length;
+	bool is_directory;
+} Naui_DirRecord;
+
+/*
+ * A recursive listing in the same depth-first order as naui_directory_filter_recursive, at a few dozen bytes
+ * per entry instead of a Naui_Path each. Names are '\0'-terminated in `names`, the listed folder comes first.
+ */
+typedef struct Naui_DirListing
+{
+	Naui_List(Naui_DirRecord) records;
+	char* names;
+	size_t _names_size;
+	size_t _names_capacity;
+	uint32_t _root_length;
+} Naui_DirListing;
+
+#define NAUI_DIR_LISTING_INIT { NULL, NULL, 0, 0, 0 }
+
+/* List `path` recursively, see naui_directory_walk for the filter and flags. Returns false if the folder could not be listed. */
+bool naui_directory_list(Naui_DirListing* out, const Naui_Path path, const char* filter, const char** extensions, int ext_count, Naui_WalkFlags flags);
+
+size_t naui_dir_listing_count(const Naui_DirListing* listing);
+const char* naui_dir_listing_name(const Naui_DirListing* listing, size_t index);
+
+/* Full path of a record, the listed folder joined with every parent. */
+Naui_Path naui_dir_listing_path(const Naui_DirListing* listing, size_t index);
+
+/* Path below the listed folder written to `out`. Returns its length, 0 when it does not fit. */
+size_t naui_dir_listing_relative(const Naui_DirListing* listing, size_t index, char* out, size_t out_size);
+
+/* The listing expanded to full paths, for code that wants a Naui_List(Naui_DirEntry). Free with naui_directory_filter_free(). */
+Naui_List(Naui_DirEntry) naui_dir_listing_entries(const Naui_DirListing* listing);
+
+void naui_dir_listing_free(Naui_DirListing* listing);
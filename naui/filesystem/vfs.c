@@ -0,0 +1,426 @@
+typedef struct
+{
+	uint32_t mount;
+	uint32_t entry;
+} Vfs_Ref;
+
+typedef struct
+{
+	char* key;
+	Vfs_Ref value;
+} Vfs_IndexEntry;
+
+typedef struct
+{
+	Naui_Path source;
+	char mount_point[NAUI_VFS_MOUNT_POINT_MAX];
+	size_t mount_point_len;
+	int32_t priority;
+	uint32_t order;
+	Naui_VfsMountKind kind;
+	bool is_used;
+	Naui_Archive zip;
+	Naui_Pak pak;
+} Vfs_Mount;
+
+typedef struct
+{
+	/* Slots never move, the zip readers inside point at themselves. */
+	Vfs_Mount mounts[NAUI_VFS_MAX_MOUNTS];
+	uint32_t next_order;
+
+	/* Virtual path -> mount and entry. Keys live in `names`, rebuilt whenever the mounts change. */
+	Naui_Map(Vfs_IndexEntry) index;
+	Naui_Arena names;
+} Vfs_State;
+
+static Vfs_State g_vfs;
+
+#pragma region Static Functions
+/* Folds separators to '/', drops "./" and leading/trailing slashes. Returns the length, or -1 if `out` is too small. */
+static int vfs_normalize(const char* path, char* out, size_t out_size)
+{
+	while (path[0] == '.' && (path[1] == '/' || path[1] == '\\'))
+	{
+		path += 2;
+	}
+
+	while (*path == '/' || *path == '\\')
+	{
+		++path;
+	}
+
+	size_t len = 0;
+	for (; *path; ++path)
+	{
+		if (len + 1 >= out_size)
+			return -1;
+
+		out[len++] = *path == '\\' ? '/' : *path;
+	}
+
+	while (len > 0 && out[len - 1] == '/')
+	{
+		--len;
+	}
+
+	out[len] = '\0';
+	return (int)len;
+}
+
+static void vfs_index_add(uint32_t mount, uint32_t entry, const char* rel, size_t rel_len)
+{
+	const Vfs_Mount* m = &g_vfs.mounts[mount];
+	size_t len = m->mount_point_len + (m->mount_point_len ? 1 : 0) + rel_len;
+	char* key = (char*)naui_arena_alloc(&g_vfs.names, len + 1);
+	if (!key)
+		return;
+
+	char* cursor = key;
+	if (m->mount_point_len)
+	{
+		memcpy(cursor, m->mount_point, m->mount_point_len);
+		cursor += m->mount_point_len;
+		*cursor++ = '/';
+	}
+
+	for (size_t i = 0; i < rel_len; ++i)
+	{
+		cursor[i] = rel[i] == '\\' ? '/' : rel[i];
+	}
+
+	key[len] = '\0';
+
+	Vfs_Ref ref = { mount, entry };
+	naui_strmap_put(g_vfs.index, key, ref);
+}
+
+static void vfs_index_mount(uint32_t mount)
+{
+	Vfs_Mount* m = &g_vfs.mounts[mount];
+	switch (m->kind)
+	{
+		case NAUI_VFS_DIRECTORY:
+		{
+			Naui_DirListing listing = NAUI_DIR_LISTING_INIT;
+			naui_directory_list(&listing, m->source, NULL, NULL, 0, NAUI_WALK_DEFAULT);
+
+			char rel[NAUI_PATH_MAX];
+			for (size_t i = 0; i < naui_dir_listing_count(&listing); ++i)
+			{
+				if (listing.records[i].is_directory)
+					continue;
+
+				size_t len = naui_dir_listing_relative(&listing, i, rel, sizeof(rel));
+				if (len)
+					vfs_index_add(mount, 0, rel, len);
+			}
+
+			naui_dir_listing_free(&listing);
+			break;
+		}
+
+		case NAUI_VFS_ZIP:
+		{
+			mz_uint count = mz_zip_reader_get_num_files(&m->zip.zip);
+			char name[NAUI_PATH_MAX];
+			for (mz_uint i = 0; i < count; ++i)
+			{
+				if (mz_zip_reader_is_file_a_directory(&m->zip.zip, i))
+					continue;
+
+				mz_uint len = mz_zip_reader_get_filename(&m->zip.zip, i, name, sizeof(name));
+				if (len > 1)
+					vfs_index_add(mount, (uint32_t)i, name, len - 1);
+			}
+
+			break;
+		}
+
+		case NAUI_VFS_PAK:
+		{
+			for (size_t i = 0; i < m->pak.count; ++i)
+			{
+				const char* name;
+				size_t len;
+				naui_pak_entry(&m->pak, i, &name, &len);
+				vfs_index_add(mount, (uint32_t)i, name, len);
+			}
+
+			break;
+		}
+	}
+}
+
+/* Lowest priority first so that later inserts overwrite the paths they shadow. */
+static void vfs_rebuild(void)
+{
+	naui_strmap_free(g_vfs.index);
+	naui_arena_free(&g_vfs.names);
+	memset(&g_vfs.names, 0, sizeof(g_vfs.names));
+
+	uint32_t order[NAUI_VFS_MAX_MOUNTS];
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < NAUI_VFS_MAX_MOUNTS; ++i)
+	{
+		if (!g_vfs.mounts[i].is_used)
+			continue;
+
+		uint32_t j = count++;
+		for (; j > 0; --j)
+		{
+			const Vfs_Mount* prev = &g_vfs.mounts[order[j - 1]];
+			const Vfs_Mount* cur = &g_vfs.mounts[i];
+			if (prev->priority < cur->priority || (prev->priority == cur->priority && prev->order < cur->order))
+				break;
+
+			order[j] = order[j - 1];
+		}
+
+		order[j] = i;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		vfs_index_mount(order[i]);
+	}
+}
+
+static void vfs_close_mount(Vfs_Mount* m)
+{
+	if (m->kind == NAUI_VFS_ZIP)
+		naui_archive_close(&m->zip);
+	else if (m->kind == NAUI_VFS_PAK)
+		naui_pak_close(&m->pak);
+
+	m->is_used = false;
+}
+
+static Vfs_Mount* vfs_find_mount(const Naui_Path source)
+{
+	for (uint32_t i = 0; i < NAUI_VFS_MAX_MOUNTS; ++i)
+	{
+		if (g_vfs.mounts[i].is_used && strcmp(g_vfs.mounts[i].source.data, source.data) == 0)
+			return &g_vfs.mounts[i];
+	}
+
+	return NULL;
+}
+
+static bool vfs_is_pak(const Naui_Path source)
+{
+	char magic[NAUI_ARCHIVE_MAGIC_SIZE];
+	Naui_FileHandle fh = NAUI_FILE_HANDLE_INIT;
+	if (!naui_file_open(&fh, source, NAUI_FILE_READ))
+		return false;
+
+	bool is_pak = naui_file_read(&fh, magic, sizeof(magic)) == sizeof(magic) && memcmp(magic, NAUI_ARCHIVE_MAGIC, sizeof(magic)) == 0;
+	naui_file_close(&fh);
+	return is_pak;
+}
+
+static const Vfs_IndexEntry* vfs_lookup(const char* path, char* key, size_t key_size)
+{
+	if (!g_vfs.index || vfs_normalize(path, key, key_size) < 0)
+		return NULL;
+
+	ptrdiff_t i = naui_strmap_get_index(g_vfs.index, key);
+	return i >= 0 ? &g_vfs.index[i] : NULL;
+}
+
+static bool vfs_has_children(const char* dir, size_t dir_len)
+{
+	for (ptrdiff_t i = 0; i < naui_strmap_len(g_vfs.index); ++i)
+	{
+		const char* key = g_vfs.index[i].key;
+		if (dir_len == 0 || (strncmp(key, dir, dir_len) == 0 && key[dir_len] == '/'))
+			return true;
+	}
+
+	return false;
+}
+#pragma endregion
+
+bool naui_vfs_mount(const Naui_Path source, const char* mount_point, int32_t priority)
+{
+	/* Mounting a source again replaces it, e.g. to change its priority. The old mount stays until the new one opened. */
+	Vfs_Mount* old = vfs_find_mount(source);
+
+	Vfs_Mount* m = NULL;
+	for (uint32_t i = 0; i < NAUI_VFS_MAX_MOUNTS && !m; ++i)
+	{
+		if (!g_vfs.mounts[i].is_used)
+			m = &g_vfs.mounts[i];
+	}
+
+	if (!m)
+	{
+		fprintf(stderr, "[Naui] VFS: too many mounts, cannot mount %s\n", source.data);
+		return false;
+	}
+
+	memset(m, 0, sizeof(*m));
+	m->source = source;
+	m->priority = priority;
+	m->order = g_vfs.next_order++;
+
+	int len = vfs_normalize(mount_point ? mount_point : "", m->mount_point, sizeof(m->mount_point));
+	if (len < 0)
+		return false;
+
+	m->mount_point_len = (size_t)len;
+	if (naui_path_is_directory(source))
+		m->kind = NAUI_VFS_DIRECTORY;
+	else if (vfs_is_pak(source))
+	{
+		m->kind = NAUI_VFS_PAK;
+		if (!naui_pak_open(&m->pak, source))
+			return false;
+	}
+	else
+	{
+		m->kind = NAUI_VFS_ZIP;
+		if (!naui_archive_open(&m->zip, source, NAUI_ARCHIVE_READ))
+		{
+			fprintf(stderr, "[Naui] VFS: %s is not a directory, zip or NauiPak\n", source.data);
+			return false;
+		}
+	}
+
+	if (old)
+		vfs_close_mount(old);
+
+	m->is_used = true;
+	vfs_rebuild();
+	return true;
+}
+
+bool naui_vfs_unmount(const Naui_Path source)
+{
+	Vfs_Mount* m = vfs_find_mount(source);
+	if (!m)
+		return false;
+
+	vfs_close_mount(m);
+	vfs_rebuild();
+	return true;
+}
+
+void naui_vfs_shutdown(void)
+{
+	for (uint32_t i = 0; i < NAUI_VFS_MAX_MOUNTS; ++i)
+	{
+		if (g_vfs.mounts[i].is_used)
+			vfs_close_mount(&g_vfs.mounts[i]);
+	}
+
+	naui_strmap_free(g_vfs.index);
+	naui_arena_free(&g_vfs.names);
+	memset(&g_vfs, 0, sizeof(g_vfs));
+}
+
+void naui_vfs_refresh(void)
+{
+	vfs_rebuild();
+}
+
+bool naui_vfs_exists(const char* path)
+{
+	char key[NAUI_PATH_MAX];
+	if (vfs_lookup(path, key, sizeof(key)))
+		return true;
+
+	int len = vfs_normalize(path, key, sizeof(key));
+	if (len >= 0 && g_vfs.index && vfs_has_children(key, (size_t)len))
+		return true;
+
+	return naui_path_exists(naui_path_from_cstr(path));
+}
+
+/* Loose files are decoded front to back right after the read, so the whole file is asked for up front. */
+static bool vfs_map_disk(const Naui_Path path, Naui_VfsFile* out)
+{
+	if (!naui_file_map(&out->_file, path, NAUI_FILE_MAP_SEQUENTIAL | NAUI_FILE_MAP_WILLNEED))
+		return false;
+
+	out->data = out->_file.data;
+	out->size = out->_file.size;
+	return true;
+}
+
+bool naui_vfs_read(const char* path, Naui_VfsFile* out)
+{
+	memset(out, 0, sizeof(*out));
+
+	char key[NAUI_PATH_MAX];
+	const Vfs_IndexEntry* hit = vfs_lookup(path, key, sizeof(key));
+	if (!hit)
+		return vfs_map_disk(naui_path_from_cstr(path), out);
+
+	Vfs_Mount* m = &g_vfs.mounts[hit->value.mount];
+	switch (m->kind)
+	{
+		case NAUI_VFS_PAK:
+		{
+			Naui_PakView view = naui_pak_entry(&m->pak, hit->value.entry, NULL, NULL);
+			out->data = view.data;
+			out->size = view.size;
+			return true;
+		}
+
+		case NAUI_VFS_ZIP:
+		{
+			size_t size;
+			void* data = mz_zip_reader_extract_to_heap(&m->zip.zip, hit->value.entry, &size, 0);
+			out->data = (const uint8_t*)data;
+			out->size = size;
+			out->_owned = data;
+			return data != NULL;
+		}
+
+		default:
+		{
+			const char* rel = hit->key + m->mount_point_len + (m->mount_point_len ? 1 : 0);
+			Naui_Path disk;
+			snprintf(disk.data, NAUI_PATH_MAX, "%s/%s", m->source.data, rel);
+
+			return vfs_map_disk(disk, out);
+		}
+	}
+}
+
+void naui_vfs_release(Naui_VfsFile* file)
+{
+	free(file->_owned);
+	naui_file_unmap(&file->_file);
+	memset(file, 0, sizeof(*file));
+}
+
+Naui_List(const char*) naui_vfs_list(const char* dir)
+{
+	char key[NAUI_PATH_MAX];
+	int len = vfs_normalize(dir, key, sizeof(key));
+	if (len < 0)
+		return NULL;
+
+	Naui_Path disk = naui_path_from_cstr(dir);
+	if (!vfs_has_children(key, (size_t)len) && !vfs_find_mount(disk))
+	{
+		if (!naui_path_is_directory(disk) || !naui_vfs_mount(disk, key, INT32_MIN))
+			return NULL;
+	}
+
+	Naui_List(const char*) list = NULL;
+	for (ptrdiff_t i = 0; i < naui_strmap_len(g_vfs.index); ++i)
+	{
+		const char* path = g_vfs.index[i].key;
+		if (len > 0 && (strncmp(path, key, (size_t)len) != 0 || path[len] != '/'))
+			continue;
+
+		const char* name = path + len + (len > 0 ? 1 : 0);
+		if (!strchr(name, '/'))
+			naui_list_push(list, path);
+	}
+
+	return list;
+}
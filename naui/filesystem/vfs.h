@@ -0,0 +1,47 @@
+#pragma once
+
+#define NAUI_VFS_MAX_MOUNTS 16
+#define NAUI_VFS_MOUNT_POINT_MAX 256
+
+typedef uint8_t Naui_VfsMountKind;
+enum
+{
+	NAUI_VFS_DIRECTORY,
+	NAUI_VFS_ZIP,
+	NAUI_VFS_PAK
+};
+
+/* Contents of one file. Pak entries point straight into the pak, disk files are mapped and zip entries are a heap copy. */
+typedef struct Naui_VfsFile
+{
+	const uint8_t* data;
+	size_t size;
+	void* _owned;
+	Naui_FileMap _file;
+} Naui_VfsFile;
+
+/*
+ * Mount a directory, zip or NauiPak so its files appear under `mount_point` ("" for the root).
+ * The kind is detected from the source. When several mounts provide the same path the highest
+ * priority wins, and the most recent mount wins a tie. Every mounted file is indexed up front.
+ */
+bool naui_vfs_mount(const Naui_Path source, const char* mount_point, int32_t priority);
+bool naui_vfs_unmount(const Naui_Path source);
+
+/* Unmount everything and drop the index. */
+void naui_vfs_shutdown(void);
+
+/* Re-index the mounts, e.g. after files were added to a mounted directory. */
+void naui_vfs_refresh(void);
+
+/* Virtual paths use '/' or '\\' and are case-sensitive. Paths no mount provides fall through to the working directory. */
+bool naui_vfs_exists(const char* path);
+bool naui_vfs_read(const char* path, Naui_VfsFile* out);
+void naui_vfs_release(Naui_VfsFile* file);
+
+/*
+ * Files directly inside `dir`. A directory that no mount covers is mounted from disk on first use.
+ * The strings belong to the index and stay valid until the next mount, unmount or refresh.
+ * Call naui_list_free() on the list when done.
+ */
+Naui_List(const char*) naui_vfs_list(const char* dir);
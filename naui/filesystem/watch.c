@@ -0,0 +1,227 @@
+#if defined(_WIN32) || defined(_WIN64)
+#	define NAUI_WATCH_SEPARATOR "\\"
+#else
+#	define NAUI_WATCH_SEPARATOR "/"
+#endif
+
+/* Everything seen for one path since it was last reported. */
+typedef struct
+{
+	char* relative;
+	Naui_WatchEvent events;
+	uint64_t due_ms;
+} Watch_Change;
+
+typedef struct Watch_Entry
+{
+	uint32_t id;
+	Naui_Path folder;
+	uint32_t debounce_ms;
+	Naui_WatchFn fn;
+	void* user;
+	Naui_List(Watch_Change) changes;
+	bool removed;
+	Watch_Backend backend;
+} Watch_Entry;
+
+/* Only touched by the polling thread. Entries removed from inside a callback are swept once the poll is over. */
+static struct
+{
+	Naui_List(Watch_Entry*) entries;
+	uint32_t next_id;
+	bool is_polling;
+} g_watch;
+
+static void watch_record(Watch_Entry* entry, const char* relative, size_t length, Naui_WatchEvent events)
+{
+	uint64_t due = watch_now_ms() + entry->debounce_ms;
+	for (size_t i = 0; i < (size_t)naui_list_len(entry->changes); ++i)
+	{
+		Watch_Change* change = &entry->changes[i];
+		if (strncmp(change->relative, relative, length) == 0 && change->relative[length] == '\0')
+		{
+			change->events |= events;
+			change->due_ms = due;
+			return;
+		}
+	}
+
+	Watch_Change change;
+	change.relative = (char*)malloc(length + 1);
+	if (!change.relative)
+		return;
+
+	memcpy(change.relative, relative, length);
+	change.relative[length] = '\0';
+	change.events = events;
+	change.due_ms = due;
+	naui_list_push(entry->changes, change);
+}
+
+static void watch_free(Watch_Entry* entry)
+{
+	watch_backend_close(&entry->backend);
+	for (size_t i = 0; i < (size_t)naui_list_len(entry->changes); ++i)
+	{
+		free(entry->changes[i].relative);
+	}
+
+	naui_list_free(entry->changes);
+	free(entry);
+}
+
+static ptrdiff_t watch_find(Naui_WatchHandle handle)
+{
+	for (ptrdiff_t i = 0; i < naui_list_len(g_watch.entries); ++i)
+	{
+		if (g_watch.entries[i]->id == handle._id && !g_watch.entries[i]->removed)
+			return i;
+	}
+
+	return -1;
+}
+
+/* Report the changes that have been quiet long enough. They are taken off the list first, so callbacks may add or remove watches. */
+static size_t watch_deliver(Watch_Entry* entry, uint64_t now)
+{
+	Naui_List(Watch_Change) due = NULL;
+	for (size_t i = 0; i < (size_t)naui_list_len(entry->changes);)
+	{
+		if (entry->changes[i].due_ms <= now)
+		{
+			naui_list_push(due, entry->changes[i]);
+			naui_list_remove(entry->changes, i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	size_t count = 0;
+	for (size_t i = 0; i < (size_t)naui_list_len(due); ++i)
+	{
+		if (!entry->removed)
+		{
+			Naui_Path path;
+			if (due[i].relative[0])
+				snprintf(path.data, NAUI_PATH_MAX, "%s" NAUI_WATCH_SEPARATOR "%s", entry->folder.data, due[i].relative);
+			else
+				path = entry->folder;
+
+			Naui_WatchChange change;
+			change.path = path.data;
+			change.relative = due[i].relative;
+			change.events = due[i].events;
+			entry->fn(&change, entry->user);
+			++count;
+		}
+
+		free(due[i].relative);
+	}
+
+	naui_list_free(due);
+	return count;
+}
+
+Naui_WatchHandle naui_watch_add(const Naui_Path folder, uint32_t debounce_ms, Naui_WatchFn fn, void* user)
+{
+	if (!fn || !naui_path_is_directory(folder))
+		return NAUI_WATCH_INVALID;
+
+	Watch_Entry* entry = (Watch_Entry*)calloc(1, sizeof(Watch_Entry));
+	if (!entry)
+		return NAUI_WATCH_INVALID;
+
+	entry->folder = folder;
+	entry->debounce_ms = debounce_ms ? debounce_ms : NAUI_WATCH_DEFAULT_DEBOUNCE_MS;
+	entry->fn = fn;
+	entry->user = user;
+	if (!watch_backend_open(&entry->backend, entry, folder))
+	{
+		fprintf(stderr, "[Naui] naui_watch_add: failed to watch '%s'\n", folder.data);
+		free(entry);
+		return NAUI_WATCH_INVALID;
+	}
+
+	if (++g_watch.next_id == 0)
+		++g_watch.next_id;
+
+	entry->id = g_watch.next_id;
+	naui_list_push(g_watch.entries, entry);
+
+	Naui_WatchHandle handle = { entry->id };
+	return handle;
+}
+
+void naui_watch_remove(Naui_WatchHandle handle)
+{
+	ptrdiff_t index = watch_find(handle);
+	if (index < 0)
+		return;
+
+	Watch_Entry* entry = g_watch.entries[index];
+	if (g_watch.is_polling)
+	{
+		entry->removed = true;
+		return;
+	}
+
+	naui_list_remove(g_watch.entries, index);
+	watch_free(entry);
+}
+
+bool naui_watch_is_valid(Naui_WatchHandle handle)
+{
+	return handle._id != 0 && watch_find(handle) >= 0;
+}
+
+size_t naui_watch_poll(void)
+{
+	if (g_watch.is_polling || naui_list_len(g_watch.entries) == 0)
+		return 0;
+
+	g_watch.is_polling = true;
+	size_t count = 0;
+	uint64_t now = watch_now_ms();
+
+	/* Watches added by a callback are picked up on the next poll. */
+	size_t entry_count = (size_t)naui_list_len(g_watch.entries);
+	for (size_t i = 0; i < entry_count; ++i)
+	{
+		Watch_Entry* entry = g_watch.entries[i];
+		if (entry->removed)
+			continue;
+
+		watch_backend_read(&entry->backend, entry);
+		count += watch_deliver(entry, now);
+	}
+
+	g_watch.is_polling = false;
+	for (size_t i = 0; i < (size_t)naui_list_len(g_watch.entries);)
+	{
+		Watch_Entry* entry = g_watch.entries[i];
+		if (entry->removed)
+		{
+			naui_list_remove(g_watch.entries, i);
+			watch_free(entry);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	return count;
+}
+
+void naui_watch_shutdown(void)
+{
+	for (size_t i = 0; i < (size_t)naui_list_len(g_watch.entries); ++i)
+	{
+		watch_free(g_watch.entries[i]);
+	}
+
+	naui_list_free(g_watch.entries);
+	g_watch.entries = NULL;
+}
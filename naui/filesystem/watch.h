@@ -0,0 +1,46 @@
+#pragma once
+
+/* Quiet time before a burst of changes to one file is reported, editors often save in several writes. */
+#define NAUI_WATCH_DEFAULT_DEBOUNCE_MS 100
+
+#define NAUI_WATCH_INVALID ((Naui_WatchHandle){ 0 })
+
+typedef struct { uint32_t _id; } Naui_WatchHandle;
+
+typedef uint8_t Naui_WatchEvent;
+enum
+{
+	NAUI_WATCH_CREATED = 1 << 0,
+	NAUI_WATCH_MODIFIED = 1 << 1,
+	NAUI_WATCH_DELETED = 1 << 2,
+
+	/* Events were dropped, anything under the watched folder may have changed. path is the folder itself. */
+	NAUI_WATCH_OVERFLOW = 1 << 3
+};
+
+/* Renames arrive as DELETED for the old name and CREATED for the new one. */
+typedef struct Naui_WatchChange
+{
+	const char* path;
+	const char* relative;
+	Naui_WatchEvent events;
+} Naui_WatchChange;
+
+typedef void (*Naui_WatchFn)(const Naui_WatchChange* change, void* user);
+
+/*
+ * Watch a folder and everything below it. Changes to one path are merged until it has been quiet for
+ * `debounce_ms` (0 for the default), then reported once from naui_watch_poll, so callbacks run on the
+ * thread that polls, the main thread in an app. Returns NAUI_WATCH_INVALID when the folder cannot be watched.
+ */
+Naui_WatchHandle naui_watch_add(const Naui_Path folder, uint32_t debounce_ms, Naui_WatchFn fn, void* user);
+void naui_watch_remove(Naui_WatchHandle handle);
+
+/* True while the watch exists: false for NAUI_WATCH_INVALID, after naui_watch_remove and after naui_watch_shutdown. */
+bool naui_watch_is_valid(Naui_WatchHandle handle);
+
+/* Collect what the OS reported and run the callbacks that are due. Returns how many ran. The app calls this every frame. */
+size_t naui_watch_poll(void);
+
+/* Remove every watch, pending changes are dropped. */
+void naui_watch_shutdown(void);
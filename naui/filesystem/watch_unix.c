@@ -0,0 +1,219 @@
+#if !defined(_WIN32) && !defined(_WIN64)
+
+#include <time.h>
+
+struct Watch_Entry;
+static void watch_record(struct Watch_Entry* entry, const char* relative, size_t length, Naui_WatchEvent events);
+
+static uint64_t watch_now_ms(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+
+#define NAUI_WATCH_INOTIFY_MASK (IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR)
+
+/* inotify is not recursive, every folder below the root gets its own watch descriptor. */
+typedef struct { int32_t key; char* value; } Watch_Dir;
+
+typedef struct
+{
+	int fd;
+	Naui_Map(Watch_Dir) dirs;
+	char folder[NAUI_PATH_MAX];
+} Watch_Backend;
+
+static int32_t watch_inotify_add(Watch_Backend* backend, const char* relative)
+{
+	char path[NAUI_PATH_MAX];
+	if (relative[0])
+		snprintf(path, sizeof(path), "%s/%s", backend->folder, relative);
+	else
+		snprintf(path, sizeof(path), "%s", backend->folder);
+
+	int wd = inotify_add_watch(backend->fd, path, NAUI_WATCH_INOTIFY_MASK);
+	if (wd < 0)
+		return -1;
+
+	/* Watching a folder twice hands back the same descriptor. */
+	if (naui_intmap_get_index(backend->dirs, wd) >= 0)
+		free(naui_intmap_get(backend->dirs, wd));
+
+	size_t length = strlen(relative);
+	char* copy = (char*)malloc(length + 1);
+	memcpy(copy, relative, length + 1);
+	naui_intmap_put(backend->dirs, wd, copy);
+	return wd;
+}
+
+/* Watch a folder and everything in it. A folder that appeared after the watch started may already have files, those are reported as created. */
+static bool watch_inotify_add_tree(Watch_Backend* backend, struct Watch_Entry* owner, const char* relative, bool report)
+{
+	if (watch_inotify_add(backend, relative) < 0)
+		return false;
+
+	Naui_Path folder;
+	if (relative[0])
+		snprintf(folder.data, NAUI_PATH_MAX, "%s/%s", backend->folder, relative);
+	else
+		snprintf(folder.data, NAUI_PATH_MAX, "%s", backend->folder);
+
+	Naui_DirListing listing = NAUI_DIR_LISTING_INIT;
+	naui_directory_list(&listing, folder, NULL, NULL, 0, NAUI_WALK_DEFAULT);
+
+	char path[NAUI_PATH_MAX];
+	size_t prefix = relative[0] ? (size_t)snprintf(path, sizeof(path), "%s/", relative) : 0;
+	for (size_t i = 0; i < naui_dir_listing_count(&listing) && prefix < sizeof(path); ++i)
+	{
+		size_t length = naui_dir_listing_relative(&listing, i, path + prefix, sizeof(path) - prefix);
+		if (!length)
+			continue;
+
+		if (listing.records[i].is_directory)
+			watch_inotify_add(backend, path);
+
+		if (report)
+			watch_record(owner, path, prefix + length, NAUI_WATCH_CREATED);
+	}
+
+	naui_dir_listing_free(&listing);
+	return true;
+}
+
+/* A folder moved away keeps its descriptors, they would report under the old name. */
+static void watch_inotify_drop_tree(Watch_Backend* backend, const char* relative)
+{
+	size_t length = strlen(relative);
+	for (ptrdiff_t i = 0; i < naui_intmap_len(backend->dirs); ++i)
+	{
+		const char* dir = backend->dirs[i].value;
+		if (strncmp(dir, relative, length) == 0 && (dir[length] == '\0' || dir[length] == '/'))
+			inotify_rm_watch(backend->fd, backend->dirs[i].key);
+	}
+}
+
+static bool watch_backend_open(Watch_Backend* backend, struct Watch_Entry* owner, const Naui_Path folder)
+{
+	memset(backend, 0, sizeof(*backend));
+	snprintf(backend->folder, sizeof(backend->folder), "%s", folder.data);
+	backend->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (backend->fd < 0)
+		return false;
+
+	if (!watch_inotify_add_tree(backend, owner, "", false))
+	{
+		close(backend->fd);
+		backend->fd = -1;
+		return false;
+	}
+
+	return true;
+}
+
+static void watch_backend_close(Watch_Backend* backend)
+{
+	for (ptrdiff_t i = 0; i < naui_intmap_len(backend->dirs); ++i)
+	{
+		free(backend->dirs[i].value);
+	}
+
+	naui_intmap_free(backend->dirs);
+	if (backend->fd >= 0)
+		close(backend->fd);
+
+	backend->fd = -1;
+}
+
+static void watch_backend_read(Watch_Backend* backend, struct Watch_Entry* owner)
+{
+	char buffer[16 * 1024] __attribute__((aligned(__alignof__(struct inotify_event))));
+	for (;;)
+	{
+		ssize_t n = read(backend->fd, buffer, sizeof(buffer));
+		if (n <= 0)
+			break;
+
+		for (ssize_t offset = 0; offset < n;)
+		{
+			const struct inotify_event* ev = (const struct inotify_event*)(buffer + offset);
+			offset += (ssize_t)sizeof(struct inotify_event) + ev->len;
+
+			if (ev->mask & IN_Q_OVERFLOW)
+			{
+				watch_record(owner, "", 0, NAUI_WATCH_OVERFLOW);
+				continue;
+			}
+
+			ptrdiff_t dir = naui_intmap_get_index(backend->dirs, ev->wd);
+			if (dir < 0)
+				continue;
+
+			if (ev->mask & IN_IGNORED)
+			{
+				free(backend->dirs[dir].value);
+				naui_intmap_del(backend->dirs, ev->wd);
+				continue;
+			}
+
+			if (ev->len == 0 || ev->name[0] == '\0')
+				continue;
+
+			char path[NAUI_PATH_MAX];
+			const char* parent = backend->dirs[dir].value;
+			int length = parent[0] ? snprintf(path, sizeof(path), "%s/%s", parent, ev->name) : snprintf(path, sizeof(path), "%s", ev->name);
+			if (length <= 0 || (size_t)length >= sizeof(path))
+				continue;
+
+			Naui_WatchEvent events = 0;
+			if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+				events |= NAUI_WATCH_CREATED;
+
+			if (ev->mask & (IN_MODIFY | IN_CLOSE_WRITE))
+				events |= NAUI_WATCH_MODIFIED;
+
+			if (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+				events |= NAUI_WATCH_DELETED;
+
+			if (ev->mask & IN_ISDIR)
+			{
+				if (ev->mask & IN_MOVED_FROM)
+					watch_inotify_drop_tree(backend, path);
+				else if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+					watch_inotify_add_tree(backend, owner, path, true);
+			}
+
+			if (events)
+				watch_record(owner, path, (size_t)length, events);
+		}
+	}
+}
+
+#else
+
+typedef struct { int _unused; } Watch_Backend;
+
+static bool watch_backend_open(Watch_Backend* backend, struct Watch_Entry* owner, const Naui_Path folder)
+{
+	(void)backend;
+	(void)owner;
+	fprintf(stderr, "[Naui] naui_watch_add: watching '%s' is not supported on this platform\n", folder.data);
+	return false;
+}
+
+static void watch_backend_close(Watch_Backend* backend)
+{
+	(void)backend;
+}
+
+static void watch_backend_read(Watch_Backend* backend, struct Watch_Entry* owner)
+{
+	(void)backend;
+	(void)owner;
+}
+
+#endif
+#endif
@@ -0,0 +1,137 @@
+#if defined(_WIN32) || defined(_WIN64)
+
+struct Watch_Entry;
+static void watch_record(struct Watch_Entry* entry, const char* relative, size_t length, Naui_WatchEvent events);
+
+#define NAUI_WATCH_NOTIFY_FILTER (FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_CREATION)
+
+/* One overlapped ReadDirectoryChangesW per watch, it covers the whole subtree on its own. */
+typedef struct
+{
+	HANDLE dir;
+	OVERLAPPED overlapped;
+	bool is_reading;
+	DWORD buffer[16 * 1024];
+} Watch_Backend;
+
+static uint64_t watch_now_ms(void)
+{
+	return (uint64_t)GetTickCount64();
+}
+
+static bool watch_win32_issue(Watch_Backend* backend)
+{
+	ResetEvent(backend->overlapped.hEvent);
+	backend->is_reading = ReadDirectoryChangesW(backend->dir, backend->buffer, sizeof(backend->buffer), TRUE, NAUI_WATCH_NOTIFY_FILTER, NULL, &backend->overlapped, NULL) != 0;
+	return backend->is_reading;
+}
+
+static bool watch_backend_open(Watch_Backend* backend, struct Watch_Entry* owner, const Naui_Path folder)
+{
+	(void)owner;
+	memset(backend, 0, sizeof(*backend));
+	backend->dir = INVALID_HANDLE_VALUE;
+
+	wchar_t wpath[NAUI_PATH_MAX];
+	if (!to_wide(folder.data, wpath))
+		return false;
+
+	backend->dir = CreateFileW(wpath, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+	if (backend->dir == INVALID_HANDLE_VALUE)
+		return false;
+
+	backend->overlapped.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+	if (!backend->overlapped.hEvent || !watch_win32_issue(backend))
+	{
+		if (backend->overlapped.hEvent)
+			CloseHandle(backend->overlapped.hEvent);
+
+		CloseHandle(backend->dir);
+		backend->dir = INVALID_HANDLE_VALUE;
+		return false;
+	}
+
+	return true;
+}
+
+static void watch_backend_close(Watch_Backend* backend)
+{
+	if (backend->dir == INVALID_HANDLE_VALUE)
+		return;
+
+	/* The buffer belongs to the kernel until the cancelled read completes. */
+	if (backend->is_reading)
+	{
+		DWORD bytes;
+		CancelIoEx(backend->dir, &backend->overlapped);
+		GetOverlappedResult(backend->dir, &backend->overlapped, &bytes, TRUE);
+	}
+
+	CloseHandle(backend->overlapped.hEvent);
+	CloseHandle(backend->dir);
+	backend->dir = INVALID_HANDLE_VALUE;
+}
+
+static void watch_backend_read(Watch_Backend* backend, struct Watch_Entry* owner)
+{
+	while (backend->is_reading)
+	{
+		DWORD bytes = 0;
+		if (!GetOverlappedResult(backend->dir, &backend->overlapped, &bytes, FALSE))
+		{
+			if (GetLastError() == ERROR_IO_INCOMPLETE)
+				return;
+
+			backend->is_reading = false;
+			watch_record(owner, "", 0, NAUI_WATCH_OVERFLOW);
+			return;
+		}
+
+		/* A completed read with nothing in it means the buffer overflowed. */
+		if (bytes == 0)
+			watch_record(owner, "", 0, NAUI_WATCH_OVERFLOW);
+
+		const uint8_t* cursor = (const uint8_t*)backend->buffer;
+		for (DWORD offset = 0; bytes > 0;)
+		{
+			const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)(cursor + offset);
+
+			char path[NAUI_PATH_MAX];
+			int length = WideCharToMultiByte(CP_UTF8, 0, info->FileName, (int)(info->FileNameLength / sizeof(WCHAR)), path, (int)sizeof(path) - 1, NULL, NULL);
+
+			Naui_WatchEvent events = 0;
+			switch (info->Action)
+			{
+				case FILE_ACTION_ADDED:
+				case FILE_ACTION_RENAMED_NEW_NAME:
+					events = NAUI_WATCH_CREATED;
+					break;
+
+				case FILE_ACTION_REMOVED:
+				case FILE_ACTION_RENAMED_OLD_NAME:
+					events = NAUI_WATCH_DELETED;
+					break;
+
+				case FILE_ACTION_MODIFIED:
+					events = NAUI_WATCH_MODIFIED;
+					break;
+			}
+
+			if (length > 0 && events)
+			{
+				path[length] = '\0';
+				watch_record(owner, path, (size_t)length, events);
+			}
+
+			if (info->NextEntryOffset == 0)
+				break;
+
+			offset += info->NextEntryOffset;
+		}
+
+		if (!watch_win32_issue(backend))
+			watch_record(owner, "", 0, NAUI_WATCH_OVERFLOW);
+	}
+}
+
+#endif
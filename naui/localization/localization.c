@@ -4,6 +4,12 @@ static Naui_Language g_current_language;
 static Naui_List(Naui_LanguageMeta) g_meta_cache = NULL;
 static bool g_current_loaded = false;
 static bool g_meta_cache_init = false;
+static char g_current_code[NAUI_LOCALIZATION_NAME_SIZE];
+
+#if NAUI_HOT_RELOAD
+static Naui_WatchHandle g_language_watch;
+static bool g_meta_cache_stale = false;
+#endif
 
 static char* naui_strdup_(const char* s)
 {
@@ -229,13 +235,51 @@ bool naui_localization_load(const char* language_code, Naui_Language* out_langua
 	return ok;
 }
 
+#if NAUI_HOT_RELOAD
+static void naui_localization_changed_(const Naui_WatchChange* change, void* user)
+{
+	(void)user;
+	const char* dot = strrchr(change->relative, '.');
+	bool is_lang = dot && strcmp(dot, ".lang") == 0;
+	if (!is_lang && !(change->events & NAUI_WATCH_OVERFLOW))
+		return;
+
+	g_meta_cache_stale = true;
+
+	/* Only the active language is loaded again, the rest is picked up with the metadata. */
+	char file_name[NAUI_LOCALIZATION_NAME_SIZE + 8];
+	snprintf(file_name, sizeof(file_name), "%s.lang", g_current_code);
+	if (g_current_code[0] && ((change->events & NAUI_WATCH_OVERFLOW) || strcmp(change->relative, file_name) == 0))
+	{
+		char code[NAUI_LOCALIZATION_NAME_SIZE];
+		memcpy(code, g_current_code, sizeof(code));
+		naui_localization_set_current(code);
+	}
+}
+
+static void naui_localization_watch_(void)
+{
+	if (naui_watch_is_valid(g_language_watch))
+		return;
+
+	Naui_Path bin_dir = naui_directory_get(NAUI_DIR_BIN);
+	Naui_Path lang_dir = naui_path_join(bin_dir, naui_path_from_cstr("Language"));
+	if (naui_path_is_directory(lang_dir))
+		g_language_watch = naui_watch_add(lang_dir, 0, naui_localization_changed_, NULL);
+}
+#endif
+
 void naui_localization_set_current(const char* language_code)
 {
 	Naui_Language new_lang;
+	const char* loaded_code = language_code;
 	bool ok = naui_localization_load(language_code, &new_lang);
 
 	if (!ok && (!language_code || strcmp(language_code, "en-US") != 0))
-		ok = naui_localization_load("en-US", &new_lang);
+	{
+		loaded_code = "en-US";
+		ok = naui_localization_load(loaded_code, &new_lang);
+	}
 
 	if (!ok)
 		return;
@@ -245,6 +289,11 @@ void naui_localization_set_current(const char* language_code)
 
 	g_current_language = new_lang;
 	g_current_loaded = true;
+	snprintf(g_current_code, sizeof(g_current_code), "%s", loaded_code);
+
+#if NAUI_HOT_RELOAD
+	naui_localization_watch_();
+#endif
 }
 
 void naui_localization_set_current_lang(Naui_Language* lang)
@@ -257,6 +306,7 @@ void naui_localization_set_current_lang(Naui_Language* lang)
 
 	g_current_language = *lang;
 	g_current_loaded = true;
+	g_current_code[0] = '\0';
 	memset(lang, 0, sizeof(*lang));
 }
 
@@ -268,6 +318,30 @@ Naui_Language* naui_localization_get_current(void)
 	return &g_current_language;
 }
 
+void naui_localization_shutdown(void)
+{
+	if (g_current_loaded)
+		naui_localization_free(&g_current_language);
+
+	g_current_loaded = false;
+	g_current_code[0] = '\0';
+
+	for (ptrdiff_t i = 0; i < naui_list_len(g_meta_cache); ++i)
+	{
+		naui_meta_free_(&g_meta_cache[i]);
+	}
+
+	naui_list_free(g_meta_cache);
+	g_meta_cache = NULL;
+	g_meta_cache_init = false;
+
+#if NAUI_HOT_RELOAD
+	naui_watch_remove(g_language_watch);
+	g_language_watch = NAUI_WATCH_INVALID;
+	g_meta_cache_stale = false;
+#endif
+}
+
 void naui_localization_reload_meta_cache(void)
 {
 	if (g_meta_cache_init)
@@ -314,6 +388,14 @@ void naui_localization_reload_meta_cache(void)
 
 Naui_List(Naui_LanguageMeta) naui_localization_get_languages(void)
 {
+#if NAUI_HOT_RELOAD
+	if (g_meta_cache_stale)
+	{
+		g_meta_cache_stale = false;
+		naui_localization_reload_meta_cache();
+	}
+#endif
+
 	if (!g_meta_cache_init)
 		naui_localization_reload_meta_cache();
 
@@ -38,6 +38,9 @@ void naui_localization_set_current_lang(Naui_Language* language);
 /* Returns the currently active language, or NULL if none loaded. */
 Naui_Language* naui_localization_get_current(void);
 
+/* Free the active language and the metadata cache, and stop watching the language folder. */
+void naui_localization_shutdown(void);
+
 /* Rebuild the metadata cache from all .lang files in the language subfolder. */
 void naui_localization_reload_meta_cache(void);
 
@@ -2,7 +2,30 @@
 
 static Naui_ImageHashEntry *image_hm = NULL;
 
-void naui_asset_manager_load_images(const char *const images_path)
+#if NAUI_HOT_RELOAD
+// the atlas stays in memory so a changed image can be patched in without decoding the rest
+static uint8_t *atlas_pixels = NULL;
+static char images_dir[NAUI_PATH_MAX];
+static Naui_WatchHandle images_watch;
+
+static void images_changed(const Naui_WatchChange *change, void *user);
+#endif
+
+static void free_image_map(Naui_ImageHashEntry *hm)
+{
+    for (ptrdiff_t i = 0; i < naui_strmap_len(hm); ++i)
+        free(hm[i].key);
+    naui_strmap_free(hm);
+}
+
+static void free_images(void)
+{
+    free_image_map(image_hm);
+    image_hm = NULL;
+}
+
+// builds the whole image map and atlas aside, the current ones are only replaced once it succeeded
+static bool load_images(const char *const images_path)
 {
     typedef struct
     {
@@ -11,60 +34,59 @@ void naui_asset_manager_load_images(const char *const images_path)
     }
     Naui_TempImageData;
 
+    if (!naui_vfs_exists(images_path))
+    {
+        fprintf(stderr, "[Naui]: failed to open %s directory for images\n", images_path);
+        return false;
+    }
+
     Naui_List(Naui_TempImageData) images = NULL;
+    Naui_ImageHashEntry *hm = NULL;
     Naui_Arena temp_arena = { 0 };
+    bool ok = true;
 
     // looping thru the images directory.
     {
-        struct dirent *dp;
-        DIR *dir = opendir(images_path);
-        if (!dir)
-        {
-            fprintf(stderr, "[Naui]: failed to open %s directory for images\n", images_path);
-            exit(1);
-        }
-
-        char path[256] = {0};
-        char cwd[512];
-#if NAUI_WINDOWS
-        _getcwd(cwd, sizeof(cwd));
-#else
-        getcwd(cwd, sizeof(cwd));
-#endif
-
-        while ((dp = readdir(dir)))
+        Naui_List(const char*) files = naui_vfs_list(images_path);
+        for (size_t i = 0; i < (size_t)naui_list_len(files); ++i)
         {
-            if (strcmp(dp->d_name, ".") == 0 || strcmp(dp->d_name, "..") == 0) continue;
+            const char *path = files[i];
+            const char *file_name = strrchr(path, '/');
+            file_name = file_name ? file_name + 1 : path;
 
-            // this is a hack, use getcwd instead.
-            snprintf(path, sizeof(path), "%s/%s", images_path, dp->d_name);
             char name[128];
-            strncpy(name, dp->d_name, sizeof(name));
+            strncpy(name, file_name, sizeof(name));
             name[sizeof(name) - 1] = '\0';
             char *image_name = strtok(name, "."); // this is also a hack, should iterate backwards thru str instead.
 
             Naui_TempImageData image;
             {
-                Naui_FileHandle file_handle;
-                naui_file_open(&file_handle, NAUI_PATH(path), NAUI_FILE_READ);
-                const size_t file_len = naui_file_size(NAUI_PATH(path));
-                uint8_t *file_data = (uint8_t*)naui_arena_alloc(&temp_arena, file_len);
-                naui_file_read(&file_handle, file_data, file_len);
-                naui_file_close(&file_handle);
-
-                int32_t temp_channels;
-                image.pixels = stbi_load_from_memory(file_data, file_len, &image.width, &image.height, &temp_channels, 4);
+                Naui_VfsFile file;
+                image.pixels = NULL;
+                if (naui_vfs_read(path, &file))
+                {
+                    int32_t temp_channels;
+                    image.pixels = stbi_load_from_memory(file.data, (int)file.size, &image.width, &image.height, &temp_channels, 4);
+                    naui_vfs_release(&file);
+                }
+
                 if (!image.pixels) naui_log(NAUI_LOG_FUCKED, "failed to load image: %s\n", path);
             }
 
             const Naui_Image sprite = (Naui_Image){ .width = (uint32_t)image.width, .height = (uint32_t)image.height };
-            naui_strmap_put(image_hm, strdup(image_name), sprite);
+            naui_strmap_put(hm, strdup(image_name), sprite);
             naui_list_push(images, image);
         }
+
+        naui_list_free(files);
     }
     
     if (naui_list_len(images) == 0)
-        return;
+    {
+        free_images();
+        image_hm = hm;
+        return true;
+    }
 
     naui_arena_reset(&temp_arena);
 
@@ -77,8 +99,6 @@ void naui_asset_manager_load_images(const char *const images_path)
         stbrp_context ctx;
         stbrp_node *nodes = (stbrp_node*)naui_arena_alloc(&temp_arena, sizeof(*nodes) * node_count);
         stbrp_rect *rects = (stbrp_rect*)naui_arena_alloc(&temp_arena, sizeof(*rects) * image_count);
-        uint8_t *pixels =      (uint8_t*)naui_arena_alloc(&temp_arena, atlas_size);
-
         stbrp_init_target(&ctx, NAUI_IMAGE_ATLAS_SIZE, NAUI_IMAGE_ATLAS_SIZE, nodes, node_count);
         for (int i=0; i < image_count; ++i)
         {
@@ -88,16 +108,27 @@ void naui_asset_manager_load_images(const char *const images_path)
             r->id = i;
         }
 
+#if NAUI_HOT_RELOAD
+        uint8_t *pixels = (uint8_t*)malloc(atlas_size);
+#else
+        uint8_t *pixels =      (uint8_t*)naui_arena_alloc(&temp_arena, atlas_size);
+#endif
+
         if (!stbrp_pack_rects(&ctx, rects, image_count))
         {
             fprintf(stderr, "[Naui]: image atlas size is not enough\n");
-            exit(1);
+            ok = false;
+        }
+        else if (!pixels)
+        {
+            fprintf(stderr, "[Naui]: failed to allocate the image atlas\n");
+            ok = false;
         }
 
-        for (int i = 0; i < image_count; ++i)
+        for (int i = 0; i < image_count && ok; ++i)
         {
             const stbrp_rect r = rects[i];
-            Naui_Image *sprite = &image_hm[i].value;
+            Naui_Image *sprite = &hm[i].value;
 
             for (int y = 0; y < r.h; ++y)
             {
@@ -113,17 +144,117 @@ void naui_asset_manager_load_images(const char *const images_path)
             sprite->texture_area[3] = (float)r.h * inv_img_atlas_size;
         }
 
-        extern void naui_renderer_build_atlas(uint32_t width, uint32_t height, void *data);
-        naui_renderer_build_atlas(NAUI_IMAGE_ATLAS_SIZE, NAUI_IMAGE_ATLAS_SIZE, pixels);
+        if (ok)
+        {
+            free_images();
+            image_hm = hm;
+#if NAUI_HOT_RELOAD
+            free(atlas_pixels);
+            atlas_pixels = pixels;
+#endif
+            extern void naui_renderer_build_atlas(uint32_t width, uint32_t height, void *data);
+            naui_renderer_build_atlas(NAUI_IMAGE_ATLAS_SIZE, NAUI_IMAGE_ATLAS_SIZE, pixels);
+        }
+        else
+        {
+            free_image_map(hm);
+#if NAUI_HOT_RELOAD
+            free(pixels);
+#endif
+        }
     }
 
+    for (size_t i = 0; i < (size_t)naui_list_len(images); ++i)
+        stbi_image_free(images[i].pixels);
     naui_arena_free(&temp_arena);
     naui_list_free(images);
+    return ok;
 }
 
+void naui_asset_manager_load_images(const char *const images_path)
+{
+    if (!load_images(images_path))
+        exit(1);
+
+#if NAUI_HOT_RELOAD
+    if (images_dir != images_path)
+        snprintf(images_dir, sizeof(images_dir), "%s", images_path);
+    if (!naui_watch_is_valid(images_watch) && naui_path_is_directory(naui_path_from_cstr(images_path)))
+        images_watch = naui_watch_add(naui_path_from_cstr(images_path), 0, images_changed, NULL);
+#endif
+}
+
+#if NAUI_HOT_RELOAD
+// copies an edited image over its old spot in the atlas, false when it is new or changed size
+static bool reload_image(const char *path)
+{
+    const char *file_name = strrchr(path, '/');
+#if defined(_WIN32)
+    if (strrchr(path, '\\') > file_name)
+        file_name = strrchr(path, '\\');
+#endif
+    file_name = file_name ? file_name + 1 : path;
+
+    char name[128];
+    strncpy(name, file_name, sizeof(name));
+    name[sizeof(name) - 1] = '\0';
+    char *image_name = strtok(name, ".");
+
+    if (!atlas_pixels || !image_name || naui_strmap_get_index(image_hm, image_name) < 0)
+        return false;
+
+    Naui_Image *sprite = &naui_strmap_get(image_hm, image_name);
+
+    int32_t width = 0, height = 0, channels;
+    uint8_t *pixels = NULL;
+    Naui_VfsFile file;
+    if (naui_vfs_read(path, &file))
+    {
+        pixels = stbi_load_from_memory(file.data, (int)file.size, &width, &height, &channels, 4);
+        naui_vfs_release(&file);
+    }
+
+    if (!pixels || (uint32_t)width != sprite->width || (uint32_t)height != sprite->height)
+    {
+        stbi_image_free(pixels);
+        return false;
+    }
+
+    const int32_t x = (int32_t)(sprite->texture_area[0] * NAUI_IMAGE_ATLAS_SIZE + 0.5f);
+    const int32_t y = (int32_t)(sprite->texture_area[1] * NAUI_IMAGE_ATLAS_SIZE + 0.5f);
+    for (int32_t row = 0; row < height; ++row)
+        memcpy(atlas_pixels + ((y + row) * NAUI_IMAGE_ATLAS_SIZE + x) * 4, pixels + row * width * 4, (size_t)width * 4);
+
+    stbi_image_free(pixels);
+
+    extern void naui_renderer_update_atlas(uint32_t width, uint32_t height, void *data);
+    naui_renderer_update_atlas(NAUI_IMAGE_ATLAS_SIZE, NAUI_IMAGE_ATLAS_SIZE, atlas_pixels);
+    return true;
+}
+
+static void images_changed(const Naui_WatchChange *change, void *user)
+{
+    (void)user;
+    if (!(change->events & (NAUI_WATCH_DELETED | NAUI_WATCH_OVERFLOW)) && reload_image(change->path))
+        return;
+
+    // added, removed or resized images need a new layout, everything is packed again.
+    // a reload that fails keeps the images and the atlas already on screen.
+    naui_vfs_refresh();
+    if (!load_images(images_dir))
+        fprintf(stderr, "[Naui]: keeping the current image atlas\n");
+}
+#endif
+
 void naui_asset_manager_free(void)
 {
-    naui_strmap_free(image_hm);
+#if NAUI_HOT_RELOAD
+    naui_watch_remove(images_watch);
+    images_watch = NAUI_WATCH_INVALID;
+    free(atlas_pixels);
+    atlas_pixels = NULL;
+#endif
+    free_images();
 }
 
 Naui_Image *naui_get_image(const char *const name)
@@ -545,6 +545,10 @@ static void naui_push_corner_ring(Naui_Vec2 center, float inner_r, float outer_r
 
 void naui_renderer_build_atlas(uint32_t width, uint32_t height, void *data)
 {
+    // a full image reload builds the atlas again
+    if (rdata->image_atlas)
+        mgfx_destroy_image(rdata->image_atlas);
+
     rdata->image_atlas = mgfx_create_image(&(mgfx_image_create_info){
         .type = MGFX_IMAGE_TYPE_2D,
         .format = MGFX_FORMAT_RGBA8_UNORM,
@@ -555,6 +559,11 @@ void naui_renderer_build_atlas(uint32_t width, uint32_t height, void *data)
     });
 }
 
+void naui_renderer_update_atlas(uint32_t width, uint32_t height, void *data)
+{
+    mgfx_update_image(rdata->image_atlas, (size_t)width * height * 4, data);
+}
+
 void naui_renderer_initialize(void)
 {
     rdata = calloc(1, sizeof(Naui_RendererData));
@@ -881,30 +890,21 @@ void naui_load_font(uint8_t index, const char *file_name)
     strncat(final_file_name, ".ttf", sizeof(final_file_name) - 1);
 
 	Naui_Path font_path = NAUI_PATH("Assets/Fonts", final_file_name);
-    FILE *f = fopen(font_path.data, "rb");
-	
-    if (!f) return;
-
-    fseek(f, 0, SEEK_END);
-    long size = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    uint8_t *ttf_buf = malloc(size);
-    if (!ttf_buf) { fclose(f); return; }
-    fread(ttf_buf, 1, size, f);
-    fclose(f);
+    Naui_VfsFile file;
+    if (!naui_vfs_read(font_path.data, &file)) return;
 
     naui_unload_font(index);
 
     stbtt_fontinfo info;
-    if (!stbtt_InitFont(&info, ttf_buf, 0))
+    if (!stbtt_InitFont(&info, file.data, 0))
     {
-        free(ttf_buf);
+        naui_vfs_release(&file);
         return;
     }
 
-    bool loaded = naui_bake_font_size(ttf_buf, &info, NAUI_FONT_BAKE_SIZE, &rdata->font[index]);
+    bool loaded = naui_bake_font_size(file.data, &info, NAUI_FONT_BAKE_SIZE, &rdata->font[index]);
 
-    free(ttf_buf);
+    naui_vfs_release(&file);
     rdata->font_loaded[index] = loaded;
 }
 
@@ -1,4 +1,9 @@
 #pragma region Static Functions
+static bool is_json_space(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
 static Naui_JsonValue* arena_value(Naui_Json* json)
 {
 	return (Naui_JsonValue*)naui_arena_alloc(&json->_arena, sizeof(Naui_JsonValue));
@@ -20,160 +25,369 @@ static const char* arena_str(Naui_Json* json, const char* src, size_t len)
 	return dst;
 }
 
-static bool build_object(Naui_Json* json, Naui_JsonReader* reader, Naui_JsonValue* obj);
-static bool build_array(Naui_Json* json, Naui_JsonReader* reader, Naui_JsonValue* arr)
+#define NAUI_JSON_RECYCLE_CLASSES 64
+#define NAUI_JSON_MIN_CAP 8
+
+/*
+ * Parse scratch: children of every open container are gathered on one heap stack,
+ * so each container gets a single exactly-sized arena array once it closes.
+ */
+typedef struct
 {
-	arr->type = NAUI_JSON_ARRAY;
-	arr->array.items = NULL;
-	arr->array.count = 0;
-	arr->array.cap = 0;
+	Naui_Json* json;
+	Naui_JsonValue* stack;
+	size_t len;
+	size_t cap;
+} Json_Builder;
 
-	while (1)
+static bool builder_push(Json_Builder* builder, const Naui_JsonValue* value)
+{
+	if (builder->len >= builder->cap)
 	{
-		Naui_JsonToken t = naui_json_reader_next(reader);
-		if (t == NAUI_JSON_TOKEN_ARRAY_END)
-			return true;
-
-		if (t == NAUI_JSON_TOKEN_ERROR || t == NAUI_JSON_TOKEN_EOF)
+		size_t new_cap = builder->cap ? builder->cap * 2 : 64;
+		Naui_JsonValue* tmp = (Naui_JsonValue*)realloc(builder->stack, new_cap * sizeof(Naui_JsonValue));
+		if (!tmp)
 			return false;
 
-		if (arr->array.count >= arr->array.cap)
-		{
-			size_t new_cap = arr->array.cap ? arr->array.cap * 2 : 8;
-			Naui_JsonValue* tmp = arena_values(json, new_cap);
-			if (!tmp)
-				return false;
+		builder->stack = tmp;
+		builder->cap = new_cap;
+	}
 
-			if (arr->array.items)
-				memcpy(tmp, arr->array.items, arr->array.count * sizeof(Naui_JsonValue));
+	builder->stack[builder->len++] = *value;
+	return true;
+}
 
-			arr->array.items = tmp;
-			arr->array.cap = new_cap;
-		}
+/* Moves everything above `base` into the arena and pops it. */
+static Naui_JsonValue* builder_pop(Json_Builder* builder, size_t base)
+{
+	size_t count = builder->len - base;
+	builder->len = base;
+	if (count == 0)
+		return NULL;
 
-		Naui_JsonValue* slot = &arr->array.items[arr->array.count++];
-		memset(slot, 0, sizeof(*slot));
+	Naui_JsonValue* items = arena_values(builder->json, count);
+	if (items)
+		memcpy(items, builder->stack + base, count * sizeof(Naui_JsonValue));
 
-		switch (t)
-		{
-			case NAUI_JSON_TOKEN_NULL:
-				slot->type = NAUI_JSON_NULL;
-				break;
+	return items;
+}
 
-			case NAUI_JSON_TOKEN_BOOL:
-				slot->type = NAUI_JSON_BOOL;
-				slot->boolean = reader->boolean;
-				break;
+static bool build_object(Json_Builder* builder, Naui_JsonReader* reader, Naui_JsonValue* obj);
+static bool build_array(Json_Builder* builder, Naui_JsonReader* reader, Naui_JsonValue* arr);
 
-			case NAUI_JSON_TOKEN_NUMBER:
-				slot->type = NAUI_JSON_NUMBER;
-				slot->number = reader->number;
-				break;
+/* Fills `slot` from the token the reader just produced, descending into containers. */
+static bool build_value(Json_Builder* builder, Naui_JsonReader* reader, Naui_JsonToken t, Naui_JsonValue* slot)
+{
+	switch (t)
+	{
+		case NAUI_JSON_TOKEN_NULL:
+			slot->type = NAUI_JSON_NULL;
+			return true;
 
-			case NAUI_JSON_TOKEN_STRING:
-				slot->type = NAUI_JSON_STRING;
-				slot->string.ptr = reader->str;
-				slot->string.len = reader->len;
-				break;
+		case NAUI_JSON_TOKEN_BOOL:
+			slot->type = NAUI_JSON_BOOL;
+			slot->boolean = reader->boolean;
+			return true;
 
-			case NAUI_JSON_TOKEN_OBJECT_BEGIN:
-				if (!build_object(json, reader, slot))
-					return false;
+		case NAUI_JSON_TOKEN_NUMBER:
+			slot->type = NAUI_JSON_NUMBER;
+			slot->number = reader->number;
+			return true;
 
-				break;
+		case NAUI_JSON_TOKEN_STRING:
+			slot->type = NAUI_JSON_STRING;
+			slot->string.ptr = reader->str;
+			slot->string.len = reader->len;
+			return true;
 
-			case NAUI_JSON_TOKEN_ARRAY_BEGIN:
-				if (!build_array(json, reader, slot))
-					return false;
+		case NAUI_JSON_TOKEN_OBJECT_BEGIN:
+			return build_object(builder, reader, slot);
 
-				break;
+		case NAUI_JSON_TOKEN_ARRAY_BEGIN:
+			return build_array(builder, reader, slot);
 
-			default:
-				return false;
-		}
+		default:
+			return false;
 	}
 }
 
-static bool build_object(Naui_Json* json, Naui_JsonReader* reader, Naui_JsonValue* obj)
+static bool build_array(Json_Builder* builder, Naui_JsonReader* reader, Naui_JsonValue* arr)
 {
-	obj->type = NAUI_JSON_OBJECT;
-	obj->object.pairs = NULL;
-	obj->object.count = 0;
-	obj->object.cap = 0;
-
+	size_t base = builder->len;
 	while (1)
 	{
 		Naui_JsonToken t = naui_json_reader_next(reader);
-		if (t == NAUI_JSON_TOKEN_OBJECT_END)
-			return true;
+		if (t == NAUI_JSON_TOKEN_ARRAY_END)
+			break;
 
 		if (t == NAUI_JSON_TOKEN_ERROR || t == NAUI_JSON_TOKEN_EOF)
 			return false;
 
+		Naui_JsonValue value;
+		memset(&value, 0, sizeof(value));
+		if (!build_value(builder, reader, t, &value) || !builder_push(builder, &value))
+			return false;
+	}
+
+	size_t count = builder->len - base;
+	arr->type = NAUI_JSON_ARRAY;
+	arr->array.items = builder_pop(builder, base);
+	arr->array.count = count;
+	arr->array.cap = count;
+	return count == 0 || arr->array.items;
+}
+
+static bool build_object(Json_Builder* builder, Naui_JsonReader* reader, Naui_JsonValue* obj)
+{
+	size_t base = builder->len;
+	while (1)
+	{
+		Naui_JsonToken t = naui_json_reader_next(reader);
+		if (t == NAUI_JSON_TOKEN_OBJECT_END)
+			break;
+
 		if (t != NAUI_JSON_TOKEN_KEY)
 			return false;
 
-		if (obj->object.count + 2 > obj->object.cap)
-		{
-			size_t new_cap = obj->object.cap ? obj->object.cap * 2 : 16;
-			Naui_JsonValue* tmp = arena_values(json, new_cap);
-			if (!tmp)
-				return false;
+		Naui_JsonValue key;
+		memset(&key, 0, sizeof(key));
+		key.type = NAUI_JSON_STRING;
+		key.string.ptr = reader->str;
+		key.string.len = reader->len;
+		if (!builder_push(builder, &key))
+			return false;
 
-			if (obj->object.pairs)
-				memcpy(tmp, obj->object.pairs, obj->object.count * sizeof(Naui_JsonValue));
+		Naui_JsonValue value;
+		memset(&value, 0, sizeof(value));
+		if (!build_value(builder, reader, naui_json_reader_next(reader), &value) || !builder_push(builder, &value))
+			return false;
+	}
 
-			obj->object.pairs = tmp;
-			obj->object.cap = new_cap;
+	size_t count = builder->len - base;
+	obj->type = NAUI_JSON_OBJECT;
+	obj->object.pairs = builder_pop(builder, base);
+	obj->object.count = count;
+	obj->object.cap = count;
+	return count == 0 || obj->object.pairs;
+}
+
+static size_t recycle_class(size_t cap)
+{
+	size_t c = 0;
+	while (c + 1 < NAUI_JSON_RECYCLE_CLASSES && ((size_t)2 << c) <= cap)
+	{
+		++c;
+	}
+
+	return c;
+}
+
+/*
+ * Grows a builder-owned array. The arena extends it in place when it can,
+ * otherwise the old array is kept on a per-size free list for the next container that grows.
+ */
+static Naui_JsonValue* grow_values(Naui_Json* json, Naui_JsonValue* values, size_t count, size_t* cap)
+{
+	size_t old_cap = *cap;
+	size_t new_cap = old_cap ? old_cap * 2 : NAUI_JSON_MIN_CAP;
+	if (values)
+	{
+		Naui_JsonValue* resized = (Naui_JsonValue*)naui_arena_resize(&json->_arena, values, old_cap * sizeof(Naui_JsonValue), new_cap * sizeof(Naui_JsonValue));
+		if (resized)
+		{
+			*cap = new_cap;
+			return resized;
 		}
+	}
+
+	if (!json->_recycled)
+	{
+		json->_recycled = (Naui_JsonValue**)naui_arena_alloc(&json->_arena, NAUI_JSON_RECYCLE_CLASSES * sizeof(Naui_JsonValue*));
+		if (!json->_recycled)
+			return NULL;
+	}
 
-		Naui_JsonValue* key_slot = &obj->object.pairs[obj->object.count++];
-		key_slot->type = NAUI_JSON_STRING;
-		key_slot->string.ptr = reader->str;
-		key_slot->string.len = reader->len;
+	/* Free arrays link through their first value, a class holds arrays of at least 2^class values. */
+	size_t take = recycle_class(new_cap);
+	if (((size_t)1 << take) < new_cap && take + 1 < NAUI_JSON_RECYCLE_CLASSES)
+		++take;
 
-		Naui_JsonValue* val_slot = &obj->object.pairs[obj->object.count++];
-		memset(val_slot, 0, sizeof(*val_slot));
-		t = naui_json_reader_next(reader);
-		
-		switch (t)
+	Naui_JsonValue* tmp = json->_recycled[take];
+	if (tmp && ((size_t)1 << take) >= new_cap)
+	{
+		json->_recycled[take] = tmp->array.items;
+		new_cap = (size_t)1 << take;
+		memset(tmp, 0, new_cap * sizeof(Naui_JsonValue));
+	}
+	else
+	{
+		tmp = arena_values(json, new_cap);
+		if (!tmp)
+			return NULL;
+	}
+
+	if (values)
+	{
+		memcpy(tmp, values, count * sizeof(Naui_JsonValue));
+		if (old_cap >= NAUI_JSON_MIN_CAP)
 		{
-			case NAUI_JSON_TOKEN_NULL:
-				val_slot->type = NAUI_JSON_NULL;
-				break;
+			size_t put = recycle_class(old_cap);
+			values->array.items = json->_recycled[put];
+			json->_recycled[put] = values;
+		}
+	}
+
+	*cap = new_cap;
+	return tmp;
+}
+
+#define NAUI_JSON_PARALLEL_MIN_CHUNK (64 * 1024)
+
+typedef struct
+{
+	size_t start;
+	size_t end;
+} Json_Span;
+
+typedef struct
+{
+	const char* src;
+	const Json_Span* spans;
+	Naui_JsonValue* items;
+	size_t first;
+	size_t count;
+	Naui_Json part;
+	bool failed;
+} Json_ParseChunk;
+
+/*
+ * Structural scan of a top-level array: records the byte span of every element without parsing it.
+ * Only brackets, quotes and escapes are looked at, anything malformed is left for the full parse to report.
+ */
+static bool scan_array_elements(const char* src, size_t len, Naui_List(Json_Span)* spans)
+{
+	size_t i = 0;
+	while (i < len && is_json_space(src[i]))
+	{
+		++i;
+	}
 
-			case NAUI_JSON_TOKEN_BOOL:
-				val_slot->type = NAUI_JSON_BOOL;
-				val_slot->boolean = reader->boolean;
-				break;
+	if (i >= len || src[i] != '[')
+		return false;
+
+	size_t depth = 1;
+	size_t start = 0;
+	bool has_start = false;
+	for (++i; i < len; ++i)
+	{
+		char c = src[i];
+		if (c == '"')
+		{
+			if (!has_start)
+			{
+				start = i;
+				has_start = true;
+			}
+
+			for (++i; i < len && src[i] != '"'; ++i)
+			{
+				if (src[i] == '\\')
+					++i;
+			}
+
+			if (i >= len)
+				return false;
 
-			case NAUI_JSON_TOKEN_NUMBER:
-				val_slot->type = NAUI_JSON_NUMBER;
-				val_slot->number = reader->number;
-				break;
+			continue;
+		}
 
-			case NAUI_JSON_TOKEN_STRING:
-				val_slot->type = NAUI_JSON_STRING;
-				val_slot->string.ptr = reader->str;
-				val_slot->string.len = reader->len;
-				break;
+		if (c == '[' || c == '{')
+		{
+			if (!has_start)
+			{
+				start = i;
+				has_start = true;
+			}
+
+			++depth;
+			continue;
+		}
 
-			case NAUI_JSON_TOKEN_OBJECT_BEGIN:
-				if (!build_object(json, reader, val_slot))
-					return false;
+		if (c == ']' || c == '}')
+		{
+			if (--depth > 0)
+				continue;
 
-				break;
+			if (c != ']')
+				return false;
 
-			case NAUI_JSON_TOKEN_ARRAY_BEGIN:
-				if (!build_array(json, reader, val_slot))
-					return false;
+			if (has_start)
+			{
+				Json_Span span = { start, i };
+				naui_list_push(*spans, span);
+			}
+			else if (naui_list_len(*spans) > 0)
+				return false;
 
-				break;
+			break;
+		}
 
-			default:
+		if (depth == 1 && c == ',')
+		{
+			if (!has_start)
 				return false;
+
+			Json_Span span = { start, i };
+			naui_list_push(*spans, span);
+			has_start = false;
+			continue;
+		}
+
+		if (!has_start && !is_json_space(c))
+		{
+			start = i;
+			has_start = true;
 		}
 	}
+
+	if (i >= len)
+		return false;
+
+	for (++i; i < len; ++i)
+	{
+		if (!is_json_space(src[i]))
+			return false;
+	}
+
+	return true;
+}
+
+static void parse_chunk(Json_ParseChunk* chunk)
+{
+	Json_Builder builder = { &chunk->part, NULL, 0, 0 };
+	for (size_t i = 0; i < chunk->count; ++i)
+	{
+		const Json_Span* span = &chunk->spans[chunk->first + i];
+		Naui_JsonReader reader;
+		naui_json_reader_init(&reader, chunk->src + span->start, span->end - span->start);
+
+		Naui_JsonValue* slot = &chunk->items[chunk->first + i];
+		if (!build_value(&builder, &reader, naui_json_reader_next(&reader), slot) || naui_json_reader_next(&reader) != NAUI_JSON_TOKEN_EOF)
+		{
+			chunk->failed = true;
+			break;
+		}
+	}
+
+	free(builder.stack);
+}
+
+static void parse_chunk_job(void* data, char* err_buf, size_t err_size)
+{
+	Json_ParseChunk* chunk = (Json_ParseChunk*)data;
+	parse_chunk(chunk);
+	if (chunk->failed)
+		snprintf(err_buf, err_size, "json chunk parse failed");
 }
 
 static void write_value(Naui_JsonWriter* writer, const Naui_JsonValue* value);
@@ -233,6 +447,15 @@ static void write_value(Naui_JsonWriter* writer, const Naui_JsonValue* value)
 	}
 }
 
+/* Sink for measuring output size without keeping it. */
+static bool discard_flush(void* user, const char* data, size_t len)
+{
+	(void)user;
+	(void)data;
+	(void)len;
+	return true;
+}
+
 static Naui_JsonValue* object_slot(Naui_Json* json, Naui_JsonValue* obj, const char* key)
 {
 	if (!obj || obj->type != NAUI_JSON_OBJECT)
@@ -248,16 +471,11 @@ static Naui_JsonValue* object_slot(Naui_Json* json, Naui_JsonValue* obj, const c
 
 	if (obj->object.count + 2 > obj->object.cap)
 	{
-		size_t new_cap = obj->object.cap ? obj->object.cap * 2 : 8;
-		Naui_JsonValue* tmp = arena_values(json, new_cap);
+		Naui_JsonValue* tmp = grow_values(json, obj->object.pairs, obj->object.count, &obj->object.cap);
 		if (!tmp)
 			return NULL;
 
-		if (obj->object.pairs)
-			memcpy(tmp, obj->object.pairs, obj->object.count * sizeof(Naui_JsonValue));
-
 		obj->object.pairs = tmp;
-		obj->object.cap = new_cap;
 	}
 
 	Naui_JsonValue* key_slot = &obj->object.pairs[obj->object.count++];
@@ -277,16 +495,11 @@ static Naui_JsonValue* array_slot(Naui_Json* json, Naui_JsonValue* arr)
 
 	if (arr->array.count >= arr->array.cap)
 	{
-		size_t new_cap = arr->array.cap ? arr->array.cap * 2 : 8;
-		Naui_JsonValue* tmp = arena_values(json, new_cap);
+		Naui_JsonValue* tmp = grow_values(json, arr->array.items, arr->array.count, &arr->array.cap);
 		if (!tmp)
 			return NULL;
 
-		if (arr->array.items)
-			memcpy(tmp, arr->array.items, arr->array.count * sizeof(Naui_JsonValue));
-
 		arr->array.items = tmp;
-		arr->array.cap = new_cap;
 	}
 
 	Naui_JsonValue* slot = &arr->array.items[arr->array.count++];
@@ -333,76 +546,158 @@ Naui_Json naui_json_parse(const char* src, size_t len)
 		return result;
 	}
 
-	bool ok = false;
-	switch (t)
+	Json_Builder builder = { &result, NULL, 0, 0 };
+	bool ok = build_value(&builder, &reader, t, root);
+	free(builder.stack);
+	if (!ok)
 	{
-		case NAUI_JSON_TOKEN_OBJECT_BEGIN:
-			ok = build_object(&result, &reader, root);
-			break;
+		naui_json_free(&result);
+		result.error = reader.error ? reader.error : "parse error";
+		result.error_line = reader.error_line;
+		result.error_col = reader.error_col;
+		return result;
+	}
 
-		case NAUI_JSON_TOKEN_ARRAY_BEGIN:
-			ok = build_array(&result, &reader, root);
-			break;
+	result.root = root;
+	return result;
+}
 
-		case NAUI_JSON_TOKEN_STRING:
-			root->type = NAUI_JSON_STRING;
-			root->string.ptr = reader.str;
-			root->string.len = reader.len;
-			ok = true;
-			break;
+Naui_Json naui_json_parse_file(const Naui_Path path)
+{
+	Naui_Json result;
+	memset(&result, 0, sizeof(result));
 
-		case NAUI_JSON_TOKEN_NUMBER:
-			root->type = NAUI_JSON_NUMBER;
-			root->number = reader.number;
-			ok = true;
-			break;
+	Naui_FileMap file;
+	if (!naui_file_map(&file, path, NAUI_FILE_MAP_SEQUENTIAL | NAUI_FILE_MAP_WILLNEED))
+	{
+		result.error = "failed to read file";
+		return result;
+	}
 
-		case NAUI_JSON_TOKEN_BOOL:
-			root->type = NAUI_JSON_BOOL;
-			root->boolean = reader.boolean;
-			ok = true;
-			break;
+	result = naui_json_parse((const char*)file.data, file.size);
+	if (result.root && !result.error)
+		result._file = file;
+	else
+		naui_file_unmap(&file);
 
-		case NAUI_JSON_TOKEN_NULL:
-			root->type = NAUI_JSON_NULL;
-			ok = true;
-			break;
+	return result;
+}
 
-		default:
-			break;
+Naui_Json naui_json_parse_parallel(const char* src, size_t len, int32_t job_count)
+{
+	if (job_count <= 0)
+		job_count = naui_jobs_worker_count() + 1;
+
+	size_t max_chunks = len / NAUI_JSON_PARALLEL_MIN_CHUNK;
+	if (job_count < 2 || max_chunks < 2)
+		return naui_json_parse(src, len);
+
+	Naui_List(Json_Span) spans = NULL;
+	if (!scan_array_elements(src, len, &spans) || naui_list_len(spans) < 2)
+	{
+		naui_list_free(spans);
+		return naui_json_parse(src, len);
+	}
+
+	size_t span_count = (size_t)naui_list_len(spans);
+	size_t chunk_count = (size_t)job_count;
+	if (chunk_count > max_chunks)
+		chunk_count = max_chunks;
+
+	if (chunk_count > span_count)
+		chunk_count = span_count;
+
+	Naui_Json result;
+	memset(&result, 0, sizeof(result));
+
+	Naui_JsonValue* root = arena_value(&result);
+	Naui_JsonValue* items = arena_values(&result, span_count);
+	Json_ParseChunk* chunks = (Json_ParseChunk*)calloc(chunk_count, sizeof(Json_ParseChunk));
+	Naui_JobHandle* handles = (Naui_JobHandle*)calloc(chunk_count, sizeof(Naui_JobHandle));
+	if (!root || !items || !chunks || !handles)
+	{
+		free(chunks);
+		free(handles);
+		naui_list_free(spans);
+		naui_json_free(&result);
+		return naui_json_parse(src, len);
 	}
 
+	/* Balance chunks by bytes rather than element count, records vary in size. */
+	size_t total = spans[span_count - 1].end - spans[0].start;
+	size_t next = 0;
+	for (size_t c = 0; c < chunk_count; ++c)
+	{
+		Json_ParseChunk* chunk = &chunks[c];
+		chunk->src = src;
+		chunk->spans = spans;
+		chunk->items = items;
+		chunk->first = next;
+
+		size_t limit = spans[0].start + total / chunk_count * (c + 1);
+		size_t remaining_chunks = chunk_count - c - 1;
+		while (next < span_count - remaining_chunks && (next == chunk->first || spans[next].start < limit || c + 1 == chunk_count))
+		{
+			++next;
+		}
+
+		chunk->count = next - chunk->first;
+	}
+
+	for (size_t c = 1; c < chunk_count; ++c)
+	{
+		if (naui_job_submit(&handles[c], parse_chunk_job, &chunks[c]) != NAUI_JOB_SUBMIT_OK)
+			parse_chunk(&chunks[c]);
+	}
+
+	parse_chunk(&chunks[0]);
+	bool ok = !chunks[0].failed;
+	for (size_t c = 1; c < chunk_count; ++c)
+	{
+		naui_job_wait(handles[c]);
+		ok &= !chunks[c].failed;
+	}
+
+	for (size_t c = 0; c < chunk_count; ++c)
+	{
+		naui_arena_merge(&result._arena, &chunks[c].part._arena);
+	}
+
+	free(handles);
+	free(chunks);
+	naui_list_free(spans);
+
 	if (!ok)
 	{
 		naui_json_free(&result);
-		result.error = reader.error ? reader.error : "parse error";
-		result.error_line = reader.error_line;
-		result.error_col = reader.error_col;
-		return result;
+		return naui_json_parse(src, len);
 	}
 
+	root->type = NAUI_JSON_ARRAY;
+	root->array.items = items;
+	root->array.count = span_count;
+	root->array.cap = span_count;
 	result.root = root;
 	return result;
 }
 
-Naui_Json naui_json_parse_file(const Naui_Path path)
+Naui_Json naui_json_parse_file_parallel(const Naui_Path path, int32_t job_count)
 {
 	Naui_Json result;
 	memset(&result, 0, sizeof(result));
 
-	size_t len;
-	char* src = naui_file_read_all(path, &len);
-	if (!src)
+	Naui_FileMap file;
+	if (!naui_file_map(&file, path, NAUI_FILE_MAP_SEQUENTIAL | NAUI_FILE_MAP_WILLNEED))
 	{
 		result.error = "failed to read file";
 		return result;
 	}
 
-	result = naui_json_parse(src, len);
+	result = naui_json_parse_parallel((const char*)file.data, file.size, job_count);
 	if (result.root && !result.error)
-		result._file_src = src;
+		result._file = file;
 	else
-		free(src);
+		naui_file_unmap(&file);
 
 	return result;
 }
@@ -410,7 +705,7 @@ Naui_Json naui_json_parse_file(const Naui_Path path)
 void naui_json_free(Naui_Json* result)
 {
 	naui_arena_free(&result->_arena);
-	free(result->_file_src);
+	naui_file_unmap(&result->_file);
 	memset(result, 0, sizeof(*result));
 }
 
@@ -629,16 +924,11 @@ int naui_json_write(const Naui_JsonValue* root, char* dest, size_t dest_size, bo
 
 	if (!dest)
 	{
+		char buf[NAUI_JSON_WRITER_STREAM_SIZE];
 		Naui_JsonWriter writer;
-		naui_json_writer_init_heap(&writer, is_pretty);
+		naui_json_writer_init_stream(&writer, buf, sizeof(buf), discard_flush, NULL, is_pretty);
 		write_value(&writer, root);
-		size_t len;
-		char* buf = naui_json_writer_finish_heap(&writer, &len);
-		if (!buf)
-			return -1;
-
-		free(buf);
-		return (int)len;
+		return naui_json_writer_finish(&writer);
 	}
 
 	Naui_JsonWriter writer;
@@ -652,17 +942,27 @@ bool naui_json_write_file(const Naui_JsonValue* root, const Naui_Path path, bool
 	if (!root)
 		return false;
 
+	/* Streamed next to the target and renamed over it, a failed write never leaves a truncated file behind. */
+	Naui_Path temp;
+	if (snprintf(temp.data, NAUI_PATH_MAX, "%s.tmp", path.data) >= NAUI_PATH_MAX)
+		return false;
+
+	Naui_FileHandle handle = NAUI_FILE_HANDLE_INIT;
+	if (!naui_file_open(&handle, temp, NAUI_FILE_WRITE))
+		return false;
+
+	char buf[NAUI_JSON_WRITER_STREAM_SIZE];
 	Naui_JsonWriter writer;
-	naui_json_writer_init_heap(&writer, is_pretty);
+	naui_json_writer_init_file(&writer, &handle, buf, sizeof(buf), is_pretty);
 	write_value(&writer, root);
 
-	size_t len;
-	char* buf = naui_json_writer_finish_heap(&writer, &len);
-	if (!buf)
-		return false;
+	bool ok = naui_json_writer_finish(&writer) >= 0;
+	naui_file_close(&handle);
+
+	ok = ok && naui_file_rename(temp, path);
+	if (!ok)
+		naui_file_delete(temp);
 
-	bool ok = naui_file_write_all(path, buf, len);
-	free(buf);
 	return ok;
 }
 #pragma endregion
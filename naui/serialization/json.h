@@ -51,11 +51,21 @@ typedef struct
 	int error_col;
 
 	Naui_Arena _arena;
-	char* _file_src;
+	Naui_JsonValue** _recycled;
+	Naui_FileMap _file;
 } Naui_Json;
 
 Naui_Json naui_json_parse(const char* src, size_t len);
 Naui_Json naui_json_parse_file(const Naui_Path path);
+
+/*
+ * Parse a top-level array with its elements split across the job system.
+ * A structural scan finds element boundaries, then chunks are parsed in parallel and merged into one result.
+ * Other inputs, inputs too small to split, or invalid inputs go through naui_json_parse (errors stay exact).
+ * `job_count` <= 0 uses one chunk per worker plus the calling thread.
+ */
+Naui_Json naui_json_parse_parallel(const char* src, size_t len, int32_t job_count);
+Naui_Json naui_json_parse_file_parallel(const Naui_Path path, int32_t job_count);
 void naui_json_free(Naui_Json* result);
 
 Naui_JsonValue* naui_json_array_get(const Naui_JsonValue* array, size_t index);
@@ -73,6 +83,10 @@ const char* naui_json_get_string(const Naui_JsonValue* v, const char* default_va
  */
 int naui_json_copy_string(const Naui_JsonValue* v, char* dest, size_t dest_size);
 
+/*
+ * Parsed containers are allocated exactly once, with cap == count.
+ * Growing a container may move its values and reuse the old array, so pointers into it do not survive the next set/push.
+ */
 Naui_Json naui_json_result_create(void);
 Naui_JsonValue* naui_json_object(Naui_Json* json);
 Naui_JsonValue* naui_json_array(Naui_Json* json);
@@ -0,0 +1,395 @@
+#pragma region Static Functions
+static bool path_add_step(Naui_JsonPath* path, const char* key, size_t key_len, bool index_only)
+{
+	if (path->count >= NAUI_JSON_PATH_MAX_STEPS)
+		return false;
+
+	Naui_JsonPathStep* step = &path->steps[path->count];
+	memset(step, 0, sizeof(*step));
+
+	bool numeric = key_len > 0 && key_len <= 9;
+	uint32_t index = 0;
+	for (size_t i = 0; i < key_len && numeric; ++i)
+	{
+		numeric = key[i] >= '0' && key[i] <= '9';
+		index = index * 10 + (uint32_t)(key[i] - '0');
+	}
+
+	if (index_only && !numeric)
+		return false;
+
+	step->has_index = numeric;
+	step->index = index;
+	if (!index_only)
+	{
+		size_t used = path->count ? path->steps[path->count - 1].key_offset + path->steps[path->count - 1].key_len : 0;
+		if (used + key_len > NAUI_JSON_PATH_MAX_KEYS)
+			return false;
+
+		memcpy(path->_keys + used, key, key_len);
+		step->has_key = true;
+		step->key_offset = (uint16_t)used;
+		step->key_len = (uint16_t)key_len;
+		step->hash = naui_hash_bytes(key, key_len);
+	}
+	else if (path->count)
+		step->key_offset = (uint16_t)(path->steps[path->count - 1].key_offset + path->steps[path->count - 1].key_len);
+
+	++path->count;
+	return true;
+}
+
+static bool path_compile_pointer(Naui_JsonPath* path, const char* expr)
+{
+	char key[NAUI_JSON_PATH_MAX_KEYS];
+	while (*expr == '/')
+	{
+		++expr;
+		size_t len = 0;
+		for (; *expr && *expr != '/'; ++expr)
+		{
+			char c = *expr;
+			if (c == '~')
+			{
+				if (expr[1] != '0' && expr[1] != '1')
+					return false;
+
+				c = *++expr == '0' ? '~' : '/';
+			}
+
+			if (len >= sizeof(key))
+				return false;
+
+			key[len++] = c;
+		}
+
+		if (!path_add_step(path, key, len, false))
+			return false;
+	}
+
+	return *expr == '\0';
+}
+
+static bool path_compile_dotted(Naui_JsonPath* path, const char* expr)
+{
+	if (*expr == '$')
+	{
+		++expr;
+		if (*expr == '.')
+			++expr;
+	}
+
+	while (*expr)
+	{
+		if (*expr == '[')
+		{
+			++expr;
+			if (*expr == '"' || *expr == '\'')
+			{
+				char quote = *expr++;
+				const char* start = expr;
+				while (*expr && *expr != quote)
+				{
+					++expr;
+				}
+
+				if (!*expr || expr[1] != ']' || !path_add_step(path, start, (size_t)(expr - start), false))
+					return false;
+
+				expr += 2;
+			}
+			else
+			{
+				const char* start = expr;
+				while (*expr && *expr != ']')
+				{
+					++expr;
+				}
+
+				if (!*expr || !path_add_step(path, start, (size_t)(expr - start), true))
+					return false;
+
+				++expr;
+			}
+		}
+		else
+		{
+			const char* start = expr;
+			while (*expr && *expr != '.' && *expr != '[')
+			{
+				++expr;
+			}
+
+			if (expr == start || !path_add_step(path, start, (size_t)(expr - start), false))
+				return false;
+		}
+
+		if (*expr == '.')
+		{
+			++expr;
+			if (!*expr)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static bool path_key_matches(const Naui_JsonPath* path, const Naui_JsonPathStep* step, const char* key, size_t key_len)
+{
+	return step->has_key && step->key_len == key_len && memcmp(path->_keys + step->key_offset, key, key_len) == 0;
+}
+
+static bool path_is_container(Naui_JsonToken t)
+{
+	return t == NAUI_JSON_TOKEN_OBJECT_BEGIN || t == NAUI_JSON_TOKEN_ARRAY_BEGIN;
+}
+
+typedef struct
+{
+	const Naui_JsonPath* paths;
+	size_t count;
+	Naui_JsonReader* reader;
+	Naui_JsonPathFn fn;
+	void* user;
+	uint64_t pending;
+} Json_PathBatch;
+
+/* The reader is on the first token of a value that the first `depth` steps of every path in `mask` led to. */
+static bool path_batch_visit(Json_PathBatch* batch, uint64_t mask, uint32_t depth)
+{
+	Naui_JsonReader* reader = batch->reader;
+	const char* cursor = reader->_cursor;
+	uint64_t deeper = 0;
+	for (size_t i = 0; i < batch->count; ++i)
+	{
+		if (!(mask & ((uint64_t)1 << i)))
+			continue;
+
+		if (batch->paths[i].count == depth)
+		{
+			batch->pending &= ~((uint64_t)1 << i);
+			batch->fn(batch->user, i, reader);
+		}
+		else
+			deeper |= (uint64_t)1 << i;
+	}
+
+	if (reader->_cursor != cursor)
+		return reader->token != NAUI_JSON_TOKEN_ERROR;
+
+	Naui_JsonToken t = reader->token;
+	if (!deeper || !path_is_container(t))
+	{
+		if (path_is_container(t))
+			naui_json_reader_skip(reader);
+
+		return reader->token != NAUI_JSON_TOKEN_ERROR;
+	}
+
+	uint32_t index = 0;
+	while (batch->pending)
+	{
+		t = naui_json_reader_next(reader);
+		if (t == NAUI_JSON_TOKEN_OBJECT_END || t == NAUI_JSON_TOKEN_ARRAY_END)
+			return true;
+
+		uint64_t match = 0;
+		if (t == NAUI_JSON_TOKEN_KEY)
+		{
+			/* One hash of the document key serves every path. */
+			uint64_t hash = naui_hash_bytes(reader->str, reader->len);
+			uint64_t active = deeper & batch->pending;
+			for (size_t i = 0; i < batch->count; ++i)
+			{
+				if (!(active & ((uint64_t)1 << i)))
+					continue;
+
+				const Naui_JsonPathStep* step = &batch->paths[i].steps[depth];
+				if (step->hash == hash && path_key_matches(&batch->paths[i], step, reader->str, reader->len))
+					match |= (uint64_t)1 << i;
+			}
+
+			t = naui_json_reader_next(reader);
+		}
+		else
+		{
+			uint64_t active = deeper & batch->pending;
+			for (size_t i = 0; i < batch->count; ++i)
+			{
+				if (!(active & ((uint64_t)1 << i)))
+					continue;
+
+				const Naui_JsonPathStep* step = &batch->paths[i].steps[depth];
+				if (step->has_index && step->index == index)
+					match |= (uint64_t)1 << i;
+			}
+
+			++index;
+		}
+
+		if (t == NAUI_JSON_TOKEN_ERROR || t == NAUI_JSON_TOKEN_EOF)
+			return false;
+
+		if (match)
+		{
+			if (!path_batch_visit(batch, match, depth + 1))
+				return false;
+		}
+		else if (path_is_container(t))
+		{
+			naui_json_reader_skip(reader);
+			if (reader->token == NAUI_JSON_TOKEN_ERROR)
+				return false;
+		}
+	}
+
+	return true;
+}
+#pragma endregion
+
+bool naui_json_path_compile(Naui_JsonPath* path, const char* expr)
+{
+	memset(path, 0, sizeof(*path));
+	if (!expr)
+		return false;
+
+	if (*expr == '/' || *expr == '\0')
+		return path_compile_pointer(path, expr);
+
+	return path_compile_dotted(path, expr);
+}
+
+const Naui_JsonValue* naui_json_path_eval(const Naui_JsonPath* path, const Naui_JsonValue* root)
+{
+	const Naui_JsonValue* value = root;
+	for (uint32_t s = 0; s < path->count && value; ++s)
+	{
+		const Naui_JsonPathStep* step = &path->steps[s];
+		const Naui_JsonValue* next = NULL;
+		if (value->type == NAUI_JSON_ARRAY)
+		{
+			if (step->has_index && step->index < value->array.count)
+				next = &value->array.items[step->index];
+		}
+		else if (value->type == NAUI_JSON_OBJECT)
+		{
+			for (size_t i = 0; i + 1 < value->object.count; i += 2)
+			{
+				const Naui_JsonValue* k = &value->object.pairs[i];
+				if (path_key_matches(path, step, k->string.ptr, k->string.len))
+				{
+					next = &value->object.pairs[i + 1];
+					break;
+				}
+			}
+		}
+
+		value = next;
+	}
+
+	return value;
+}
+
+Naui_JsonNode naui_json_path_eval_node(const Naui_JsonPath* path, Naui_JsonNode root)
+{
+	Naui_JsonNode node = root;
+	for (uint32_t s = 0; s < path->count && naui_json_node_valid(node); ++s)
+	{
+		const Naui_JsonPathStep* step = &path->steps[s];
+		Naui_JsonType type = naui_json_node_type(node);
+		if (type == NAUI_JSON_ARRAY && step->has_index)
+			node = naui_json_node_array_get(node, step->index);
+		else if (type == NAUI_JSON_OBJECT && step->has_key)
+		{
+			Naui_JsonNode it = naui_json_node_first(node);
+			for (; naui_json_node_valid(it); it = naui_json_node_next(it))
+			{
+				size_t key_len;
+				const char* key = naui_json_node_key(it, &key_len);
+				if (path_key_matches(path, step, key, key_len))
+					break;
+			}
+
+			node = it;
+		}
+		else
+		{
+			Naui_JsonNode none = { NULL, 0, 0 };
+			node = none;
+		}
+	}
+
+	return node;
+}
+
+bool naui_json_path_eval_reader(const Naui_JsonPath* path, Naui_JsonReader* reader)
+{
+	Naui_JsonToken t = naui_json_reader_next(reader);
+	for (uint32_t s = 0; s < path->count; ++s)
+	{
+		const Naui_JsonPathStep* step = &path->steps[s];
+		if (t == NAUI_JSON_TOKEN_OBJECT_BEGIN && step->has_key)
+		{
+			while (1)
+			{
+				t = naui_json_reader_next(reader);
+				if (t != NAUI_JSON_TOKEN_KEY)
+					return false;
+
+				bool match = path_key_matches(path, step, reader->str, reader->len);
+				t = naui_json_reader_next(reader);
+				if (match)
+					break;
+
+				if (path_is_container(t))
+					naui_json_reader_skip(reader);
+
+				if (reader->token == NAUI_JSON_TOKEN_ERROR || reader->token == NAUI_JSON_TOKEN_EOF)
+					return false;
+			}
+		}
+		else if (t == NAUI_JSON_TOKEN_ARRAY_BEGIN && step->has_index)
+		{
+			for (uint32_t i = 0; ; ++i)
+			{
+				t = naui_json_reader_next(reader);
+				if (t == NAUI_JSON_TOKEN_ARRAY_END || t == NAUI_JSON_TOKEN_ERROR || t == NAUI_JSON_TOKEN_EOF)
+					return false;
+
+				if (i == step->index)
+					break;
+
+				if (path_is_container(t))
+					naui_json_reader_skip(reader);
+
+				if (reader->token == NAUI_JSON_TOKEN_ERROR)
+					return false;
+			}
+		}
+		else
+			return false;
+	}
+
+	return t != NAUI_JSON_TOKEN_ERROR && t != NAUI_JSON_TOKEN_EOF;
+}
+
+bool naui_json_path_eval_batch(const Naui_JsonPath* paths, size_t count, Naui_JsonReader* reader, Naui_JsonPathFn fn, void* user)
+{
+	if (!paths || count == 0 || count > NAUI_JSON_PATH_MAX_BATCH || !fn)
+		return false;
+
+	Json_PathBatch batch;
+	batch.paths = paths;
+	batch.count = count;
+	batch.reader = reader;
+	batch.fn = fn;
+	batch.user = user;
+	batch.pending = count == 64 ? ~(uint64_t)0 : (((uint64_t)1 << count) - 1);
+
+	Naui_JsonToken t = naui_json_reader_next(reader);
+	if (t == NAUI_JSON_TOKEN_ERROR || t == NAUI_JSON_TOKEN_EOF)
+		return false;
+
+	return path_batch_visit(&batch, batch.pending, 0);
+}
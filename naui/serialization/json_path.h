@@ -0,0 +1,48 @@
+#define NAUI_JSON_PATH_MAX_STEPS 32
+#define NAUI_JSON_PATH_MAX_KEYS 256
+#define NAUI_JSON_PATH_MAX_BATCH 64
+
+typedef struct
+{
+	uint64_t hash;
+	uint16_t key_offset;
+	uint16_t key_len;
+	uint32_t index;
+	bool has_key;
+	bool has_index;
+} Naui_JsonPathStep;
+
+/*
+ * A query compiled once and evaluated many times. Accepts JSON pointers ("/panels/3/type")
+ * and dotted paths ("panels[3].type", "$.a[\"b.c\"]"). Pointer segments and dotted keys that
+ * are plain numbers match both an object key and an array index. Keys compare raw, like naui_json_object_get.
+ */
+typedef struct
+{
+	Naui_JsonPathStep steps[NAUI_JSON_PATH_MAX_STEPS];
+	uint32_t count;
+	char _keys[NAUI_JSON_PATH_MAX_KEYS];
+} Naui_JsonPath;
+
+/*
+ * Called with the reader on the first token of a matched value. The callback may leave the reader
+ * alone or consume exactly that value (e.g. with naui_json_reader_skip), paths below a consumed value are not visited.
+ */
+typedef void (*Naui_JsonPathFn)(void* user, size_t path_index, Naui_JsonReader* reader);
+
+bool naui_json_path_compile(Naui_JsonPath* path, const char* expr);
+
+const Naui_JsonValue* naui_json_path_eval(const Naui_JsonPath* path, const Naui_JsonValue* root);
+Naui_JsonNode naui_json_path_eval_node(const Naui_JsonPath* path, Naui_JsonNode root);
+
+/*
+ * Streams from a freshly initialized reader, skipping subtrees that cannot match.
+ * On success the reader sits on the first token of the matched value.
+ */
+bool naui_json_path_eval_reader(const Naui_JsonPath* path, Naui_JsonReader* reader);
+
+/*
+ * Evaluates up to NAUI_JSON_PATH_MAX_BATCH paths in a single pass over the reader, calling `fn` for each match.
+ * Stops reading once every path has matched. Returns false on a parse error.
+ */
+bool naui_json_path_eval_batch(const Naui_JsonPath* paths, size_t count, Naui_JsonReader* reader, Naui_JsonPathFn fn, void* user);
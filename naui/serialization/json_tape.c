@@ -0,0 +1,329 @@
+#pragma region Static Functions
+static const Naui_JsonTapeEntry* tape_entry(Naui_JsonNode node)
+{
+	if (!node.tape || node.index >= node.tape->count)
+		return NULL;
+
+	return &node.tape->entries[node.index];
+}
+
+/* `end` is where the enclosing container stops, so siblings can be stepped without finding the parent. */
+static Naui_JsonNode tape_node(const Naui_JsonTape* tape, uint32_t index, uint32_t end)
+{
+	Naui_JsonNode node;
+	node.tape = index < end ? tape : NULL;
+	node.index = index;
+	node._end = end;
+	return node;
+}
+
+static Naui_JsonNode tape_invalid(void)
+{
+	Naui_JsonNode node = { NULL, 0, 0 };
+	return node;
+}
+
+static uint32_t tape_push(Naui_List(Naui_JsonTapeEntry)* entries, Naui_JsonType type, uint32_t* stack, uint8_t depth)
+{
+	uint32_t index = (uint32_t)naui_list_len(*entries);
+	Naui_JsonTapeEntry entry;
+	memset(&entry, 0, sizeof(entry));
+	entry.type = type;
+	entry.next = index + 1;
+	naui_list_push(*entries, entry);
+
+	/* Object members are counted on their key. */
+	if (depth > 0 && (*entries)[stack[depth - 1]].type == NAUI_JSON_ARRAY)
+		++(*entries)[stack[depth - 1]].count;
+
+	return index;
+}
+#pragma endregion
+
+Naui_JsonTape naui_json_tape_parse(const char* src, size_t len)
+{
+	Naui_JsonTape tape;
+	memset(&tape, 0, sizeof(tape));
+	tape.src = src;
+
+	if (len > UINT32_MAX)
+	{
+		tape.error = "input too large";
+		return tape;
+	}
+
+	Naui_JsonReader reader;
+	naui_json_reader_init(&reader, src, len);
+
+	/* Rough guess of one entry per eight bytes keeps regrowth rare. */
+	Naui_List(Naui_JsonTapeEntry) entries = NULL;
+	naui_list_reserve(entries, len / 8 + 16);
+
+	uint32_t stack[NAUI_JSON_READER_MAX_DEPTH + 1];
+	uint8_t depth = 0;
+	while (1)
+	{
+		Naui_JsonToken t = naui_json_reader_next(&reader);
+		if (t == NAUI_JSON_TOKEN_EOF)
+			break;
+
+		uint32_t index;
+		switch (t)
+		{
+			case NAUI_JSON_TOKEN_OBJECT_BEGIN:
+			case NAUI_JSON_TOKEN_ARRAY_BEGIN:
+				index = tape_push(&entries, t == NAUI_JSON_TOKEN_OBJECT_BEGIN ? NAUI_JSON_OBJECT : NAUI_JSON_ARRAY, stack, depth);
+				stack[depth++] = index;
+				break;
+
+			case NAUI_JSON_TOKEN_OBJECT_END:
+			case NAUI_JSON_TOKEN_ARRAY_END:
+				--depth;
+				entries[stack[depth]].next = (uint32_t)naui_list_len(entries);
+				break;
+
+			case NAUI_JSON_TOKEN_KEY:
+				index = tape_push(&entries, NAUI_JSON_STRING, stack, 0);
+				entries[index].is_key = true;
+				entries[index].string.offset = (uint32_t)(reader.str - src);
+				entries[index].string.len = (uint32_t)reader.len;
+				++entries[stack[depth - 1]].count;
+				break;
+
+			case NAUI_JSON_TOKEN_STRING:
+				index = tape_push(&entries, NAUI_JSON_STRING, stack, depth);
+				entries[index].string.offset = (uint32_t)(reader.str - src);
+				entries[index].string.len = (uint32_t)reader.len;
+				break;
+
+			case NAUI_JSON_TOKEN_NUMBER:
+				index = tape_push(&entries, NAUI_JSON_NUMBER, stack, depth);
+				entries[index].number = reader.number;
+				break;
+
+			case NAUI_JSON_TOKEN_BOOL:
+				index = tape_push(&entries, NAUI_JSON_BOOL, stack, depth);
+				entries[index].boolean = reader.boolean;
+				break;
+
+			case NAUI_JSON_TOKEN_NULL:
+				tape_push(&entries, NAUI_JSON_NULL, stack, depth);
+				break;
+
+			default:
+				naui_list_free(entries);
+				tape.error = reader.error ? reader.error : "parse error";
+				tape.error_line = reader.error_line;
+				tape.error_col = reader.error_col;
+				return tape;
+		}
+	}
+
+	if (naui_list_len(entries) == 0)
+	{
+		naui_list_free(entries);
+		tape.error = "empty input";
+		return tape;
+	}
+
+	tape.entries = entries;
+	tape.count = (size_t)naui_list_len(entries);
+	return tape;
+}
+
+Naui_JsonTape naui_json_tape_parse_file(const Naui_Path path)
+{
+	Naui_JsonTape tape;
+	memset(&tape, 0, sizeof(tape));
+
+	Naui_FileMap file;
+	if (!naui_file_map(&file, path, NAUI_FILE_MAP_SEQUENTIAL | NAUI_FILE_MAP_WILLNEED))
+	{
+		tape.error = "failed to read file";
+		return tape;
+	}
+
+	tape = naui_json_tape_parse((const char*)file.data, file.size);
+	if (tape.entries && !tape.error)
+		tape._file = file;
+	else
+		naui_file_unmap(&file);
+
+	return tape;
+}
+
+void naui_json_tape_free(Naui_JsonTape* tape)
+{
+	Naui_JsonTapeEntry* entries = (Naui_JsonTapeEntry*)tape->entries;
+	naui_list_free(entries);
+	naui_file_unmap(&tape->_file);
+	memset(tape, 0, sizeof(*tape));
+}
+
+Naui_JsonNode naui_json_tape_root(const Naui_JsonTape* tape)
+{
+	if (!tape || !tape->entries)
+		return tape_invalid();
+
+	return tape_node(tape, 0, (uint32_t)tape->count);
+}
+
+bool naui_json_node_valid(Naui_JsonNode node)
+{
+	return tape_entry(node) != NULL;
+}
+
+Naui_JsonType naui_json_node_type(Naui_JsonNode node)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(node);
+	return entry ? entry->type : NAUI_JSON_NULL;
+}
+
+size_t naui_json_node_count(Naui_JsonNode node)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(node);
+	if (!entry || (entry->type != NAUI_JSON_ARRAY && entry->type != NAUI_JSON_OBJECT))
+		return 0;
+
+	return entry->count;
+}
+
+Naui_JsonNode naui_json_node_object_get(Naui_JsonNode object, const char* key)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(object);
+	if (!entry || entry->type != NAUI_JSON_OBJECT || !key)
+		return tape_invalid();
+
+	const Naui_JsonTape* tape = object.tape;
+	size_t key_len = strlen(key);
+	uint32_t i = object.index + 1;
+	for (uint32_t m = 0; m < entry->count; ++m)
+	{
+		const Naui_JsonTapeEntry* k = &tape->entries[i];
+		if (k->string.len == key_len && memcmp(tape->src + k->string.offset, key, key_len) == 0)
+			return tape_node(tape, i + 1, entry->next);
+
+		i = tape->entries[i + 1].next;
+	}
+
+	return tape_invalid();
+}
+
+Naui_JsonNode naui_json_node_array_get(Naui_JsonNode array, size_t index)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(array);
+	if (!entry || entry->type != NAUI_JSON_ARRAY || index >= entry->count)
+		return tape_invalid();
+
+	uint32_t i = array.index + 1;
+	while (index-- > 0)
+	{
+		i = array.tape->entries[i].next;
+	}
+
+	return tape_node(array.tape, i, entry->next);
+}
+
+Naui_JsonNode naui_json_node_first(Naui_JsonNode container)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(container);
+	if (!entry || entry->count == 0)
+		return tape_invalid();
+
+	if (entry->type == NAUI_JSON_ARRAY)
+		return tape_node(container.tape, container.index + 1, entry->next);
+
+	if (entry->type == NAUI_JSON_OBJECT)
+		return tape_node(container.tape, container.index + 2, entry->next);
+
+	return tape_invalid();
+}
+
+Naui_JsonNode naui_json_node_next(Naui_JsonNode node)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(node);
+	if (!entry)
+		return tape_invalid();
+
+	/* Inside an object the next sibling is a key, its value follows. */
+	uint32_t i = entry->next;
+	if (i < node._end && node.tape->entries[i].is_key)
+		++i;
+
+	return tape_node(node.tape, i, node._end);
+}
+
+const char* naui_json_node_key(Naui_JsonNode node, size_t* out_len)
+{
+	if (!tape_entry(node) || node.index == 0)
+		return NULL;
+
+	/* A subtree never ends on a key, so a key right before a value is its own. */
+	const Naui_JsonTapeEntry* k = &node.tape->entries[node.index - 1];
+	if (!k->is_key)
+		return NULL;
+
+	if (out_len)
+		*out_len = k->string.len;
+
+	return node.tape->src + k->string.offset;
+}
+
+bool naui_json_node_is_null(Naui_JsonNode node)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(node);
+	return !entry || entry->type == NAUI_JSON_NULL;
+}
+
+bool naui_json_node_get_bool(Naui_JsonNode node, bool default_value)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(node);
+	if (!entry || entry->type != NAUI_JSON_BOOL)
+		return default_value;
+
+	return entry->boolean;
+}
+
+double naui_json_node_get_number(Naui_JsonNode node, double default_value)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(node);
+	if (!entry || entry->type != NAUI_JSON_NUMBER)
+		return default_value;
+
+	return entry->number;
+}
+
+int naui_json_node_get_int(Naui_JsonNode node, int default_value)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(node);
+	if (!entry || entry->type != NAUI_JSON_NUMBER)
+		return default_value;
+
+	return (int)entry->number;
+}
+
+const char* naui_json_node_get_string(Naui_JsonNode node, size_t* out_len)
+{
+	const Naui_JsonTapeEntry* entry = tape_entry(node);
+	if (!entry || entry->type != NAUI_JSON_STRING || entry->is_key)
+		return NULL;
+
+	if (out_len)
+		*out_len = entry->string.len;
+
+	return node.tape->src + entry->string.offset;
+}
+
+int naui_json_node_copy_string(Naui_JsonNode node, char* dest, size_t dest_size)
+{
+	size_t len;
+	const char* str = naui_json_node_get_string(node, &len);
+	if (!str)
+		return -1;
+
+	Naui_JsonValue value;
+	value.type = NAUI_JSON_STRING;
+	value.string.ptr = str;
+	value.string.len = len;
+	return naui_json_copy_string(&value, dest, dest_size);
+}
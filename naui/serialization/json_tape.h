@@ -0,0 +1,77 @@
+/*
+ * On-demand JSON: one pass records every token on a flat tape, containers store the index just past
+ * their subtree. Nodes are cursors into the tape, so lookups skip whole subtrees without building values.
+ * Strings stay in the source buffer (escapes unresolved), which must outlive the tape.
+ */
+typedef struct
+{
+	Naui_JsonType type;
+	bool is_key;
+	uint32_t next;
+	union
+	{
+		bool boolean;
+		double number;
+		uint32_t count;
+		struct
+		{
+			uint32_t offset;
+			uint32_t len;
+		} string;
+	};
+} Naui_JsonTapeEntry;
+
+typedef struct
+{
+	const Naui_JsonTapeEntry* entries;
+	size_t count;
+	const char* src;
+	const char* error;
+	int error_line;
+	int error_col;
+
+	Naui_FileMap _file;
+} Naui_JsonTape;
+
+typedef struct
+{
+	const Naui_JsonTape* tape;
+	uint32_t index;
+	uint32_t _end;
+} Naui_JsonNode;
+
+/* Inputs are limited to 4 GiB, tape offsets are 32-bit. */
+Naui_JsonTape naui_json_tape_parse(const char* src, size_t len);
+Naui_JsonTape naui_json_tape_parse_file(const Naui_Path path);
+void naui_json_tape_free(Naui_JsonTape* tape);
+
+Naui_JsonNode naui_json_tape_root(const Naui_JsonTape* tape);
+
+bool naui_json_node_valid(Naui_JsonNode node);
+Naui_JsonType naui_json_node_type(Naui_JsonNode node);
+
+/* Members of an object, elements of an array, 0 for anything else. */
+size_t naui_json_node_count(Naui_JsonNode node);
+
+Naui_JsonNode naui_json_node_object_get(Naui_JsonNode object, const char* key);
+
+/* Walks `index` siblings, prefer first/next when visiting every element. */
+Naui_JsonNode naui_json_node_array_get(Naui_JsonNode array, size_t index);
+
+/* First element or member value of a container, and the one after `node`. Invalid past the end. */
+Naui_JsonNode naui_json_node_first(Naui_JsonNode container);
+Naui_JsonNode naui_json_node_next(Naui_JsonNode node);
+
+/* Raw key of an object member value, NULL for anything else. */
+const char* naui_json_node_key(Naui_JsonNode node, size_t* out_len);
+
+bool naui_json_node_is_null(Naui_JsonNode node);
+bool naui_json_node_get_bool(Naui_JsonNode node, bool default_value);
+double naui_json_node_get_number(Naui_JsonNode node, double default_value);
+int naui_json_node_get_int(Naui_JsonNode node, int default_value);
+
+/* Raw string in the source buffer, not null-terminated. */
+const char* naui_json_node_get_string(Naui_JsonNode node, size_t* out_len);
+
+/* Same contract as naui_json_copy_string. */
+int naui_json_node_copy_string(Naui_JsonNode node, char* dest, size_t dest_size);
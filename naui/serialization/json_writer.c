@@ -1,48 +1,98 @@
 #pragma region Static Functions
-static void writer_putc(Naui_JsonWriter* writer, char c)
+static void writer_flush_stream(Naui_JsonWriter* writer)
 {
-	if (writer->has_error)
+	size_t pending = writer->written - writer->_flushed;
+	if (pending == 0 || writer->has_error)
 		return;
 
-	if (writer->_heap)
+	if (!writer->_flush(writer->_user, writer->buf, pending))
 	{
-		if (writer->written + 1 >= writer->buf_size)
-		{
-			size_t new_cap = writer->buf_size ? writer->buf_size * 2 : 256;
-			char* tmp = (char*)realloc(writer->buf, new_cap);
-			if (!tmp)
-			{
-				writer->has_error = true;
-				return;
-			}
+		writer->has_error = true;
+		return;
+	}
 
-			writer->buf = tmp;
-			writer->buf_size = new_cap;
-		}
+	writer->_flushed = writer->written;
+}
+
+/* Makes room for `len` more bytes in heap or fixed mode, keeping one byte for the terminator. */
+static bool writer_reserve(Naui_JsonWriter* writer, size_t len)
+{
+	if (writer->written + len < writer->buf_size)
+		return true;
+
+	if (!writer->_heap)
+	{
+		writer->has_error = true;
+		return false;
+	}
+
+	size_t new_cap = writer->buf_size ? writer->buf_size * 2 : 256;
+	while (writer->written + len >= new_cap)
+	{
+		new_cap *= 2;
 	}
-	else if (writer->written + 1 >= writer->buf_size)
+
+	char* tmp = (char*)realloc(writer->buf, new_cap);
+	if (!tmp)
 	{
 		writer->has_error = true;
-		return;
+		return false;
 	}
 
-	writer->buf[writer->written++] = c;
+	writer->buf = tmp;
+	writer->buf_size = new_cap;
+	return true;
 }
 
 static void writer_puts(Naui_JsonWriter* writer, const char* str, size_t len)
 {
-	for (size_t i = 0; i < len; ++i)
+	if (writer->has_error || len == 0)
+		return;
+
+	if (writer->_flush)
 	{
-		writer_putc(writer, str[i]);
+		while (len > 0 && !writer->has_error)
+		{
+			size_t pos = writer->written - writer->_flushed;
+			if (pos == writer->buf_size)
+			{
+				writer_flush_stream(writer);
+				continue;
+			}
+
+			size_t n = writer->buf_size - pos;
+			if (n > len)
+				n = len;
+
+			memcpy(writer->buf + pos, str, n);
+			writer->written += n;
+			str += n;
+			len -= n;
+		}
+
+		return;
 	}
+
+	if (!writer_reserve(writer, len))
+		return;
+
+	memcpy(writer->buf + writer->written, str, len);
+	writer->written += len;
+}
+
+static void writer_putc(Naui_JsonWriter* writer, char c)
+{
+	writer_puts(writer, &c, 1);
 }
 
 static void writer_cstr(Naui_JsonWriter* writer, const char* str)
 {
-	while (*str)
-	{
-		writer_putc(writer, *str++);
-	}
+	writer_puts(writer, str, strlen(str));
+}
+
+static bool writer_file_flush(void* user, const char* data, size_t len)
+{
+	return naui_file_write((const Naui_FileHandle*)user, data, len) == len;
 }
 
 static void writer_indent(Naui_JsonWriter* writer)
@@ -75,9 +125,15 @@ static void writer_comma_and_indent(Naui_JsonWriter* writer)
 static void writer_string_escaped(Naui_JsonWriter* writer, const char* str, size_t len)
 {
 	writer_putc(writer, '"');
+	size_t run = 0;
 	for (size_t i = 0; i < len; ++i)
 	{
 		unsigned char c = (unsigned char)str[i];
+		if (c >= 0x20 && c != '"' && c != '\\')
+			continue;
+
+		writer_puts(writer, str + run, i - run);
+		run = i + 1;
 		switch (c)
 		{
 			case '"':
@@ -109,19 +165,16 @@ static void writer_string_escaped(Naui_JsonWriter* writer, const char* str, size
 				break;
 
 			default:
-				if (c < 0x20)
-				{
-					char esc[7];
-					snprintf(esc, sizeof(esc), "\\u%04x", c);
-					writer_puts(writer, esc, 6);
-				}
-				else
-					writer_putc(writer, (char)c);
-
+			{
+				char esc[7];
+				snprintf(esc, sizeof(esc), "\\u%04x", c);
+				writer_puts(writer, esc, 6);
 				break;
+			}
 		}
 	}
 
+	writer_puts(writer, str + run, len - run);
 	writer_putc(writer, '"');
 }
 
@@ -161,6 +214,33 @@ void naui_json_writer_init_heap(Naui_JsonWriter* writer, bool is_pretty)
 	writer->_heap = true;
 }
 
+void naui_json_writer_init_stream(Naui_JsonWriter* writer, char* buf, size_t buf_size, Naui_JsonWriterFlushFn flush, void* user, bool is_pretty)
+{
+	memset(writer, 0, sizeof(*writer));
+	writer->buf = buf;
+	writer->buf_size = buf_size;
+	writer->is_pretty = is_pretty;
+	writer->_flush = flush;
+	writer->_user = user;
+	writer->has_error = !buf || buf_size == 0 || !flush;
+}
+
+void naui_json_writer_init_file(Naui_JsonWriter* writer, const Naui_FileHandle* handle, char* buf, size_t buf_size, bool is_pretty)
+{
+	naui_json_writer_init_stream(writer, buf, buf_size, writer_file_flush, (void*)handle, is_pretty);
+	if (!naui_file_is_valid(handle))
+		writer->has_error = true;
+}
+
+bool naui_json_writer_flush(Naui_JsonWriter* writer)
+{
+	if (!writer->_flush)
+		return false;
+
+	writer_flush_stream(writer);
+	return !writer->has_error;
+}
+
 void naui_json_writer_object_begin(Naui_JsonWriter* writer)
 {
 	writer_comma_and_indent(writer);
@@ -319,6 +399,14 @@ int naui_json_writer_finish(Naui_JsonWriter* writer)
 	if (writer->has_error)
 		return -1;
 
+	if (writer->_flush)
+	{
+		if (!naui_json_writer_flush(writer))
+			return -1;
+
+		return writer->written > INT_MAX ? INT_MAX : (int)writer->written;
+	}
+
 	if (writer->buf && writer->buf_size > 0)
 	{
 		size_t null_pos = writer->written < writer->buf_size ? writer->written : writer->buf_size - 1;
@@ -335,6 +423,10 @@ char* naui_json_writer_finish_heap(Naui_JsonWriter* writer, size_t* out_len)
 {
 	if (writer->has_error || !writer->_heap)
 	{
+		if (writer->_heap)
+			free(writer->buf);
+
+		writer->buf = NULL;
 		if (out_len)
 			*out_len = 0;
 			
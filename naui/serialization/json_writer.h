@@ -1,4 +1,9 @@
 #define NAUI_JSON_WRITER_MAX_DEPTH 64
+#define NAUI_JSON_WRITER_STREAM_SIZE (8 * 1024)
+
+/* Receives the next chunk of output in stream mode.
+ * Return false to abort, the writer then reports an error. */
+typedef bool (*Naui_JsonWriterFlushFn)(void* user, const char* data, size_t len);
 
 typedef struct
 {
@@ -9,6 +14,9 @@ typedef struct
 	bool has_error;
 
 	bool _heap;
+	size_t _flushed;
+	Naui_JsonWriterFlushFn _flush;
+	void* _user;
 	uint8_t _depth;
 	bool _needs_comma[NAUI_JSON_WRITER_MAX_DEPTH];
 	bool _in_object[NAUI_JSON_WRITER_MAX_DEPTH];
@@ -22,6 +30,17 @@ void naui_json_writer_init(Naui_JsonWriter* w, char* buf, size_t buf_size, bool
  * Grows as needed. */
 void naui_json_writer_init_heap(Naui_JsonWriter* w, bool is_pretty);
 
+/* Uses buf as a bounded staging area, handing it to flush every time it fills up.
+ * Memory use stays at buf_size no matter how large the document gets. */
+void naui_json_writer_init_stream(Naui_JsonWriter* w, char* buf, size_t buf_size, Naui_JsonWriterFlushFn flush, void* user, bool is_pretty);
+
+/* Stream mode writing to an open file handle. The handle must outlive the writer. */
+void naui_json_writer_init_file(Naui_JsonWriter* w, const Naui_FileHandle* handle, char* buf, size_t buf_size, bool is_pretty);
+
+/* Stream mode only: hands everything buffered so far to the sink.
+ * Returns false on error. */
+bool naui_json_writer_flush(Naui_JsonWriter* w);
+
 void naui_json_writer_object_begin(Naui_JsonWriter* w);
 void naui_json_writer_object_end(Naui_JsonWriter* w);
 void naui_json_writer_array_begin(Naui_JsonWriter* w);
@@ -41,7 +60,8 @@ void naui_json_writer_uint64(Naui_JsonWriter* w, uint64_t value);
 void naui_json_writer_bool(Naui_JsonWriter* w, bool value);
 void naui_json_writer_null(Naui_JsonWriter* w);
 
-/* Returns bytes written or -1 on error/truncation. */
+/* Returns bytes written or -1 on error/truncation.
+ * In stream mode the remaining output is flushed, use w->written for totals past INT_MAX. */
 int naui_json_writer_finish(Naui_JsonWriter* w);
 
 /* Returns the buffer, NULL on error. */
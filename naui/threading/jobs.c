@@ -276,6 +276,11 @@ void naui_jobs_shutdown(void)
 	memset(&g_jobs, 0, sizeof(g_jobs));
 }
 
+int32_t naui_jobs_worker_count(void)
+{
+	return g_jobs.initialized ? g_jobs.worker_count : 0;
+}
+
 Naui_JobSubmitResult naui_job_submit(Naui_JobHandle* out_handle, Naui_JobFn fn, void* data)
 {
 	if (out_handle)
@@ -26,6 +26,9 @@ void naui_jobs_init(int32_t thread_count, int32_t job_capacity);
 /* Finish all pending/running jobs, then tear down the pool. */
 void naui_jobs_shutdown(void);
 
+/* Number of worker threads, 0 if the pool is not initialized. */
+int32_t naui_jobs_worker_count(void);
+
 /* Submit a job.
  * On success, *out_handle is set and NAUI_JOB_SUBMIT_OK is returned.
  * On failure, *out_handle is set to NAUI_JOB_INVALID. */
@@ -1,4 +1,5 @@
 #define NAUI_ARENA_BLOCK_SIZE (32 * 1024)
+#define NAUI_ARENA_ALIGN(size) (((size) + sizeof(void*) - 1) & ~(sizeof(void*) - 1))
 
 typedef struct Naui_ArenaBlock
 {
@@ -20,16 +21,10 @@ static void* arena_alloc_block(Naui_Arena* arena, size_t size)
 	if(!arena->head)
 		arena->head = block;
 	else
-	{
-		Naui_ArenaBlock* last = arena->head;
-		while(last->next)
-		{
-			last = last->next;
-		}
+		arena->tail->next = block;
+
+	arena->tail = block;
 
-		last->next = block;
-	}
- 
 	memset((char*)(block + 1), 0, size);
 	return block;
 }
@@ -37,8 +32,13 @@ static void* arena_alloc_block(Naui_Arena* arena, size_t size)
 void naui_arena_init(Naui_Arena* arena, size_t size)
 {
 	arena->head = NULL;
+	arena->tail = NULL;
 	if(size > 0)
-		arena_alloc_block(arena, size);
+	{
+		Naui_ArenaBlock* block = (Naui_ArenaBlock*)arena_alloc_block(arena, size);
+		if(block)
+			block->used = 0;
+	}
 }
 
 void naui_arena_free(Naui_Arena* arena)
@@ -52,6 +52,7 @@ void naui_arena_free(Naui_Arena* arena)
 	}
 
 	arena->head = NULL;
+	arena->tail = NULL;
 }
 
 void naui_arena_reset(Naui_Arena* arena)
@@ -66,16 +67,8 @@ void naui_arena_reset(Naui_Arena* arena)
 
 void* naui_arena_alloc(Naui_Arena* arena, size_t size)
 {
-	size = (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
-	Naui_ArenaBlock* block = arena->head;
-	Naui_ArenaBlock* last = NULL;
-
-	while(block)
-	{
-		last = block;
-		block = block->next;
-	}
-
+	size = NAUI_ARENA_ALIGN(size);
+	Naui_ArenaBlock* last = arena->tail;
 	if(last && last->used + size <= last->cap)
 	{
 		void* ptr = (char*)(last + 1) + last->used;
@@ -91,6 +84,87 @@ void* naui_arena_alloc(Naui_Arena* arena, size_t size)
 	return (char*)(new_block + 1);
 }
 
+void* naui_arena_resize(Naui_Arena* arena, void* ptr, size_t old_size, size_t new_size)
+{
+	if(!ptr)
+		return NULL;
+
+	old_size = NAUI_ARENA_ALIGN(old_size);
+	new_size = NAUI_ARENA_ALIGN(new_size);
+
+	Naui_ArenaBlock* last = arena->tail;
+	if(last && (char*)ptr + old_size == (char*)(last + 1) + last->used && last->used - old_size + new_size <= last->cap)
+	{
+		last->used = last->used - old_size + new_size;
+		if(new_size > old_size)
+			memset((char*)ptr + old_size, 0, new_size - old_size);
+
+		return ptr;
+	}
+
+	/* Only large allocations own a block, and a block holding nothing else can be reallocated as a whole. */
+	if(old_size < NAUI_ARENA_BLOCK_SIZE)
+		return NULL;
+
+	Naui_ArenaBlock* prev = NULL;
+	Naui_ArenaBlock* block = arena->head;
+	while(block && (void*)(block + 1) != ptr)
+	{
+		prev = block;
+		block = block->next;
+	}
+
+	if(!block || block->used != old_size)
+		return NULL;
+
+	Naui_ArenaBlock* moved = (Naui_ArenaBlock*)realloc(block, sizeof(Naui_ArenaBlock) + new_size);
+	if(!moved)
+		return NULL;
+
+	if(prev)
+		prev->next = moved;
+	else
+		arena->head = moved;
+
+	if(arena->tail == block)
+		arena->tail = moved;
+
+	moved->used = new_size;
+	moved->cap = new_size;
+	if(new_size > old_size)
+		memset((char*)(moved + 1) + old_size, 0, new_size - old_size);
+
+	return moved + 1;
+}
+
+void naui_arena_merge(Naui_Arena* dst, Naui_Arena* src)
+{
+	if(!src->head)
+		return;
+
+	if(!dst->head)
+		dst->head = src->head;
+	else
+		dst->tail->next = src->head;
+
+	dst->tail = src->tail;
+	src->head = NULL;
+	src->tail = NULL;
+}
+
+Naui_ArenaStats naui_arena_stats(const Naui_Arena* arena)
+{
+	Naui_ArenaStats stats = {0};
+	for(const Naui_ArenaBlock* block = arena->head; block; block = block->next)
+	{
+		++stats.block_count;
+		stats.used += block->used;
+		stats.reserved += block->cap;
+	}
+
+	return stats;
+}
+
 static Naui_Arena frame_arena = {0};
 
 NAUI_API Naui_Arena *naui_arena_frame(void) {
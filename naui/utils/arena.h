@@ -3,11 +3,30 @@ typedef struct Naui_ArenaBlock Naui_ArenaBlock;
 typedef struct Naui_Arena
 {
 	Naui_ArenaBlock* head;
+	Naui_ArenaBlock* tail;
 } Naui_Arena;
 
+typedef struct Naui_ArenaStats
+{
+	size_t block_count;
+	size_t used;
+	size_t reserved;
+} Naui_ArenaStats;
+
 NAUI_API void naui_arena_init(Naui_Arena* arena, size_t size);
 NAUI_API void naui_arena_free(Naui_Arena* arena);
 NAUI_API void naui_arena_reset(Naui_Arena* arena);
 NAUI_API void* naui_arena_alloc(Naui_Arena* arena, size_t size);
 
+/* Resizes an allocation in place when it is the most recent one, or when it owns a whole block.
+ * Returns the (possibly moved) memory with any growth zeroed, or NULL when neither applies - the
+ * caller then allocates a new region. old_size must be the size the allocation was made with. */
+NAUI_API void* naui_arena_resize(Naui_Arena* arena, void* ptr, size_t old_size, size_t new_size);
+
+/* Moves every block of src to the end of dst without copying, src is left empty. */
+NAUI_API void naui_arena_merge(Naui_Arena* dst, Naui_Arena* src);
+
+/* Walks the block list, meant for diagnostics and benchmarks. */
+NAUI_API Naui_ArenaStats naui_arena_stats(const Naui_Arena* arena);
+
 NAUI_API Naui_Arena *naui_arena_frame(void);
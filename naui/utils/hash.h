@@ -30,3 +30,149 @@ static inline uint64_t naui_hash_combine(uint64_t h1, uint64_t h2)
 {
 	return h1 ^ (h2 + 0x9e3779b97f4a7c15ull + (h1 << 6) + (h1 >> 2));
 }
+
+#define NAUI_HASH64_PRIME1 0x9E3779B185EBCA87ull
+#define NAUI_HASH64_PRIME2 0xC2B2AE3D27D4EB4Full
+#define NAUI_HASH64_PRIME3 0x165667B19E3779F9ull
+#define NAUI_HASH64_PRIME4 0x85EBCA77C2B2AE63ull
+#define NAUI_HASH64_PRIME5 0x27D4EB2F165667C5ull
+
+/* Streaming XXH64 for file contents, where FNV-1a is too slow and too weak. Input is read little-endian. */
+typedef struct Naui_Hash64State
+{
+	uint64_t acc[4];
+	uint64_t total;
+	uint64_t seed;
+	uint8_t buf[32];
+	uint32_t buf_len;
+} Naui_Hash64State;
+
+static inline uint64_t naui_hash64_rotl(uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t naui_hash64_read64(const uint8_t* p)
+{
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint64_t naui_hash64_round(uint64_t acc, uint64_t input)
+{
+	acc += input * NAUI_HASH64_PRIME2;
+	acc = naui_hash64_rotl(acc, 31);
+	return acc * NAUI_HASH64_PRIME1;
+}
+
+static inline uint64_t naui_hash64_merge(uint64_t h, uint64_t acc)
+{
+	h ^= naui_hash64_round(0, acc);
+	return h * NAUI_HASH64_PRIME1 + NAUI_HASH64_PRIME4;
+}
+
+static inline void naui_hash64_init(Naui_Hash64State* state, uint64_t seed)
+{
+	memset(state, 0, sizeof(*state));
+	state->seed = seed;
+	state->acc[0] = seed + NAUI_HASH64_PRIME1 + NAUI_HASH64_PRIME2;
+	state->acc[1] = seed + NAUI_HASH64_PRIME2;
+	state->acc[2] = seed;
+	state->acc[3] = seed - NAUI_HASH64_PRIME1;
+}
+
+static inline void naui_hash64_stripe(Naui_Hash64State* state, const uint8_t* p)
+{
+	state->acc[0] = naui_hash64_round(state->acc[0], naui_hash64_read64(p));
+	state->acc[1] = naui_hash64_round(state->acc[1], naui_hash64_read64(p + 8));
+	state->acc[2] = naui_hash64_round(state->acc[2], naui_hash64_read64(p + 16));
+	state->acc[3] = naui_hash64_round(state->acc[3], naui_hash64_read64(p + 24));
+}
+
+static inline void naui_hash64_update(Naui_Hash64State* state, const void* data, size_t size)
+{
+	const uint8_t* p = (const uint8_t*)data;
+	state->total += size;
+
+	if (state->buf_len)
+	{
+		size_t take = 32 - state->buf_len;
+		if (take > size)
+			take = size;
+
+		memcpy(state->buf + state->buf_len, p, take);
+		state->buf_len += (uint32_t)take;
+		p += take;
+		size -= take;
+		if (state->buf_len < 32)
+			return;
+
+		naui_hash64_stripe(state, state->buf);
+		state->buf_len = 0;
+	}
+
+	for (; size >= 32; p += 32, size -= 32)
+	{
+		naui_hash64_stripe(state, p);
+	}
+
+	memcpy(state->buf, p, size);
+	state->buf_len = (uint32_t)size;
+}
+
+static inline uint64_t naui_hash64_digest(const Naui_Hash64State* state)
+{
+	uint64_t h;
+	if (state->total >= 32)
+	{
+		h = naui_hash64_rotl(state->acc[0], 1) + naui_hash64_rotl(state->acc[1], 7) + naui_hash64_rotl(state->acc[2], 12) + naui_hash64_rotl(state->acc[3], 18);
+		for (int i = 0; i < 4; ++i)
+		{
+			h = naui_hash64_merge(h, state->acc[i]);
+		}
+	}
+	else
+		h = state->seed + NAUI_HASH64_PRIME5;
+
+	h += state->total;
+
+	const uint8_t* p = state->buf;
+	uint32_t left = state->buf_len;
+	for (; left >= 8; p += 8, left -= 8)
+	{
+		h ^= naui_hash64_round(0, naui_hash64_read64(p));
+		h = naui_hash64_rotl(h, 27) * NAUI_HASH64_PRIME1 + NAUI_HASH64_PRIME4;
+	}
+
+	if (left >= 4)
+	{
+		uint32_t v;
+		memcpy(&v, p, sizeof(v));
+		h ^= (uint64_t)v * NAUI_HASH64_PRIME1;
+		h = naui_hash64_rotl(h, 23) * NAUI_HASH64_PRIME2 + NAUI_HASH64_PRIME3;
+		p += 4;
+		left -= 4;
+	}
+
+	for (; left > 0; ++p, --left)
+	{
+		h ^= (uint64_t)*p * NAUI_HASH64_PRIME5;
+		h = naui_hash64_rotl(h, 11) * NAUI_HASH64_PRIME1;
+	}
+
+	h ^= h >> 33;
+	h *= NAUI_HASH64_PRIME2;
+	h ^= h >> 29;
+	h *= NAUI_HASH64_PRIME3;
+	h ^= h >> 32;
+	return h;
+}
+
+static inline uint64_t naui_hash64(const void* data, size_t size, uint64_t seed)
+{
+	Naui_Hash64State state;
+	naui_hash64_init(&state, seed);
+	naui_hash64_update(&state, data, size);
+	return naui_hash64_digest(&state);
+}
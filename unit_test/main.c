@@ -5,6 +5,11 @@ int main(void)
 {
 	filesystem_test();
 	archive_test();
+	vfs_test();
+	async_io_test();
+	watch_test();
+	file_hash_test();
+	file_filter_test();
 	math_test();
 	string_test();
 	iterator_test();
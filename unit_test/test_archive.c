@@ -167,6 +167,371 @@ static void test_archive_add_folder_extract_to(void)
 	TEST_END();
 }
 
+static void test_archive_add_folder_many(void)
+{
+	TEST_BEGIN("naui_archive_add_folder - many mixed files");
+
+	{
+		/* Text, incompressible noise and empty files, enough to keep every worker busy */
+		naui_directory_create(tp("src_many"));
+		naui_directory_create(tp("src_many" SEP "deep"));
+
+		uint32_t seed = 7;
+		char name[64];
+		char data[4096];
+		for (int i = 0; i < 96; ++i)
+		{
+			size_t len = (size_t)(i % 3 == 2 ? 0 : 512 + i * 31);
+			for (size_t b = 0; b < len; ++b)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				data[b] = i % 3 == 0 ? (char)('a' + b % 7) : (char)(seed >> 24);
+			}
+
+			snprintf(name, sizeof(name), "src_many" SEP "%s%03d.bin", i % 2 ? "deep" SEP : "", i);
+			naui_file_write_all(tp(name), data, len);
+		}
+
+		Naui_Archive w = NAUI_ARCHIVE_INIT;
+		naui_archive_open(&w, tp("many.zip"), NAUI_ARCHIVE_WRITE);
+		ASSERT(naui_archive_add_folder(&w, tp("src_many"), naui_path_from_cstr("pack")));
+		naui_archive_close(&w);
+
+		Naui_Archive r = NAUI_ARCHIVE_INIT;
+		naui_archive_open(&r, tp("many.zip"), NAUI_ARCHIVE_READ);
+		Naui_List(Naui_ArchiveEntry) list = naui_archive_list_entries(&r);
+		ASSERT(naui_list_len(list) == 96);
+		naui_archive_list_free(list);
+
+		naui_directory_create(tp("dst_many"));
+		ASSERT(naui_archive_extract_to(&r, tp("dst_many")));
+		naui_archive_close(&r);
+
+		bool same = true;
+		for (int i = 0; i < 96; ++i)
+		{
+			snprintf(name, sizeof(name), "src_many" SEP "%s%03d.bin", i % 2 ? "deep" SEP : "", i);
+			size_t a_len, b_len;
+			char* a = naui_file_read_all(tp(name), &a_len);
+
+			snprintf(name, sizeof(name), "dst_many" SEP "pack" SEP "%s%03d.bin", i % 2 ? "deep" SEP : "", i);
+			char* b = naui_file_read_all(tp(name), &b_len);
+			same &= a && b && a_len == b_len && memcmp(a, b, a_len) == 0;
+			free(a);
+			free(b);
+		}
+
+		ASSERT(same);
+	}
+
+	TEST_END();
+}
+
+static const Naui_ArchiveEntry* find_entry(Naui_List(Naui_ArchiveEntry) list, const char* path)
+{
+	for (ptrdiff_t i = 0; i < naui_list_len(list); ++i)
+	{
+		if (strcmp(list[i].path.data, path) == 0)
+			return &list[i];
+	}
+
+	return NULL;
+}
+
+static void test_archive_policy(void)
+{
+	TEST_BEGIN("naui_archive_set_policy - per-entry levels and adaptive store");
+
+	{
+		naui_directory_create(tp("src_policy"));
+
+		size_t len = 128 * 1024;
+		char* text = (char*)malloc(len);
+		char* noise = (char*)malloc(len);
+		uint32_t state = 12345;
+		for (size_t i = 0; i < len; ++i)
+		{
+			text[i] = "naui archive policy "[i % 20];
+			state = state * 1664525u + 1013904223u;
+			noise[i] = (char)(state >> 24);
+		}
+
+		naui_file_write_all(tp("src_policy" SEP "text.txt"), text, len);
+		naui_file_write_all(tp("src_policy" SEP "image.PNG"), text, len);
+		naui_file_write_all(tp("src_policy" SEP "noise.bin"), noise, len);
+		write_text(tp("src_policy" SEP "tiny.txt"), "tiny tiny tiny tiny");
+		free(text);
+		free(noise);
+
+		static const Naui_ArchiveRule rules[] = { { ".png", 0, MZ_NO_COMPRESSION } };
+		Naui_ArchivePolicy policy = { MZ_DEFAULT_LEVEL, 64, rules, 1, true, NAUI_ARCHIVE_ADAPTIVE_RATIO };
+
+		Naui_Archive w = NAUI_ARCHIVE_INIT;
+		ASSERT(naui_archive_open(&w, tp("policy.zip"), NAUI_ARCHIVE_WRITE));
+		naui_archive_set_policy(&w, &policy);
+		ASSERT(naui_archive_add_folder(&w, tp("src_policy"), naui_path_from_cstr("")));
+		naui_archive_close(&w);
+
+		Naui_Archive r = NAUI_ARCHIVE_INIT;
+		ASSERT(naui_archive_open(&r, tp("policy.zip"), NAUI_ARCHIVE_READ));
+		Naui_List(Naui_ArchiveEntry) list = naui_archive_list_entries(&r);
+
+		const Naui_ArchiveEntry* e = find_entry(list, "text.txt");
+		ASSERT(e && e->compressed_size < e->size / 10);
+
+		/* Stored by extension even though it would compress, by sampling, and by size. */
+		e = find_entry(list, "image.PNG");
+		ASSERT(e && e->compressed_size == e->size);
+		e = find_entry(list, "noise.bin");
+		ASSERT(e && e->compressed_size == e->size);
+		e = find_entry(list, "tiny.txt");
+		ASSERT(e && e->compressed_size == e->size);
+
+		naui_archive_list_free(list);
+
+		naui_directory_create(tp("policy_out"));
+		ASSERT(naui_archive_extract_to(&r, tp("policy_out")));
+		ASSERT(naui_file_size(tp("policy_out" SEP "noise.bin")) == len);
+		naui_archive_close(&r);
+	}
+
+	TEST_END();
+}
+
+typedef struct
+{
+	int calls;
+	uint64_t last_done;
+	uint64_t total;
+	bool is_monotonic;
+	int cancel_after;
+} Progress;
+
+static bool on_progress(const Naui_ArchiveProgress* progress, void* user)
+{
+	Progress* p = (Progress*)user;
+	p->is_monotonic &= progress->done_bytes >= p->last_done && progress->done_bytes <= progress->total_bytes;
+	p->is_monotonic &= progress->done_entries <= progress->total_entries;
+	p->last_done = progress->done_bytes;
+	p->total = progress->total_bytes;
+	return ++p->calls != p->cancel_after;
+}
+
+static void test_archive_extract_progress(void)
+{
+	TEST_BEGIN("naui_archive_extract_to_progress - progress and cancel");
+
+	{
+		naui_directory_create(tp("src_progress"));
+		naui_directory_create(tp("src_progress" SEP "a"));
+		naui_directory_create(tp("src_progress" SEP "a" SEP "b"));
+
+		/* Past the in-memory limit, so this one streams through the write callback. */
+		size_t big_len = 9 * 1024 * 1024;
+		char* big = (char*)malloc(big_len);
+		for (size_t i = 0; i < big_len; ++i)
+		{
+			big[i] = (char)('a' + (i / 13) % 26);
+		}
+
+		naui_file_write_all(tp("src_progress" SEP "a" SEP "big.bin"), big, big_len);
+
+		char name[64];
+		for (int i = 0; i < 24; ++i)
+		{
+			snprintf(name, sizeof(name), "src_progress" SEP "a" SEP "b" SEP "%02d.txt", i);
+			write_text(tp(name), "progress progress progress");
+		}
+
+		Naui_Archive w = NAUI_ARCHIVE_INIT;
+		naui_archive_open(&w, tp("progress.zip"), NAUI_ARCHIVE_WRITE);
+		ASSERT(naui_archive_add_folder(&w, tp("src_progress"), naui_path_from_cstr("")));
+		naui_archive_close(&w);
+
+		Naui_Archive r = NAUI_ARCHIVE_INIT;
+		ASSERT(naui_archive_open(&r, tp("progress.zip"), NAUI_ARCHIVE_READ));
+
+		Progress progress = { 0, 0, 0, true, -1 };
+		ASSERT(naui_archive_extract_to_progress(&r, tp("progress_out"), on_progress, &progress));
+		ASSERT(progress.is_monotonic);
+		ASSERT(progress.total == big_len + 24 * 26);
+		ASSERT(progress.last_done == progress.total);
+
+		size_t sz;
+		char* out = naui_file_read_all(tp("progress_out" SEP "a" SEP "big.bin"), &sz);
+		ASSERT(out && sz == big_len && memcmp(out, big, big_len) == 0);
+		free(out);
+		free(big);
+		ASSERT(naui_path_exists(tp("progress_out" SEP "a" SEP "b" SEP "23.txt")));
+
+		Progress cancel = { 0, 0, 0, true, 1 };
+		ASSERT(!naui_archive_extract_to_progress(&r, tp("cancel_out"), on_progress, &cancel));
+		ASSERT(cancel.calls == 1 && cancel.last_done == 0);
+		ASSERT(!naui_path_exists(tp("cancel_out" SEP "a" SEP "big.bin")));
+		naui_archive_close(&r);
+	}
+
+	TEST_END();
+}
+
+/* Holds a job worker until the gate is opened, so a task queued behind it cannot start early. */
+static void gate_job(void* data, char* err_buf, size_t err_size)
+{
+	(void)err_buf;
+	(void)err_size;
+	Naui_Mutex gate = (Naui_Mutex)data;
+	naui_mutex_lock(gate);
+	naui_mutex_unlock(gate);
+}
+
+/* Waits for the task's job and returns its status, the handle is released. */
+static Naui_JobStatus finish_task(Naui_JobHandle handle, char* err, size_t err_size)
+{
+	naui_job_wait_peek(handle);
+	Naui_JobStatus status = naui_job_status(handle);
+	snprintf(err, err_size, "%s", naui_job_error(handle));
+	naui_job_release(handle);
+	return status;
+}
+
+static void test_archive_async(void)
+{
+	TEST_BEGIN("naui_archive_*_async - progress, results and cancel");
+
+	/* The tasks run as jobs, so the suite brings up its own pool when the runner has none. */
+	bool owns_jobs = naui_jobs_worker_count() == 0;
+	if (owns_jobs)
+		naui_jobs_init(4, 1024);
+
+	{
+		naui_directory_create(tp("src_async"));
+		naui_directory_create(tp("src_async" SEP "sub"));
+
+		char name[64];
+		for (int i = 0; i < 16; ++i)
+		{
+			snprintf(name, sizeof(name), "src_async" SEP "sub" SEP "%02d.txt", i);
+			write_text(tp(name), "async async");
+		}
+
+		write_text(tp("src_async" SEP "top.txt"), "top");
+
+		char err[128];
+		Naui_ArchiveTask task;
+		Naui_JobHandle handle = naui_archive_pack_async(&task, tp("src_async"), tp("async.zip"), naui_path_from_cstr("data"), NULL, NULL);
+		ASSERT(naui_job_is_valid(handle));
+		ASSERT(finish_task(handle, err, sizeof(err)) == NAUI_JOB_DONE);
+
+		Naui_ArchiveProgress progress = naui_archive_task_progress(&task);
+		ASSERT(progress.total_entries == 17 && progress.done_entries == 17);
+		ASSERT(progress.total_bytes == 16 * 11 + 3 && progress.done_bytes == progress.total_bytes);
+		naui_archive_task_free(&task);
+
+		handle = naui_archive_extract_async(&task, tp("async.zip"), tp("async_out"), NULL, NULL);
+		ASSERT(finish_task(handle, err, sizeof(err)) == NAUI_JOB_DONE);
+		progress = naui_archive_task_progress(&task);
+		ASSERT(progress.done_bytes == 16 * 11 + 3 && progress.done_entries == progress.total_entries);
+		naui_archive_task_free(&task);
+
+		size_t sz;
+		char* out = naui_file_read_all(tp("async_out" SEP "data" SEP "sub" SEP "15.txt"), &sz);
+		ASSERT(out && sz == 11 && memcmp(out, "async async", 11) == 0);
+		free(out);
+
+		handle = naui_archive_create_custom_async(&task, tp("src_async"), tp("async.naui"), NULL, NULL);
+		ASSERT(finish_task(handle, err, sizeof(err)) == NAUI_JOB_DONE);
+		ASSERT(naui_archive_task_progress(&task).done_entries == 17);
+		naui_archive_task_free(&task);
+
+		handle = naui_archive_extract_custom_async(&task, tp("async.naui"), tp("async_custom_out"), NULL, NULL);
+		ASSERT(finish_task(handle, err, sizeof(err)) == NAUI_JOB_DONE);
+		naui_archive_task_free(&task);
+
+		out = naui_file_read_all(tp("async_custom_out" SEP "top.txt"), &sz);
+		ASSERT(out && sz == 3 && memcmp(out, "top", 3) == 0);
+		free(out);
+
+		/* Every worker is parked behind the gate, so the cancel lands before the task starts. */
+		Naui_Mutex gate = naui_mutex_create();
+		naui_mutex_lock(gate);
+
+		int32_t workers = naui_jobs_worker_count();
+		Naui_JobHandle* gates = (Naui_JobHandle*)calloc((size_t)(workers > 0 ? workers : 1), sizeof(Naui_JobHandle));
+		for (int32_t w = 0; w < workers; ++w)
+		{
+			naui_job_submit(&gates[w], gate_job, gate);
+		}
+
+		handle = naui_archive_pack_async(&task, tp("src_async"), tp("cancel.zip"), naui_path_from_cstr(""), NULL, NULL);
+		naui_archive_task_cancel(&task);
+		naui_mutex_unlock(gate);
+
+		ASSERT(finish_task(handle, err, sizeof(err)) == NAUI_JOB_FAILED);
+		ASSERT(strcmp(err, "cancelled") == 0);
+		progress = naui_archive_task_progress(&task);
+		ASSERT(progress.done_entries == 0 && progress.total_entries == 17);
+		ASSERT(!naui_path_exists(tp("cancel.zip")));
+		naui_archive_task_free(&task);
+
+		naui_job_wait_all(gates, workers);
+		naui_mutex_destroy(gate);
+		free(gates);
+	}
+
+	if (owns_jobs)
+		naui_jobs_shutdown();
+
+	TEST_END();
+}
+
+static void test_archive_update_folder(void)
+{
+	TEST_BEGIN("naui_archive_update_folder - only changed files are recompressed");
+
+	{
+		build_src_tree(tp("src_update"));
+
+		Naui_ArchiveUpdateStats stats;
+		ASSERT(naui_archive_update_folder(tp("update.zip"), tp("src_update"), naui_path_from_cstr("data"), NULL, &stats));
+		ASSERT(stats.updated == 3 && stats.unchanged == 0 && stats.removed == 0);
+
+		write_text(tp("src_update" SEP "world.txt"), "World, again");
+		write_text(tp("src_update" SEP "added.txt"), "Added");
+		naui_file_delete(tp("src_update" SEP "hello.txt"));
+
+		ASSERT(naui_archive_update_folder(tp("update.zip"), tp("src_update"), naui_path_from_cstr("data"), NULL, &stats));
+		ASSERT(stats.unchanged == 1);
+		ASSERT(stats.updated == 2);
+		ASSERT(stats.removed == 1);
+
+		ASSERT(naui_archive_update_folder(tp("update.zip"), tp("src_update"), naui_path_from_cstr("data"), NULL, &stats));
+		ASSERT(stats.unchanged == 3 && stats.updated == 0 && stats.removed == 0);
+
+		Naui_Archive r = NAUI_ARCHIVE_INIT;
+		naui_archive_open(&r, tp("update.zip"), NAUI_ARCHIVE_READ);
+		naui_directory_create(tp("update_out"));
+		ASSERT(naui_archive_extract_to(&r, tp("update_out")));
+		naui_archive_close(&r);
+
+		size_t sz;
+		char* world = naui_file_read_all(tp("update_out" SEP "data" SEP "world.txt"), &sz);
+		ASSERT_NOT_NULL(world);
+		ASSERT_STR_EQ(world, "World, again");
+		free(world);
+
+		char* nested = naui_file_read_all(tp("update_out" SEP "data" SEP "sub" SEP "nested.txt"), &sz);
+		ASSERT_NOT_NULL(nested);
+		ASSERT_STR_EQ(nested, "Nested");
+		free(nested);
+
+		ASSERT(naui_path_exists(tp("update_out" SEP "data" SEP "added.txt")));
+		ASSERT(!naui_path_exists(tp("update_out" SEP "data" SEP "hello.txt")));
+		ASSERT(!naui_path_exists(tp("update.zip.tmp")));
+	}
+
+	TEST_END();
+}
+
 static void test_archive_list_entries(void)
 {
 	TEST_BEGIN("naui_archive_list_entries");
@@ -304,6 +669,182 @@ static void test_archive_custom_create_extract(void)
 	TEST_END();
 }
 
+static void test_archive_custom_large_file(void)
+{
+	TEST_BEGIN("naui_archive_create_custom - files spanning several copy chunks");
+
+	{
+		naui_directory_create(tp("src_custom_large"));
+
+		size_t big_len = 3 * 256 * 1024 + 17;
+		char* big = (char*)malloc(big_len);
+		for (size_t i = 0; i < big_len; ++i)
+		{
+			big[i] = (char)(i * 131 + (i >> 11));
+		}
+
+		naui_file_write_all(tp("src_custom_large" SEP "big.bin"), big, big_len);
+		naui_file_write_all(tp("src_custom_large" SEP "empty.bin"), "", 0);
+		write_text(tp("src_custom_large" SEP "tail.txt"), "Tail");
+
+		ASSERT(naui_archive_create_custom(tp("src_custom_large"), tp("custom_large.naui")));
+
+		naui_directory_create(tp("custom_large_out"));
+		ASSERT(naui_archive_extract_custom(tp("custom_large.naui"), tp("custom_large_out")));
+
+		size_t sz;
+		char* out = naui_file_read_all(tp("custom_large_out" SEP "big.bin"), &sz);
+		ASSERT_NOT_NULL(out);
+		ASSERT(sz == big_len && memcmp(out, big, big_len) == 0);
+		free(out);
+		free(big);
+
+		ASSERT(naui_path_exists(tp("custom_large_out" SEP "empty.bin")));
+
+		char* tail = naui_file_read_all(tp("custom_large_out" SEP "tail.txt"), &sz);
+		ASSERT_NOT_NULL(tail);
+		ASSERT_STR_EQ(tail, "Tail");
+		free(tail);
+	}
+
+	TEST_END();
+}
+
+static void test_archive_pak_find(void)
+{
+	TEST_BEGIN("naui_pak_open / naui_pak_find");
+
+	{
+		build_src_tree(tp("src_pak"));
+		ASSERT(naui_archive_create_custom(tp("src_pak"), tp("find.naui")));
+
+		Naui_Pak pak = NAUI_PAK_INIT;
+		ASSERT(naui_pak_open(&pak, tp("find.naui")));
+		ASSERT(pak.count == 3);
+
+		Naui_PakView hello = naui_pak_find(&pak, "hello.txt");
+		ASSERT_NOT_NULL(hello.data);
+		ASSERT(hello.size == 5 && memcmp(hello.data, "Hello", 5) == 0);
+
+		Naui_PakView nested = naui_pak_find(&pak, "sub/nested.txt");
+		ASSERT_NOT_NULL(nested.data);
+		ASSERT(nested.size == 6 && memcmp(nested.data, "Nested", 6) == 0);
+
+		Naui_PakView nested_win = naui_pak_find(&pak, "sub\\nested.txt");
+		ASSERT(nested_win.data == nested.data);
+
+		ASSERT(naui_pak_find(&pak, "missing.txt").data == NULL);
+		ASSERT(naui_pak_find(&pak, "Hello.txt").data == NULL);
+
+		size_t total = 0;
+		for (size_t i = 0; i < pak.count; ++i)
+		{
+			const char* name;
+			size_t name_len;
+			Naui_PakView view = naui_pak_entry(&pak, i, &name, &name_len);
+			ASSERT(name_len > 0 && view.data != NULL);
+			total += view.size;
+		}
+
+		ASSERT(total == 16);
+		naui_pak_close(&pak);
+		ASSERT(pak.data == NULL);
+
+		write_text(tp("bad_pak.naui"), "NauiPak-but-truncated");
+		Naui_Pak bad = NAUI_PAK_INIT;
+		ASSERT(!naui_pak_open(&bad, tp("bad_pak.naui")));
+		ASSERT(!naui_pak_open(&bad, tp("no_such.naui")));
+	}
+
+	TEST_END();
+}
+
+static void test_archive_update_custom(void)
+{
+	TEST_BEGIN("naui_archive_update_custom - unchanged files come from the old pak");
+
+	{
+		build_src_tree(tp("src_pak_update"));
+		ASSERT(naui_archive_create_custom(tp("src_pak_update"), tp("update.naui")));
+
+		write_text(tp("src_pak_update" SEP "world.txt"), "World, again");
+		write_text(tp("src_pak_update" SEP "added.txt"), "Added");
+
+		Naui_ArchiveUpdateStats stats;
+		ASSERT(naui_archive_update_custom(tp("src_pak_update"), tp("update.naui"), &stats));
+		ASSERT(stats.unchanged == 2);
+		ASSERT(stats.updated == 2);
+		ASSERT(stats.removed == 0);
+
+		Naui_Pak pak = NAUI_PAK_INIT;
+		ASSERT(naui_pak_open(&pak, tp("update.naui")));
+		ASSERT(pak.version == NAUI_ARCHIVE_VERSION);
+		ASSERT(pak.count == 4);
+
+		Naui_PakView world = naui_pak_find(&pak, "world.txt");
+		ASSERT(world.size == 12 && memcmp(world.data, "World, again", 12) == 0);
+
+		Naui_PakView hello = naui_pak_find(&pak, "hello.txt");
+		ASSERT(hello.size == 5 && memcmp(hello.data, "Hello", 5) == 0);
+		naui_pak_close(&pak);
+
+		ASSERT(!naui_path_exists(tp("update.naui.tmp")));
+	}
+
+	TEST_END();
+}
+
+static void test_archive_custom_dedup(void)
+{
+	TEST_BEGIN("naui_archive_create_custom - identical files share one payload");
+
+	{
+		naui_directory_create(tp("src_pak_dedup"));
+		naui_directory_create(tp("src_pak_dedup" SEP "copy"));
+
+		size_t len = 2 * 256 * 1024 + 5;
+		char* data = (char*)malloc(len);
+		for (size_t i = 0; i < len; ++i)
+		{
+			data[i] = (char)(i * 7 + (i >> 9));
+		}
+
+		naui_file_write_all(tp("src_pak_dedup" SEP "a.bin"), data, len);
+		naui_file_write_all(tp("src_pak_dedup" SEP "copy" SEP "a.bin"), data, len);
+
+		/* Same size, one byte different at the end. */
+		data[len - 1] ^= 1;
+		naui_file_write_all(tp("src_pak_dedup" SEP "near.bin"), data, len);
+
+		ASSERT(naui_archive_create_custom(tp("src_pak_dedup"), tp("dedup.naui")));
+
+		Naui_Pak pak = NAUI_PAK_INIT;
+		ASSERT(naui_pak_open(&pak, tp("dedup.naui")));
+
+		Naui_PakView a = naui_pak_find(&pak, "a.bin");
+		Naui_PakView copy = naui_pak_find(&pak, "copy/a.bin");
+		Naui_PakView near = naui_pak_find(&pak, "near.bin");
+		ASSERT(a.data != NULL && a.data == copy.data && a.size == len);
+		ASSERT(near.data != a.data && memcmp(near.data, data, len) == 0);
+
+		Naui_PakStats stats = naui_pak_stats(&pak);
+		ASSERT(stats.payloads == 2);
+		ASSERT(stats.logical_size == 3 * (uint64_t)len);
+		ASSERT(stats.stored_size == 2 * (uint64_t)len);
+		naui_pak_close(&pak);
+		free(data);
+
+		/* Unchanged files copied from the old pak are deduplicated too. */
+		Naui_ArchiveUpdateStats update;
+		ASSERT(naui_archive_update_custom(tp("src_pak_dedup"), tp("dedup.naui"), &update));
+		ASSERT(update.unchanged == 3);
+		ASSERT(update.duplicates == 1);
+		ASSERT(update.bytes_saved == len);
+	}
+
+	TEST_END();
+}
+
 static void test_archive_custom_bad_magic(void)
 {
 	TEST_BEGIN("naui_archive_extract_custom - bad magic");
@@ -325,11 +866,20 @@ void archive_test(void)
 	test_archive_open_invalid();
 	test_archive_add_extract_file();
 	test_archive_add_folder_extract_to();
+	test_archive_add_folder_many();
+	test_archive_extract_progress();
+	test_archive_async();
+	test_archive_update_folder();
+	test_archive_policy();
 	test_archive_list_entries();
 	test_archive_move();
 	test_archive_mode_guard();
 	test_archive_custom_create_extract();
+	test_archive_custom_large_file();
+	test_archive_update_custom();
+	test_archive_custom_dedup();
 	test_archive_custom_bad_magic();
+	test_archive_pak_find();
 
 	naui_directory_remove_all(root);
 }
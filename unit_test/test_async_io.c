@@ -0,0 +1,153 @@
+#include "test.h"
+#include "test_func.h"
+#include "naui/filesystem/async_io.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#	define SEP "\\"
+#else
+#	define SEP "/"
+#endif
+
+static Naui_Path temp_root(void)
+{
+	static char buf[NAUI_PATH_MAX];
+	static bool computed = false;
+
+	if (!computed)
+	{
+#if defined(_WIN32) || defined(_WIN64)
+		const char* tmp = getenv("TEMP");
+		if (!tmp) tmp = "C:\\Temp";
+		snprintf(buf, sizeof(buf), "%s\\naui_async_io_test", tmp);
+#else
+		snprintf(buf, sizeof(buf), "/tmp/naui_async_io_test");
+#endif
+		computed = true;
+	}
+
+	return naui_path_from_cstr(buf);
+}
+
+static Naui_Path tp(const char* sub)
+{
+	Naui_Path path;
+	snprintf(path.data, NAUI_PATH_MAX, "%s" SEP "%s", temp_root().data, sub);
+	return path;
+}
+
+static void on_read(Naui_IoRequest* request, void* user)
+{
+	(void)request;
+	++*(int*)user;
+}
+
+static void test_async_io_backend(Naui_IoBackend backend, const char* name)
+{
+	TEST_BEGIN(name);
+
+	{
+		ASSERT(naui_io_init(backend, 8));
+		ASSERT(backend == NAUI_IO_BACKEND_AUTO || naui_io_backend() == backend);
+
+		/* More files than the ring holds, so some wait for a slot. */
+		enum { FILE_COUNT = 40 };
+		Naui_IoRequest* requests = (Naui_IoRequest*)calloc(FILE_COUNT + 1, sizeof(Naui_IoRequest));
+		char name_buf[64];
+		char text[64];
+		for (int i = 0; i < FILE_COUNT; ++i)
+		{
+			snprintf(name_buf, sizeof(name_buf), "file_%02d.txt", i);
+			snprintf(text, sizeof(text), "contents of file %d", i);
+			naui_file_write_all(tp(name_buf), text, strlen(text));
+
+			requests[i].op = NAUI_IO_READ;
+			requests[i].path = tp(name_buf);
+			requests[i].on_done = on_read;
+		}
+
+		requests[FILE_COUNT].op = NAUI_IO_READ;
+		requests[FILE_COUNT].path = tp("missing.txt");
+
+		int callbacks = 0;
+		for (int i = 0; i < FILE_COUNT; ++i)
+		{
+			requests[i].user = &callbacks;
+		}
+
+		ASSERT(naui_io_submit(requests, FILE_COUNT + 1));
+		ASSERT(!naui_io_submit(requests, 1));
+		naui_io_wait_all();
+		ASSERT(callbacks == FILE_COUNT);
+
+		bool all_match = true;
+		for (int i = 0; i < FILE_COUNT; ++i)
+		{
+			snprintf(text, sizeof(text), "contents of file %d", i);
+			all_match &= requests[i].status == NAUI_IO_DONE && requests[i].transferred == strlen(text);
+			all_match &= requests[i].buffer && strcmp((const char*)requests[i].buffer, text) == 0;
+			naui_io_release(&requests[i]);
+		}
+
+		ASSERT(all_match);
+		ASSERT(requests[FILE_COUNT].status == NAUI_IO_FAILED);
+		ASSERT(requests[0].buffer == NULL && requests[0].status == NAUI_IO_IDLE);
+
+		/* A slice of a file into the caller's buffer. */
+		char slice[5] = { 0 };
+		Naui_IoRequest part;
+		memset(&part, 0, sizeof(part));
+		part.op = NAUI_IO_READ;
+		part.path = tp("file_07.txt");
+		part.buffer = slice;
+		part.size = 4;
+		part.offset = 9;
+		ASSERT(naui_io_submit(&part, 1));
+		naui_io_wait(&part);
+		ASSERT(part.status == NAUI_IO_DONE && part.transferred == 4 && memcmp(slice, "of f", 4) == 0);
+
+		/* Writes replace the file. */
+		size_t save_len = 300 * 1024;
+		char* save = (char*)malloc(save_len);
+		for (size_t i = 0; i < save_len; ++i)
+		{
+			save[i] = (char)('A' + i % 23);
+		}
+
+		Naui_IoRequest write;
+		memset(&write, 0, sizeof(write));
+		write.op = NAUI_IO_WRITE;
+		write.path = tp("save.bin");
+		write.buffer = save;
+		write.size = save_len;
+		ASSERT(naui_io_submit(&write, 1));
+		naui_io_wait(&write);
+		ASSERT(write.status == NAUI_IO_DONE && write.transferred == save_len);
+
+		size_t got;
+		char* back = naui_file_read_all(tp("save.bin"), &got);
+		ASSERT(back && got == save_len && memcmp(back, save, save_len) == 0);
+		free(back);
+		free(save);
+
+		naui_io_release(&requests[FILE_COUNT]);
+		free(requests);
+		naui_io_shutdown();
+		ASSERT(naui_io_backend() == NAUI_IO_BACKEND_AUTO);
+	}
+
+	TEST_END();
+}
+
+void async_io_test(void)
+{
+	Naui_Path root = temp_root();
+	naui_directory_create(root);
+
+	test_async_io_backend(NAUI_IO_BACKEND_AUTO, "naui_io - default backend");
+	test_async_io_backend(NAUI_IO_BACKEND_THREADS, "naui_io - thread pool backend");
+
+	naui_directory_remove_all(root);
+}
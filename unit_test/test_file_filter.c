@@ -0,0 +1,260 @@
+#include "test.h"
+#include "test_func.h"
+#include "naui/filesystem/file_filter.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#	define SEP "\\"
+#else
+#	define SEP "/"
+#endif
+
+static Naui_Path temp_root(void)
+{
+	static char buf[NAUI_PATH_MAX];
+	static bool computed = false;
+
+	if (!computed)
+	{
+#if defined(_WIN32) || defined(_WIN64)
+		const char* tmp = getenv("TEMP");
+		if (!tmp) tmp = "C:\\Temp";
+		snprintf(buf, sizeof(buf), "%s\\naui_file_filter_test", tmp);
+#else
+		snprintf(buf, sizeof(buf), "/tmp/naui_file_filter_test");
+#endif
+		computed = true;
+	}
+
+	return naui_path_from_cstr(buf);
+}
+
+static Naui_Path tp(const char* sub)
+{
+	Naui_Path path;
+	snprintf(path.data, NAUI_PATH_MAX, "%s" SEP "%s", temp_root().data, sub);
+	return path;
+}
+
+static bool glob(const char* pattern, const char* text, bool case_sensitive)
+{
+	Naui_FileFilter filter;
+	naui_file_filter_init(&filter, pattern, NULL, 0, case_sensitive);
+	bool matched = naui_file_filter_match(&filter, text, strlen(text));
+	naui_file_filter_free(&filter);
+	return matched;
+}
+
+static void test_file_filter_glob(void)
+{
+	TEST_BEGIN("Naui_FileFilter - patterns");
+
+	{
+		ASSERT(glob(NULL, "anything", true));
+		ASSERT(glob("", "anything", true));
+		ASSERT(glob("*", "anything", true));
+
+		ASSERT(glob("icon.png", "icon.png", true));
+		ASSERT(!glob("icon.png", "icon.pn", true));
+		ASSERT(!glob("icon.png", "Icon.png", true));
+		ASSERT(glob("icon.png", "Icon.PNG", false));
+
+		ASSERT(glob("*.png", "icon.png", true));
+		ASSERT(glob("*.png", ".png", true));
+		ASSERT(!glob("*.png", "icon.png.bak", true));
+		ASSERT(glob("icon_*", "icon_", true));
+		ASSERT(glob("icon_*.png", "icon_42.png", true));
+		ASSERT(!glob("icon_*.png", "icon.png", true));
+		ASSERT(!glob("ab*ba", "aba", true));
+		ASSERT(glob("*.PNG", "a.png", false));
+
+		ASSERT(glob("a*b*c", "axxbyyc", true));
+		ASSERT(glob("a*b*c", "abcbc", true));
+		ASSERT(!glob("a*b*c", "acb", true));
+		ASSERT(glob("*a*a*a*b", "aaaaaaaaaaaaaaaaaaab", true));
+		ASSERT(!glob("*a*a*a*b", "aaaaaaaaaaaaaaaaaaaa", true));
+
+		ASSERT(glob("icon_??.png", "icon_42.png", true));
+		ASSERT(!glob("icon_??.png", "icon_4.png", true));
+
+		ASSERT(glob("[abc].txt", "b.txt", true));
+		ASSERT(!glob("[abc].txt", "d.txt", true));
+		ASSERT(glob("[a-z]x", "qx", true));
+		ASSERT(!glob("[a-z]x", "Qx", true));
+		ASSERT(glob("[a-z]x", "Qx", false));
+		ASSERT(glob("[!._]*", "name", true));
+		ASSERT(!glob("[!._]*", ".hidden", true));
+		ASSERT(glob("[]]", "]", true));
+		ASSERT(glob("[*]", "*", true));
+		ASSERT(!glob("[*]", "a", true));
+		ASSERT(glob("a[b", "a[b", true));
+	}
+
+	TEST_END();
+}
+
+static void test_file_filter_paths(void)
+{
+	TEST_BEGIN("Naui_FileFilter - path patterns");
+
+	{
+		Naui_FileFilter filter;
+		naui_file_filter_init(&filter, "Textures/*.png", NULL, 0, true);
+		ASSERT(filter.is_path);
+		ASSERT(naui_file_filter_match(&filter, "Textures/a.png", 14));
+		ASSERT(!naui_file_filter_match(&filter, "Textures/ui/a.png", 17));
+		ASSERT(!naui_file_filter_match(&filter, "a.png", 5));
+		naui_file_filter_free(&filter);
+
+		ASSERT(glob("**/*.png", "a.png", true));
+		ASSERT(glob("**/*.png", "x/y/a.png", true));
+		ASSERT(!glob("**/*.png", "x/y/a.json", true));
+		ASSERT(glob("Textures/**/*.png", "Textures/a.png", true));
+		ASSERT(glob("Textures/**/*.png", "Textures/ui/icons/a.png", true));
+		ASSERT(!glob("Textures/**/*.png", "Sounds/ui/a.png", true));
+		ASSERT(glob("Textures/**", "Textures/ui/a.png", true));
+		ASSERT(glob("a/?/c", "a/b/c", true));
+		ASSERT(!glob("a/?/c", "a//c", true));
+		ASSERT(!glob("a/*c", "a/b/c", true));
+		ASSERT(glob("a/**c", "a/b/c", true));
+		ASSERT(glob("*/*.json", "pack/a.json", true));
+		ASSERT(!glob("*/*.json", "pack/group/a.json", true));
+	}
+
+	TEST_END();
+}
+
+static void test_file_filter_extensions(void)
+{
+	TEST_BEGIN("Naui_FileFilter - extensions");
+
+	{
+		const char* exts[] = { ".png", "jpg", NULL, ".tar", ".png", ".JSON" };
+
+		Naui_FileFilter filter;
+		ASSERT(naui_file_filter_init(&filter, NULL, exts, 6, true));
+		ASSERT(!naui_file_filter_is_open(&filter));
+		ASSERT(filter._ext_count == 4);
+		ASSERT(naui_file_filter_match(&filter, "a.png", 5));
+		ASSERT(naui_file_filter_match(&filter, "a.jpg", 5));
+		ASSERT(naui_file_filter_match(&filter, "a.b.JSON", 8));
+		ASSERT(!naui_file_filter_match(&filter, "a.json", 6));
+		ASSERT(!naui_file_filter_match(&filter, "a.tar.gz", 8));
+		ASSERT(!naui_file_filter_match(&filter, "png", 3));
+		ASSERT(!naui_file_filter_match(&filter, "dir.png/file", 12));
+		naui_file_filter_free(&filter);
+
+		ASSERT(naui_file_filter_init(&filter, "icon_*", exts, 6, false));
+		ASSERT(naui_file_filter_match(&filter, "ICON_1.PNG", 10));
+		ASSERT(naui_file_filter_match(&filter, "icon_2.json", 11));
+		ASSERT(!naui_file_filter_match(&filter, "logo.png", 8));
+		naui_file_filter_free(&filter);
+
+		/* Many extensions still land in one probe or two. */
+		char names[64][8];
+		const char* many[64];
+		for (int i = 0; i < 64; ++i)
+		{
+			snprintf(names[i], sizeof(names[i]), ".e%d", i);
+			many[i] = names[i];
+		}
+
+		ASSERT(naui_file_filter_init(&filter, NULL, many, 64, true));
+		ASSERT(filter._ext_count == 64);
+		ASSERT(naui_file_filter_match(&filter, "x.e0", 4));
+		ASSERT(naui_file_filter_match(&filter, "x.e63", 5));
+		ASSERT(!naui_file_filter_match(&filter, "x.e64", 5));
+		naui_file_filter_free(&filter);
+
+		ASSERT(naui_file_filter_init(&filter, "", NULL, 0, true));
+		ASSERT(naui_file_filter_is_open(&filter));
+		naui_file_filter_free(&filter);
+	}
+
+	TEST_END();
+}
+
+static void test_file_filter_listing(void)
+{
+	TEST_BEGIN("Naui_FileFilter - directory listings");
+
+	{
+		naui_directory_create(tp("Textures"));
+		naui_directory_create(tp("Textures" SEP "ui"));
+		naui_file_write_all(tp("readme.txt"), "r", 1);
+		naui_file_write_all(tp("Textures" SEP "icon_a.png"), "a", 1);
+		naui_file_write_all(tp("Textures" SEP "icon_b.jpg"), "b", 1);
+		naui_file_write_all(tp("Textures" SEP "ui" SEP "icon_c.png"), "c", 1);
+		naui_file_write_all(tp("Textures" SEP "ui" SEP "frame.png"), "f", 1);
+
+		const char* exts[] = { ".png" };
+		Naui_List(Naui_DirEntry) list = naui_directory_filter(tp("Textures"), "icon_*", exts, 1);
+		ASSERT(naui_list_len(list) == 1);
+		naui_directory_filter_free(list);
+
+		/* Folders are always listed by recursive walks, only files are filtered. */
+		size_t files = 0;
+		list = naui_directory_walk(temp_root(), "Textures/**/icon_*.png", NULL, 0, NAUI_WALK_DEFAULT);
+		for (int32_t i = 0; i < naui_list_len(list); ++i)
+		{
+			files += !list[i].is_directory;
+		}
+
+		ASSERT(files == 2);
+		naui_directory_filter_free(list);
+
+		Naui_DirListing listing = NAUI_DIR_LISTING_INIT;
+		ASSERT(naui_directory_list(&listing, tp("Textures"), "ui/*", exts, 1, NAUI_WALK_DEFAULT));
+		files = 0;
+		for (size_t i = 0; i < naui_dir_listing_count(&listing); ++i)
+		{
+			files += !listing.records[i].is_directory;
+		}
+
+		ASSERT(files == 2);
+		naui_dir_listing_free(&listing);
+
+		/* A folder that cannot be listed leaves nothing to free. */
+		ASSERT(!naui_directory_list(&listing, tp("missing"), NULL, NULL, 0, NAUI_WALK_DEFAULT));
+		ASSERT(listing.names == NULL && listing.records == NULL);
+
+		/* The iterator keeps treating a plain filter as a name prefix. */
+		files = 0;
+		Naui_DirIterator it = naui_dir_iterator_open(tp("Textures"), "icon", NAUI_EXTENSIONS(".png", ".jpg"), true, NAUI_DIR_ITERATOR_DEFAULT);
+		for (; naui_dir_iterator_valid(&it); naui_dir_iterator_next(&it))
+		{
+			++files;
+		}
+
+		naui_dir_iterator_close(&it);
+		ASSERT(files == 2);
+
+		files = 0;
+		it = naui_dir_iterator_open(tp("Textures"), "icon_[a]*", NULL, true, NAUI_DIR_ITERATOR_NAMES);
+		for (; naui_dir_iterator_valid(&it); naui_dir_iterator_next(&it))
+		{
+			++files;
+		}
+
+		naui_dir_iterator_close(&it);
+		ASSERT(files == 1);
+	}
+
+	TEST_END();
+}
+
+void file_filter_test(void)
+{
+	Naui_Path root = temp_root();
+	naui_directory_remove_all(root);
+	naui_directory_create(root);
+
+	test_file_filter_glob();
+	test_file_filter_paths();
+	test_file_filter_extensions();
+	test_file_filter_listing();
+
+	naui_directory_remove_all(root);
+}
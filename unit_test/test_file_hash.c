@@ -0,0 +1,191 @@
+#include "test.h"
+#include "test_func.h"
+#include "naui/filesystem/file_hash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#	define SEP "\\"
+#else
+#	define SEP "/"
+#endif
+
+static Naui_Path temp_root(void)
+{
+	static char buf[NAUI_PATH_MAX];
+	static bool computed = false;
+
+	if (!computed)
+	{
+#if defined(_WIN32) || defined(_WIN64)
+		const char* tmp = getenv("TEMP");
+		if (!tmp) tmp = "C:\\Temp";
+		snprintf(buf, sizeof(buf), "%s\\naui_file_hash_test", tmp);
+#else
+		snprintf(buf, sizeof(buf), "/tmp/naui_file_hash_test");
+#endif
+		computed = true;
+	}
+
+	return naui_path_from_cstr(buf);
+}
+
+static Naui_Path tp(const char* sub)
+{
+	Naui_Path path;
+	snprintf(path.data, NAUI_PATH_MAX, "%s" SEP "%s", temp_root().data, sub);
+	return path;
+}
+
+static void write_text(const Naui_Path path, const char* text)
+{
+	naui_file_write_all(path, text, strlen(text));
+}
+
+static void test_file_hash(void)
+{
+	TEST_BEGIN("naui_file_hash");
+
+	{
+		/* Several stream chunks plus a tail that does not fill a stripe. */
+		size_t size = 200 * 1024 + 5;
+		char* data = (char*)malloc(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			data[i] = (char)(i * 131 + (i >> 11));
+		}
+
+		ASSERT(naui_file_write_all(tp("big.bin"), data, size));
+
+		uint64_t hash = 0;
+		ASSERT(naui_file_hash(tp("big.bin"), &hash));
+		ASSERT(hash == naui_hash64(data, size, 0));
+
+		write_text(tp("empty.bin"), "");
+		ASSERT(naui_file_hash(tp("empty.bin"), &hash));
+		ASSERT(hash == naui_hash64("", 0, 0));
+
+		ASSERT(!naui_file_hash(tp("missing.bin"), &hash));
+		ASSERT(hash == 0);
+		ASSERT(!naui_file_hash(temp_root(), &hash));
+
+		free(data);
+	}
+
+	TEST_END();
+}
+
+static void test_file_hash_cache(void)
+{
+	TEST_BEGIN("Naui_FileHashCache");
+
+	{
+		write_text(tp("one.txt"), "one");
+		write_text(tp("two.txt"), "two");
+
+		Naui_FileHashCache cache;
+		ASSERT(naui_file_hash_cache_open(&cache, tp("hashes.cache")));
+
+		uint64_t one = 0, two = 0;
+		ASSERT(naui_file_hash_cached(&cache, tp("one.txt"), &one));
+		ASSERT(naui_file_hash_cached(&cache, tp("two.txt"), &two));
+		ASSERT(one == naui_hash64("one", 3, 0));
+		ASSERT(two == naui_hash64("two", 3, 0));
+		ASSERT(!naui_file_hash_cached(&cache, tp("missing.txt"), &one));
+		ASSERT(naui_file_hash_cache_close(&cache));
+		ASSERT(naui_path_exists(tp("hashes.cache")));
+
+		/* Reopened: both come back from disk, and a changed file is hashed again. */
+		ASSERT(naui_file_hash_cache_open(&cache, tp("hashes.cache")));
+		ASSERT(naui_strmap_len(cache._entries) == 2);
+		ASSERT(naui_file_hash_cached(&cache, tp("one.txt"), &one));
+		ASSERT(one == naui_hash64("one", 3, 0));
+
+		write_text(tp("one.txt"), "one, longer");
+		ASSERT(naui_file_hash_cached(&cache, tp("one.txt"), &one));
+		ASSERT(one == naui_hash64("one, longer", 11, 0));
+		ASSERT(naui_file_hash_cache_close(&cache));
+
+		/* two.txt was not looked up in the last session, so it was dropped. */
+		ASSERT(naui_file_hash_cache_open(&cache, tp("hashes.cache")));
+		ASSERT(naui_strmap_len(cache._entries) == 1);
+		ASSERT(naui_file_hash_cache_close(&cache));
+
+		/* A damaged file gives an empty cache that is rewritten. */
+		write_text(tp("hashes.cache"), "garbage");
+		ASSERT(naui_file_hash_cache_open(&cache, tp("hashes.cache")));
+		ASSERT(naui_strmap_len(cache._entries) == 0);
+		ASSERT(naui_file_hash_cached(&cache, tp("two.txt"), &two));
+		ASSERT(naui_file_hash_cache_close(&cache));
+		ASSERT(naui_file_hash_cache_open(&cache, tp("hashes.cache")));
+		ASSERT(naui_strmap_len(cache._entries) == 1);
+		ASSERT(naui_file_hash_cache_close(&cache));
+
+		/* Without a path nothing is written. */
+		ASSERT(naui_file_hash_cache_open(&cache, naui_path_from_cstr("")));
+		ASSERT(naui_file_hash_cached(&cache, tp("two.txt"), &two));
+		ASSERT(naui_file_hash_cache_close(&cache));
+	}
+
+	TEST_END();
+}
+
+static void test_file_hash_many(void)
+{
+	TEST_BEGIN("naui_file_hash_many");
+
+	{
+		enum { HASH_FILES = 24 };
+		Naui_Path* paths = (Naui_Path*)malloc(sizeof(Naui_Path) * HASH_FILES);
+		uint64_t hashes[HASH_FILES];
+		for (int i = 0; i < HASH_FILES; ++i)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "many_%02d.txt", i);
+			paths[i] = tp(name);
+			if (i != 7)
+				write_text(paths[i], name);
+		}
+
+		ASSERT(naui_file_hash_many(paths, HASH_FILES, hashes, NULL) == HASH_FILES - 1);
+
+		bool same = true;
+		for (int i = 0; i < HASH_FILES; ++i)
+		{
+			uint64_t expected = 0;
+			naui_file_hash(paths[i], &expected);
+			same = same && hashes[i] == expected;
+		}
+
+		ASSERT(same);
+		ASSERT(hashes[7] == 0);
+
+		Naui_FileHashCache cache;
+		ASSERT(naui_file_hash_cache_open(&cache, tp("many.cache")));
+		uint64_t cached[HASH_FILES];
+		ASSERT(naui_file_hash_many(paths, HASH_FILES, cached, &cache) == HASH_FILES - 1);
+		ASSERT(memcmp(cached, hashes, sizeof(hashes)) == 0);
+		ASSERT(naui_strmap_len(cache._entries) == HASH_FILES - 1);
+		ASSERT(naui_file_hash_many(paths, HASH_FILES, cached, &cache) == HASH_FILES - 1);
+		ASSERT(memcmp(cached, hashes, sizeof(hashes)) == 0);
+		ASSERT(naui_file_hash_cache_close(&cache));
+
+		ASSERT(naui_file_hash_many(paths, 0, hashes, NULL) == 0);
+		free(paths);
+	}
+
+	TEST_END();
+}
+
+void file_hash_test(void)
+{
+	Naui_Path root = temp_root();
+	naui_directory_create(root);
+
+	test_file_hash();
+	test_file_hash_cache();
+	test_file_hash_many();
+
+	naui_directory_remove_all(root);
+}
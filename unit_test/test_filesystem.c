@@ -2,6 +2,8 @@
 #include "test_func.h"
 #include "naui/base.h"
 #include "naui/filesystem/filesystem.h"
+#include "naui/filesystem/listing.h"
+#include "naui/filesystem/buffered.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -15,8 +17,7 @@
 
 static Naui_Path TEST_ROOT;
 
-/* Thin, non-allocating wrap of a C string - callers own the string's
- * lifetime, same contract as naui_path_from_cstr. */
+/* Copies a C string into a Naui_Path, same as naui_path_from_cstr. */
 static Naui_Path make_path(const char* s)
 {
     return naui_path_from_cstr(s);
@@ -27,21 +28,17 @@ static void init_test_root(void)
     Naui_Path cwd = naui_directory_get(NAUI_DIR_WORKING);
     Naui_Path naui_test = NAUI_PATH("naui_test");
     Naui_Path joined = naui_path_join(cwd, naui_test);
-    NAUI_PATH_FREE(cwd, naui_test);
 
     TEST_ROOT = naui_path_normalize(joined);
-    NAUI_PATH_FREE(joined);
 
     naui_directory_create(TEST_ROOT);
 }
 
-/* Builds a path under TEST_ROOT. Always an owned allocation - the
- * caller must naui_path_free() the result. */
+/* Builds a normalized path under TEST_ROOT. */
 static Naui_Path tp(const char* sub)
 {
     Naui_Path joined = naui_path_join(TEST_ROOT, make_path(sub));
     Naui_Path result = naui_path_normalize(joined);
-    NAUI_PATH_FREE(joined);
     return result;
 }
 
@@ -62,23 +59,19 @@ static void test_file_open(void)
         ASSERT(naui_file_is_valid(&h));
         naui_file_close(&h);
         ASSERT(!naui_file_is_valid(&h));
-        NAUI_PATH_FREE(open_test);
 
         /* Nonexistent file opened for reading must fail */
         Naui_Path not_exists = tp("does_not_exist.txt");
         ASSERT(!naui_file_open(&h, not_exists, NAUI_FILE_READ));
         ASSERT(!naui_file_is_valid(&h));
-        NAUI_PATH_FREE(not_exists);
 
         /* NULL handle */
         Naui_Path txt_file = tp("x.txt");
         ASSERT(!naui_file_open(NULL, txt_file, NAUI_FILE_WRITE));
-        NAUI_PATH_FREE(txt_file);
 
         /* Empty path */
         Naui_Path empty = NAUI_PATH("");
         ASSERT(!naui_file_open(&h, empty, NAUI_FILE_WRITE));
-        NAUI_PATH_FREE(empty);
     }
 
     TEST_END();
@@ -106,7 +99,6 @@ static void test_file_write_read(void)
 
         ASSERT(got == plen);
         ASSERT_STR_EQ(buf, payload);
-        NAUI_PATH_FREE(rw_test);
 
         /* Invalid handle returns 0 */
         Naui_FileHandle bad = NAUI_FILE_HANDLE_INIT;
@@ -135,8 +127,6 @@ static void test_file_append(void)
         ASSERT_NOT_NULL(all);
         ASSERT_STR_EQ(all, "Line1\nLine2\n");
         free(all); /* raw malloc'd buffer, not a Naui_Path - plain free() */
-
-        NAUI_PATH_FREE(append_test);
     }
 
     TEST_END();
@@ -155,8 +145,6 @@ static void test_file_size(void)
         ASSERT(naui_file_size(size_test) == 5);
         ASSERT(naui_file_size(no_file) == 0);
         ASSERT(naui_file_size(empty) == 0);
-
-        NAUI_PATH_FREE(size_test, no_file, empty);
     }
 
     TEST_END();
@@ -188,8 +176,6 @@ static void test_file_read_all(void)
         Naui_Path empty = NAUI_PATH("");
         ASSERT_NULL(naui_file_read_all(ghost, &sz));
         ASSERT_NULL(naui_file_read_all(empty, &sz));
-
-        NAUI_PATH_FREE(read_all, ghost, empty);
     }
 
     TEST_END();
@@ -212,8 +198,62 @@ static void test_file_write_all(void)
         ASSERT_NOT_NULL(back);
         ASSERT_STR_EQ(back, data);
         free(back);
+    }
+
+    TEST_END();
+}
 
-        NAUI_PATH_FREE(write_all, empty);
+static void test_file_map(void)
+{
+    TEST_BEGIN("naui_file_map / naui_file_unmap");
+
+    {
+        /* Small files come back as a heap copy. */
+        Naui_Path small = tp("map_small.txt");
+        write_text(small, "mapped");
+
+        Naui_FileMap map;
+        ASSERT(naui_file_map(&map, small, NAUI_FILE_MAP_NONE));
+        ASSERT(!map.is_mapped);
+        ASSERT(map.size == 6 && memcmp(map.data, "mapped", 6) == 0);
+        ASSERT(map.data[map.size] == '\0');
+        naui_file_unmap(&map);
+        ASSERT_NULL(map.data);
+
+        /* Past the threshold the file is mapped, still followed by a '\0'. */
+        Naui_Path big = tp("map_big.bin");
+        size_t big_len = NAUI_FILE_MAP_MIN_SIZE * 2 + 123;
+        char* data = (char*)malloc(big_len);
+        for (size_t i = 0; i < big_len; ++i)
+        {
+            data[i] = (char)('a' + i % 26);
+        }
+
+        ASSERT(naui_file_write_all(big, data, big_len));
+        ASSERT(naui_file_map(&map, big, NAUI_FILE_MAP_SEQUENTIAL | NAUI_FILE_MAP_WILLNEED));
+        ASSERT(map.is_mapped);
+        ASSERT(map.size == big_len && memcmp(map.data, data, big_len) == 0);
+        ASSERT(map.data[map.size] == '\0');
+        naui_file_unmap(&map);
+
+        /* A whole number of pages has no spare byte after it, so it is read. */
+        Naui_Path pages = tp("map_pages.bin");
+        ASSERT(naui_file_write_all(pages, data, NAUI_FILE_MAP_MIN_SIZE * 2));
+        ASSERT(naui_file_map(&map, pages, NAUI_FILE_MAP_NONE));
+        ASSERT(!map.is_mapped && map.size == NAUI_FILE_MAP_MIN_SIZE * 2);
+        ASSERT(map.data[map.size] == '\0');
+        naui_file_unmap(&map);
+        free(data);
+
+        Naui_Path empty_file = tp("map_empty.bin");
+        ASSERT(naui_file_write_all(empty_file, "", 0));
+        ASSERT(naui_file_map(&map, empty_file, NAUI_FILE_MAP_NONE));
+        ASSERT(map.size == 0 && map.data && map.data[0] == '\0');
+        naui_file_unmap(&map);
+
+        Naui_Path ghost = tp("map_ghost.bin");
+        ASSERT(!naui_file_map(&map, ghost, NAUI_FILE_MAP_NONE));
+        ASSERT_NULL(map.data);
     }
 
     TEST_END();
@@ -246,8 +286,248 @@ static void test_file_seek(void)
 
         ASSERT(!naui_file_seek(&h, 0, SEEK_SET));
         ASSERT(!naui_file_seek(NULL, 0, SEEK_SET));
+    }
+
+    TEST_END();
+}
+
+static void test_file_positional_vectored(void)
+{
+    TEST_BEGIN("naui_file_read_at / write_at / readv / writev");
+
+    {
+        Naui_Path vec_test = tp("vec_test.bin");
+
+        Naui_FileHandle h = NAUI_FILE_HANDLE_INIT;
+        ASSERT(naui_file_open(&h, vec_test, NAUI_FILE_WRITE));
+
+        char head[] = "ABC";
+        char empty[1];
+        char tail[] = "DEFGH";
+        Naui_FileVec out[3] = { { head, 3 }, { empty, 0 }, { tail, 5 } };
+        ASSERT(naui_file_writev(&h, out, 3) == 8);
+
+        /* Positional writes leave the position where it was. */
+        ASSERT(naui_file_write_at(&h, "xy", 2, 1) == 2);
+        ASSERT(naui_file_write(&h, "IJ", 2) == 2);
+        naui_file_close(&h);
+
+        ASSERT(naui_file_open(&h, vec_test, NAUI_FILE_READ));
+        char buf[8] = {0};
+        ASSERT(naui_file_read_at(&h, buf, 4, 6) == 4);
+        ASSERT(memcmp(buf, "GHIJ", 4) == 0);
+        ASSERT(naui_file_read_at(&h, buf, 4, 8) == 2);
+
+        char a[2], b[4], c[8];
+        Naui_FileVec in[3] = { { a, 2 }, { b, 4 }, { c, 8 } };
+        ASSERT(naui_file_readv(&h, in, 3) == 10);
+        ASSERT(memcmp(a, "Ax", 2) == 0);
+        ASSERT(memcmp(b, "yDEF", 4) == 0);
+        ASSERT(memcmp(c, "GHIJ", 4) == 0);
+        ASSERT(naui_file_readv(&h, in, 3) == 0);
+        naui_file_close(&h);
+
+        ASSERT(naui_file_read_at(&h, buf, 4, 0) == 0);
+        ASSERT(naui_file_writev(&h, out, 3) == 0);
+
+        /* A read-write handle truncates like a writer and reads back what it wrote, without a second open. */
+        ASSERT(naui_file_open(&h, vec_test, NAUI_FILE_READ_WRITE));
+        ASSERT(naui_file_size(vec_test) == 0);
+        ASSERT(naui_file_write(&h, "KLMN", 4) == 4);
+        ASSERT(naui_file_read_at(&h, buf, 2, 1) == 2);
+        ASSERT(memcmp(buf, "LM", 2) == 0);
+        ASSERT(naui_file_write(&h, "O", 1) == 1);
+        naui_file_close(&h);
+        ASSERT(naui_file_size(vec_test) == 5);
+    }
+
+    TEST_END();
+}
+
+static void test_file_buffered(void)
+{
+    TEST_BEGIN("Naui_FileReader / Naui_FileWriter");
+
+    {
+        Naui_Path buf_test = tp("buffered_test.bin");
+
+        /* Records smaller than the buffer, one that spills past it and one larger than it. */
+        enum { RECORDS = 1000 };
+        uint8_t big[100];
+        for (size_t i = 0; i < sizeof(big); i++)
+        {
+            big[i] = (uint8_t)(i * 7);
+        }
+
+        Naui_FileHandle h = NAUI_FILE_HANDLE_INIT;
+        ASSERT(naui_file_open(&h, buf_test, NAUI_FILE_WRITE));
+
+        uint8_t storage[64];
+        Naui_FileWriter w;
+        ASSERT(naui_file_writer_init(&w, &h, storage, sizeof(storage)));
+        for (uint32_t i = 0; i < RECORDS; i++)
+        {
+            naui_file_writer_write(&w, &i, sizeof(i));
+        }
+
+        ASSERT(naui_file_writer_write(&w, big, 40));
+        ASSERT(naui_file_writer_write(&w, big, sizeof(big)));
+        ASSERT(naui_file_writer_finish(&w));
+        naui_file_close(&h);
+
+        ASSERT(naui_file_size(buf_test) == RECORDS * sizeof(uint32_t) + 40 + sizeof(big));
+
+        ASSERT(naui_file_open(&h, buf_test, NAUI_FILE_READ));
+        Naui_FileReader r;
+        ASSERT(naui_file_reader_init(&r, &h, NULL, 64));
+
+        bool in_order = true;
+        for (uint32_t i = 0; i < RECORDS / 2; i++)
+        {
+            uint32_t value = 0;
+            in_order = in_order && naui_file_reader_read(&r, &value, sizeof(value)) == sizeof(value) && value == i;
+        }
+
+        for (uint32_t i = RECORDS / 2; i < RECORDS; i++)
+        {
+            const uint32_t* value = (const uint32_t*)naui_file_reader_next(&r, sizeof(uint32_t));
+            in_order = in_order && value && *value == i;
+        }
+
+        ASSERT(in_order);
+
+        uint8_t back[sizeof(big)];
+        ASSERT(naui_file_reader_read(&r, back, 40) == 40);
+        ASSERT(memcmp(back, big, 40) == 0);
+        ASSERT(naui_file_reader_next(&r, 65) == NULL);
+        ASSERT(naui_file_reader_read(&r, back, sizeof(back)) == sizeof(big));
+        ASSERT(memcmp(back, big, sizeof(big)) == 0);
+        ASSERT(naui_file_reader_read(&r, back, 1) == 0);
+        ASSERT(naui_file_reader_next(&r, 1) == NULL);
+        naui_file_reader_free(&r);
+        naui_file_close(&h);
+
+        ASSERT(!naui_file_reader_init(&r, &h, NULL, 0));
+        ASSERT(!naui_file_writer_init(&w, &h, NULL, 0));
+        ASSERT(!naui_file_writer_write(&w, big, 1));
+        ASSERT(!naui_file_writer_finish(&w));
+    }
+
+    TEST_END();
+}
+
+static void test_file_copy(void)
+{
+    TEST_BEGIN("naui_file_copy");
+
+    {
+        Naui_Path src = tp("copy_src.bin");
+        Naui_Path dst = tp("copy_dst.bin");
+
+        /* Large enough that the in-kernel copy takes several chunks on filesystems without reflinks. */
+        size_t size = 300 * 1024 + 17;
+        char* data = (char*)malloc(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            data[i] = (char)(i * 31 + (i >> 9));
+        }
+
+        ASSERT(naui_file_write_all(src, data, size));
+        write_text(dst, "old contents that are longer than nothing");
+        ASSERT(naui_file_copy(src, dst));
+
+        size_t got_size = 0;
+        char* got = naui_file_read_all(dst, &got_size);
+        ASSERT(got && got_size == size && memcmp(got, data, size) == 0);
+        ASSERT(naui_file_modified_time(dst) == naui_file_modified_time(src));
+        free(got);
+
+        /* Copying onto itself must not truncate the source. */
+        ASSERT(!naui_file_copy(src, src));
+        ASSERT(naui_file_size(src) == size);
+
+        Naui_Path empty = tp("copy_empty.bin");
+        Naui_Path empty_copy = tp("copy_empty_copy.bin");
+        write_text(empty, "");
+        ASSERT(naui_file_copy(empty, empty_copy));
+        ASSERT(naui_path_exists(empty_copy));
+        ASSERT(naui_file_size(empty_copy) == 0);
+
+        ASSERT(!naui_file_copy(tp("copy_missing.bin"), tp("copy_missing_out.bin")));
+        ASSERT(!naui_path_exists(tp("copy_missing_out.bin")));
+        ASSERT(!naui_file_copy(TEST_ROOT, tp("copy_dir_out.bin")));
+
+        free(data);
+        naui_file_delete(src);
+        naui_file_delete(dst);
+        naui_file_delete(empty);
+        naui_file_delete(empty_copy);
+    }
+
+    TEST_END();
+}
+
+static void test_directory_copy(void)
+{
+    TEST_BEGIN("naui_directory_copy");
+
+    {
+        Naui_Path src = tp("tree_src");
+        Naui_Path dst = tp("tree_dst");
+        naui_directory_create(src);
+        naui_directory_create(tp("tree_src" SEP "empty"));
+        naui_directory_create(tp("tree_src" SEP "sub"));
+        naui_directory_create(tp("tree_src" SEP "sub" SEP "deep"));
+        write_text(tp("tree_src" SEP "a.txt"), "A");
+        write_text(tp("tree_src" SEP "sub" SEP "b.txt"), "BB");
+        for (int i = 0; i < 20; i++)
+        {
+            char name[64];
+            snprintf(name, sizeof(name), "tree_src" SEP "sub" SEP "deep" SEP "f%02d.txt", i);
+            write_text(tp(name), name);
+        }
+
+        /* An existing destination keeps files the source does not have. */
+        naui_directory_create(dst);
+        write_text(tp("tree_dst" SEP "keep.txt"), "keep");
+        write_text(tp("tree_dst" SEP "a.txt"), "stale");
 
-        NAUI_PATH_FREE(seek_test);
+        ASSERT(naui_directory_copy(src, dst));
+        ASSERT(naui_path_is_directory(tp("tree_dst" SEP "empty")));
+        ASSERT(naui_path_exists(tp("tree_dst" SEP "keep.txt")));
+
+        Naui_List(Naui_DirEntry) from = naui_directory_walk(src, NULL, NULL, 0, NAUI_WALK_SIZES);
+        Naui_List(Naui_DirEntry) to = naui_directory_walk(dst, NULL, NULL, 0, NAUI_WALK_SIZES);
+        ASSERT(naui_list_len(to) == naui_list_len(from) + 1);
+
+        size_t root_len = strlen(src.data);
+        bool same = true;
+        for (int32_t i = 0; i < naui_list_len(from); i++)
+        {
+            if (from[i].is_directory)
+                continue;
+
+            char copied[NAUI_PATH_MAX];
+            snprintf(copied, sizeof(copied), "%s%s", dst.data, from[i].path.data + root_len);
+            size_t a_size = 0, b_size = 0;
+            char* a = naui_file_read_all(from[i].path, &a_size);
+            char* b = naui_file_read_all(make_path(copied), &b_size);
+            same = same && a && b && a_size == b_size && memcmp(a, b, a_size) == 0;
+            free(a);
+            free(b);
+        }
+
+        ASSERT(same);
+        naui_directory_filter_free(from);
+        naui_directory_filter_free(to);
+
+        ASSERT(!naui_directory_copy(src, tp("tree_src" SEP "sub" SEP "inside")));
+        ASSERT(!naui_path_exists(tp("tree_src" SEP "sub" SEP "inside")));
+        ASSERT(!naui_directory_copy(src, src));
+        ASSERT(!naui_directory_copy(tp("tree_missing"), tp("tree_missing_out")));
+
+        naui_directory_remove_all(src);
+        naui_directory_remove_all(dst);
     }
 
     TEST_END();
@@ -260,7 +540,6 @@ static void test_file_delete_rename(void)
     {
         Naui_Path not_test = NAUI_PATH("Test.txt");
         ASSERT(!naui_path_exists(not_test));
-        NAUI_PATH_FREE(not_test);
 
         Naui_Path delete_me = tp("del_me.txt");
         write_text(delete_me, "bye");
@@ -268,7 +547,6 @@ static void test_file_delete_rename(void)
         ASSERT(naui_file_delete(delete_me));
         ASSERT(!naui_path_exists(delete_me));
         ASSERT(!naui_file_delete(delete_me));
-        NAUI_PATH_FREE(delete_me);
 
         Naui_Path rename_src = tp("rename_src.txt");
         Naui_Path rename_dst = tp("rename_dst.txt");
@@ -277,14 +555,12 @@ static void test_file_delete_rename(void)
         ASSERT(!naui_path_exists(rename_src));
         ASSERT(naui_path_exists(rename_dst));
         naui_file_delete(rename_dst);
-        NAUI_PATH_FREE(rename_src, rename_dst);
 
         Naui_Path x_files = tp("x.txt");
         Naui_Path empty = NAUI_PATH("");
         ASSERT(!naui_file_delete(empty));
         ASSERT(!naui_file_rename(empty, x_files));
         ASSERT(!naui_file_rename(x_files, empty));
-        NAUI_PATH_FREE(x_files, empty);
     }
 
     TEST_END();
@@ -295,22 +571,20 @@ static void test_file_filename(void)
     TEST_BEGIN("naui_file_filename");
 
     {
-        /* naui_file_filename returns a VIEW into its input - it must be
-         * read before the input is freed, and must never be freed itself. */
+        /* naui_file_filename points into the path it was given, valid as long as that path is. */
         Naui_Path p1 = tp("foo/bar/baz.txt");
-        Naui_StringView f1 = naui_file_filename(p1);
-        ASSERT_STR_EQ(f1.data, "baz.txt");
-        NAUI_PATH_FREE(p1);
+        const char* f1 = naui_file_filename(&p1);
+        ASSERT_STR_EQ(f1, "baz.txt");
+        ASSERT(f1 > p1.data && f1 < p1.data + NAUI_PATH_MAX);
 
         Naui_Path p2 = tp("baz.txt");
-        Naui_StringView f2 = naui_file_filename(p2);
-        ASSERT_STR_EQ(f2.data, "baz.txt");
-        NAUI_PATH_FREE(p2);
-
-        Naui_Path p3 = NAUI_PATH("");
-        Naui_StringView f3 = naui_file_filename(p3);
-        ASSERT(f3.len == 0);
-        NAUI_PATH_FREE(p3);
+        ASSERT_STR_EQ(naui_file_filename(&p2), "baz.txt");
+
+        Naui_Path p3 = NAUI_PATH("plain.txt");
+        ASSERT(naui_file_filename(&p3) == p3.data);
+
+        Naui_Path p4 = NAUI_PATH("");
+        ASSERT_STR_EQ(naui_file_filename(&p4), "");
     }
 
     TEST_END();
@@ -321,30 +595,24 @@ static void test_file_stem(void)
     TEST_BEGIN("naui_file_stem");
 
     {
-        /* Unlike filename/extension, stem is a PREFIX of the filename,
-         * so it can't safely be a view (the byte after it is '.', not
-         * a null terminator) - it's always an owned allocation. */
+        /* Stem and extension are copies, they outlive the path they came from. */
         Naui_Path file = tp("dir/file.txt");
-        Naui_StringView s1 = naui_file_stem(file);
-        ASSERT(naui_sv_cmp(s1, NAUI_STR("file"), true));
-        NAUI_PATH_FREE(file);
+        Naui_Path s1 = naui_file_stem(file);
+        ASSERT_STR_EQ(s1.data, "file");
 
         Naui_Path archive = tp("dir/archive.tar.gz");
-        Naui_StringView s2 = naui_file_stem(archive);
-        ASSERT(naui_sv_cmp(s2, NAUI_STR("archive.tar"), true));
-        NAUI_PATH_FREE(archive);
+        Naui_Path s2 = naui_file_stem(archive);
+        ASSERT_STR_EQ(s2.data, "archive.tar");
 
         /* No extension - full filename is the stem */
         Naui_Path noext = tp("dir/noext");
-        Naui_StringView s3 = naui_file_stem(noext);
+        Naui_Path s3 = naui_file_stem(noext);
         ASSERT_STR_EQ(s3.data, "noext");
-        NAUI_PATH_FREE(noext);
 
         /* Dotfile - the whole name is the stem */
         Naui_Path hidden = tp("dir/.hidden");
-        Naui_StringView s4 = naui_file_stem(hidden);
+        Naui_Path s4 = naui_file_stem(hidden);
         ASSERT_STR_EQ(s4.data, ".hidden");
-        NAUI_PATH_FREE(hidden);
     }
 
     TEST_END();
@@ -355,29 +623,23 @@ static void test_file_extension(void)
     TEST_BEGIN("naui_file_extension");
 
     {
-        /* extension IS a suffix, so (unlike stem) it's a view - use it
-         * before freeing the path it came from. */
         Naui_Path file = tp("file.txt");
-        Naui_StringView e1 = naui_file_extension(file);
+        Naui_Path e1 = naui_file_extension(file);
         ASSERT_STR_EQ(e1.data, ".txt");
-        NAUI_PATH_FREE(file);
 
         Naui_Path archive = tp("archive.tar.gz");
-        Naui_StringView e2 = naui_file_extension(archive);
+        Naui_Path e2 = naui_file_extension(archive);
         ASSERT_STR_EQ(e2.data, ".gz");
-        NAUI_PATH_FREE(archive);
 
         /* No extension - empty result */
         Naui_Path noext = tp("noext");
-        Naui_StringView e3 = naui_file_extension(noext);
-        ASSERT(e3.len == 0);
-        NAUI_PATH_FREE(noext);
+        Naui_Path e3 = naui_file_extension(noext);
+        ASSERT(naui_path_is_empty(e3));
 
         /* Dotfile has no extension */
         Naui_Path hidden = tp(".hidden");
-        Naui_StringView e4 = naui_file_extension(hidden);
-        ASSERT(e4.len == 0);
-        NAUI_PATH_FREE(hidden);
+        Naui_Path e4 = naui_file_extension(hidden);
+        ASSERT(naui_path_is_empty(e4));
     }
 
     TEST_END();
@@ -393,13 +655,8 @@ static void test_file_hide_is_hidden(void)
 
         ASSERT(!naui_file_is_hidden(original));
 
-        /* naui_file_hide's contract: it may hand back the exact same
-         * path unchanged (a view aliasing the input - e.g. Windows,
-         * which only flips an attribute) or a freshly renamed, owned
-         * path (e.g. POSIX, which adds/strips a leading dot). Which
-         * one you get isn't tracked at runtime, so we tell them apart
-         * by pointer identity before freeing, which is correct on
-         * both platforms without needing an #ifdef here. */
+        /* naui_file_hide hands back the path the file now has: the same one on Windows,
+         * which only flips an attribute, a renamed one on POSIX, which adds or strips a leading dot. */
         Naui_Path hidden = naui_file_hide(original, true);
         ASSERT(naui_file_is_hidden(hidden));
         ASSERT(naui_path_exists(hidden));
@@ -410,18 +667,11 @@ static void test_file_hide_is_hidden(void)
 
         naui_file_delete(unhidden);
 
-        if (unhidden.data != hidden.data)
-            NAUI_PATH_FREE(unhidden);
-        if (hidden.data != original.data)
-            NAUI_PATH_FREE(hidden);
-        NAUI_PATH_FREE(original);
-
         /* Empty path: hide is a no-op and always returns empty */
         Naui_Path empty = NAUI_PATH("");
         Naui_Path result = naui_file_hide(empty, true);
         ASSERT(naui_path_is_empty(result));
         ASSERT(!naui_file_is_hidden(empty));
-        NAUI_PATH_FREE(empty, result);
     }
 
     TEST_END();
@@ -442,7 +692,6 @@ static void test_path_exists(void)
         ASSERT(!naui_path_exists(empty));
 
         naui_file_delete(exists);
-        NAUI_PATH_FREE(exists, ghost, empty);
     }
 
     TEST_END();
@@ -458,24 +707,20 @@ static void test_path_parent(void)
 
         Naui_Path foo = tp("foo/bar");
         ASSERT_STR_EQ(p1.data, foo.data);
-        NAUI_PATH_FREE(baz, p1, foo);
 
         Naui_Path root = NAUI_PATH("/foo");
         Naui_Path p2 = naui_path_parent(root);
         ASSERT_STR_EQ(p2.data, "/");
-        NAUI_PATH_FREE(root, p2);
 
         Naui_Path bare = NAUI_PATH("only_filename");
         Naui_Path p3 = naui_path_parent(bare);
         ASSERT_STR_EQ(p3.data, ".");
-        NAUI_PATH_FREE(bare, p3);
 
         /* Parent of an empty path is "." - same as a bare filename
          * with no separators, not an empty result. */
         Naui_Path empty = NAUI_PATH("");
         Naui_Path p4 = naui_path_parent(empty);
         ASSERT_STR_EQ(p4.data, ".");
-        NAUI_PATH_FREE(empty, p4);
     }
 
     TEST_END();
@@ -491,28 +736,20 @@ static void test_path_join(void)
 
         Naui_Path joined = naui_path_join(base, rel);
         ASSERT_STR_EQ(joined.data, "/foo/bar" SEP "baz.txt");
-        NAUI_PATH_FREE(joined);
 
-        /* naui_path_join always allocates fresh, even in these
-         * "trivial" cases - never a passthrough view - so every result
-         * here is safe to free independently. */
+        /* An absolute second part is still appended, not returned as is. */
         Naui_Path abs_b = NAUI_PATH("/absolute/path");
         Naui_Path joined_abs = naui_path_join(base, abs_b);
         ASSERT_STR_EQ(joined_abs.data, "/foo/bar" SEP "absolute/path");
-        NAUI_PATH_FREE(abs_b, joined_abs);
 
         /* Empty a returns (a copy of) b */
         Naui_Path empty = NAUI_PATH("");
         Naui_Path from_empty = naui_path_join(empty, rel);
         ASSERT_STR_EQ(from_empty.data, rel.data);
-        NAUI_PATH_FREE(from_empty);
 
         Naui_Path abs = NAUI_PATH("/foo/bar");
         Naui_Path abs_joined = naui_path_join(empty, abs);
         ASSERT_STR_EQ(abs_joined.data, abs.data);
-        NAUI_PATH_FREE(abs_joined);
-
-        NAUI_PATH_FREE(base, rel, empty, abs);
     }
 
     TEST_END();
@@ -527,28 +764,24 @@ static void test_path_variadic_join(void)
 		 * except NAUI_PATH always allocates. */
 		Naui_Path p = NAUI_PATH("file.txt");
 		ASSERT_STR_EQ(p.data, "file.txt");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
 		/* Two plain parts. */
 		Naui_Path p = NAUI_PATH("Language", "/en-US.lang");
 		ASSERT_STR_EQ(p.data, "Language" SEP "en-US.lang");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
 		/* Three parts, the classic motivating example. */
 		Naui_Path p = NAUI_PATH("Some/", "Folder", "file.txt");
 		ASSERT_STR_EQ(p.data, "Some" SEP "Folder" SEP "file.txt");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
 		/* Trailing separator on an earlier part doesn't double up. */
 		Naui_Path p = NAUI_PATH("a" SEP, "b");
 		ASSERT_STR_EQ(p.data, "a" SEP "b");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
@@ -557,21 +790,18 @@ static void test_path_variadic_join(void)
 		 * since NAUI_PATH(...) shares the same join logic. */
 		Naui_Path p = NAUI_PATH("a", SEP "b", SEP "c");
 		ASSERT_STR_EQ(p.data, "a" SEP "b" SEP "c");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
 		/* Separators on both sides of a seam collapse to exactly one. */
 		Naui_Path p = NAUI_PATH("a" SEP, SEP "b");
 		ASSERT_STR_EQ(p.data, "a" SEP "b");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
 		/* Empty string parts are skipped, no double separators. */
 		Naui_Path p = NAUI_PATH("a", "", "b");
 		ASSERT_STR_EQ(p.data, "a" SEP "b");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
@@ -579,14 +809,12 @@ static void test_path_variadic_join(void)
 		 * what makes an absolute path absolute. */
 		Naui_Path p = NAUI_PATH(SEP "root", "child");
 		ASSERT_STR_EQ(p.data, SEP "root" SEP "child");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
 		/* Many parts, mixed separator placement at each seam. */
 		Naui_Path p = NAUI_PATH("one", "two" SEP, SEP "three", "four" SEP);
 		ASSERT_STR_EQ(p.data, "one" SEP "two" SEP "three" SEP "four");
-		NAUI_PATH_FREE(p);
 	}
 
 	{
@@ -599,7 +827,6 @@ static void test_path_variadic_join(void)
 
 		Naui_Path lang_file = NAUI_PATH(bin_dir.data, "Language", filename);
 		ASSERT_STR_EQ(lang_file.data, "usr" SEP "local" SEP "MyApp" SEP "Language" SEP "en-US.lang");
-		NAUI_PATH_FREE(bin_dir, lang_file);
 	}
 
 	TEST_END();
@@ -617,17 +844,14 @@ static void test_path_normalize(void)
 #else
         ASSERT_STR_EQ(n1.data, "/foo/baz/qux");
 #endif
-        NAUI_PATH_FREE(p1, n1);
 
         Naui_Path p2 = NAUI_PATH(".");
         Naui_Path n2 = naui_path_normalize(p2);
         ASSERT_STR_EQ(n2.data, ".");
-        NAUI_PATH_FREE(p2, n2);
 
         Naui_Path p3 = NAUI_PATH("a/b/../../c");
         Naui_Path n3 = naui_path_normalize(p3);
         ASSERT_STR_EQ(n3.data, "c");
-        NAUI_PATH_FREE(p3, n3);
     }
 
     TEST_END();
@@ -638,22 +862,17 @@ static void test_path_absolute(void)
     TEST_BEGIN("naui_path_absolute");
 
     {
-        /* An already-absolute path is returned as a view aliasing the
-         * input - only the input needs freeing. */
+        /* An already-absolute path comes back unchanged. */
         Naui_Path abs_in = NAUI_PATH("/already/absolute");
         Naui_Path abs_out = naui_path_absolute(abs_in);
         ASSERT_STR_EQ(abs_out.data, "/already/absolute");
-        NAUI_PATH_FREE(abs_in);
 
-        /* A relative path gets the cwd prepended - owned, since it's
-         * genuinely new data. */
+        /* A relative path gets the cwd prepended. */
         Naui_Path rel = NAUI_PATH("relative_file.txt");
         Naui_Path made_abs = naui_path_absolute(rel);
 
         Naui_Path cwd = naui_directory_get(NAUI_DIR_WORKING);
         ASSERT(strncmp(made_abs.data, cwd.data, strlen(cwd.data)) == 0);
-
-        NAUI_PATH_FREE(rel, made_abs, cwd);
     }
 
     TEST_END();
@@ -666,17 +885,14 @@ static void test_path_canonical(void)
     {
         Naui_Path canon = naui_path_canonical(TEST_ROOT);
         ASSERT(!naui_path_is_empty(canon));
-        NAUI_PATH_FREE(canon);
 
         Naui_Path missing = tp("does_not_exist_for_canonical");
         Naui_Path bad = naui_path_canonical(missing);
         ASSERT(naui_path_is_empty(bad));
-        NAUI_PATH_FREE(missing, bad);
 
         Naui_Path empty_in = NAUI_PATH("");
         Naui_Path empty_out = naui_path_canonical(empty_in);
         ASSERT(naui_path_is_empty(empty_out));
-        NAUI_PATH_FREE(empty_in, empty_out);
     }
 
     TEST_END();
@@ -690,7 +906,6 @@ static void test_path_weakly_canonical(void)
         /* Fully existing path behaves like canonical */
         Naui_Path wc1 = naui_path_weakly_canonical(TEST_ROOT);
         ASSERT(!naui_path_is_empty(wc1));
-        NAUI_PATH_FREE(wc1);
 
         /* Partially existing: existing prefix is canonicalized,
          * non-existing tail is normalized and appended. */
@@ -698,7 +913,6 @@ static void test_path_weakly_canonical(void)
         Naui_Path wc2 = naui_path_weakly_canonical(check_dir);
         ASSERT(!naui_path_is_empty(wc2));
         ASSERT(strstr(wc2.data, "nonexistent_dir") != NULL);
-        NAUI_PATH_FREE(check_dir, wc2);
     }
 
     TEST_END();
@@ -715,12 +929,10 @@ static void test_directory_create_remove(void)
         ASSERT(naui_directory_create(mkdir_path)); /* EEXIST is OK */
         ASSERT(naui_directory_remove(mkdir_path));
         ASSERT(!naui_path_exists(mkdir_path));
-        NAUI_PATH_FREE(mkdir_path);
 
         Naui_Path empty = NAUI_PATH("");
         ASSERT(!naui_directory_create(empty));
         ASSERT(!naui_directory_remove(empty));
-        NAUI_PATH_FREE(empty);
     }
 
     TEST_END();
@@ -746,8 +958,6 @@ static void test_directory_remove_all(void)
 
         Naui_Path empty = NAUI_PATH("");
         ASSERT(!naui_directory_remove_all(empty));
-
-        NAUI_PATH_FREE(rm, sub, leaf, empty);
     }
 
     TEST_END();
@@ -770,8 +980,6 @@ static void test_directory_rename(void)
         ASSERT(!naui_directory_rename(empty, dst));
         ASSERT(!naui_directory_rename(dst, empty));
         ASSERT(naui_directory_remove(dst));
-
-        NAUI_PATH_FREE(src, dst, empty);
     }
 
     TEST_END();
@@ -782,21 +990,17 @@ static void test_directory_get(void)
     TEST_BEGIN("naui_directory_get");
 
     {
-        /* WORKING is backed by a mutable cache, so it's always an
-         * owned copy - must be freed. */
+        /* WORKING follows naui_path_set_current, HOME and BIN are looked up once. */
         Naui_Path cwd = naui_directory_get(NAUI_DIR_WORKING);
         ASSERT(!naui_path_is_empty(cwd));
-        NAUI_PATH_FREE(cwd);
 
-        /* HOME/BIN are write-once caches returned as views into static
-         * storage - must NOT be freed. */
         Naui_Path home = naui_directory_get(NAUI_DIR_HOME);
         ASSERT(!naui_path_is_empty(home));
 
         Naui_Path bin = naui_directory_get(NAUI_DIR_BIN);
         ASSERT(!naui_path_is_empty(bin));
 
-        /* Invalid enum - naui_path_empty(), harmless either way */
+        /* Invalid enum - an empty path */
         Naui_Path bad = naui_directory_get((Naui_Dir)9999);
         ASSERT(naui_path_is_empty(bad));
     }
@@ -847,8 +1051,155 @@ static void test_directory_filter(void)
 
         naui_directory_filter_free(list); /* frees each entry's path, then the list */
         naui_directory_remove_all(root);
+    }
+
+    TEST_END();
+}
+
+static void test_directory_walk(void)
+{
+    TEST_BEGIN("naui_directory_walk");
+
+    {
+        Naui_Path root = tp("walk_root");
+        naui_directory_create(root);
+
+        /* Wide and a few levels deep, so helper jobs get directories to share. */
+        int files = 0;
+        for (int i = 0; i < 6; i++)
+        {
+            char sub[64];
+            snprintf(sub, sizeof(sub), "walk_root" SEP "d%d", i);
+            naui_directory_create(tp(sub));
+
+            for (int j = 0; j < 3; j++)
+            {
+                char deep[96];
+                snprintf(deep, sizeof(deep), "%s" SEP "e%d", sub, j);
+                naui_directory_create(tp(deep));
+
+                char file[128];
+                snprintf(file, sizeof(file), "%s" SEP "f%d.txt", deep, j);
+                write_text(tp(file), "walk");
+                snprintf(file, sizeof(file), "%s" SEP "skip.log", deep);
+                write_text(tp(file), "skip");
+                files++;
+            }
+        }
+
+        const char* exts[] = { ".txt" };
+        Naui_List(Naui_DirEntry) sized = naui_directory_walk(root, NULL, exts, 1, NAUI_WALK_SIZES);
+        Naui_List(Naui_DirEntry) plain = naui_directory_walk(root, NULL, exts, 1, NAUI_WALK_DEFAULT);
+        Naui_List(Naui_DirEntry) legacy = naui_directory_filter_recursive(root, NULL, exts, 1);
+
+        size_t count = (size_t)naui_list_len(sized);
+        ASSERT(count == (size_t)(6 + 6 * 3 + files));
+        ASSERT((size_t)naui_list_len(plain) == count);
+        ASSERT((size_t)naui_list_len(legacy) == count);
+
+        size_t root_len = strlen(root.data);
+        int seen_files = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            ASSERT(strcmp(sized[i].path.data, plain[i].path.data) == 0);
+            ASSERT(strcmp(sized[i].path.data, legacy[i].path.data) == 0);
+            ASSERT(sized[i].is_directory == plain[i].is_directory);
+            ASSERT(plain[i].size == 0);
+
+            if (!sized[i].is_directory)
+            {
+                ASSERT(sized[i].size == 4);
+                ASSERT(strstr(sized[i].path.data, ".txt") != NULL);
+                seen_files++;
+            }
+
+            /* Every entry comes after its parent directory. */
+            Naui_Path parent = naui_path_parent(sized[i].path);
+            if (strlen(parent.data) > root_len)
+            {
+                bool found = false;
+                for (size_t j = 0; j < i && !found; j++)
+                    found = sized[j].is_directory && strcmp(sized[j].path.data, parent.data) == 0;
+
+                ASSERT(found);
+            }
+        }
+
+        ASSERT(seen_files == files);
+
+        naui_directory_filter_free(sized);
+        naui_directory_filter_free(plain);
+        naui_directory_filter_free(legacy);
+
+        ASSERT(naui_directory_walk(tp("walk_missing"), NULL, NULL, 0, NAUI_WALK_SIZES) == NULL);
+
+        naui_directory_remove_all(root);
+    }
+
+    TEST_END();
+}
 
-        NAUI_PATH_FREE(root, a, b, c);
+static void test_directory_list(void)
+{
+    TEST_BEGIN("naui_directory_list");
+
+    {
+        Naui_Path root = tp("list_root");
+        naui_directory_create(root);
+        naui_directory_create(tp("list_root" SEP "sub"));
+        naui_directory_create(tp("list_root" SEP "sub" SEP "deep"));
+        write_text(tp("list_root" SEP "a.txt"), "A");
+        write_text(tp("list_root" SEP "sub" SEP "b.txt"), "BB");
+        write_text(tp("list_root" SEP "sub" SEP "deep" SEP "c.txt"), "CCC");
+        write_text(tp("list_root" SEP "sub" SEP "deep" SEP "d.log"), "D");
+
+        const char* exts[] = { ".txt" };
+        Naui_DirListing listing = NAUI_DIR_LISTING_INIT;
+        ASSERT(naui_directory_list(&listing, root, NULL, exts, 1, NAUI_WALK_SIZES));
+        ASSERT(naui_dir_listing_count(&listing) == 5);
+
+        /* Same entries, order and sizes as the full-path listing. */
+        Naui_List(Naui_DirEntry) walked = naui_directory_walk(root, NULL, exts, 1, NAUI_WALK_SIZES);
+        Naui_List(Naui_DirEntry) expanded = naui_dir_listing_entries(&listing);
+        ASSERT((size_t)naui_list_len(walked) == naui_dir_listing_count(&listing));
+        ASSERT((size_t)naui_list_len(expanded) == naui_dir_listing_count(&listing));
+
+        for (size_t i = 0; i < naui_dir_listing_count(&listing); i++)
+        {
+            Naui_Path path = naui_dir_listing_path(&listing, i);
+            ASSERT(strcmp(path.data, walked[i].path.data) == 0);
+            ASSERT(strcmp(expanded[i].path.data, walked[i].path.data) == 0);
+            ASSERT(listing.records[i].is_directory == walked[i].is_directory);
+            ASSERT(listing.records[i].size == (uint64_t)walked[i].size);
+            ASSERT(strcmp(naui_dir_listing_name(&listing, i), naui_file_filename(&path)) == 0);
+        }
+
+        char rel[64];
+        bool saw_deep = false;
+        for (size_t i = 0; i < naui_dir_listing_count(&listing); i++)
+        {
+            size_t len = naui_dir_listing_relative(&listing, i, rel, sizeof(rel));
+            if (strcmp(rel, "sub" SEP "deep" SEP "c.txt") == 0)
+            {
+                saw_deep = true;
+                ASSERT(len == strlen(rel));
+                ASSERT(listing.records[i].size == 3);
+            }
+        }
+
+        ASSERT(saw_deep);
+        ASSERT(naui_dir_listing_relative(&listing, naui_dir_listing_count(&listing) - 1, rel, 4) == 0);
+
+        naui_directory_filter_free(walked);
+        naui_directory_filter_free(expanded);
+        naui_dir_listing_free(&listing);
+        ASSERT(listing.records == NULL);
+
+        ASSERT(!naui_directory_list(&listing, tp("list_missing"), NULL, NULL, 0, NAUI_WALK_DEFAULT));
+        ASSERT(naui_dir_listing_count(&listing) == 0);
+        naui_dir_listing_free(&listing);
+
+        naui_directory_remove_all(root);
     }
 
     TEST_END();
@@ -876,8 +1227,6 @@ static void test_path_absolute_parent(void)
 
     ASSERT_STR_EQ(abs.data, expected);
 
-    NAUI_PATH_FREE(rel, abs, cwd);
-
     TEST_END();
 }
 
@@ -907,8 +1256,6 @@ static void test_path_lock(void)
         ASSERT(!naui_path_lock(empty));
         ASSERT(!naui_path_is_locked(empty));
         naui_path_unlock(empty);
-
-        NAUI_PATH_FREE(lockfile, empty);
     }
 
     TEST_END();
@@ -939,8 +1286,6 @@ static void test_path_lock_independent(void)
         /* Unlock B */
         naui_path_unlock(b);
         ASSERT(!naui_path_is_locked(b));
-
-        NAUI_PATH_FREE(a, b);
     }
 
     TEST_END();
@@ -960,10 +1305,8 @@ static void test_current_directory_all(void)
 
         Naui_Path cwd = naui_directory_get(NAUI_DIR_WORKING);
         ASSERT_STR_EQ(cwd.data, dir.data);
-        NAUI_PATH_FREE(cwd);
 
         ASSERT(naui_path_set_current(original));
-        NAUI_PATH_FREE(dir);
     }
 
     {
@@ -971,11 +1314,9 @@ static void test_current_directory_all(void)
 
         Naui_Path empty = NAUI_PATH("");
         ASSERT(!naui_path_set_current(empty));
-        NAUI_PATH_FREE(empty);
 
         Naui_Path after = naui_directory_get(NAUI_DIR_WORKING);
         ASSERT_STR_EQ(before.data, after.data);
-        NAUI_PATH_FREE(before, after);
     }
 
     {
@@ -983,11 +1324,9 @@ static void test_current_directory_all(void)
 
         Naui_Path bad = tp("this_directory_should_not_exist_12345");
         ASSERT(!naui_path_set_current(bad));
-        NAUI_PATH_FREE(bad);
 
         Naui_Path after = naui_directory_get(NAUI_DIR_WORKING);
         ASSERT_STR_EQ(before.data, after.data);
-        NAUI_PATH_FREE(before, after);
     }
 
     {
@@ -998,10 +1337,8 @@ static void test_current_directory_all(void)
 
         Naui_Path cwd = naui_directory_get(NAUI_DIR_WORKING);
         ASSERT_STR_EQ(cwd.data, dir.data);
-        NAUI_PATH_FREE(cwd);
 
         ASSERT(naui_path_set_current(original));
-        NAUI_PATH_FREE(dir);
     }
 
     {
@@ -1015,14 +1352,10 @@ static void test_current_directory_all(void)
 
         Naui_Path now = naui_directory_get(NAUI_DIR_WORKING);
         ASSERT_STR_EQ(now.data, parent.data);
-        NAUI_PATH_FREE(now);
 
         ASSERT(naui_path_set_current(original));
-        NAUI_PATH_FREE(cwd, parent);
     }
 
-    NAUI_PATH_FREE(original);
-
     TEST_END();
 }
 
@@ -1032,7 +1365,6 @@ static void test_cleanup(void)
 	ASSERT(naui_directory_remove_all(TEST_ROOT));
 	ASSERT(!naui_path_exists(TEST_ROOT));
 	ASSERT(!naui_directory_remove_all(TEST_ROOT));
-	NAUI_PATH_FREE(TEST_ROOT); /* release TEST_ROOT's own memory - separate from removing the directory from disk above */
 	TEST_END();
 }
 
@@ -1046,7 +1378,11 @@ void filesystem_test(void)
     test_file_size();
     test_file_read_all();
     test_file_write_all();
+    test_file_map();
     test_file_seek();
+    test_file_positional_vectored();
+    test_file_buffered();
+    test_file_copy();
     test_file_delete_rename();
     test_file_filename();
     test_file_stem();
@@ -1066,6 +1402,9 @@ void filesystem_test(void)
     test_directory_get();
     test_path_absolute_parent();
     test_directory_filter();
+    test_directory_walk();
+    test_directory_list();
+    test_directory_copy();
     test_path_lock();
     test_path_lock_independent();
     test_current_directory_all();
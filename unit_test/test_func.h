@@ -2,6 +2,11 @@
 
 	void filesystem_test();
 	void archive_test();
+	void vfs_test();
+	void async_io_test();
+	void watch_test();
+	void file_hash_test();
+	void file_filter_test();
 	void math_test();
 	void string_test();
 	void iterator_test();
@@ -4,6 +4,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 void test_dir_iterator_basic()
 {
@@ -14,28 +15,25 @@ void test_dir_iterator_basic()
 	Naui_Path a_name = NAUI_PATH("a.txt");
 	Naui_Path a_path = naui_path_join(root, a_name);
 	naui_file_write_all(a_path, "x", 1);
-	NAUI_PATH_FREE(a_name, a_path);
 	
 	Naui_Path b_name = NAUI_PATH("b.txt");
 	Naui_Path b_path = naui_path_join(root, b_name);
 	naui_file_write_all(b_path, "x", 1);
-	NAUI_PATH_FREE(b_name, b_path);
 	
 	Naui_Path c_name = NAUI_PATH("c.bin");
 	Naui_Path c_path = naui_path_join(root, c_name);
 	naui_file_write_all(c_path, "x", 1);
-	NAUI_PATH_FREE(c_name, c_path);
 	
-	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 	bool saw_a = false;
 	bool saw_b = false;
 	bool saw_c = false;
 
 	while (naui_dir_iterator_valid(&it)) {
-		Naui_StringView name = naui_file_filename(it.entry.path);
-		if (naui_sv_cmp(name, NAUI_STR("a.txt"), true)) saw_a = true;
-		if (naui_sv_cmp(name, NAUI_STR("b.txt"), true)) saw_b = true;
-		if (naui_sv_cmp(name, NAUI_STR("c.bin"), true)) saw_c = true;
+		const char* name = it.name;
+		if (strcmp(name, "a.txt") == 0) saw_a = true;
+		if (strcmp(name, "b.txt") == 0) saw_b = true;
+		if (strcmp(name, "c.bin") == 0) saw_c = true;
 
 		naui_dir_iterator_next(&it);
 	}
@@ -47,7 +45,6 @@ void test_dir_iterator_basic()
 	ASSERT(saw_c);
 
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -66,24 +63,19 @@ void test_dir_iterator_filter()
 	naui_file_write_all(apple_path, "x", 1);
 	naui_file_write_all(banana_path, "x", 1);
 	naui_file_write_all(apricot_path, "x", 1);
-	NAUI_PATH_FREE(apple_name, apple_path, banana_name, banana_path, apricot_name, apricot_path);
 
-	/* NAUI_EXTENSIONS(...) - unlike NAUI_PATH(...) - just builds a
-	 * plain local array of string-literal pointers (no allocation),
-	 * matching how extensions arrays are used everywhere else in the
-	 * codebase (naui_directory_filter etc. take a raw const char**
-	 * with no ownership implications), so this is safe to use inline. */
-	Naui_DirIterator it = naui_dir_iterator_open(root, "apple", NAUI_EXTENSIONS(".txt"), false);
+	/* NAUI_EXTENSIONS builds a NULL-terminated compound literal, the iterator compiles it on open. */
+	Naui_DirIterator it = naui_dir_iterator_open(root, "apple", NAUI_EXTENSIONS(".txt"), false, NAUI_DIR_ITERATOR_DEFAULT);
 
 	bool saw_apple = false;
 	bool saw_apricot = false;
 	bool saw_banana = false;
 
 	while (naui_dir_iterator_valid(&it)) {
-		Naui_StringView name = naui_file_filename(it.entry.path);
-		if (naui_sv_cmp(name, NAUI_STR("apple.txt"), true)) saw_apple = true;
-		if (naui_sv_cmp(name, NAUI_STR("apricot.txt"), true)) saw_apricot = true;
-		if (naui_sv_cmp(name, NAUI_STR("banana.txt"), true)) saw_banana = true;
+		const char* name = it.name;
+		if (strcmp(name, "apple.txt") == 0) saw_apple = true;
+		if (strcmp(name, "apricot.txt") == 0) saw_apricot = true;
+		if (strcmp(name, "banana.txt") == 0) saw_banana = true;
 
 		naui_dir_iterator_next(&it);
 	}
@@ -95,7 +87,6 @@ void test_dir_iterator_filter()
 	ASSERT(!saw_banana);
 
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -114,21 +105,20 @@ void test_dir_iterator_extensions()
 	naui_file_write_all(a_path, "x", 1);
 	naui_file_write_all(b_path, "x", 1);
 	naui_file_write_all(c_path, "x", 1);
-	NAUI_PATH_FREE(a_name, a_path, b_name, b_path, c_name, c_path);
 
 	const char* exts[] = { ".txt", NULL };
 
-	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, exts, false);
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, exts, false, NAUI_DIR_ITERATOR_DEFAULT);
 
 	bool saw_a = false;
 	bool saw_b = false;
 	bool saw_c = false;
 
 	while (naui_dir_iterator_valid(&it)) {
-		Naui_StringView name = naui_file_filename(it.entry.path);
-		if (naui_sv_cmp(name, NAUI_STR("a.txt"), true)) saw_a = true;
-		if (naui_sv_cmp(name, NAUI_STR("b.bin"), true)) saw_b = true;
-		if (naui_sv_cmp(name, NAUI_STR("c.txt"), true)) saw_c = true;
+		const char* name = it.name;
+		if (strcmp(name, "a.txt") == 0) saw_a = true;
+		if (strcmp(name, "b.bin") == 0) saw_b = true;
+		if (strcmp(name, "c.txt") == 0) saw_c = true;
 
 		naui_dir_iterator_next(&it);
 	}
@@ -140,7 +130,6 @@ void test_dir_iterator_extensions()
 	ASSERT(saw_c);
 
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -157,25 +146,23 @@ void test_dir_iterator_mixed()
 	Naui_Path b_path = naui_path_join(root, b_name);
 	naui_file_write_all(a_path, "x", 1);
 	naui_file_write_all(b_path, "x", 1);
-	NAUI_PATH_FREE(a_name, a_path, b_name, b_path);
 
 	// Directory
 	Naui_Path sub_name = NAUI_PATH("folder");
 	Naui_Path sub = naui_path_join(root, sub_name);
 	naui_directory_create(sub);
-	NAUI_PATH_FREE(sub_name, sub);
 
-	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 
 	bool saw_a = false;
 	bool saw_b = false;
 	bool saw_folder = false;
 
 	while (naui_dir_iterator_valid(&it)) {
-		Naui_StringView name = naui_file_filename(it.entry.path);
-		if (naui_sv_cmp(name, NAUI_STR("a.txt"), true)) saw_a = true;
-		if (naui_sv_cmp(name, NAUI_STR("b.txt"), true)) saw_b = true;
-		if (naui_sv_cmp(name, NAUI_STR("folder"), true) && it.entry.is_directory)
+		const char* name = it.name;
+		if (strcmp(name, "a.txt") == 0) saw_a = true;
+		if (strcmp(name, "b.txt") == 0) saw_b = true;
+		if (strcmp(name, "folder") == 0 && it.is_directory)
 			saw_folder = true;
 
 		naui_dir_iterator_next(&it);
@@ -188,7 +175,6 @@ void test_dir_iterator_mixed()
 	ASSERT(saw_folder);
 
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -197,12 +183,11 @@ void test_dir_iterator_empty()
 	TEST_BEGIN("Iterator - Empty Directory");
 	Naui_Path root = NAUI_PATH("test_iter_empty");
 	ASSERT(naui_directory_create(root));
-	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 	ASSERT(!naui_dir_iterator_valid(&it));
 
 	naui_dir_iterator_close(&it);
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -210,10 +195,9 @@ void test_dir_iterator_invalid_path()
 {
 	TEST_BEGIN("Iterator - Invalid Path");
 	Naui_Path root = NAUI_PATH("this_path_should_not_exist_12345");
-	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 	ASSERT(!naui_dir_iterator_valid(&it));
 	naui_dir_iterator_close(&it);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -227,37 +211,27 @@ void test_dir_iterator_hidden_files()
 	Naui_Path visible_name = NAUI_PATH("visible.txt");
 	Naui_Path visible = naui_path_join(root, visible_name);
 	naui_file_write_all(visible, "x", 1);
-	NAUI_PATH_FREE(visible_name);
 
 	// Create hidden file
 	Naui_Path hidden_name = NAUI_PATH("secret.txt");
 	Naui_Path hidden_orig = naui_path_join(root, hidden_name);
 	naui_file_write_all(hidden_orig, "x", 1);
-	NAUI_PATH_FREE(hidden_name);
-
-	/* naui_file_hide's contract: it may hand back a view aliasing the
-	 * input (Windows, attribute-only - the name on disk never changes)
-	 * or a freshly renamed, owned path (POSIX, which adds a leading
-	 * dot). The ORIGINAL version of this test hardcoded the expected
-	 * name as ".secret.txt", which only holds on POSIX - on Windows
-	 * the file stays named "secret.txt", so that assertion would
-	 * silently and permanently fail there. Fixed to check against
-	 * whatever naui_file_hide actually produced, which is correct on
-	 * both platforms. */
+
+	/* POSIX renames the file with a leading dot, Windows only sets the attribute, so compare with what naui_file_hide returned. */
 	Naui_Path hidden = naui_file_hide(hidden_orig, true);
 	ASSERT(naui_file_is_hidden(hidden));
 
-	Naui_StringView expected_hidden_name = naui_file_filename(hidden);
+	const char* expected_hidden_name = naui_file_filename(&hidden);
 
-	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 
 	bool saw_visible = false;
 	bool saw_hidden = false;
 
 	while (naui_dir_iterator_valid(&it)) {
-		Naui_StringView name = naui_file_filename(it.entry.path);
-		if (naui_sv_cmp(name, NAUI_STR("visible.txt"), true)) saw_visible = true;
-		if (naui_sv_cmp(name, expected_hidden_name, true) && naui_file_is_hidden(it.entry.path))
+		const char* name = it.name;
+		if (strcmp(name, "visible.txt") == 0) saw_visible = true;
+		if (strcmp(name, expected_hidden_name) == 0 && naui_file_is_hidden(naui_path_from_cstr(it.path)))
 			saw_hidden = true;
 
 		naui_dir_iterator_next(&it);
@@ -269,14 +243,6 @@ void test_dir_iterator_hidden_files()
 	ASSERT(saw_hidden);
 
 	naui_directory_remove_all(root);
-
-	/* Tell apart the view-vs-owned cases by pointer identity before
-	 * freeing, same pattern as the filesystem test suite - correct on
-	 * both platforms without needing an #ifdef. */
-	if (hidden.data != hidden_orig.data)
-		NAUI_PATH_FREE(hidden);
-	NAUI_PATH_FREE(hidden_orig, visible, root);
-
 	TEST_END();
 }
 
@@ -295,21 +261,20 @@ void test_dir_iterator_filter_and_ext()
 	naui_file_write_all(apple_path, "x", 1);
 	naui_file_write_all(banana_path, "x", 1);
 	naui_file_write_all(apricot_path, "x", 1);
-	NAUI_PATH_FREE(apple_name, apple_path, banana_name, banana_path, apricot_name, apricot_path);
 
 	const char* exts[] = { ".txt", ".bin", NULL };
 
-	Naui_DirIterator it = naui_dir_iterator_open(root, "apricot", exts, true);
+	Naui_DirIterator it = naui_dir_iterator_open(root, "apricot", exts, true, NAUI_DIR_ITERATOR_DEFAULT);
 
 	bool saw_apple = false;
 	bool saw_banana = false;
 	bool saw_apricot = false;
 
 	while (naui_dir_iterator_valid(&it)) {
-		Naui_StringView name = naui_file_filename(it.entry.path);
-		if (naui_sv_cmp(name, NAUI_STR("apple.txt"), true)) saw_apple = true;
-		if (naui_sv_cmp(name, NAUI_STR("banana.txt"), true)) saw_banana = true;
-		if (naui_sv_cmp(name, NAUI_STR("apricot.bin"), true)) saw_apricot = true;
+		const char* name = it.name;
+		if (strcmp(name, "apple.txt") == 0) saw_apple = true;
+		if (strcmp(name, "banana.txt") == 0) saw_banana = true;
+		if (strcmp(name, "apricot.bin") == 0) saw_apricot = true;
 
 		naui_dir_iterator_next(&it);
 	}
@@ -321,7 +286,6 @@ void test_dir_iterator_filter_and_ext()
 	ASSERT(saw_apricot);
 
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -334,11 +298,10 @@ void test_dir_iterator_reuse()
 	Naui_Path a_name = NAUI_PATH("a.txt");
 	Naui_Path a_path = naui_path_join(root, a_name);
 	naui_file_write_all(a_path, "x", 1);
-	NAUI_PATH_FREE(a_name, a_path);
 
 	// First iteration
 	{
-		Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+		Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 		ASSERT(naui_dir_iterator_valid(&it));
 		naui_dir_iterator_next(&it);
 		ASSERT(!naui_dir_iterator_valid(&it));
@@ -347,13 +310,12 @@ void test_dir_iterator_reuse()
 
 	// Second iteration (fresh)
 	{
-		Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+		Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 		ASSERT(naui_dir_iterator_valid(&it));
 		naui_dir_iterator_close(&it);
 	}
 
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -363,18 +325,17 @@ void test_dir_iterator_no_parent_entries()
 	Naui_Path root = NAUI_PATH("test_iter_no_parent");
 	ASSERT(naui_directory_create(root));
 
-	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 
 	while (naui_dir_iterator_valid(&it)) {
-		Naui_StringView name = naui_file_filename(it.entry.path);
-		ASSERT(!naui_sv_cmp(name, NAUI_STR("."), true));
-		ASSERT(!naui_sv_cmp(name, NAUI_STR(".."), true));
+		const char* name = it.name;
+		ASSERT(strcmp(name, ".") != 0);
+		ASSERT(strcmp(name, "..") != 0);
 		naui_dir_iterator_next(&it);
 	}
 
 	naui_dir_iterator_close(&it);
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
 	TEST_END();
 }
 
@@ -389,21 +350,14 @@ void test_dir_iterator_large()
 
 	for (int i = 0; i < COUNT; i++)
 	{
-		/* A small fixed buffer, not NAUI_PATH_MAX (32768 on Windows) -
-		 * this is always going to be "file_NNN.txt". The original had
-		 * `Naui_Path name; snprintf(name.data, NAUI_PATH_MAX, ...)`,
-		 * which writes through an uninitialized pointer - name.data
-		 * was never assigned, so this was undefined behaviour / a
-		 * likely crash. */
 		char name_buf[64];
 		snprintf(name_buf, sizeof(name_buf), "file_%03d.txt", i);
-		Naui_Path name = naui_path_from_cstr(name_buf); /* view - no allocation */
+		Naui_Path name = naui_path_from_cstr(name_buf);
 		Naui_Path p = naui_path_join(root, name);
 		naui_file_write_all(p, "x", 1);
-		NAUI_PATH_FREE(p);
 	}
 
-	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false);
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, false, NAUI_DIR_ITERATOR_DEFAULT);
 
 	int seen = 0;
 
@@ -418,7 +372,62 @@ void test_dir_iterator_large()
 	ASSERT(seen > 1);
 
 	naui_directory_remove_all(root);
-	NAUI_PATH_FREE(root);
+	TEST_END();
+}
+
+void test_dir_iterator_paths_and_names()
+{
+	TEST_BEGIN("Iterator - Paths and Names");
+	Naui_Path root = NAUI_PATH("test_iter_names");
+	ASSERT(naui_directory_create(root));
+
+	Naui_Path file = naui_path_join(root, naui_path_from_cstr("data.bin"));
+	naui_file_write_all(file, "12345", 5);
+	naui_directory_create(naui_path_join(root, naui_path_from_cstr("sub")));
+
+	/* By default the entry has the joined path and the file size. */
+	int seen = 0;
+	Naui_DirIterator it = naui_dir_iterator_open(root, NULL, NULL, true, NAUI_DIR_ITERATOR_DEFAULT);
+	for (; naui_dir_iterator_valid(&it); naui_dir_iterator_next(&it))
+	{
+		ASSERT(it.path != NULL);
+		if (!it.path)
+			continue;
+
+		Naui_Path expected = naui_path_join(root, naui_path_from_cstr(it.name));
+		ASSERT(strcmp(it.path, expected.data) == 0);
+		if (strcmp(it.name, "data.bin") == 0)
+			ASSERT(!it.is_directory && it.size == 5);
+
+		if (strcmp(it.name, "sub") == 0)
+			ASSERT(it.is_directory);
+
+		++seen;
+	}
+
+	naui_dir_iterator_close(&it);
+	ASSERT(seen == 2);
+	ASSERT(it._state == NULL);
+
+	/* Names only: no path and no sizes, directories are still told apart. */
+	seen = 0;
+	it = naui_dir_iterator_open(root, NULL, NULL, true, NAUI_DIR_ITERATOR_NAMES);
+	for (; naui_dir_iterator_valid(&it); naui_dir_iterator_next(&it))
+	{
+		ASSERT(it.path == NULL);
+		ASSERT(it.size == 0);
+		ASSERT(it.is_directory == (strcmp(it.name, "sub") == 0));
+		++seen;
+	}
+
+	naui_dir_iterator_close(&it);
+	ASSERT(seen == 2);
+
+	/* Closing twice, or an iterator that never opened, is harmless. */
+	naui_dir_iterator_close(&it);
+	ASSERT(sizeof(Naui_DirIterator) <= 64);
+
+	naui_directory_remove_all(root);
 	TEST_END();
 }
 
@@ -435,4 +444,5 @@ void iterator_test()
 	test_dir_iterator_reuse();
 	test_dir_iterator_no_parent_entries();
 	test_dir_iterator_large();
+	test_dir_iterator_paths_and_names();
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "naui/serialization/json_reader.h"
 #include "naui/serialization/json_writer.h"
 #include "naui/serialization/json.h"
+#include "naui/serialization/json_tape.h"
+#include "naui/serialization/json_path.h"
+#include "naui/filesystem/filesystem.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -430,6 +433,73 @@ static void test_writer_heap(void)
 	TEST_END();
 }
 
+typedef struct
+{
+	char data[256];
+	size_t len;
+	int flushes;
+} StreamSink;
+
+static bool stream_sink_flush(void* user, const char* data, size_t len)
+{
+	StreamSink* sink = (StreamSink*)user;
+	if (sink->len + len > sizeof(sink->data))
+		return false;
+
+	memcpy(sink->data + sink->len, data, len);
+	sink->len += len;
+	++sink->flushes;
+	return true;
+}
+
+static void test_writer_stream(void)
+{
+	TEST_BEGIN("naui_json_writer - stream mode");
+
+	{
+		StreamSink sink;
+		memset(&sink, 0, sizeof(sink));
+
+		/* Tiny staging buffer forces many flushes */
+		char buffer[8];
+		Naui_JsonWriter w;
+		naui_json_writer_init_stream(&w, buffer, sizeof(buffer), stream_sink_flush, &sink, false);
+
+		naui_json_writer_object_begin(&w);
+		naui_json_writer_key(&w, "name");
+		naui_json_writer_string(&w, "a \"quoted\" value");
+		naui_json_writer_key(&w, "list");
+		naui_json_writer_array_begin(&w);
+		naui_json_writer_int(&w, 1);
+		naui_json_writer_int(&w, 2);
+		naui_json_writer_array_end(&w);
+		naui_json_writer_object_end(&w);
+
+		int len = naui_json_writer_finish(&w);
+		ASSERT(len == (int)sink.len);
+		ASSERT(sink.flushes > 1);
+
+		sink.data[sink.len] = '\0';
+		ASSERT_STR_EQ(sink.data, "{\"name\":\"a \\\"quoted\\\" value\",\"list\":[1,2]}");
+	}
+
+	{
+		/* A failing sink surfaces as an error */
+		StreamSink sink;
+		memset(&sink, 0, sizeof(sink));
+		sink.len = sizeof(sink.data);
+
+		char buffer[4];
+		Naui_JsonWriter w;
+		naui_json_writer_init_stream(&w, buffer, sizeof(buffer), stream_sink_flush, &sink, false);
+		naui_json_writer_string(&w, "does not fit");
+		ASSERT(naui_json_writer_finish(&w) == -1);
+		ASSERT(w.has_error);
+	}
+
+	TEST_END();
+}
+
 static void test_writer_pretty(void)
 {
 	TEST_BEGIN("naui_json_writer - pretty print");
@@ -597,6 +667,76 @@ static void test_dom_parse_error(void)
 }
 
 
+static char* make_record_array(size_t records, size_t* out_len)
+{
+	size_t cap = records * 64 + 16;
+	char* src = (char*)malloc(cap);
+	size_t len = 0;
+	src[len++] = '[';
+	for (size_t i = 0; i < records; ++i)
+	{
+		len += (size_t)snprintf(src + len, cap - len, "%s{\"id\":%zu,\"name\":\"rec\\n%zu\",\"tags\":[1,[2]]}", i ? ",\n" : "", i, i);
+	}
+
+	src[len++] = ']';
+	src[len] = '\0';
+	*out_len = len;
+	return src;
+}
+
+static void test_dom_parse_parallel(void)
+{
+	TEST_BEGIN("naui_json DOM - parallel array parse");
+
+	{
+		size_t len;
+		char* src = make_record_array(20000, &len);
+
+		Naui_Json serial = naui_json_parse(src, len);
+		Naui_Json parallel = naui_json_parse_parallel(src, len, 4);
+		ASSERT_NULL(parallel.error);
+		ASSERT_NOT_NULL(parallel.root);
+		ASSERT(parallel.root->array.count == serial.root->array.count);
+
+		bool same = true;
+		for (size_t i = 0; i < serial.root->array.count; i += 97)
+		{
+			Naui_JsonValue* a = naui_json_array_get(serial.root, i);
+			Naui_JsonValue* b = naui_json_array_get(parallel.root, i);
+			same &= naui_json_get_int(naui_json_object_get(a, "id"), -1) == naui_json_get_int(naui_json_object_get(b, "id"), -2);
+			same &= naui_json_object_get(b, "name")->string.ptr == naui_json_object_get(a, "name")->string.ptr;
+		}
+
+		ASSERT(same);
+
+		Naui_JsonValue* last = naui_json_array_get(parallel.root, 19999);
+		ASSERT(naui_json_get_int(naui_json_object_get(last, "id"), 0) == 19999);
+
+		naui_json_free(&serial);
+		naui_json_free(&parallel);
+
+		/* A broken element falls back to the serial parser for the error */
+		char* broken = strstr(src + len / 2, "\"tags\"");
+		broken[0] = '!';
+		Naui_Json bad = naui_json_parse_parallel(src, len, 4);
+		ASSERT_NULL(bad.root);
+		ASSERT_NOT_NULL(bad.error);
+		ASSERT(bad.error_line > 1);
+		free(src);
+	}
+
+	{
+		/* Non-array input goes through the normal parser */
+		const char* src = "{\"a\": 1}";
+		Naui_Json r = naui_json_parse_parallel(src, strlen(src), 4);
+		ASSERT_NULL(r.error);
+		ASSERT(r.root->type == NAUI_JSON_OBJECT);
+		naui_json_free(&r);
+	}
+
+	TEST_END();
+}
+
 static void test_dom_build_object(void)
 {
 	TEST_BEGIN("naui_json DOM - build object");
@@ -697,6 +837,83 @@ static void test_dom_build_nested(void)
 	TEST_END();
 }
 
+static void test_dom_build_growth(void)
+{
+	TEST_BEGIN("naui_json DOM - container growth");
+
+	{
+		/* Parsed containers are sized exactly */
+		const char* src = "{\"a\": [1, 2, 3], \"b\": {\"c\": [], \"d\": 4}}";
+		Naui_Json r = naui_json_parse(src, strlen(src));
+		ASSERT_NULL(r.error);
+		ASSERT(r.root->object.cap == r.root->object.count);
+
+		Naui_JsonValue* a = naui_json_object_get(r.root, "a");
+		ASSERT(a->array.count == 3 && a->array.cap == 3);
+		ASSERT(naui_json_object_get(naui_json_object_get(r.root, "b"), "c")->array.count == 0);
+
+		/* Pushing into a parsed array grows it */
+		naui_json_push_int(&r, a, 4);
+		ASSERT(a->array.count == 4);
+		ASSERT(naui_json_get_int(naui_json_array_get(a, 0), 0) == 1);
+		ASSERT(naui_json_get_int(naui_json_array_get(a, 3), 0) == 4);
+		naui_json_free(&r);
+	}
+
+	{
+		/* Interleaved growth recycles the arrays left behind */
+		Naui_Json r = naui_json_result_create();
+		Naui_JsonValue* root = naui_json_object(&r);
+		Naui_JsonValue* lists[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			char key[8];
+			snprintf(key, sizeof(key), "l%d", i);
+			lists[i] = naui_json_set_array(&r, root, key);
+		}
+
+		for (int n = 0; n < 2000; ++n)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				naui_json_push_int(&r, lists[i], n * 4 + i);
+			}
+		}
+
+		bool ok = true;
+		for (int i = 0; i < 4; ++i)
+		{
+			ok &= lists[i]->array.count == 2000;
+			for (int n = 0; n < 2000; ++n)
+			{
+				ok &= naui_json_get_int(naui_json_array_get(lists[i], n), -1) == n * 4 + i;
+			}
+		}
+
+		ASSERT(ok);
+		naui_json_free(&r);
+	}
+
+	{
+		/* A large array keeps its values when grown in place */
+		Naui_Json r = naui_json_result_create();
+		Naui_JsonValue* root = naui_json_array(&r);
+		for (int i = 0; i < 100000; ++i)
+		{
+			naui_json_push_int(&r, root, i);
+		}
+
+		ASSERT(root->array.count == 100000);
+		ASSERT(root->array.cap < 2 * 131072);
+		ASSERT(naui_json_get_int(naui_json_array_get(root, 0), -1) == 0);
+		ASSERT(naui_json_get_int(naui_json_array_get(root, 65536), -1) == 65536);
+		ASSERT(naui_json_get_int(naui_json_array_get(root, 99999), -1) == 99999);
+		naui_json_free(&r);
+	}
+
+	TEST_END();
+}
+
 static void test_dom_roundtrip(void)
 {
 	TEST_BEGIN("naui_json DOM - round-trip build -> write -> parse");
@@ -744,6 +961,48 @@ static void test_dom_roundtrip(void)
 	TEST_END();
 }
 
+static void test_dom_write_file(void)
+{
+	TEST_BEGIN("naui_json DOM - write_file streams to disk");
+
+	{
+		Naui_Json r = naui_json_result_create();
+		Naui_JsonValue* root = naui_json_array(&r);
+		for (int i = 0; i < 4096; ++i)
+		{
+			naui_json_push_int(&r, root, i);
+		}
+
+		Naui_Path path = naui_path_join(naui_directory_get(NAUI_DIR_TEMP), naui_path_from_cstr("naui_json_stream.json"));
+		ASSERT(naui_json_write_file(root, path, true));
+
+		int expected = naui_json_write(root, NULL, 0, true);
+		ASSERT(expected > NAUI_JSON_WRITER_STREAM_SIZE);
+		ASSERT(naui_file_size(path) == (size_t)expected);
+
+		Naui_Json parsed = naui_json_parse_file(path);
+		ASSERT_NULL(parsed.error);
+		ASSERT(parsed.root->array.count == 4096);
+		ASSERT(naui_json_get_int(naui_json_array_get(parsed.root, 4095), 0) == 4095);
+
+		/* A rewrite replaces the whole file and leaves no temporary behind. */
+		Naui_JsonValue* small = naui_json_array(&r);
+		naui_json_push_int(&r, small, 7);
+		ASSERT(naui_json_write_file(small, path, false));
+		ASSERT(naui_file_size(path) == 3);
+
+		Naui_Path temp;
+		snprintf(temp.data, NAUI_PATH_MAX, "%s.tmp", path.data);
+		ASSERT(!naui_path_exists(temp));
+
+		naui_json_free(&parsed);
+		naui_json_free(&r);
+		naui_file_delete(path);
+	}
+
+	TEST_END();
+}
+
 static void test_dom_write_measure(void)
 {
 	TEST_BEGIN("naui_json DOM - write with NULL dest measures size");
@@ -767,6 +1026,197 @@ static void test_dom_write_measure(void)
 	TEST_END();
 }
 
+static void test_tape(void)
+{
+	TEST_BEGIN("naui_json tape - on-demand access");
+
+	{
+		const char* src = "{\"name\": \"Naui\", \"skip\": {\"deep\": [1, [2, 3], {\"x\": null}]}, "
+			"\"list\": [10, {\"a\": true}, \"s\\n\", []], \"n\": 2.5}";
+		Naui_JsonTape tape = naui_json_tape_parse(src, strlen(src));
+		ASSERT_NULL(tape.error);
+		ASSERT(sizeof(Naui_JsonTapeEntry) == 16);
+
+		Naui_JsonNode root = naui_json_tape_root(&tape);
+		ASSERT(naui_json_node_type(root) == NAUI_JSON_OBJECT);
+		ASSERT(naui_json_node_count(root) == 4);
+
+		char buffer[32];
+		naui_json_node_copy_string(naui_json_node_object_get(root, "name"), buffer, sizeof(buffer));
+		ASSERT_STR_EQ(buffer, "Naui");
+		ASSERT(fabs(naui_json_node_get_number(naui_json_node_object_get(root, "n"), 0.0) - 2.5) < 1e-9);
+		ASSERT(!naui_json_node_valid(naui_json_node_object_get(root, "missing")));
+		ASSERT(!naui_json_node_valid(naui_json_node_object_get(root, "deep")));
+
+		Naui_JsonNode list = naui_json_node_object_get(root, "list");
+		ASSERT(naui_json_node_count(list) == 4);
+		ASSERT(naui_json_node_get_int(naui_json_node_array_get(list, 0), 0) == 10);
+		ASSERT(naui_json_node_get_bool(naui_json_node_object_get(naui_json_node_array_get(list, 1), "a"), false));
+		naui_json_node_copy_string(naui_json_node_array_get(list, 2), buffer, sizeof(buffer));
+		ASSERT_STR_EQ(buffer, "s\n");
+		ASSERT(naui_json_node_type(naui_json_node_array_get(list, 3)) == NAUI_JSON_ARRAY);
+		ASSERT(!naui_json_node_valid(naui_json_node_array_get(list, 4)));
+
+		/* Sibling iteration stays inside the container */
+		int elements = 0;
+		for (Naui_JsonNode it = naui_json_node_first(list); naui_json_node_valid(it); it = naui_json_node_next(it))
+		{
+			ASSERT_NULL(naui_json_node_key(it, NULL));
+			++elements;
+		}
+
+		ASSERT(elements == 4);
+
+		int members = 0;
+		size_t key_len = 0;
+		const char* last_key = NULL;
+		for (Naui_JsonNode it = naui_json_node_first(root); naui_json_node_valid(it); it = naui_json_node_next(it))
+		{
+			last_key = naui_json_node_key(it, &key_len);
+			++members;
+		}
+
+		ASSERT(members == 4);
+		ASSERT(last_key && key_len == 1 && last_key[0] == 'n');
+		naui_json_tape_free(&tape);
+	}
+
+	{
+		const char* src = "[1, 2,";
+		Naui_JsonTape tape = naui_json_tape_parse(src, strlen(src));
+		ASSERT_NOT_NULL(tape.error);
+		ASSERT(!naui_json_node_valid(naui_json_tape_root(&tape)));
+		naui_json_tape_free(&tape);
+	}
+
+	{
+		/* Lookups agree with the DOM on a larger document */
+		size_t len;
+		char* src = make_record_array(2000, &len);
+		Naui_JsonTape tape = naui_json_tape_parse(src, len);
+		ASSERT_NULL(tape.error);
+
+		Naui_JsonNode root = naui_json_tape_root(&tape);
+		ASSERT(naui_json_node_count(root) == 2000);
+
+		bool same = true;
+		int i = 0;
+		for (Naui_JsonNode it = naui_json_node_first(root); naui_json_node_valid(it); it = naui_json_node_next(it), ++i)
+		{
+			same &= naui_json_node_get_int(naui_json_node_object_get(it, "id"), -1) == i;
+		}
+
+		ASSERT(same && i == 2000);
+		naui_json_tape_free(&tape);
+		free(src);
+	}
+
+	TEST_END();
+}
+
+typedef struct
+{
+	int hits;
+	int ids[4];
+	bool consumed;
+} PathBatchResult;
+
+static void path_batch_collect(void* user, size_t path_index, Naui_JsonReader* reader)
+{
+	PathBatchResult* result = (PathBatchResult*)user;
+	++result->hits;
+	if (reader->token == NAUI_JSON_TOKEN_NUMBER)
+		result->ids[path_index] = (int)reader->number;
+	else if (reader->token == NAUI_JSON_TOKEN_OBJECT_BEGIN)
+	{
+		naui_json_reader_skip(reader);
+		result->consumed = true;
+	}
+}
+
+static void test_path(void)
+{
+	TEST_BEGIN("naui_json path - compiled queries");
+
+	const char* src = "{\"panels\": [{\"type\": \"a\"}, {\"type\": \"b\", \"children\": [{\"type\": \"leaf\", \"id\": 7}]}], "
+		"\"a/b\": {\"c.d\": 3}, \"7\": 1}";
+
+	{
+		Naui_JsonPath dotted, pointer, quoted, escaped, numeric, missing, bad;
+		ASSERT(naui_json_path_compile(&dotted, "panels[1].children[0].type"));
+		ASSERT(naui_json_path_compile(&pointer, "/panels/1/children/0/id"));
+		ASSERT(naui_json_path_compile(&quoted, "$[\"a/b\"][\"c.d\"]"));
+		ASSERT(naui_json_path_compile(&escaped, "/a~1b/c.d"));
+		ASSERT(naui_json_path_compile(&numeric, "/7"));
+		ASSERT(naui_json_path_compile(&missing, "panels[5].type"));
+		ASSERT(!naui_json_path_compile(&bad, "panels[x]"));
+		ASSERT(!naui_json_path_compile(&bad, "panels."));
+		ASSERT(dotted.count == 5);
+
+		Naui_Json dom = naui_json_parse(src, strlen(src));
+		char buffer[16];
+		naui_json_copy_string(naui_json_path_eval(&dotted, dom.root), buffer, sizeof(buffer));
+		ASSERT_STR_EQ(buffer, "leaf");
+		ASSERT(naui_json_get_int(naui_json_path_eval(&pointer, dom.root), 0) == 7);
+		ASSERT(naui_json_get_int(naui_json_path_eval(&quoted, dom.root), 0) == 3);
+		ASSERT(naui_json_get_int(naui_json_path_eval(&escaped, dom.root), 0) == 3);
+		ASSERT(naui_json_get_int(naui_json_path_eval(&numeric, dom.root), 0) == 1);
+		ASSERT_NULL(naui_json_path_eval(&missing, dom.root));
+		naui_json_free(&dom);
+
+		Naui_JsonTape tape = naui_json_tape_parse(src, strlen(src));
+		Naui_JsonNode root = naui_json_tape_root(&tape);
+		naui_json_node_copy_string(naui_json_path_eval_node(&dotted, root), buffer, sizeof(buffer));
+		ASSERT_STR_EQ(buffer, "leaf");
+		ASSERT(naui_json_node_get_int(naui_json_path_eval_node(&quoted, root), 0) == 3);
+		ASSERT(!naui_json_node_valid(naui_json_path_eval_node(&missing, root)));
+		naui_json_tape_free(&tape);
+
+		Naui_JsonReader reader;
+		naui_json_reader_init(&reader, src, strlen(src));
+		ASSERT(naui_json_path_eval_reader(&dotted, &reader));
+		naui_json_reader_copy_str(&reader, buffer, sizeof(buffer));
+		ASSERT_STR_EQ(buffer, "leaf");
+
+		naui_json_reader_init(&reader, src, strlen(src));
+		ASSERT(naui_json_path_eval_reader(&pointer, &reader));
+		ASSERT(reader.token == NAUI_JSON_TOKEN_NUMBER && (int)reader.number == 7);
+
+		naui_json_reader_init(&reader, src, strlen(src));
+		ASSERT(!naui_json_path_eval_reader(&missing, &reader));
+	}
+
+	{
+		/* One pass over the reader resolves every path */
+		Naui_JsonPath paths[4];
+		naui_json_path_compile(&paths[0], "/panels/1/children/0/id");
+		naui_json_path_compile(&paths[1], "/7");
+		naui_json_path_compile(&paths[2], "/panels/1");
+		naui_json_path_compile(&paths[3], "/a~1b/c.d");
+
+		PathBatchResult result;
+		memset(&result, 0, sizeof(result));
+		Naui_JsonReader reader;
+		naui_json_reader_init(&reader, src, strlen(src));
+		ASSERT(naui_json_path_eval_batch(paths, 4, &reader, path_batch_collect, &result));
+
+		/* paths[2] consumed the panel, so paths[0] below it is never reached */
+		ASSERT(result.consumed);
+		ASSERT(result.hits == 3);
+		ASSERT(result.ids[0] == 0);
+		ASSERT(result.ids[1] == 1);
+		ASSERT(result.ids[3] == 3);
+
+		memset(&result, 0, sizeof(result));
+		naui_json_reader_init(&reader, src, strlen(src));
+		ASSERT(naui_json_path_eval_batch(paths, 2, &reader, path_batch_collect, &result));
+		ASSERT(result.hits == 2);
+		ASSERT(result.ids[0] == 7 && result.ids[1] == 1);
+	}
+
+	TEST_END();
+}
+
 void json_test(void)
 {
 	test_reader_empty();
@@ -785,17 +1235,24 @@ void json_test(void)
 	test_writer_escape();
 	test_writer_truncation();
 	test_writer_heap();
+	test_writer_stream();
 	test_writer_pretty();
 
 	test_dom_parse_object();
 	test_dom_parse_array();
 	test_dom_parse_nested();
 	test_dom_parse_error();
+	test_dom_parse_parallel();
 
 	test_dom_build_object();
 	test_dom_build_array();
 	test_dom_build_nested();
+	test_dom_build_growth();
 
 	test_dom_roundtrip();
+	test_dom_write_file();
 	test_dom_write_measure();
+
+	test_tape();
+	test_path();
 }
\ No newline at end of file
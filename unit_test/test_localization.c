@@ -582,6 +582,39 @@ static void test_localization_meta_cache_metadata_fields(void)
 	TEST_END();
 }
 
+static void test_localization_shutdown(void)
+{
+	TEST_BEGIN("Localization - shutdown and set_current again");
+
+	Naui_Path lang_dir = get_lang_dir();
+	Naui_Path file = write_test_lang(lang_dir, "en-US.lang",
+		"{"
+		"  \"_meta\": {"
+		"	\"language\": \"en-US\","
+		"	\"direction\": \"ltr\","
+		"	\"name\": \"English\""
+		"  },"
+		"  \"hello\": \"Hello again\""
+		"}"
+	);
+
+	naui_localization_set_current("en-US");
+	ASSERT_NOT_NULL(naui_localization_get_current());
+
+	naui_localization_shutdown();
+	ASSERT_NULL(naui_localization_get_current());
+
+	/* Everything comes back after a shutdown, the language folder included. */
+	naui_localization_set_current("en-US");
+	ASSERT_NOT_NULL(naui_localization_get_current());
+	ASSERT_STR_EQ(NAUI_TR("hello"), "Hello again");
+
+	naui_localization_shutdown();
+	naui_file_delete(file);
+
+	TEST_END();
+}
+
 void localization_test(void)
 {
 	test_localization_basic();
@@ -598,4 +631,5 @@ void localization_test(void)
 	test_localization_meta_cache_corrupt_file();
 	test_localization_meta_cache_no_meta_block();
 	test_localization_meta_cache_metadata_fields();
+	test_localization_shutdown();
 }
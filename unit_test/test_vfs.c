@@ -0,0 +1,181 @@
+#include "test.h"
+#include "test_func.h"
+#include "naui/filesystem/vfs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#	define SEP "\\"
+#else
+#	define SEP "/"
+#endif
+
+static Naui_Path temp_root(void)
+{
+	static char buf[NAUI_PATH_MAX];
+	static bool computed = false;
+
+	if (!computed)
+	{
+#if defined(_WIN32) || defined(_WIN64)
+		const char* tmp = getenv("TEMP");
+		if (!tmp) tmp = "C:\\Temp";
+		snprintf(buf, sizeof(buf), "%s\\naui_vfs_test", tmp);
+#else
+		snprintf(buf, sizeof(buf), "/tmp/naui_vfs_test");
+#endif
+		computed = true;
+	}
+
+	return naui_path_from_cstr(buf);
+}
+
+static Naui_Path tp(const char* sub)
+{
+	enum { TP_POOL_SIZE = 32 };
+	static char pool[TP_POOL_SIZE][NAUI_PATH_MAX];
+	static size_t idx = 0;
+	idx = (idx + 1) % TP_POOL_SIZE;
+
+	Naui_Path root = temp_root();
+	snprintf(pool[idx], NAUI_PATH_MAX, "%s" SEP "%s", root.data, sub);
+	return naui_path_from_cstr(pool[idx]);
+}
+
+static void write_text(const Naui_Path path, const char* text)
+{
+	naui_file_write_all(path, text, strlen(text));
+}
+
+static bool read_equals(const char* path, const char* expected)
+{
+	Naui_VfsFile file;
+	if (!naui_vfs_read(path, &file))
+		return false;
+
+	bool same = file.size == strlen(expected) && memcmp(file.data, expected, file.size) == 0;
+	naui_vfs_release(&file);
+	return same;
+}
+
+static void test_vfs_directory(void)
+{
+	TEST_BEGIN("naui_vfs_mount - directory");
+
+	{
+		naui_directory_create(tp("loose"));
+		naui_directory_create(tp("loose" SEP "Fonts"));
+		write_text(tp("loose" SEP "Fonts" SEP "a.ttf"), "font");
+		write_text(tp("loose" SEP "b.txt"), "bee");
+
+		ASSERT(naui_vfs_mount(tp("loose"), "Assets", 0));
+		ASSERT(naui_vfs_exists("Assets/Fonts/a.ttf"));
+		ASSERT(naui_vfs_exists("Assets\\Fonts"));
+		ASSERT(read_equals("./Assets/Fonts/a.ttf", "font"));
+		ASSERT(read_equals("Assets\\b.txt", "bee"));
+		ASSERT(!naui_vfs_exists("Assets/Fonts/missing.ttf"));
+
+		Naui_List(const char*) list = naui_vfs_list("Assets");
+		ASSERT(naui_list_len(list) == 1);
+		ASSERT(list && strcmp(list[0], "Assets/b.txt") == 0);
+		naui_list_free(list);
+
+		naui_vfs_shutdown();
+	}
+
+	TEST_END();
+}
+
+static void test_vfs_overlay(void)
+{
+	TEST_BEGIN("naui_vfs_mount - pak and zip overlays");
+
+	{
+		naui_directory_create(tp("base"));
+		write_text(tp("base" SEP "shared.txt"), "base");
+		write_text(tp("base" SEP "only_base.txt"), "only base");
+
+		naui_directory_create(tp("packed"));
+		write_text(tp("packed" SEP "shared.txt"), "pak");
+		ASSERT(naui_archive_create_custom(tp("packed"), tp("packed.naui")));
+
+		naui_directory_create(tp("zipped"));
+		write_text(tp("zipped" SEP "shared.txt"), "zip");
+		write_text(tp("zipped" SEP "only_zip.txt"), "only zip");
+
+		Naui_Archive w = NAUI_ARCHIVE_INIT;
+		naui_archive_open(&w, tp("zipped.zip"), NAUI_ARCHIVE_WRITE);
+		naui_archive_add_folder(&w, tp("zipped"), naui_path_from_cstr(""));
+		naui_archive_close(&w);
+
+		ASSERT(naui_vfs_mount(tp("base"), "", 0));
+		ASSERT(naui_vfs_mount(tp("packed.naui"), "", 2));
+		ASSERT(naui_vfs_mount(tp("zipped.zip"), "", 1));
+
+		ASSERT(read_equals("shared.txt", "pak"));
+		ASSERT(read_equals("only_base.txt", "only base"));
+		ASSERT(read_equals("only_zip.txt", "only zip"));
+
+		ASSERT(naui_vfs_unmount(tp("packed.naui")));
+		ASSERT(read_equals("shared.txt", "zip"));
+
+		/* Re-mounting replaces the old priority. */
+		ASSERT(naui_vfs_mount(tp("base"), "", 5));
+		ASSERT(read_equals("shared.txt", "base"));
+
+		/* A re-mount that fails keeps the mount it would have replaced. */
+		char long_point[NAUI_VFS_MOUNT_POINT_MAX + 8];
+		memset(long_point, 'a', sizeof(long_point) - 1);
+		long_point[sizeof(long_point) - 1] = '\0';
+		ASSERT(!naui_vfs_mount(tp("base"), long_point, 5));
+		ASSERT(read_equals("shared.txt", "base"));
+
+		naui_vfs_shutdown();
+		ASSERT(!naui_vfs_exists("only_zip.txt"));
+	}
+
+	TEST_END();
+}
+
+static void test_vfs_fallthrough(void)
+{
+	TEST_BEGIN("naui_vfs - unmounted paths fall through to disk");
+
+	{
+		naui_directory_create(tp("disk"));
+		write_text(tp("disk" SEP "one.txt"), "one");
+		write_text(tp("disk" SEP "two.txt"), "two");
+
+		ASSERT(naui_vfs_exists(tp("disk" SEP "one.txt").data));
+		ASSERT(read_equals(tp("disk" SEP "one.txt").data, "one"));
+
+		Naui_VfsFile file;
+		ASSERT(!naui_vfs_read(tp("disk" SEP "missing.txt").data, &file));
+		ASSERT(file.data == NULL);
+
+		Naui_List(const char*) list = naui_vfs_list(tp("disk").data);
+		ASSERT(naui_list_len(list) == 2);
+		for (size_t i = 0; i < (size_t)naui_list_len(list); ++i)
+		{
+			ASSERT(naui_vfs_exists(list[i]));
+		}
+
+		naui_list_free(list);
+		naui_vfs_shutdown();
+	}
+
+	TEST_END();
+}
+
+void vfs_test(void)
+{
+	Naui_Path root = temp_root();
+	naui_directory_create(root);
+
+	test_vfs_directory();
+	test_vfs_overlay();
+	test_vfs_fallthrough();
+
+	naui_directory_remove_all(root);
+}
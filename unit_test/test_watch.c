@@ -0,0 +1,157 @@
+#include "test.h"
+#include "test_func.h"
+#include "naui/filesystem/watch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#	define SEP "\\"
+#else
+#	define SEP "/"
+#endif
+
+enum { WATCH_LOG_MAX = 32 };
+
+typedef struct
+{
+	char relative[WATCH_LOG_MAX][128];
+	Naui_WatchEvent events[WATCH_LOG_MAX];
+	int count;
+} Watch_Log;
+
+static Naui_Path temp_root(void)
+{
+	static char buf[NAUI_PATH_MAX];
+	static bool computed = false;
+
+	if (!computed)
+	{
+#if defined(_WIN32) || defined(_WIN64)
+		const char* tmp = getenv("TEMP");
+		if (!tmp) tmp = "C:\\Temp";
+		snprintf(buf, sizeof(buf), "%s\\naui_watch_test", tmp);
+#else
+		snprintf(buf, sizeof(buf), "/tmp/naui_watch_test");
+#endif
+		computed = true;
+	}
+
+	return naui_path_from_cstr(buf);
+}
+
+static Naui_Path tp(const char* sub)
+{
+	Naui_Path path;
+	snprintf(path.data, NAUI_PATH_MAX, "%s" SEP "%s", temp_root().data, sub);
+	return path;
+}
+
+static void on_change(const Naui_WatchChange* change, void* user)
+{
+	Watch_Log* log = (Watch_Log*)user;
+	if (log->count >= WATCH_LOG_MAX)
+		return;
+
+	snprintf(log->relative[log->count], sizeof(log->relative[0]), "%s", change->relative);
+	log->events[log->count] = change->events;
+	++log->count;
+}
+
+/* Poll until something is reported and the debounce window after it has passed. */
+static void pump(Watch_Log* log, uint32_t timeout_ms)
+{
+	int before = log->count;
+	for (uint32_t waited = 0; waited < timeout_ms; waited += 10)
+	{
+		naui_watch_poll();
+		if (log->count > before)
+		{
+			naui_thread_sleep_ms(60);
+			naui_watch_poll();
+			return;
+		}
+
+		naui_thread_sleep_ms(10);
+	}
+}
+
+static int find(const Watch_Log* log, const char* relative)
+{
+	for (int i = 0; i < log->count; ++i)
+	{
+		if (strcmp(log->relative[i], relative) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+static void test_watch_changes(void)
+{
+	TEST_BEGIN("naui_watch - debounced changes");
+
+	{
+		naui_directory_create(tp("tree"));
+		naui_directory_create(tp("tree" SEP "sub"));
+
+		Watch_Log log;
+		memset(&log, 0, sizeof(log));
+		Naui_WatchHandle watch = naui_watch_add(tp("tree"), 30, on_change, &log);
+		ASSERT(watch._id != 0);
+
+		/* Several writes to one file inside the window come out as one change. */
+		for (int i = 0; i < 5; ++i)
+		{
+			naui_file_write_all(tp("tree" SEP "theme.json"), "{}", 2);
+		}
+
+		pump(&log, 2000);
+		ASSERT(log.count == 1);
+		int theme = find(&log, "theme.json");
+		ASSERT(theme >= 0 && (log.events[theme] & NAUI_WATCH_CREATED) && (log.events[theme] & NAUI_WATCH_MODIFIED));
+
+		/* Folders below the root are watched, including ones created later. */
+		naui_file_write_all(tp("tree" SEP "sub" SEP "image.png"), "png", 3);
+		pump(&log, 2000);
+		ASSERT(find(&log, "sub" SEP "image.png") >= 0);
+
+		naui_directory_create(tp("tree" SEP "late"));
+		naui_thread_sleep_ms(5);
+		naui_watch_poll();
+		naui_file_write_all(tp("tree" SEP "late" SEP "en-US.lang"), "{}", 2);
+		pump(&log, 2000);
+		naui_thread_sleep_ms(60);
+		naui_watch_poll();
+		ASSERT(find(&log, "late") >= 0);
+		ASSERT(find(&log, "late" SEP "en-US.lang") >= 0);
+
+		int before = log.count;
+		naui_file_delete(tp("tree" SEP "theme.json"));
+		pump(&log, 2000);
+		ASSERT(log.count == before + 1 && (log.events[before] & NAUI_WATCH_DELETED));
+
+		/* Nothing is reported once the watch is gone. */
+		naui_watch_remove(watch);
+		before = log.count;
+		naui_file_write_all(tp("tree" SEP "sub" SEP "image.png"), "png!", 4);
+		pump(&log, 200);
+		ASSERT(log.count == before);
+
+		ASSERT(naui_watch_add(tp("missing"), 0, on_change, &log)._id == 0);
+		naui_watch_shutdown();
+	}
+
+	TEST_END();
+}
+
+void watch_test(void)
+{
+	Naui_Path root = temp_root();
+	naui_directory_remove_all(root);
+	naui_directory_create(root);
+
+	test_watch_changes();
+
+	naui_directory_remove_all(root);
+}